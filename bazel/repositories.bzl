@@ -11,6 +11,8 @@ WINDOWS_SKIP_TARGETS = [
     "envoy.filters.http.file_system_buffer",
     "envoy.filters.http.language",
     "envoy.filters.http.sxg",
+    # Maps its region with POSIX mmap().
+    "envoy.stat_sinks.shared_memory",
     "envoy.tracers.dynamic_ot",
     "envoy.tracers.datadog",
     # Extensions that require CEL.
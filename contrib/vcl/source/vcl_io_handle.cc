@@ -281,6 +281,10 @@ Api::IoCallUint64Result VclIoHandle::recv(void* buffer, size_t length, int flags
   return vclCallResultToIoCallResult(rv);
 }
 
+Api::IoCallUint64Result VclIoHandle::recvZeroCopyCompletions(const ZeroCopyCompletionCb&) {
+  return {0, Envoy::Network::IoSocketError::create(SOCKET_ERROR_NOT_SUP)};
+}
+
 Api::IoCallUint64Result VclIoHandle::sendmsg(const Buffer::RawSlice* slices, uint64_t num_slice,
                                              int, const Envoy::Network::Address::Ip*,
                                              const Envoy::Network::Address::Instance&) {
@@ -39,6 +39,7 @@ public:
   Api::IoCallUint64Result writev(const Buffer::RawSlice* slices, uint64_t num_slice) override;
   Api::IoCallUint64Result write(Buffer::Instance& buffer) override;
   Api::IoCallUint64Result recv(void* buffer, size_t length, int flags) override;
+  Api::IoCallUint64Result recvZeroCopyCompletions(const ZeroCopyCompletionCb& cb) override;
   Api::IoCallUint64Result sendmsg(const Buffer::RawSlice* slices, uint64_t num_slice, int flags,
                                   const Envoy::Network::Address::Ip* self_ip,
                                   const Envoy::Network::Address::Instance& peer_address) override;
@@ -20,6 +20,17 @@ public:
    * @see sched_getaffinity (man 2 sched_getaffinity)
    */
   virtual SysCallIntResult sched_getaffinity(pid_t pid, size_t cpusetsize, cpu_set_t* mask) PURE;
+
+  /**
+   * @see pipe2 (man 2 pipe2)
+   */
+  virtual SysCallIntResult pipe2(int pipefd[2], int flags) PURE;
+
+  /**
+   * @see splice (man 2 splice). Both offsets are always null, i.e. neither end is seekable.
+   */
+  virtual SysCallSizeResult splice(os_fd_t fd_in, os_fd_t fd_out, size_t len,
+                                   unsigned int flags) PURE;
 };
 
 using LinuxOsSysCallsPtr = std::unique_ptr<LinuxOsSysCalls>;
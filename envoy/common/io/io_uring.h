@@ -42,9 +42,22 @@ public:
    */
   IoUringSocket& socket() const { return socket_; }
 
+  /**
+   * Returns the flags of the latest completion of the request, e.g. whether a multishot request
+   * will post more completions or which provided buffer holds the received data.
+   */
+  uint32_t completionFlags() const { return completion_flags_; }
+
+  /**
+   * Sets the flags of the latest completion of the request. This is called by the IoUring
+   * before the completion is handed to the CompletionCb.
+   */
+  void setCompletionFlags(uint32_t flags) { completion_flags_ = flags; }
+
 private:
   RequestType type_;
   IoUringSocket& socket_;
+  uint32_t completion_flags_{0};
 };
 
 /**
@@ -101,6 +114,15 @@ public:
   virtual IoUringResult prepareAccept(os_fd_t fd, struct sockaddr* remote_addr,
                                       socklen_t* remote_addr_len, Request* user_data) PURE;
 
+  /**
+   * Prepares a multishot accept system call and puts it into the submission queue. The request
+   * posts a completion for every accepted connection until it fails or is cancelled. The accepted
+   * sockets are non-blocking.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareMultishotAccept(os_fd_t fd, Request* user_data) PURE;
+
   /**
    * Prepares a connect system call and puts it into the submission queue.
    * Returns IoUringResult::Failed in case the submission queue is full already
@@ -118,6 +140,15 @@ public:
   virtual IoUringResult prepareReadv(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
                                      off_t offset, Request* user_data) PURE;
 
+  /**
+   * Prepares a multishot recv system call and puts it into the submission queue. The request
+   * receives into the buffers provided by setupProvidedBuffers() and keeps posting completions
+   * until it fails, is cancelled or runs out of provided buffers.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareRecvMultishot(os_fd_t fd, Request* user_data) PURE;
+
   /**
    * Prepares a writev system call and puts it into the submission queue.
    * Returns IoUringResult::Failed in case the submission queue is full already
@@ -175,6 +206,34 @@ public:
    * @param fd is used to refer to the completions will be removed.
    */
   virtual void removeInjectedCompletion(os_fd_t fd) PURE;
+
+  /**
+   * Registers a ring of buffers which the kernel picks from to complete multishot recv requests.
+   * @param num_buffers is the number of buffers, which must be a power of two no larger than
+   * 32768.
+   * @param buffer_size is the size of each buffer.
+   * @return false if the kernel does not support provided buffer rings.
+   */
+  virtual bool setupProvidedBuffers(uint32_t num_buffers, uint32_t buffer_size) PURE;
+
+  /**
+   * Returns the number of provided buffers which are currently available to the kernel.
+   */
+  virtual uint32_t numAvailableProvidedBuffers() const PURE;
+
+  /**
+   * Takes ownership of the provided buffer the kernel completed a request with. The buffer is not
+   * used by the kernel again until it is returned with returnProvidedBuffer().
+   * @param buffer_id is the buffer id carried in the completion flags.
+   * @return the start of the buffer.
+   */
+  virtual uint8_t* takeProvidedBuffer(uint16_t buffer_id) PURE;
+
+  /**
+   * Returns a buffer taken with takeProvidedBuffer() to the kernel.
+   * @param buffer_id is the id of the buffer.
+   */
+  virtual void returnProvidedBuffer(uint16_t buffer_id) PURE;
 };
 
 using IoUringPtr = std::unique_ptr<IoUring>;
@@ -376,6 +435,12 @@ public:
    * @param cb the callback function.
    */
   virtual void setFileReadyCb(Event::FileReadyCb cb) PURE;
+
+  /**
+   * Return the oldest connection accepted by an accept socket and not yet handed out.
+   * @return the file descriptor of the connection or INVALID_SOCKET if there is none.
+   */
+  virtual os_fd_t popAcceptedFd() PURE;
 };
 
 using IoUringSocketPtr = std::unique_ptr<IoUringSocket>;
@@ -405,11 +470,22 @@ public:
   virtual IoUringSocket& addClientSocket(os_fd_t fd, Event::FileReadyCb cb,
                                          bool enable_close_event) PURE;
 
+  /**
+   * Add an accept socket for a listening file descriptor to the worker. The file descriptor stays
+   * owned by the caller.
+   */
+  virtual IoUringSocket& addAcceptSocket(os_fd_t fd, Event::FileReadyCb cb) PURE;
+
   /**
    * Return the current thread's dispatcher.
    */
   virtual Event::Dispatcher& dispatcher() PURE;
 
+  /**
+   * Submit an accept request for a socket.
+   */
+  virtual Request* submitAcceptRequest(IoUringSocket& socket) PURE;
+
   /**
    * Submit a connect request for a socket.
    */
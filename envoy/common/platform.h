@@ -238,6 +238,14 @@ constexpr bool win32SupportsOriginalDestination() {
 #define IPPROTO_MPTCP 262
 #endif
 
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+
 typedef int os_fd_t;            // NOLINT(modernize-use-using)
 typedef int filesystem_os_id_t; // NOLINT(modernize-use-using)
 typedef int signal_t;           // NOLINT(modernize-use-using)
@@ -335,3 +343,9 @@ struct mmsghdr {
 #else
 #define ENVOY_PLATFORM_ENABLE_SEND_RST 0
 #endif
+
+#if defined(__linux__)
+#define ENVOY_PLATFORM_ENABLE_ZEROCOPY_SEND 1
+#else
+#define ENVOY_PLATFORM_ENABLE_ZEROCOPY_SEND 0
+#endif
@@ -111,6 +111,11 @@ public:
    */
   using BytesSentCb = std::function<bool(uint64_t bytes_sent)>;
 
+  /**
+   * Callback function for when data read from the connection was spliced to another connection.
+   */
+  using SplicedBytesCb = std::function<void(uint64_t bytes_spliced)>;
+
   struct ConnectionStats {
     Stats::Counter& read_total_;
     Stats::Gauge& read_current_;
@@ -362,6 +367,21 @@ public:
    */
   virtual bool startSecureTransport() PURE;
 
+  /**
+   * Starts moving data read from this connection straight to the socket of `target` with
+   * splice(2), without copying it through user space. Spliced data bypasses the read filters of
+   * this connection and the write filters of `target`, `cb` is called with the number of bytes
+   * moved instead. End of stream and errors are still raised through the read filters. Data is
+   * read as usual while `target` has buffered data of its own, so ordering and watermark based
+   * flow control are unaffected. Splicing stops when either connection closes.
+   * @param target supplies the connection to which data read from this connection is written.
+   * @param cb supplies the callback invoked with the number of bytes spliced.
+   * @return whether splicing was started. It is only supported on Linux, between plaintext
+   *         connections on the default socket interface with at most one read filter and no
+   *         write filters each.
+   */
+  virtual bool startSplice(Connection& target, SplicedBytesCb cb) PURE;
+
   /**
    *  @return absl::optional<std::chrono::milliseconds> An optional of the most recent round-trip
    *  time of the connection. If the platform does not support this, then an empty optional is
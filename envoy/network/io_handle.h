@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <functional>
 #include <memory>
 
 #include "envoy/api/io_error.h"
@@ -216,6 +217,25 @@ public:
    */
   virtual Api::IoCallUint64Result recv(void* buffer, size_t length, int flags) PURE;
 
+  /**
+   * Called for each MSG_ZEROCOPY completion notification read from the socket error queue.
+   * @param first_id the id of the first send the notification completes.
+   * @param last_id the id of the last send the notification completes, inclusive. Ids wrap around.
+   * @param copied true if the kernel copied the data instead of transmitting it in place.
+   */
+  using ZeroCopyCompletionCb =
+      std::function<void(uint32_t first_id, uint32_t last_id, bool copied)>;
+
+  /**
+   * Read the MSG_ZEROCOPY completion notifications queued on the socket error queue, without
+   * blocking.
+   * @param cb supplies the callback to invoke for each notification.
+   * @return a Api::IoCallUint64Result with err_ = an Api::IoError instance or
+   * err_ = nullptr and rc_ = the number of notifications read. Handles which cannot send with
+   * MSG_ZEROCOPY fail with IoErrorCode::NoSupport.
+   */
+  virtual Api::IoCallUint64Result recvZeroCopyCompletions(const ZeroCopyCompletionCb& cb) PURE;
+
   /**
    * return true if the platform supports recvmmsg() and sendmmsg().
    */
@@ -85,6 +85,12 @@ public:
    */
   virtual bool flushOnAdmin() const PURE;
 
+  /**
+   * @return bool indicator to only flush the counters and gauges that changed since the previous
+   *         flush.
+   */
+  virtual bool flushChangedOnly() const PURE;
+
   /**
    * @return true if deferred creation of stats is enabled.
    */
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <functional>
+#include <memory>
+#include <vector>
 
 #include "envoy/common/time.h"
+#include "envoy/config/core/v3/base.pb.h"
 #include "envoy/config/typed_config.h"
 #include "envoy/ssl/context.h"
 #include "envoy/ssl/context_config.h"
@@ -22,6 +25,17 @@ namespace Ssl {
 using ContextAdditionalInitFunc =
     std::function<absl::Status(Ssl::TlsContext& context, const Ssl::TlsCertificateConfig& cert)>;
 
+/**
+ * State prepared ahead of creating the client contexts of a batch of transport sockets, which is
+ * kept for as long as the handle is held.
+ */
+class PreparedClientContexts {
+public:
+  virtual ~PreparedClientContexts() = default;
+};
+
+using PreparedClientContextsPtr = std::unique_ptr<PreparedClientContexts>;
+
 /**
  * Manages all of the SSL contexts in the process
  */
@@ -35,6 +49,16 @@ public:
   virtual absl::StatusOr<ClientContextSharedPtr>
   createSslClientContext(Stats::Scope& scope, const ClientContextConfig& config) PURE;
 
+  /**
+   * Prepares the pure parts of creating the client contexts of the transport sockets, such as
+   * parsing their trusted CA bundles, on helper threads, so that creating the contexts on the main
+   * thread afterwards reuses them. Transport sockets that are not TLS are ignored.
+   * @param transport_sockets supplies the transport sockets, in config order.
+   * @return the prepared state, which is released with the handle.
+   */
+  virtual PreparedClientContextsPtr prepareClientContexts(
+      const std::vector<const envoy::config::core::v3::TransportSocket*>& transport_sockets) PURE;
+
   /**
    * Builds a ServerContext from a ServerContextConfig.
    */
@@ -94,6 +94,19 @@ public:
   virtual void forEachSinkedGauge(SizeFn f_size, StatFn<Gauge> f_stat) const PURE;
   virtual void forEachSinkedTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) const PURE;
 
+  /**
+   * Iterate over the stats that need to be flushed to sinks and that changed since the previous
+   * call, so that a flush can skip the stats that did not. The first call visits all of them and
+   * starts tracking changes; stats that are created and never updated afterwards are not visited.
+   * Note, that implementations can potentially hold on to a mutex that will deadlock if the
+   * passed in functors try to create or delete a stat.
+   * @param f_size functor that is provided the number of stats that will be visited. Note that
+   * this is called only once, prior to any calls to f_stat.
+   * @param f_stat functor that is provided one changed stat at a time.
+   */
+  virtual void forEachChangedSinkedCounter(SizeFn f_size, StatFn<Counter> f_stat) PURE;
+  virtual void forEachChangedSinkedGauge(SizeFn f_size, StatFn<Gauge> f_stat) PURE;
+
   /**
    * Set the predicates to filter stats for sink.
    */
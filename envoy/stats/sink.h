@@ -24,7 +24,9 @@ public:
   virtual ~MetricSnapshot() = default;
 
   /**
-   * @return a snapshot of all counters with pre-latched deltas.
+   * @return a snapshot of all counters with pre-latched deltas. If the server is configured to
+   * flush changed stats only, counters and gauges that did not change since the previous flush
+   * are left out.
    */
   virtual const std::vector<CounterSnapshot>& counters() PURE;
 
@@ -157,6 +157,18 @@ public:
    * @return the const SSL connection data of upstream.
    */
   virtual Ssl::ConnectionInfoConstSharedPtr getUpstreamConnectionSslInfo() PURE;
+
+  /**
+   * Starts splicing data between the downstream and the upstream connection, see
+   * Network::Connection::startSplice().
+   * @param downstream supplies the downstream connection.
+   * @param downstream_cb supplies the callback for data spliced from downstream to upstream.
+   * @param upstream_cb supplies the callback for data spliced from upstream to downstream.
+   * @return whether data is spliced in at least the downstream to upstream direction.
+   */
+  virtual bool startSplice(Network::Connection& downstream,
+                           Network::Connection::SplicedBytesCb downstream_cb,
+                           Network::Connection::SplicedBytesCb upstream_cb) PURE;
 };
 
 using GenericConnPoolPtr = std::unique_ptr<GenericConnPool>;
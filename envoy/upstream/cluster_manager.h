@@ -624,6 +624,11 @@ public:
    */
   virtual Secret::SecretManager& secretManager() PURE;
 
+  /**
+   * Returns the SSL context manager.
+   */
+  virtual Ssl::ContextManager& sslContextManager() PURE;
+
   /**
    * Returns the singleton manager.
    */
@@ -107,6 +107,18 @@ public:
   virtual absl::Status onOrcaLoadReport(const OrcaLoadReport& /*report*/) {
     return absl::OkStatus();
   }
+
+  /**
+   * Invoked on the worker thread that owns the connection pool when a request to this upstream
+   * host becomes active, i.e. when the host's rq_active gauge is incremented.
+   */
+  virtual void onRequestActive() {}
+
+  /**
+   * Invoked on the worker thread that owns the connection pool when a request to this upstream
+   * host is no longer active, i.e. when the host's rq_active gauge is decremented.
+   */
+  virtual void onRequestInactive() {}
 };
 
 using HostLbPolicyDataPtr = std::unique_ptr<HostLbPolicyData>;
@@ -1,12 +1,18 @@
 #include "source/common/buffer/buffer_impl.h"
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
+#include "source/common/runtime/runtime_features.h"
 
 #include "absl/container/fixed_array.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/synchronization/mutex.h"
 #include "event2/buffer.h"
 
 namespace Envoy {
@@ -17,8 +23,217 @@ namespace {
 // TODO(yanavlasov): This may not be optimal for all hardware configurations or traffic patterns and
 // may need to be configurable in the future.
 constexpr uint64_t CopyThreshold = 512;
+
+std::atomic<uint64_t> max_cached_bytes_per_thread{SliceStorageCache::DefaultMaxBytesPerThread};
+
+int sizeClass(uint64_t size) {
+  for (size_t i = 0; i < SliceStorageCache::SizeClasses.size(); ++i) {
+    if (SliceStorageCache::SizeClasses[i] == size) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+// Counter only written by its own thread, and read by any thread summing up the counters.
+class ThreadCounter {
+public:
+  void add(uint64_t delta) {
+    value_.store(value_.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+  }
+  void sub(uint64_t delta) {
+    value_.store(value_.load(std::memory_order_relaxed) - delta, std::memory_order_relaxed);
+  }
+  uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+  void reset() { value_.store(0, std::memory_order_relaxed); }
+
+private:
+  std::atomic<uint64_t> value_{};
+};
+
+class ThreadSliceStorageCache;
+
+// The caches of all live threads, and the counters of the threads which have exited.
+struct ThreadSliceStorageCaches {
+  absl::Mutex mutex_;
+  absl::flat_hash_set<const ThreadSliceStorageCache*> caches_ ABSL_GUARDED_BY(mutex_);
+  SliceStorageCache::Counters exited_ ABSL_GUARDED_BY(mutex_);
+};
+
+ThreadSliceStorageCaches& threadSliceStorageCaches() {
+  MUTABLE_CONSTRUCT_ON_FIRST_USE(ThreadSliceStorageCaches);
+}
+
+// The cache of one thread. It is reached through a trivially destructible pointer, so that slices
+// released after the thread's cache was destroyed, e.g. by static objects, bypass it safely.
+class ThreadSliceStorageCache {
+public:
+  ThreadSliceStorageCache();
+  ~ThreadSliceStorageCache();
+
+  static ThreadSliceStorageCache* get();
+
+  // Whether storage released on this thread is kept. It is updated by every allocation of a size
+  // class, so that releases do not have to look up the runtime guard.
+  bool enabled() const { return enabled_; }
+  std::unique_ptr<uint8_t[]> allocate(int size_class, uint64_t size);
+  void release(int size_class, std::unique_ptr<uint8_t[]> storage, uint64_t size);
+  // Frees the cached storage and stops caching until the next allocation with the guard enabled.
+  void disable();
+  void clear();
+  SliceStorageCache::Counters counters() const;
+
+private:
+  bool enabled_{};
+  std::array<std::vector<std::unique_ptr<uint8_t[]>>, SliceStorageCache::SizeClasses.size()>
+      free_lists_;
+  ThreadCounter hits_;
+  ThreadCounter misses_;
+  ThreadCounter overflows_;
+  ThreadCounter cached_bytes_;
+};
+
+thread_local ThreadSliceStorageCache* thread_slice_storage_cache = nullptr;
+thread_local bool thread_slice_storage_cache_destroyed = false;
+
+ThreadSliceStorageCache::ThreadSliceStorageCache() {
+  ThreadSliceStorageCaches& caches = threadSliceStorageCaches();
+  absl::MutexLock lock(&caches.mutex_);
+  caches.caches_.insert(this);
+}
+
+ThreadSliceStorageCache::~ThreadSliceStorageCache() {
+  thread_slice_storage_cache = nullptr;
+  thread_slice_storage_cache_destroyed = true;
+  ThreadSliceStorageCaches& caches = threadSliceStorageCaches();
+  absl::MutexLock lock(&caches.mutex_);
+  caches.caches_.erase(this);
+  caches.exited_.hits_ += hits_.value();
+  caches.exited_.misses_ += misses_.value();
+  caches.exited_.overflows_ += overflows_.value();
+}
+
+ThreadSliceStorageCache* ThreadSliceStorageCache::get() {
+  if (thread_slice_storage_cache == nullptr && !thread_slice_storage_cache_destroyed) {
+    static thread_local ThreadSliceStorageCache cache;
+    thread_slice_storage_cache = &cache;
+  }
+  return thread_slice_storage_cache;
+}
+
+std::unique_ptr<uint8_t[]> ThreadSliceStorageCache::allocate(int size_class, uint64_t size) {
+  enabled_ = true;
+  auto& free_list = free_lists_[size_class];
+  if (!free_list.empty()) {
+    std::unique_ptr<uint8_t[]> storage = std::move(free_list.back());
+    free_list.pop_back();
+    cached_bytes_.sub(size);
+    hits_.add(1);
+    return storage;
+  }
+  misses_.add(1);
+  return std::unique_ptr<uint8_t[]>(new uint8_t[size]);
+}
+
+void ThreadSliceStorageCache::release(int size_class, std::unique_ptr<uint8_t[]> storage,
+                                      uint64_t size) {
+  if (cached_bytes_.value() + size >
+      max_cached_bytes_per_thread.load(std::memory_order_relaxed)) {
+    overflows_.add(1);
+    return;
+  }
+  free_lists_[size_class].push_back(std::move(storage));
+  cached_bytes_.add(size);
+}
+
+void ThreadSliceStorageCache::disable() {
+  enabled_ = false;
+  for (auto& free_list : free_lists_) {
+    free_list.clear();
+  }
+  cached_bytes_.reset();
+}
+
+void ThreadSliceStorageCache::clear() {
+  disable();
+  hits_.reset();
+  misses_.reset();
+  overflows_.reset();
+}
+
+SliceStorageCache::Counters ThreadSliceStorageCache::counters() const {
+  return {hits_.value(), misses_.value(), overflows_.value(), cached_bytes_.value()};
+}
+
 } // namespace
 
+bool SliceStorageCache::enabled() {
+  if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.buffer_slice_storage_cache")) {
+    return true;
+  }
+  if (thread_slice_storage_cache != nullptr && thread_slice_storage_cache->enabled()) {
+    // The guard was turned off since this thread last used its cache.
+    thread_slice_storage_cache->disable();
+  }
+  return false;
+}
+
+std::unique_ptr<uint8_t[]> SliceStorageCache::allocate(uint64_t size) {
+  const int size_class = sizeClass(size);
+  if (size_class >= 0 && enabled()) {
+    ThreadSliceStorageCache* cache = ThreadSliceStorageCache::get();
+    if (cache != nullptr) {
+      return cache->allocate(size_class, size);
+    }
+  }
+  return std::unique_ptr<uint8_t[]>(new uint8_t[size]);
+}
+
+void SliceStorageCache::release(std::unique_ptr<uint8_t[]> storage, uint64_t size) {
+  ThreadSliceStorageCache* cache = thread_slice_storage_cache;
+  if (cache == nullptr || !cache->enabled()) {
+    return;
+  }
+  const int size_class = sizeClass(size);
+  if (size_class >= 0) {
+    cache->release(size_class, std::move(storage), size);
+  }
+}
+
+void SliceStorageCache::setMaxBytesPerThread(uint64_t max_bytes) {
+  max_cached_bytes_per_thread.store(max_bytes, std::memory_order_relaxed);
+}
+
+uint64_t SliceStorageCache::maxBytesPerThread() {
+  return max_cached_bytes_per_thread.load(std::memory_order_relaxed);
+}
+
+SliceStorageCache::Counters SliceStorageCache::counters() {
+  ThreadSliceStorageCaches& caches = threadSliceStorageCaches();
+  absl::MutexLock lock(&caches.mutex_);
+  Counters total = caches.exited_;
+  for (const ThreadSliceStorageCache* cache : caches.caches_) {
+    const Counters counters = cache->counters();
+    total.hits_ += counters.hits_;
+    total.misses_ += counters.misses_;
+    total.overflows_ += counters.overflows_;
+    total.cached_bytes_ += counters.cached_bytes_;
+  }
+  return total;
+}
+
+SliceStorageCache::Counters SliceStorageCache::threadCountersForTest() {
+  ThreadSliceStorageCache* cache = ThreadSliceStorageCache::get();
+  return cache != nullptr ? cache->counters() : Counters{};
+}
+
+void SliceStorageCache::clearThreadCacheForTest() {
+  ThreadSliceStorageCache* cache = ThreadSliceStorageCache::get();
+  if (cache != nullptr) {
+    cache->clear();
+  }
+}
+
 thread_local absl::InlinedVector<Slice::StoragePtr,
                                  OwnedImpl::OwnedImplReservationSlicesOwnerMultiple::free_list_max_>
     OwnedImpl::OwnedImplReservationSlicesOwnerMultiple::free_list_;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <deque>
 #include <memory>
@@ -19,6 +20,75 @@
 namespace Envoy {
 namespace Buffer {
 
+/**
+ * Per-thread cache of slice storage. Storage of one of the fixed size classes is kept on a free
+ * list of the thread which releases it, and handed out again by the next allocation of the same
+ * size on that thread, instead of going back to the heap. Other sizes bypass the cache.
+ *
+ * The bytes cached by a thread are capped by maxBytesPerThread(); storage released above the cap
+ * is freed. The cache is only used while envoy.reloadable_features.buffer_slice_storage_cache is
+ * enabled.
+ */
+class SliceStorageCache {
+public:
+  static constexpr std::array<uint64_t, 3> SizeClasses = {4096, 16384, 65536};
+  static constexpr uint64_t DefaultMaxBytesPerThread = 1024 * 1024;
+
+  struct Counters {
+    // Allocations of a size class served from the cache.
+    uint64_t hits_{};
+    // Allocations of a size class which had to go to the heap.
+    uint64_t misses_{};
+    // Releases of a size class which were freed because the cache was full.
+    uint64_t overflows_{};
+    // Bytes currently held by the cache.
+    uint64_t cached_bytes_{};
+  };
+
+  /**
+   * @param size supplies the size of the storage, which must be a multiple of the page size as
+   *        returned by Slice::sliceSize().
+   * @return new storage of the given size.
+   */
+  static std::unique_ptr<uint8_t[]> allocate(uint64_t size);
+
+  /**
+   * Returns storage obtained from allocate() to the calling thread's cache, or frees it.
+   * @param storage supplies the storage.
+   * @param size supplies the size the storage was allocated with.
+   */
+  static void release(std::unique_ptr<uint8_t[]> storage, uint64_t size);
+
+  /**
+   * @return whether the runtime guard enables the cache. Also stops the calling thread's cache if
+   *         the guard was turned off since the thread last used it.
+   */
+  static bool enabled();
+
+  /**
+   * Sets the number of bytes each thread may cache. Zero disables caching.
+   * @param max_bytes supplies the cap, which applies to the next release on every thread.
+   */
+  static void setMaxBytesPerThread(uint64_t max_bytes);
+  static uint64_t maxBytesPerThread();
+
+  /**
+   * @return the counters of all threads added up, including threads which have exited.
+   *         Thread safe.
+   */
+  static Counters counters();
+
+  /**
+   * @return the counters of the calling thread's cache.
+   */
+  static Counters threadCountersForTest();
+
+  /**
+   * Frees the storage cached by the calling thread and resets its counters.
+   */
+  static void clearThreadCacheForTest();
+};
+
 /**
  * A Slice manages a contiguous block of bytes.
  * The block is arranged like this:
@@ -57,7 +127,7 @@ public:
    * @param account the account to charge.
    */
   Slice(uint64_t min_capacity, const BufferMemoryAccountSharedPtr& account)
-      : capacity_(sliceSize(min_capacity)), storage_(new uint8_t[capacity_]),
+      : capacity_(sliceSize(min_capacity)), storage_(SliceStorageCache::allocate(capacity_)),
         base_(storage_.get()) {
     if (account) {
       account->charge(capacity_);
@@ -114,6 +184,7 @@ public:
   Slice& operator=(Slice&& rhs) noexcept {
     if (this != &rhs) {
       callAndClearDrainTrackersAndCharges();
+      releaseOwnedStorage();
 
       capacity_ = rhs.capacity_;
       storage_ = std::move(rhs.storage_);
@@ -142,6 +213,7 @@ public:
     if (releasor_) {
       releasor_();
     }
+    releaseOwnedStorage();
   }
 
   /**
@@ -385,10 +457,26 @@ public:
    */
   static inline SizedStorage newStorage(uint64_t min_capacity) {
     const uint64_t slice_size = sliceSize(min_capacity);
-    return {StoragePtr{new uint8_t[slice_size]}, static_cast<size_t>(slice_size)};
+    return {SliceStorageCache::allocate(slice_size), static_cast<size_t>(slice_size)};
+  }
+
+  /**
+   * Release backend storage created by newStorage() which was not handed to a slice.
+   */
+  static void releaseStorage(SizedStorage storage) {
+    if (storage.mem_ != nullptr) {
+      SliceStorageCache::release(std::move(storage.mem_), storage.len_);
+    }
   }
 
 protected:
+  /** Returns owned storage, if any, to the storage cache. */
+  void releaseOwnedStorage() {
+    if (storage_ != nullptr) {
+      SliceStorageCache::release(std::move(storage_), capacity_);
+    }
+  }
+
   /** Length of the byte array that base_ points to. This is also the offset in bytes from the start
    * of the slice to the end of the Reservable section. */
   uint64_t capacity_ = 0;
@@ -785,10 +873,15 @@ private:
   public:
     static constexpr uint32_t free_list_max_ = Buffer::Reservation::MAX_SLICES_;
 
-    OwnedImplReservationSlicesOwnerMultiple() : free_list_ref_(free_list_) {}
+    OwnedImplReservationSlicesOwnerMultiple()
+        : use_storage_cache_(SliceStorageCache::enabled()), free_list_ref_(free_list_) {}
     ~OwnedImplReservationSlicesOwnerMultiple() override {
       for (auto r = owned_storages_.rbegin(); r != owned_storages_.rend(); r++) {
-        if (r->mem_ != nullptr) {
+        if (use_storage_cache_) {
+          // Storage which was not committed goes back to the cache, most recently allocated
+          // first.
+          Slice::releaseStorage(std::move(*r));
+        } else if (r->mem_ != nullptr) {
           ASSERT(r->len_ == Slice::default_slice_size_);
           if (free_list_ref_.size() < free_list_max_) {
             free_list_ref_.push_back(std::move(r->mem_));
@@ -799,6 +892,9 @@ private:
 
     Slice::SizedStorage newStorage() {
       ASSERT(Slice::sliceSize(Slice::default_slice_size_) == Slice::default_slice_size_);
+      if (use_storage_cache_) {
+        return Slice::newStorage(Slice::default_slice_size_);
+      }
 
       Slice::SizedStorage storage{nullptr, Slice::default_slice_size_};
       if (!free_list_ref_.empty()) {
@@ -818,6 +914,10 @@ private:
     absl::InlinedVector<Slice::SizedStorage, Buffer::Reservation::MAX_SLICES_> owned_storages_;
 
   private:
+    // With the slice storage cache enabled, storage comes from and goes back to that cache instead
+    // of the free list below.
+    const bool use_storage_cache_;
+
     // Thread local resolving introduces additional overhead. Initialize this reference once when
     // constructing the owner to reduce thread local resolving to improve performance.
     absl::InlinedVector<Slice::StoragePtr, free_list_max_>& free_list_ref_;
@@ -829,6 +929,10 @@ private:
   };
 
   struct OwnedImplReservationSlicesOwnerSingle : public OwnedImplReservationSlicesOwner {
+    ~OwnedImplReservationSlicesOwnerSingle() override {
+      Slice::releaseStorage(std::move(owned_storage_));
+    }
+
     absl::Span<Slice::SizedStorage> ownedStorages() override {
       return absl::MakeSpan(&owned_storage_, 1);
     }
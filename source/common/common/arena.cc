@@ -0,0 +1,47 @@
+#include "source/common/common/arena.h"
+
+#include <cstring>
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+
+void* Arena::allocate(size_t size, size_t alignment) {
+  ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0);
+  ASSERT(alignment <= alignof(std::max_align_t));
+  bytes_allocated_ += size;
+
+  if (size > block_size_ / 4) {
+    // Large allocations get their own block. The current block is kept so that later small
+    // allocations can still use its tail. Fresh blocks are suitably aligned for any type.
+    return addBlock(size);
+  }
+
+  size_t padding = (alignment - reinterpret_cast<uintptr_t>(current_) % alignment) % alignment;
+  if (current_ == nullptr || padding + size > remaining_) {
+    current_ = addBlock(block_size_);
+    remaining_ = block_size_;
+    padding = 0;
+  }
+
+  void* result = current_ + padding;
+  current_ += padding + size;
+  remaining_ -= padding + size;
+  return result;
+}
+
+absl::string_view Arena::copyString(absl::string_view str) {
+  if (str.empty()) {
+    return {};
+  }
+  char* storage = static_cast<char*>(allocate(str.size(), alignof(char)));
+  memcpy(storage, str.data(), str.size()); // NOLINT(safe-memcpy)
+  return {storage, str.size()};
+}
+
+uint8_t* Arena::addBlock(size_t size) {
+  blocks_.emplace_back(new uint8_t[size]);
+  return blocks_.back().get();
+}
+
+} // namespace Envoy
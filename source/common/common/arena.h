@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "envoy/common/optref.h"
+
+#include "source/common/common/non_copyable.h"
+
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+
+/**
+ * A bump allocator for objects that share a single lifetime, e.g. the bookkeeping of an HTTP
+ * stream. Memory is carved out of blocks owned by the arena and is only released, all at once,
+ * when the arena is destroyed; there is no per-allocation free. This trades a bounded amount of
+ * slack for replacing many small malloc/free pairs with a handful of block allocations.
+ *
+ * The arena does not run destructors. Objects with non-trivial destructors must be owned through
+ * an ArenaPtr (see below), which runs the destructor without releasing the memory.
+ *
+ * This class is not thread safe.
+ */
+class Arena : NonCopyable {
+public:
+  static constexpr uint32_t DefaultBlockSize = 4096;
+
+  explicit Arena(uint32_t block_size = DefaultBlockSize) : block_size_(block_size) {}
+
+  /**
+   * Allocates uninitialized storage with the requested size and alignment. Allocations larger
+   * than a quarter of the block size get a dedicated block, so that they do not waste the tail of
+   * the current block.
+   * @param size supplies the number of bytes to allocate.
+   * @param alignment supplies the required alignment, which must be a power of two no larger than
+   *        alignof(std::max_align_t).
+   * @return pointer to the storage, which is valid until the arena is destroyed.
+   */
+  void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+  /**
+   * Copies a string into the arena.
+   * @return a view of the copy, which is valid until the arena is destroyed.
+   */
+  absl::string_view copyString(absl::string_view str);
+
+  /**
+   * @return the number of bytes handed out by allocate(), excluding alignment padding.
+   */
+  uint64_t bytesAllocated() const { return bytes_allocated_; }
+
+  /**
+   * @return the number of blocks currently owned by the arena.
+   */
+  size_t numBlocks() const { return blocks_.size(); }
+
+private:
+  uint8_t* addBlock(size_t size);
+
+  const uint32_t block_size_;
+  absl::InlinedVector<std::unique_ptr<uint8_t[]>, 4> blocks_;
+  // The unused tail of the current block.
+  uint8_t* current_{};
+  size_t remaining_{};
+  uint64_t bytes_allocated_{};
+};
+
+using ArenaOptRef = OptRef<Arena>;
+
+/**
+ * Deleter for objects which may or may not live in an Arena. Arena-backed objects only have their
+ * destructor run, the memory being released with the arena; heap objects are deleted.
+ */
+template <class T> class ArenaDeleter {
+public:
+  ArenaDeleter() = default;
+  explicit ArenaDeleter(bool in_arena) : in_arena_(in_arena) {}
+  // Allows ArenaPtr<Derived> to be converted into ArenaPtr<Base>.
+  template <class U, class = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+  ArenaDeleter(const ArenaDeleter<U>& other) : in_arena_(other.inArena()) {}
+
+  void operator()(T* ptr) const {
+    if (in_arena_) {
+      ptr->~T();
+    } else {
+      delete ptr;
+    }
+  }
+
+  bool inArena() const { return in_arena_; }
+
+private:
+  bool in_arena_{false};
+};
+
+template <class T> using ArenaPtr = std::unique_ptr<T, ArenaDeleter<T>>;
+
+/**
+ * Constructs a T in the arena if one is supplied, or on the heap otherwise. This lets callers opt
+ * in to arena allocation without having to handle both ownership models.
+ */
+template <class T, class... Args> ArenaPtr<T> makeArenaPtr(ArenaOptRef arena, Args&&... args) {
+  static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not supported");
+  if (!arena.has_value()) {
+    return ArenaPtr<T>(new T(std::forward<Args>(args)...), ArenaDeleter<T>(false));
+  }
+  void* storage = arena->allocate(sizeof(T), alignof(T));
+  return ArenaPtr<T>(new (storage) T(std::forward<Args>(args)...), ArenaDeleter<T>(true));
+}
+
+} // namespace Envoy
@@ -0,0 +1,92 @@
+#include "source/common/common/helper_thread_pool.h"
+
+#include "absl/synchronization/blocking_counter.h"
+
+namespace Envoy {
+namespace Thread {
+
+HelperThreadPool::HelperThreadPool(ThreadFactory& thread_factory, uint32_t helper_threads,
+                                   std::string thread_name)
+    : thread_factory_(thread_factory), helper_threads_(helper_threads),
+      thread_name_(std::move(thread_name)) {}
+
+HelperThreadPool::~HelperThreadPool() {
+  std::vector<ThreadPtr> threads;
+  {
+    absl::MutexLock lock(&mutex_);
+    shutdown_ = true;
+    threads.swap(threads_);
+  }
+  for (ThreadPtr& thread : threads) {
+    thread->join();
+  }
+}
+
+void HelperThreadPool::startThreads() {
+  started_ = true;
+  const Options options{thread_name_};
+  for (uint32_t i = 0; i < helper_threads_; ++i) {
+    ThreadPtr thread = thread_factory_.createThread([this]() { workerLoop(); }, options);
+    if (thread != nullptr) {
+      threads_.push_back(std::move(thread));
+    }
+  }
+}
+
+void HelperThreadPool::workerLoop() {
+  while (true) {
+    std::function<void()> task;
+    {
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(absl::Condition(this, &HelperThreadPool::hasWorkOrShutdown));
+      if (queue_.empty()) {
+        return;
+      }
+      task = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    task();
+  }
+}
+
+bool HelperThreadPool::runQueuedTask() {
+  std::function<void()> task;
+  {
+    absl::MutexLock lock(&mutex_);
+    if (queue_.empty()) {
+      return false;
+    }
+    task = std::move(queue_.front());
+    queue_.pop_front();
+  }
+  task();
+  return true;
+}
+
+void HelperThreadPool::run(uint32_t tasks, const std::function<void(uint32_t)>& task) {
+  if (tasks == 0) {
+    return;
+  }
+  absl::BlockingCounter pending(tasks - 1);
+  {
+    absl::MutexLock lock(&mutex_);
+    if (!started_) {
+      startThreads();
+    }
+    for (uint32_t i = 1; i < tasks; ++i) {
+      queue_.push_back([&task, &pending, i]() {
+        task(i);
+        pending.DecrementCount();
+      });
+    }
+  }
+  task(0);
+  // Work on the queued tasks too rather than only wait for the helper threads, which also covers a
+  // pool without any threads.
+  while (runQueuedTask()) {
+  }
+  pending.Wait();
+}
+
+} // namespace Thread
+} // namespace Envoy
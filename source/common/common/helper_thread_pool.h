@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "envoy/thread/thread.h"
+
+#include "source/common/common/non_copyable.h"
+
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Thread {
+
+/**
+ * A fixed set of helper threads that batches of pure work are spread over, for work that a single
+ * thread would otherwise run serially. The threads are only started by the first batch, and are
+ * kept until the pool is destroyed. The thread running a batch works on it as well.
+ */
+class HelperThreadPool : NonCopyable {
+public:
+  /**
+   * @param thread_factory supplies the factory the helper threads are created with.
+   * @param helper_threads supplies the number of helper threads.
+   * @param thread_name supplies the name of the helper threads.
+   */
+  HelperThreadPool(ThreadFactory& thread_factory, uint32_t helper_threads,
+                   std::string thread_name);
+  virtual ~HelperThreadPool();
+
+  /**
+   * @return the number of threads, including the calling one, that run() spreads tasks over.
+   */
+  uint32_t concurrency() const { return helper_threads_ + 1; }
+
+  /**
+   * Runs task(0) to task(tasks - 1) on the helper threads and the calling thread, and returns once
+   * they have all completed. Tasks are run on the calling thread alone if no helper thread could be
+   * created.
+   */
+  void run(uint32_t tasks, const std::function<void(uint32_t)>& task);
+
+private:
+  void startThreads() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void workerLoop();
+  // Pops one queued task and runs it. Returns false if the queue was empty.
+  bool runQueuedTask();
+  bool hasWorkOrShutdown() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return !queue_.empty() || shutdown_;
+  }
+
+  ThreadFactory& thread_factory_;
+  const uint32_t helper_threads_;
+  const std::string thread_name_;
+  absl::Mutex mutex_;
+  std::deque<std::function<void()>> queue_ ABSL_GUARDED_BY(mutex_);
+  bool started_ ABSL_GUARDED_BY(mutex_){};
+  bool shutdown_ ABSL_GUARDED_BY(mutex_){};
+  std::vector<ThreadPtr> threads_ ABSL_GUARDED_BY(mutex_);
+};
+
+} // namespace Thread
+} // namespace Envoy
@@ -167,6 +167,30 @@ public:
     return nodes_[result].value_;
   }
 
+  /**
+   * Visits the entries of all keys which are a prefix of the specified key (including the key
+   * itself and the empty key), in order of increasing key length.
+   * Complexity is O(min(longest key prefix, key length)).
+   * @param key the key used to find.
+   * @param cb invoked with the length of the matching key and its value, for each matching key
+   *        with a non-empty value.
+   */
+  template <class Callback> void forEachPrefix(absl::string_view key, Callback&& cb) const {
+    int32_t current = 0;
+    if (nodes_[current].value_) {
+      cb(0, nodes_[current].value_);
+    }
+    for (size_t i = 0; i < key.size(); ++i) {
+      current = getChildIndex(current, static_cast<uint8_t>(key[i]));
+      if (current == NoNode) {
+        return;
+      }
+      if (nodes_[current].value_) {
+        cb(i + 1, nodes_[current].value_);
+      }
+    }
+  }
+
 private:
   // Flat representation of the tree - each node has a vector of indices to its
   // child nodes.
@@ -203,6 +203,10 @@ void ConnPoolImplBase::attachStreamToClient(Envoy::ConnectionPool::ActiveClient&
   num_active_streams_++;
   host_->stats().rq_total_.inc();
   host_->stats().rq_active_.inc();
+  if (OptRef<Upstream::HostLbPolicyData> lb_policy_data = host_->lbPolicyData();
+      lb_policy_data.has_value()) {
+    lb_policy_data->onRequestActive();
+  }
   traffic_stats.upstream_rq_total_.inc();
   traffic_stats.upstream_rq_active_.inc();
   host_->cluster().resourceManager(priority_).requests().inc();
@@ -217,6 +221,10 @@ void ConnPoolImplBase::onStreamClosed(Envoy::ConnectionPool::ActiveClient& clien
   state_.decrActiveStreams(1);
   num_active_streams_--;
   host_->stats().rq_active_.dec();
+  if (OptRef<Upstream::HostLbPolicyData> lb_policy_data = host_->lbPolicyData();
+      lb_policy_data.has_value()) {
+    lb_policy_data->onRequestInactive();
+  }
   host_->cluster().trafficStats()->upstream_rq_active_.dec();
   host_->cluster().resourceManager(priority_).requests().dec();
   // We don't update the capacity for HTTP/3 as the stream count should only
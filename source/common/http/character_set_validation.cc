@@ -0,0 +1,176 @@
+#include "source/common/http/character_set_validation.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ENVOY_CHAR_TABLE_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace Envoy {
+namespace Http {
+
+namespace {
+
+using FindFirstFn = size_t (*)(const VectorizedCharTable&, absl::string_view, bool);
+
+size_t findFirstScalar(const VectorizedCharTable& table, absl::string_view str, size_t start,
+                       bool in_table) {
+  for (size_t i = start; i < str.size(); ++i) {
+    if (table.contains(str[i]) == in_table) {
+      return i;
+    }
+  }
+  return absl::string_view::npos;
+}
+
+size_t findFirstScalarImpl(const VectorizedCharTable& table, absl::string_view str,
+                           bool in_table) {
+  return findFirstScalar(table, str, 0, in_table);
+}
+
+#ifdef ENVOY_CHAR_TABLE_X86_SIMD
+// Both kernels classify a vector of characters the same way: the low nibble of each character
+// selects a row from the ascii or extended nibble table, depending on the character's top bit,
+// and the high nibble selects the bit within that row.
+
+// Returns a mask with bit i set if character i of the 16 byte block at `data` is in the table.
+// Always inlined so that the AVX2 kernel gets a VEX encoded copy, avoiding SSE/AVX transitions.
+__attribute__((target("sse4.2"), always_inline)) inline uint32_t
+classify16(const VectorizedCharTable& table, const char* data) {
+  const __m128i ascii = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.ascii().data()));
+  const __m128i extended =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.extended().data()));
+  const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+  const __m128i nibble_mask = _mm_set1_epi8(0x0f);
+
+  const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+  const __m128i low = _mm_and_si128(input, nibble_mask);
+  const __m128i high = _mm_and_si128(_mm_srli_epi16(input, 4), nibble_mask);
+  const __m128i rows =
+      _mm_blendv_epi8(_mm_shuffle_epi8(ascii, low), _mm_shuffle_epi8(extended, low), input);
+  const __m128i bit = _mm_shuffle_epi8(bits, high);
+  const __m128i member = _mm_cmpeq_epi8(_mm_and_si128(rows, bit), bit);
+  return static_cast<uint32_t>(_mm_movemask_epi8(member));
+}
+
+// Searches 16 byte blocks starting at `start`, then finishes with the scalar loop.
+__attribute__((target("sse4.2"), always_inline)) inline size_t
+findFirst16(const VectorizedCharTable& table, absl::string_view str, size_t start,
+            bool in_table) {
+  const uint32_t invert = in_table ? 0 : 0xffff;
+  size_t i = start;
+  for (; i + 16 <= str.size(); i += 16) {
+    const uint32_t mask = classify16(table, str.data() + i) ^ invert;
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  return findFirstScalar(table, str, i, in_table);
+}
+
+__attribute__((target("sse4.2"))) size_t
+findFirstSse42(const VectorizedCharTable& table, absl::string_view str, bool in_table) {
+  return findFirst16(table, str, 0, in_table);
+}
+
+__attribute__((target("avx2"))) size_t
+findFirstAvx2(const VectorizedCharTable& table, absl::string_view str, bool in_table) {
+  const __m256i ascii = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.ascii().data())));
+  const __m256i extended = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.extended().data())));
+  const __m256i bits = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                        1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+  const __m256i nibble_mask = _mm256_set1_epi8(0x0f);
+  const uint32_t invert = in_table ? 0 : 0xffffffff;
+
+  size_t i = 0;
+  for (; i + 32 <= str.size(); i += 32) {
+    const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str.data() + i));
+    const __m256i low = _mm256_and_si256(input, nibble_mask);
+    const __m256i high = _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble_mask);
+    const __m256i rows = _mm256_blendv_epi8(_mm256_shuffle_epi8(ascii, low),
+                                            _mm256_shuffle_epi8(extended, low), input);
+    const __m256i bit = _mm256_shuffle_epi8(bits, high);
+    const __m256i member = _mm256_cmpeq_epi8(_mm256_and_si256(rows, bit), bit);
+    const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(member)) ^ invert;
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  return findFirst16(table, str, i, in_table);
+}
+#endif
+
+FindFirstFn findFirstFn(CharTableSearchImpl impl) {
+  switch (impl) {
+  case CharTableSearchImpl::Scalar:
+    return findFirstScalarImpl;
+#ifdef ENVOY_CHAR_TABLE_X86_SIMD
+  case CharTableSearchImpl::Sse42:
+    return findFirstSse42;
+  case CharTableSearchImpl::Avx2:
+    return findFirstAvx2;
+#else
+  case CharTableSearchImpl::Sse42:
+  case CharTableSearchImpl::Avx2:
+    break;
+#endif
+  }
+  return nullptr;
+}
+
+FindFirstFn selectFindFirstFn() {
+  for (const CharTableSearchImpl impl : {CharTableSearchImpl::Avx2, CharTableSearchImpl::Sse42}) {
+    if (charTableSearchImplSupported(impl)) {
+      return findFirstFn(impl);
+    }
+  }
+  return findFirstScalarImpl;
+}
+
+// Short strings are not worth the call through the function pointer.
+constexpr size_t MinVectorizedSearchLength = 16;
+
+size_t findFirst(const VectorizedCharTable& table, absl::string_view str, bool in_table) {
+  if (str.size() < MinVectorizedSearchLength) {
+    return findFirstScalar(table, str, 0, in_table);
+  }
+  static const FindFirstFn find_first = selectFindFirstFn();
+  return find_first(table, str, in_table);
+}
+
+} // namespace
+
+size_t findFirstNotInCharTable(const VectorizedCharTable& table, absl::string_view str) {
+  return findFirst(table, str, false);
+}
+
+size_t findFirstInCharTable(const VectorizedCharTable& table, absl::string_view str) {
+  return findFirst(table, str, true);
+}
+
+bool charTableSearchImplSupported(CharTableSearchImpl impl) {
+  switch (impl) {
+  case CharTableSearchImpl::Scalar:
+    return true;
+#ifdef ENVOY_CHAR_TABLE_X86_SIMD
+  case CharTableSearchImpl::Sse42:
+    return __builtin_cpu_supports("sse4.2");
+  case CharTableSearchImpl::Avx2:
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("sse4.2");
+#else
+  case CharTableSearchImpl::Sse42:
+  case CharTableSearchImpl::Avx2:
+    return false;
+#endif
+  }
+  return false;
+}
+
+size_t findFirstCharForTest(CharTableSearchImpl impl, const VectorizedCharTable& table,
+                            absl::string_view str, bool in_table) {
+  return findFirstFn(impl)(table, str, in_table);
+}
+
+} // namespace Http
+} // namespace Envoy
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 
+#include "absl/strings/string_view.h"
+
 // A set of tables for validating that a character is in a specific
 // character set. Used to validate RFC compliance for various HTTP protocol elements.
 
@@ -72,5 +75,73 @@ inline constexpr std::array<uint32_t, 8> kUriQueryAndFragmentCharTable = {
     0b00000000000000000000000000000000,
 };
 
+/**
+ * A character table laid out for vectorized lookups, in addition to the bit table used for the
+ * scalar lookups above. Characters are split into their low and high nibbles: ascii_[low] has bit
+ * `high` set if the character (high << 4 | low) in the range 0x00-0x7f is in the table, and
+ * extended_[low] does the same for the range 0x80-0xff with bit `high - 8`. This lets SIMD kernels
+ * classify 16 or 32 characters at a time with two byte shuffles.
+ */
+class VectorizedCharTable {
+public:
+  constexpr explicit VectorizedCharTable(const std::array<uint32_t, 8>& table) : table_(table) {
+    for (uint32_t c = 0; c < 256; ++c) {
+      if (testCharInTable(table, static_cast<char>(c))) {
+        std::array<uint8_t, 16>& nibbles = c < 0x80 ? ascii_ : extended_;
+        nibbles[c & 0x0f] |= static_cast<uint8_t>(1 << ((c >> 4) & 0x07));
+      }
+    }
+  }
+
+  constexpr bool contains(char c) const { return testCharInTable(table_, c); }
+  const std::array<uint8_t, 16>& ascii() const { return ascii_; }
+  const std::array<uint8_t, 16>& extended() const { return extended_; }
+
+private:
+  const std::array<uint32_t, 8> table_;
+  std::array<uint8_t, 16> ascii_{};
+  std::array<uint8_t, 16> extended_{};
+};
+
+/**
+ * Finds the first character of a string which is not in the table. Uses AVX2 or SSE4.2 kernels
+ * when supported by the CPU, with a scalar fallback.
+ * @return the index of the character, or absl::string_view::npos if all characters are in the
+ *         table.
+ */
+size_t findFirstNotInCharTable(const VectorizedCharTable& table, absl::string_view str);
+
+/**
+ * Finds the first character of a string which is in the table, e.g. a delimiter. Uses the same
+ * kernels as findFirstNotInCharTable().
+ * @return the index of the character, or absl::string_view::npos if there is none.
+ */
+size_t findFirstInCharTable(const VectorizedCharTable& table, absl::string_view str);
+
+/**
+ * @return whether all characters of the string are in the table.
+ */
+inline bool allCharsInTable(const VectorizedCharTable& table, absl::string_view str) {
+  return findFirstNotInCharTable(table, str) == absl::string_view::npos;
+}
+
+// Implementations of the table searches, exposed for tests.
+enum class CharTableSearchImpl { Scalar, Sse42, Avx2 };
+
+/**
+ * @return whether the implementation is compiled in and supported by the CPU.
+ */
+bool charTableSearchImplSupported(CharTableSearchImpl impl);
+
+/**
+ * Searches for the first character whose membership in the table equals `in_table`, using the
+ * specified implementation, which must be supported.
+ */
+size_t findFirstCharForTest(CharTableSearchImpl impl, const VectorizedCharTable& table,
+                            absl::string_view str, bool in_table);
+
+inline constexpr VectorizedCharTable kGenericHeaderNameVectorizedCharTable{
+    kGenericHeaderNameCharTable};
+
 } // namespace Http
 } // namespace Envoy
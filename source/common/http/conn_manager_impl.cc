@@ -826,8 +826,9 @@ ConnectionManagerImpl::ActiveStream::ActiveStream(ConnectionManagerImpl& connect
                       connection_manager_.codec_->protocol(), connection_manager_.timeSource(),
                       connection_manager_.read_callbacks_->connection().streamInfo().filterState(),
                       connection_manager_.overload_manager_),
-      request_response_timespan_(new Stats::HistogramCompletableTimespanImpl(
-          connection_manager_.stats_.named_.downstream_rq_time_, connection_manager_.timeSource())),
+      request_response_timespan_(makeArenaPtr<Stats::HistogramCompletableTimespanImpl>(
+          filter_manager_.streamArena(), connection_manager_.stats_.named_.downstream_rq_time_,
+          connection_manager_.timeSource())),
       header_validator_(
           connection_manager.config_->makeHeaderValidator(connection_manager.codec_->protocol())) {
   ASSERT(!connection_manager.config_->isRoutable() ||
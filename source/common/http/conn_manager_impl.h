@@ -457,7 +457,8 @@ private:
 
     Tracing::SpanPtr active_span_;
     ResponseEncoder* response_encoder_{};
-    Stats::TimespanPtr request_response_timespan_;
+    // Allocated from the filter manager's stream arena when enabled.
+    ArenaPtr<Stats::Timespan> request_response_timespan_;
     // Per-stream idle timeout. This timer gets reset whenever activity occurs on the stream, and,
     // when triggered, will close the stream.
     Event::TimerPtr stream_idle_timer_;
@@ -14,6 +14,7 @@
 #include "envoy/protobuf/message_validator.h"
 
 #include "source/common/buffer/watermark_buffer.h"
+#include "source/common/common/arena.h"
 #include "source/common/common/dump_state_utils.h"
 #include "source/common/common/linked_object.h"
 #include "source/common/common/logger.h"
@@ -37,8 +38,10 @@ class DownstreamFilterManager;
 struct ActiveStreamFilterBase;
 struct ActiveStreamDecoderFilter;
 struct ActiveStreamEncoderFilter;
-using ActiveStreamDecoderFilterPtr = std::unique_ptr<ActiveStreamDecoderFilter>;
-using ActiveStreamEncoderFilterPtr = std::unique_ptr<ActiveStreamEncoderFilter>;
+// Filter wrappers are allocated from the per-stream arena when it is enabled, and from the heap
+// otherwise.
+using ActiveStreamDecoderFilterPtr = ArenaPtr<ActiveStreamDecoderFilter>;
+using ActiveStreamEncoderFilterPtr = ArenaPtr<ActiveStreamEncoderFilter>;
 
 constexpr absl::string_view LocalReplyFilterStateKey =
     "envoy.filters.network.http_connection_manager.local_reply_owner";
@@ -61,7 +64,8 @@ private:
 
 // TODO(wbpcode): Rather than allocating every filter with an unique pointer, we could
 // construct the filter in place in the vector. This should reduce the heap allocation and
-// memory fragmentation.
+// memory fragmentation. When the per-stream arena is enabled the filter wrappers are already
+// allocated from it rather than from the heap.
 
 // HTTP decoder filters. If filters are configured in the following order (assume all three
 // filters are both decoder/encoder filters):
@@ -688,7 +692,11 @@ public:
                 uint32_t buffer_limit)
       : filter_manager_callbacks_(filter_manager_callbacks), dispatcher_(dispatcher),
         connection_(connection), stream_id_(stream_id), account_(std::move(account)),
-        proxy_100_continue_(proxy_100_continue), buffer_limit_(buffer_limit) {}
+        proxy_100_continue_(proxy_100_continue), buffer_limit_(buffer_limit) {
+    if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.http_stream_arena")) {
+      stream_arena_.emplace();
+    }
+  }
 
   ~FilterManager() override {
     ASSERT(state_.destroyed_);
@@ -900,6 +908,14 @@ public:
   uint64_t streamId() const { return stream_id_; }
   Buffer::BufferMemoryAccountSharedPtr account() const { return account_; }
 
+  /**
+   * @return the arena scoped to this stream, if enabled. Allocations from it must not outlive the
+   *         filter manager.
+   */
+  ArenaOptRef streamArena() {
+    return stream_arena_.has_value() ? ArenaOptRef(*stream_arena_) : ArenaOptRef();
+  }
+
   Buffer::InstancePtr& bufferedRequestData() { return buffered_request_data_; }
 
   void contextOnContinue(ScopeTrackedObjectStack& tracked_object_stack);
@@ -988,24 +1004,24 @@ private:
     void addStreamDecoderFilter(Http::StreamDecoderFilterSharedPtr filter) override {
       manager_.filters_.push_back(filter.get());
 
-      manager_.decoder_filters_.entries_.emplace_back(
-          std::make_unique<ActiveStreamDecoderFilter>(manager_, std::move(filter), context_));
+      manager_.decoder_filters_.entries_.emplace_back(makeArenaPtr<ActiveStreamDecoderFilter>(
+          manager_.streamArena(), manager_, std::move(filter), context_));
     }
 
     void addStreamEncoderFilter(Http::StreamEncoderFilterSharedPtr filter) override {
       manager_.filters_.push_back(filter.get());
 
-      manager_.encoder_filters_.entries_.emplace_back(
-          std::make_unique<ActiveStreamEncoderFilter>(manager_, std::move(filter), context_));
+      manager_.encoder_filters_.entries_.emplace_back(makeArenaPtr<ActiveStreamEncoderFilter>(
+          manager_.streamArena(), manager_, std::move(filter), context_));
     }
 
     void addStreamFilter(Http::StreamFilterSharedPtr filter) override {
       manager_.filters_.push_back(filter.get());
 
-      manager_.decoder_filters_.entries_.emplace_back(
-          std::make_unique<ActiveStreamDecoderFilter>(manager_, filter, context_));
-      manager_.encoder_filters_.entries_.emplace_back(
-          std::make_unique<ActiveStreamEncoderFilter>(manager_, std::move(filter), context_));
+      manager_.decoder_filters_.entries_.emplace_back(makeArenaPtr<ActiveStreamDecoderFilter>(
+          manager_.streamArena(), manager_, filter, context_));
+      manager_.encoder_filters_.entries_.emplace_back(makeArenaPtr<ActiveStreamEncoderFilter>(
+          manager_.streamArena(), manager_, std::move(filter), context_));
     }
 
     void addAccessLogHandler(AccessLog::InstanceSharedPtr handler) override {
@@ -1106,6 +1122,10 @@ private:
   Buffer::BufferMemoryAccountSharedPtr account_;
   const bool proxy_100_continue_;
 
+  // Per-stream arena, present when "envoy.reloadable_features.http_stream_arena" is enabled.
+  // Everything allocated from it is released in one shot when the stream is destroyed, so it
+  // must be declared before (and thus outlive) any member that allocates from it.
+  absl::optional<Arena> stream_arena_;
   StreamDecoderFilters decoder_filters_;
   StreamEncoderFilters encoder_filters_;
   std::vector<StreamFilterBase*> filters_;
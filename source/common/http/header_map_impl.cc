@@ -25,6 +25,11 @@ namespace {
 constexpr absl::string_view DelimiterForInlineHeaders{","};
 constexpr absl::string_view DelimiterForInlineCookies{"; "};
 const static int kMinHeadersForLazyMap = 3; // Optimal hard-coded value based on benchmarks.
+// The first node block of a pooled header list holds this many entries, and every following block
+// doubles in size up to the maximum. This keeps small maps (e.g. trailers) cheap while bounding
+// the number of allocations for maps with many headers.
+constexpr uint32_t kInitialNodesPerBlock = 4;
+constexpr uint32_t kMaxNodesPerBlock = 64;
 
 absl::string_view delimiterByHeader(const LowerCaseString& key) {
   if (key == Http::Headers::get().Cookie) {
@@ -54,6 +59,53 @@ template <> bool HeaderMapImpl::HeaderList::isPseudoHeader(const LowerCaseString
   return key.get().c_str()[0] == ':';
 }
 
+void* HeaderMapImpl::HeaderNodePool::allocate(size_t size) {
+  if (mode_ == Mode::Unset) {
+    const bool pooled =
+        Runtime::runtimeFeatureEnabled("envoy.reloadable_features.header_map_pooled_node_storage");
+    mode_ = (pooled && size >= sizeof(FreeNode)) ? Mode::Pooled : Mode::Heap;
+    node_size_ = size;
+  }
+  if (mode_ == Mode::Heap || size != node_size_) {
+    return ::operator new(size);
+  }
+
+  if (free_list_ != nullptr) {
+    FreeNode* node = free_list_;
+    free_list_ = node->next_;
+    return node;
+  }
+  if (unused_nodes_ == 0) {
+    addBlock();
+  }
+  void* node = next_unused_;
+  next_unused_ += node_size_;
+  --unused_nodes_;
+  return node;
+}
+
+void HeaderMapImpl::HeaderNodePool::deallocate(void* node, size_t size) {
+  if (mode_ != Mode::Pooled || size != node_size_) {
+    ::operator delete(node);
+    return;
+  }
+  FreeNode* free_node = static_cast<FreeNode*>(node);
+  free_node->next_ = free_list_;
+  free_list_ = free_node;
+}
+
+void HeaderMapImpl::HeaderNodePool::addBlock() {
+  ASSERT(unused_nodes_ == 0);
+  uint32_t nodes = kInitialNodesPerBlock;
+  for (size_t i = 0; i < blocks_.size() && nodes < kMaxNodesPerBlock; ++i) {
+    nodes *= 2;
+  }
+  // The default operator new[] alignment is sufficient for HeaderEntryImpl list nodes.
+  blocks_.emplace_back(new uint8_t[static_cast<size_t>(nodes) * node_size_]);
+  next_unused_ = blocks_.back().get();
+  unused_nodes_ = nodes;
+}
+
 bool HeaderMapImpl::HeaderList::maybeMakeMap() {
   if (lazy_map_.empty()) {
     if (headers_.size() < kMinHeadersForLazyMap) {
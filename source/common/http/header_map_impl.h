@@ -17,6 +17,8 @@
 #include "source/common/http/headers.h"
 #include "source/common/runtime/runtime_features.h"
 
+#include "absl/container/inlined_vector.h"
+
 namespace Envoy {
 namespace Http {
 
@@ -78,6 +80,8 @@ public:
 
   // Performs a manual byte size count for test verification.
   void verifyByteSizeInternalForTest() const;
+  // Returns the number of contiguous blocks backing the header entries, for test verification.
+  size_t storageBlocksForTest() const { return headers_.poolForTest().numBlocksForTest(); }
 
   // Note: This class does not actually implement Http::HeaderMap to avoid virtual inheritance in
   // the derived classes. Instead, it is used as a mix-in class for TypedHeaderMapImpl below. This
@@ -114,6 +118,84 @@ public:
   StatefulHeaderKeyFormatterOptRef formatter() { return makeOptRefFromPtr(formatter_.get()); }
 
 protected:
+  /**
+   * Backing storage for the nodes of a HeaderList. When pooled storage is enabled via
+   * "envoy.reloadable_features.header_map_pooled_node_storage", list nodes are carved out of
+   * contiguous blocks owned by the header map (growing geometrically), and nodes released by
+   * removals are recycled through an intrusive free list. Populating a map with N headers then
+   * costs O(log N) heap allocations instead of N, and iteration in insertion order mostly walks
+   * adjacent memory. Blocks are only returned to the heap when the owning map is destroyed, so the
+   * memory held is bounded by the peak number of headers in the map.
+   *
+   * The storage mode is latched on the first allocation so that empty header maps never pay for
+   * the runtime lookup.
+   */
+  class HeaderNodePool : NonCopyable {
+  public:
+    void* allocate(size_t size);
+    void deallocate(void* node, size_t size);
+
+    // Number of contiguous blocks currently owned by the pool. Exposed for tests.
+    size_t numBlocksForTest() const { return blocks_.size(); }
+
+  private:
+    struct FreeNode {
+      FreeNode* next_;
+    };
+    enum class Mode : uint8_t { Unset, Pooled, Heap };
+
+    void addBlock();
+
+    absl::InlinedVector<std::unique_ptr<uint8_t[]>, 2> blocks_;
+    FreeNode* free_list_{};
+    // Next never-used node in the most recently added block.
+    uint8_t* next_unused_{};
+    uint32_t unused_nodes_{};
+    uint32_t node_size_{};
+    Mode mode_{Mode::Unset};
+  };
+
+  /**
+   * Stateful allocator handing out HeaderList nodes from a HeaderNodePool.
+   */
+  template <class T> class HeaderNodeAllocator {
+  public:
+    using value_type = T;
+
+    explicit HeaderNodeAllocator(HeaderNodePool& pool) : pool_(&pool) {}
+    template <class U>
+    HeaderNodeAllocator(const HeaderNodeAllocator<U>& other) : pool_(other.pool_) {}
+
+    T* allocate(size_t n) {
+      if (n != 1) {
+        return std::allocator<T>().allocate(n);
+      }
+      return static_cast<T*>(pool_->allocate(sizeof(T)));
+    }
+    void deallocate(T* p, size_t n) {
+      if (n != 1) {
+        std::allocator<T>().deallocate(p, n);
+        return;
+      }
+      pool_->deallocate(p, sizeof(T));
+    }
+
+    template <class U> bool operator==(const HeaderNodeAllocator<U>& other) const {
+      return pool_ == other.pool_;
+    }
+    template <class U> bool operator!=(const HeaderNodeAllocator<U>& other) const {
+      return pool_ != other.pool_;
+    }
+
+  private:
+    template <class U> friend class HeaderNodeAllocator;
+
+    HeaderNodePool* pool_;
+  };
+
+  struct HeaderEntryImpl;
+  using HeaderListStorage = std::list<HeaderEntryImpl, HeaderNodeAllocator<HeaderEntryImpl>>;
+
   struct HeaderEntryImpl : public HeaderEntry, NonCopyable {
     HeaderEntryImpl(const LowerCaseString& key);
     HeaderEntryImpl(const LowerCaseString& key, HeaderString&& value);
@@ -129,9 +211,9 @@ protected:
 
     HeaderString key_;
     HeaderString value_;
-    std::list<HeaderEntryImpl>::iterator entry_;
+    HeaderListStorage::iterator entry_;
   };
-  using HeaderNode = std::list<HeaderEntryImpl>::iterator;
+  using HeaderNode = HeaderListStorage::iterator;
 
   /**
    * This is the static lookup table that is used to determine whether a header is one of the O(1)
@@ -210,7 +292,9 @@ protected:
     using HeaderNodeVector = absl::InlinedVector<HeaderNode, 1>;
     using HeaderLazyMap = absl::flat_hash_map<absl::string_view, HeaderNodeVector>;
 
-    HeaderList() : pseudo_headers_end_(headers_.end()) {}
+    HeaderList()
+        : headers_(HeaderNodeAllocator<HeaderEntryImpl>(pool_)),
+          pseudo_headers_end_(headers_.end()) {}
 
     template <class Key> bool isPseudoHeader(const Key& key) {
       return !key.getStringView().empty() && key.getStringView()[0] == ':';
@@ -300,12 +384,12 @@ protected:
      */
     size_t remove(absl::string_view key);
 
-    std::list<HeaderEntryImpl>::iterator begin() { return headers_.begin(); }
-    std::list<HeaderEntryImpl>::iterator end() { return headers_.end(); }
-    std::list<HeaderEntryImpl>::const_iterator begin() const { return headers_.begin(); }
-    std::list<HeaderEntryImpl>::const_iterator end() const { return headers_.end(); }
-    std::list<HeaderEntryImpl>::const_reverse_iterator rbegin() const { return headers_.rbegin(); }
-    std::list<HeaderEntryImpl>::const_reverse_iterator rend() const { return headers_.rend(); }
+    HeaderListStorage::iterator begin() { return headers_.begin(); }
+    HeaderListStorage::iterator end() { return headers_.end(); }
+    HeaderListStorage::const_iterator begin() const { return headers_.begin(); }
+    HeaderListStorage::const_iterator end() const { return headers_.end(); }
+    HeaderListStorage::const_reverse_iterator rbegin() const { return headers_.rbegin(); }
+    HeaderListStorage::const_reverse_iterator rend() const { return headers_.rend(); }
     HeaderLazyMap::iterator mapFind(absl::string_view key) { return lazy_map_.find(key); }
     HeaderLazyMap::iterator mapEnd() { return lazy_map_.end(); }
     size_t size() const { return headers_.size(); }
@@ -315,9 +399,12 @@ protected:
       pseudo_headers_end_ = headers_.end();
       lazy_map_.clear();
     }
+    const HeaderNodePool& poolForTest() const { return pool_; }
 
   private:
-    std::list<HeaderEntryImpl> headers_;
+    // Must be declared before (and hence destroyed after) the list whose nodes it owns.
+    HeaderNodePool pool_;
+    HeaderListStorage headers_;
     HeaderNode pseudo_headers_end_;
     HeaderLazyMap lazy_map_;
   };
@@ -5,6 +5,7 @@
 #include <cstdint>
 
 #include "source/common/common/assert.h"
+#include "source/common/http/character_set_validation.h"
 #include "source/common/http/headers.h"
 #include "source/common/runtime/runtime_features.h"
 
@@ -28,10 +29,21 @@ constexpr absl::string_view kHttpVersionPrefix = "HTTP/";
 // Allowed characters for field names according to Section 5.1
 // and for methods according to Section 9.1 of RFC 9110:
 // https://www.rfc-editor.org/rfc/rfc9110.html
-constexpr absl::string_view kValidCharacters =
-    "!#$%&'*+-.0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ^_`abcdefghijklmnopqrstuvwxyz|~";
-constexpr absl::string_view::iterator kValidCharactersBegin = kValidCharacters.begin();
-constexpr absl::string_view::iterator kValidCharactersEnd = kValidCharacters.end();
+// Both are tokens, see kGenericHeaderNameCharTable.
+const VectorizedCharTable& kValidCharacters = kGenericHeaderNameVectorizedCharTable;
+
+// CR and LF, which are removed from header values.
+constexpr VectorizedCharTable kCrOrLfCharacters{std::array<uint32_t, 8>{
+    // control characters
+    0b00000000001001000000000000000000,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+}};
 
 bool isFirstCharacterOfValidMethod(char c) {
   static constexpr char kValidFirstCharacters[] = {'A', 'B', 'C', 'D', 'G', 'H', 'L', 'M',
@@ -46,10 +58,7 @@ bool isFirstCharacterOfValidMethod(char c) {
 // enabled.
 bool isMethodValid(absl::string_view method, bool allow_custom_methods) {
   if (allow_custom_methods) {
-    return !method.empty() &&
-           std::all_of(method.begin(), method.end(), [](absl::string_view::value_type c) {
-             return std::binary_search(kValidCharactersBegin, kValidCharactersEnd, c);
-           });
+    return !method.empty() && allCharsInTable(kValidCharacters, method);
   }
 
   static constexpr absl::string_view kValidMethods[] = {
@@ -139,11 +148,7 @@ bool isVersionValid(absl::string_view version_input) {
          version_input[1] == '.' && absl::ascii_isdigit(version_input[2]);
 }
 
-bool isHeaderNameValid(absl::string_view name) {
-  return std::all_of(name.begin(), name.end(), [](absl::string_view::value_type c) {
-    return std::binary_search(kValidCharactersBegin, kValidCharactersEnd, c);
-  });
-}
+bool isHeaderNameValid(absl::string_view name) { return allCharsInTable(kValidCharacters, name); }
 
 } // anonymous namespace
 
@@ -432,12 +437,13 @@ void BalsaParser::validateAndProcessHeadersOrTrailersImpl(const quiche::BalsaHea
     }
 
     // Remove CR and LF characters to match http-parser behavior.
-    auto is_cr_or_lf = [](char c) { return c == '\r' || c == '\n'; };
-    if (std::any_of(value.begin(), value.end(), is_cr_or_lf)) {
+    const size_t first_cr_or_lf = findFirstInCharTable(kCrOrLfCharacters, value);
+    if (first_cr_or_lf != absl::string_view::npos) {
       std::string value_without_cr_or_lf;
       value_without_cr_or_lf.reserve(value.size());
-      for (char c : value) {
-        if (!is_cr_or_lf(c)) {
+      value_without_cr_or_lf.append(value.data(), first_cr_or_lf);
+      for (char c : value.substr(first_cr_or_lf)) {
+        if (!kCrOrLfCharacters.contains(c)) {
           value_without_cr_or_lf.push_back(c);
         }
       }
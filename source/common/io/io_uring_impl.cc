@@ -30,7 +30,12 @@ IoUringImpl::IoUringImpl(uint32_t io_uring_size, bool use_submission_queue_polli
   RELEASE_ASSERT(ret == 0, fmt::format("unable to initialize io_uring: {}", errorDetails(-ret)));
 }
 
-IoUringImpl::~IoUringImpl() { io_uring_queue_exit(&ring_); }
+IoUringImpl::~IoUringImpl() {
+  if (buf_ring_ != nullptr) {
+    io_uring_free_buf_ring(&ring_, buf_ring_, num_provided_buffers_, ProvidedBufferGroupId);
+  }
+  io_uring_queue_exit(&ring_);
+}
 
 os_fd_t IoUringImpl::registerEventfd() {
   ASSERT(!isEventfdRegistered());
@@ -69,7 +74,11 @@ void IoUringImpl::forEveryCompletion(const CompletionCb& completion_cb) {
 
   for (unsigned i = 0; i < count; ++i) {
     struct io_uring_cqe* cqe = cqes_[i];
-    completion_cb(reinterpret_cast<Request*>(cqe->user_data), cqe->res, false);
+    Request* req = reinterpret_cast<Request*>(cqe->user_data);
+    if (req != nullptr) {
+      req->setCompletionFlags(cqe->flags);
+    }
+    completion_cb(req, cqe->res, false);
   }
 
   io_uring_cq_advance(&ring_, count);
@@ -105,6 +114,21 @@ IoUringResult IoUringImpl::prepareAccept(os_fd_t fd, struct sockaddr* remote_add
   return IoUringResult::Ok;
 }
 
+IoUringResult IoUringImpl::prepareMultishotAccept(os_fd_t fd, Request* user_data) {
+  ENVOY_LOG(trace, "prepare multishot accept for fd = {}", fd);
+  // TODO (soulxu): Handling the case of CQ ring is overflow.
+  ASSERT(!(*(ring_.sq.kflags) & IORING_SQ_CQ_OVERFLOW));
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (sqe == nullptr) {
+    return IoUringResult::Failed;
+  }
+
+  // All the completions share the address arguments, so no peer address is reported.
+  io_uring_prep_multishot_accept(sqe, fd, nullptr, nullptr, SOCK_NONBLOCK);
+  io_uring_sqe_set_data(sqe, user_data);
+  return IoUringResult::Ok;
+}
+
 IoUringResult IoUringImpl::prepareConnect(os_fd_t fd,
                                           const Network::Address::InstanceConstSharedPtr& address,
                                           Request* user_data) {
@@ -136,6 +160,23 @@ IoUringResult IoUringImpl::prepareReadv(os_fd_t fd, const struct iovec* iovecs,
   return IoUringResult::Ok;
 }
 
+IoUringResult IoUringImpl::prepareRecvMultishot(os_fd_t fd, Request* user_data) {
+  ENVOY_LOG(trace, "prepare multishot recv for fd = {}", fd);
+  ASSERT(buf_ring_ != nullptr);
+  // TODO (soulxu): Handling the case of CQ ring is overflow.
+  ASSERT(!(*(ring_.sq.kflags) & IORING_SQ_CQ_OVERFLOW));
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (sqe == nullptr) {
+    return IoUringResult::Failed;
+  }
+
+  io_uring_prep_recv_multishot(sqe, fd, nullptr, 0, 0);
+  sqe->flags |= IOSQE_BUFFER_SELECT;
+  sqe->buf_group = ProvidedBufferGroupId;
+  io_uring_sqe_set_data(sqe, user_data);
+  return IoUringResult::Ok;
+}
+
 IoUringResult IoUringImpl::prepareWritev(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
                                          off_t offset, Request* user_data) {
   ENVOY_LOG(trace, "prepare writev for fd = {}", fd);
@@ -219,5 +260,42 @@ void IoUringImpl::removeInjectedCompletion(os_fd_t fd) {
   });
 }
 
+bool IoUringImpl::setupProvidedBuffers(uint32_t num_buffers, uint32_t buffer_size) {
+  ASSERT(buf_ring_ == nullptr);
+  ASSERT(num_buffers > 0 && num_buffers <= 32768 && (num_buffers & (num_buffers - 1)) == 0);
+  int ret = 0;
+  buf_ring_ = io_uring_setup_buf_ring(&ring_, num_buffers, ProvidedBufferGroupId, 0, &ret);
+  if (buf_ring_ == nullptr) {
+    ENVOY_LOG(debug, "unable to register provided buffer ring: {}", errorDetails(-ret));
+    return false;
+  }
+
+  provided_buffers_ = std::make_unique<uint8_t[]>(static_cast<size_t>(num_buffers) * buffer_size);
+  num_provided_buffers_ = num_buffers;
+  provided_buffer_size_ = buffer_size;
+  const int mask = io_uring_buf_ring_mask(num_buffers);
+  for (uint32_t i = 0; i < num_buffers; ++i) {
+    io_uring_buf_ring_add(buf_ring_, providedBuffer(i), buffer_size, i, mask, i);
+  }
+  io_uring_buf_ring_advance(buf_ring_, num_buffers);
+  num_available_provided_buffers_ = num_buffers;
+  return true;
+}
+
+uint8_t* IoUringImpl::takeProvidedBuffer(uint16_t buffer_id) {
+  ASSERT(buffer_id < num_provided_buffers_);
+  ASSERT(num_available_provided_buffers_ > 0);
+  --num_available_provided_buffers_;
+  return providedBuffer(buffer_id);
+}
+
+void IoUringImpl::returnProvidedBuffer(uint16_t buffer_id) {
+  ASSERT(buffer_id < num_provided_buffers_);
+  io_uring_buf_ring_add(buf_ring_, providedBuffer(buffer_id), provided_buffer_size_, buffer_id,
+                        io_uring_buf_ring_mask(num_provided_buffers_), 0);
+  io_uring_buf_ring_advance(buf_ring_, 1);
+  ++num_available_provided_buffers_;
+}
+
 } // namespace Io
 } // namespace Envoy
@@ -34,10 +34,12 @@ public:
   void forEveryCompletion(const CompletionCb& completion_cb) override;
   IoUringResult prepareAccept(os_fd_t fd, struct sockaddr* remote_addr, socklen_t* remote_addr_len,
                               Request* user_data) override;
+  IoUringResult prepareMultishotAccept(os_fd_t fd, Request* user_data) override;
   IoUringResult prepareConnect(os_fd_t fd, const Network::Address::InstanceConstSharedPtr& address,
                                Request* user_data) override;
   IoUringResult prepareReadv(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs, off_t offset,
                              Request* user_data) override;
+  IoUringResult prepareRecvMultishot(os_fd_t fd, Request* user_data) override;
   IoUringResult prepareWritev(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
                               off_t offset, Request* user_data) override;
   IoUringResult prepareClose(os_fd_t fd, Request* user_data) override;
@@ -46,12 +48,29 @@ public:
   IoUringResult submit() override;
   void injectCompletion(os_fd_t fd, Request* user_data, int32_t result) override;
   void removeInjectedCompletion(os_fd_t fd) override;
+  bool setupProvidedBuffers(uint32_t num_buffers, uint32_t buffer_size) override;
+  uint32_t numAvailableProvidedBuffers() const override { return num_available_provided_buffers_; }
+  uint8_t* takeProvidedBuffer(uint16_t buffer_id) override;
+  void returnProvidedBuffer(uint16_t buffer_id) override;
 
 private:
+  // All provided buffers belong to a single buffer group.
+  static constexpr uint16_t ProvidedBufferGroupId = 0;
+
+  uint8_t* providedBuffer(uint16_t buffer_id) const {
+    return provided_buffers_.get() + static_cast<size_t>(buffer_id) * provided_buffer_size_;
+  }
+
   struct io_uring ring_ {};
   std::vector<struct io_uring_cqe*> cqes_;
   os_fd_t event_fd_{INVALID_SOCKET};
   std::list<InjectedCompletion> injected_completions_;
+  // The ring the kernel picks provided buffers from, and the memory backing the buffers.
+  struct io_uring_buf_ring* buf_ring_{nullptr};
+  std::unique_ptr<uint8_t[]> provided_buffers_;
+  uint32_t num_provided_buffers_{0};
+  uint32_t provided_buffer_size_{0};
+  uint32_t num_available_provided_buffers_{0};
 };
 
 } // namespace Io
@@ -1,18 +1,45 @@
 #include "source/common/io/io_uring_worker_factory_impl.h"
 
+#include <algorithm>
+#include <bit>
+
 #include "source/common/io/io_uring_worker_impl.h"
 #include "source/common/network/io_uring_socket_handle_impl.h"
+#include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
 namespace Io {
+namespace {
+
+// The kernel requires a power of two number of entries in a provided buffer ring, at most 32768.
+constexpr uint32_t MaxProvidedBuffers = 32768;
+
+uint32_t numProvidedBuffers(uint32_t io_uring_size) {
+  if (!Runtime::runtimeFeatureEnabled("envoy.reloadable_features.io_uring_provided_buffers")) {
+    return 0;
+  }
+  return std::bit_ceil(std::clamp<uint32_t>(io_uring_size, 1, MaxProvidedBuffers));
+}
+
+} // namespace
+
+IoUringWorkerFactoryImpl::IoUringWorkerFactoryImpl(uint32_t io_uring_size,
+                                                   bool use_submission_queue_polling,
+                                                   uint32_t read_buffer_size,
+                                                   uint32_t write_timeout_ms,
+                                                   ThreadLocal::SlotAllocator& tls)
+    : IoUringWorkerFactoryImpl(io_uring_size, use_submission_queue_polling, read_buffer_size,
+                               write_timeout_ms, numProvidedBuffers(io_uring_size), tls) {}
 
 IoUringWorkerFactoryImpl::IoUringWorkerFactoryImpl(uint32_t io_uring_size,
                                                    bool use_submission_queue_polling,
                                                    uint32_t read_buffer_size,
                                                    uint32_t write_timeout_ms,
+                                                   uint32_t num_provided_buffers,
                                                    ThreadLocal::SlotAllocator& tls)
     : io_uring_size_(io_uring_size), use_submission_queue_polling_(use_submission_queue_polling),
-      read_buffer_size_(read_buffer_size), write_timeout_ms_(write_timeout_ms), tls_(tls) {}
+      read_buffer_size_(read_buffer_size), write_timeout_ms_(write_timeout_ms),
+      num_provided_buffers_(num_provided_buffers), tls_(tls) {}
 
 OptRef<IoUringWorker> IoUringWorkerFactoryImpl::getIoUringWorker() {
   auto ret = tls_.get();
@@ -26,9 +53,11 @@ void IoUringWorkerFactoryImpl::onWorkerThreadInitialized() {
   tls_.set([io_uring_size = io_uring_size_,
             use_submission_queue_polling = use_submission_queue_polling_,
             read_buffer_size = read_buffer_size_,
-            write_timeout_ms = write_timeout_ms_](Event::Dispatcher& dispatcher) {
+            write_timeout_ms = write_timeout_ms_,
+            num_provided_buffers = num_provided_buffers_](Event::Dispatcher& dispatcher) {
     return std::make_shared<IoUringWorkerImpl>(io_uring_size, use_submission_queue_polling,
-                                               read_buffer_size, write_timeout_ms, dispatcher);
+                                               read_buffer_size, write_timeout_ms,
+                                               num_provided_buffers, dispatcher);
   });
 }
 
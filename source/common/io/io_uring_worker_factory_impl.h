@@ -8,9 +8,16 @@ namespace Io {
 
 class IoUringWorkerFactoryImpl : public IoUringWorkerFactory {
 public:
+  /**
+   * Each worker registers provided buffers for multishot reads when
+   * envoy.reloadable_features.io_uring_provided_buffers is enabled, one per submission queue entry.
+   */
   IoUringWorkerFactoryImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                            uint32_t read_buffer_size, uint32_t write_timeout_ms,
                            ThreadLocal::SlotAllocator& tls);
+  IoUringWorkerFactoryImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
+                           uint32_t read_buffer_size, uint32_t write_timeout_ms,
+                           uint32_t num_provided_buffers, ThreadLocal::SlotAllocator& tls);
 
   OptRef<IoUringWorker> getIoUringWorker() override;
 
@@ -24,6 +31,7 @@ private:
   const bool use_submission_queue_polling_;
   const uint32_t read_buffer_size_;
   const uint32_t write_timeout_ms_;
+  const uint32_t num_provided_buffers_;
   ThreadLocal::TypedSlot<IoUringWorker> tls_;
 };
 
@@ -1,5 +1,7 @@
 #include "source/common/io/io_uring_worker_impl.h"
 
+#include <unistd.h>
+
 namespace Envoy {
 namespace Io {
 
@@ -10,6 +12,9 @@ ReadRequest::ReadRequest(IoUringSocket& socket, uint32_t size)
   iov_->iov_len = size;
 }
 
+ReadRequest::ReadRequest(IoUringSocket& socket)
+    : Request(RequestType::Read, socket), multishot_(true) {}
+
 WriteRequest::WriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector& slices)
     : Request(RequestType::Write, socket), iov_(std::make_unique<struct iovec[]>(slices.size())) {
   for (size_t i = 0; i < slices.size(); i++) {
@@ -60,14 +65,21 @@ void IoUringSocketEntry::onRemoteClose() {
 
 IoUringWorkerImpl::IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                                      uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                                     Event::Dispatcher& dispatcher)
+                                     uint32_t num_provided_buffers, Event::Dispatcher& dispatcher)
     : IoUringWorkerImpl(std::make_unique<IoUringImpl>(io_uring_size, use_submission_queue_polling),
-                        read_buffer_size, write_timeout_ms, dispatcher) {}
+                        read_buffer_size, write_timeout_ms, num_provided_buffers, dispatcher) {}
 
 IoUringWorkerImpl::IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size,
-                                     uint32_t write_timeout_ms, Event::Dispatcher& dispatcher)
+                                     uint32_t write_timeout_ms, uint32_t num_provided_buffers,
+                                     Event::Dispatcher& dispatcher)
     : io_uring_(std::move(io_uring)), read_buffer_size_(read_buffer_size),
       write_timeout_ms_(write_timeout_ms), dispatcher_(dispatcher) {
+  if (num_provided_buffers > 0) {
+    provided_buffers_enabled_ =
+        io_uring_->setupProvidedBuffers(num_provided_buffers, read_buffer_size_);
+    ENVOY_LOG(debug, "io uring worker, provided buffers enabled = {}", provided_buffers_enabled_);
+  }
+
   const os_fd_t event_fd = io_uring_->registerEventfd();
   // We only care about the read event of Eventfd, since we only receive the
   // event here.
@@ -127,6 +139,14 @@ IoUringSocket& IoUringWorkerImpl::addClientSocket(os_fd_t fd, Event::FileReadyCb
   return addSocket(std::move(socket));
 }
 
+IoUringSocket& IoUringWorkerImpl::addAcceptSocket(os_fd_t fd, Event::FileReadyCb cb) {
+  ENVOY_LOG(trace, "add accept socket, fd = {}", fd);
+  std::unique_ptr<IoUringAcceptSocket> socket =
+      std::make_unique<IoUringAcceptSocket>(fd, *this, std::move(cb));
+  socket->enableRead();
+  return addSocket(std::move(socket));
+}
+
 Event::Dispatcher& IoUringWorkerImpl::dispatcher() { return dispatcher_; }
 
 IoUringSocketEntry& IoUringWorkerImpl::addSocket(IoUringSocketEntryPtr&& socket) {
@@ -134,6 +154,28 @@ IoUringSocketEntry& IoUringWorkerImpl::addSocket(IoUringSocketEntryPtr&& socket)
   return *sockets_.back();
 }
 
+Request* IoUringWorkerImpl::submitAcceptRequest(IoUringSocket& socket) {
+  Request* req = new Request(Request::RequestType::Accept, socket);
+
+  ENVOY_LOG(trace, "submit accept request, fd = {}, multishot = {}, accept req = {}", socket.fd(),
+            multishot_accept_enabled_, fmt::ptr(req));
+
+  auto prepare = [this, &socket, req]() {
+    return multishot_accept_enabled_
+               ? io_uring_->prepareMultishotAccept(socket.fd(), req)
+               : io_uring_->prepareAccept(socket.fd(), nullptr, nullptr, req);
+  };
+  auto res = prepare();
+  if (res == IoUringResult::Failed) {
+    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
+    submit();
+    res = prepare();
+    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare accept");
+  }
+  submit();
+  return req;
+}
+
 Request*
 IoUringWorkerImpl::submitConnectRequest(IoUringSocket& socket,
                                         const Network::Address::InstanceConstSharedPtr& address) {
@@ -153,6 +195,27 @@ IoUringWorkerImpl::submitConnectRequest(IoUringSocket& socket,
 }
 
 Request* IoUringWorkerImpl::submitReadRequest(IoUringSocket& socket) {
+  // One multishot request serves all the reads until it is terminated. Once the kernel runs out of
+  // provided buffers, fall back to readv until some are returned. A socket with reads disabled only
+  // reads to detect a remote close, so it must not keep taking provided buffers nobody drains.
+  if (provided_buffers_enabled_ && socket.getStatus() == ReadEnabled &&
+      io_uring_->numAvailableProvidedBuffers() > 0) {
+    ReadRequest* req = new ReadRequest(socket);
+
+    ENVOY_LOG(trace, "submit multishot read request, fd = {}, read req = {}", socket.fd(),
+              fmt::ptr(req));
+
+    auto res = io_uring_->prepareRecvMultishot(socket.fd(), req);
+    if (res == IoUringResult::Failed) {
+      // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
+      submit();
+      res = io_uring_->prepareRecvMultishot(socket.fd(), req);
+      RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare multishot recv");
+    }
+    submit();
+    return req;
+  }
+
   ReadRequest* req = new ReadRequest(socket, read_buffer_size_);
 
   ENVOY_LOG(trace, "submit read request, fd = {}, read req = {}", socket.fd(), fmt::ptr(req));
@@ -235,6 +298,35 @@ Request* IoUringWorkerImpl::submitShutdownRequest(IoUringSocket& socket, int how
   return req;
 }
 
+Buffer::BufferFragment& IoUringWorkerImpl::takeProvidedBuffer(uint16_t buffer_id, size_t length) {
+  ASSERT(length <= read_buffer_size_);
+  uint8_t* data = io_uring_->takeProvidedBuffer(buffer_id);
+  return *new Buffer::BufferFragmentImpl(
+      data, length,
+      [this, &dispatcher = dispatcher_, still_alive = std::weak_ptr<bool>(still_alive_),
+       buffer_id](const void*, size_t, const Buffer::BufferFragmentImpl* this_fragment) {
+        delete this_fragment;
+        // The buffer is owned by the io_uring instance, so the data must not outlive the worker.
+        ASSERT(!still_alive.expired());
+        if (dispatcher.isThreadSafe()) {
+          returnProvidedBuffer(buffer_id);
+          return;
+        }
+        // The data was moved to a buffer drained on another thread. The io_uring instance is only
+        // accessed from the worker's thread, so the buffer is returned there.
+        dispatcher.post([this, still_alive, buffer_id]() {
+          if (!still_alive.expired()) {
+            returnProvidedBuffer(buffer_id);
+          }
+        });
+      });
+}
+
+void IoUringWorkerImpl::returnProvidedBuffer(uint16_t buffer_id) {
+  ASSERT(dispatcher_.isThreadSafe());
+  io_uring_->returnProvidedBuffer(buffer_id);
+}
+
 IoUringSocketEntryPtr IoUringWorkerImpl::removeSocket(IoUringSocketEntry& socket) {
   // Remove all the injection completion for this socket.
   io_uring_->removeInjectedCompletion(socket.fd());
@@ -294,7 +386,10 @@ void IoUringWorkerImpl::onFileEvent() {
       break;
     }
 
-    delete req;
+    // A multishot request stays alive until its last completion.
+    if (!(req->completionFlags() & IORING_CQE_F_MORE)) {
+      delete req;
+    }
   });
   delay_submit_ = false;
   submit();
@@ -333,12 +428,14 @@ void IoUringServerSocket::close(bool keep_fd_open, IoUringSocketOnClosedCb cb) {
   keep_fd_open_ = keep_fd_open;
 
   // Delay close until read request and write (or shutdown) request are drained.
-  if (read_req_ == nullptr && write_or_shutdown_req_ == nullptr) {
+  if (read_req_ == nullptr && write_or_shutdown_req_ == nullptr && read_cancel_req_ == nullptr) {
     closeInternal();
     return;
   }
 
-  if (read_req_ != nullptr) {
+  // A read cancelled by disableRead() is not replaced until the cancellation completes, so there is
+  // nothing else to cancel.
+  if (read_req_ != nullptr && read_cancel_req_ == nullptr) {
     ENVOY_LOG(trace, "cancel the read request, fd = {}", fd_);
     read_cancel_req_ = parent_.submitCancelRequest(*this, read_req_);
   }
@@ -372,7 +469,19 @@ void IoUringServerSocket::enableRead() {
   submitReadRequest();
 }
 
-void IoUringServerSocket::disableRead() { IoUringSocketEntry::disableRead(); }
+void IoUringServerSocket::disableRead() {
+  IoUringSocketEntry::disableRead();
+
+  // A multishot read keeps filling provided buffers, which are shared by all the sockets of the
+  // worker, until it is terminated. Cancel it, the read submitted once the cancellation completes
+  // is a single readv. enableRead() doesn't cancel that readv, the multishot read is submitted
+  // again once it completes.
+  if (read_req_ != nullptr && read_cancel_req_ == nullptr &&
+      static_cast<ReadRequest*>(read_req_)->multishot()) {
+    ENVOY_LOG(trace, "cancel the multishot read request, fd = {}", fd_);
+    read_cancel_req_ = parent_.submitCancelRequest(*this, read_req_);
+  }
+}
 
 void IoUringServerSocket::write(Buffer::Instance& data) {
   ENVOY_LOG(trace, "write, buffer size = {}, fd = {}", data.length(), fd_);
@@ -418,6 +527,10 @@ void IoUringServerSocket::onCancel(Request* req, int32_t result, bool injected)
   ASSERT(!injected);
   if (read_cancel_req_ == req) {
     read_cancel_req_ = nullptr;
+    // Submit the read deferred while the multishot read cancelled by disableRead() terminated.
+    if ((status_ == ReadEnabled || status_ == ReadDisabled) && !read_error_.has_value()) {
+      submitReadRequest();
+    }
   }
   if (write_or_shutdown_cancel_req_ == req) {
     write_or_shutdown_cancel_req_ = nullptr;
@@ -429,6 +542,11 @@ void IoUringServerSocket::onCancel(Request* req, int32_t result, bool injected)
 }
 
 void IoUringServerSocket::moveReadDataToBuffer(Request* req, size_t data_length) {
+  if (req->completionFlags() & IORING_CQE_F_BUFFER) {
+    read_buf_.addBufferFragment(parent_.takeProvidedBuffer(
+        static_cast<uint16_t>(req->completionFlags() >> IORING_CQE_BUFFER_SHIFT), data_length));
+    return;
+  }
   ReadRequest* read_req = static_cast<ReadRequest*>(req);
   Buffer::BufferFragment* fragment = new Buffer::BufferFragmentImpl(
       read_req->buf_.release(), data_length,
@@ -456,11 +574,23 @@ void IoUringServerSocket::onRead(Request* req, int32_t result, bool injected) {
   ENVOY_LOG(trace,
             "onRead with result {}, fd = {}, injected = {}, status_ = {}, enable_close_event = {}",
             result, fd_, injected, static_cast<int>(status_), enable_close_event_);
+  // Whether a multishot read was terminated because the kernel ran out of provided buffers or
+  // doesn't support multishot reads. This isn't an error, the read is just submitted again.
+  bool resubmit_read = false;
   if (!injected) {
-    read_req_ = nullptr;
+    // A multishot read keeps completing until the kernel terminates it.
+    if (!(req->completionFlags() & IORING_CQE_F_MORE)) {
+      read_req_ = nullptr;
+    }
+    if (static_cast<ReadRequest*>(req)->multishot() && (result == -ENOBUFS || result == -EINVAL)) {
+      if (result == -EINVAL) {
+        parent_.disableProvidedBuffers();
+      }
+      resubmit_read = true;
+    }
     // If the socket is going to close, discard all results.
-    if (status_ == Closed && write_or_shutdown_req_ == nullptr && read_cancel_req_ == nullptr &&
-        write_or_shutdown_cancel_req_ == nullptr) {
+    if (status_ == Closed && read_req_ == nullptr && write_or_shutdown_req_ == nullptr &&
+        read_cancel_req_ == nullptr && write_or_shutdown_cancel_req_ == nullptr) {
       if (result > 0 && keep_fd_open_) {
         moveReadDataToBuffer(req, result);
       }
@@ -473,7 +603,7 @@ void IoUringServerSocket::onRead(Request* req, int32_t result, bool injected) {
   if (result > 0) {
     moveReadDataToBuffer(req, result);
   } else {
-    if (result != -ECANCELED) {
+    if (result != -ECANCELED && !resubmit_read) {
       read_error_ = result;
     }
   }
@@ -610,7 +740,16 @@ void IoUringServerSocket::onShutdown(Request* req, int32_t result, bool injected
 void IoUringServerSocket::closeInternal() {
   if (keep_fd_open_) {
     if (on_closed_cb_) {
-      on_closed_cb_(read_buf_);
+      if (parent_.providedBuffersEnabled() && read_buf_.length() > 0) {
+        // The socket may be moved to another worker, while the provided buffers must be returned
+        // to this one. Hand over a copy of the data instead.
+        Buffer::OwnedImpl read_buf_copy;
+        read_buf_copy.add(read_buf_);
+        read_buf_.drain(read_buf_.length());
+        on_closed_cb_(read_buf_copy);
+      } else {
+        on_closed_cb_(read_buf_);
+      }
     }
     cleanup();
     return;
@@ -621,7 +760,8 @@ void IoUringServerSocket::closeInternal() {
 }
 
 void IoUringServerSocket::submitReadRequest() {
-  if (!read_req_) {
+  // A read cancelled by disableRead() is only replaced once the cancellation completes.
+  if (!read_req_ && read_cancel_req_ == nullptr) {
     read_req_ = parent_.submitReadRequest(*this);
   }
 }
@@ -642,6 +782,140 @@ void IoUringServerSocket::submitWriteOrShutdownRequest() {
   }
 }
 
+IoUringAcceptSocket::IoUringAcceptSocket(os_fd_t fd, IoUringWorkerImpl& parent,
+                                         Event::FileReadyCb cb)
+    : IoUringSocketEntry(fd, parent, std::move(cb), false) {}
+
+IoUringAcceptSocket::~IoUringAcceptSocket() {
+  for (const os_fd_t fd : accepted_fds_) {
+    ::close(fd);
+  }
+}
+
+void IoUringAcceptSocket::close(bool keep_fd_open, IoUringSocketOnClosedCb cb) {
+  ENVOY_LOG(trace, "close the accept socket, fd = {}, status = {}", fd_,
+            static_cast<int>(status_));
+  IoUringSocketEntry::close(keep_fd_open, cb);
+
+  // Delay close until the accept request is drained.
+  if (accept_req_ == nullptr) {
+    closeInternal();
+    return;
+  }
+  cancelAcceptRequest();
+}
+
+void IoUringAcceptSocket::enableRead() {
+  IoUringSocketEntry::enableRead();
+  ENVOY_LOG(trace, "enable accept, fd = {}, pending = {}", fd_, accepted_fds_.size());
+
+  // Continue handing out the connections accepted before.
+  if (!accepted_fds_.empty()) {
+    injectCompletion(Request::RequestType::Accept);
+  }
+  submitAcceptRequest();
+}
+
+void IoUringAcceptSocket::disableRead() {
+  IoUringSocketEntry::disableRead();
+  ENVOY_LOG(trace, "disable accept, fd = {}", fd_);
+
+  // Leave new connections in the listen backlog, like a disabled file event does.
+  cancelAcceptRequest();
+}
+
+void IoUringAcceptSocket::onAccept(Request* req, int32_t result, bool injected) {
+  IoUringSocketEntry::onAccept(req, result, injected);
+
+  ENVOY_LOG(trace, "onAccept with result {}, fd = {}, injected = {}, status_ = {}", result, fd_,
+            injected, static_cast<int>(status_));
+  if (!injected) {
+    // A multishot accept keeps completing until it is cancelled or fails.
+    if (!(req->completionFlags() & IORING_CQE_F_MORE)) {
+      accept_req_ = nullptr;
+    }
+    if (result >= 0) {
+      accepted_fds_.push_back(result);
+    } else if (result == -EINVAL && parent_.multishotAcceptEnabled()) {
+      ENVOY_LOG(debug, "multishot accept is not supported, fd = {}", fd_);
+      parent_.disableMultishotAccept();
+    } else if (result != -ECANCELED) {
+      ENVOY_LOG(debug, "accept failed, fd = {}, error = {}", fd_, errorDetails(-result));
+    }
+  }
+
+  if (status_ == Closed) {
+    if (accept_req_ == nullptr && accept_cancel_req_ == nullptr) {
+      closeInternal();
+    }
+    return;
+  }
+  if (status_ != ReadEnabled) {
+    return;
+  }
+
+  // An injected completion is an activated read event, which is delivered even if nothing is
+  // pending.
+  const size_t pending = accepted_fds_.size();
+  if (injected || pending > 0) {
+    THROW_IF_NOT_OK(cb_(Event::FileReadyType::Read));
+  }
+
+  // The callback may accept only some of the connections, or disable or close the socket. Keep
+  // delivering the rest as long as the callback makes progress, like a level triggered event.
+  if (status_ == ReadEnabled) {
+    if (!accepted_fds_.empty() && accepted_fds_.size() < pending) {
+      injectCompletion(Request::RequestType::Accept);
+    }
+    submitAcceptRequest();
+  }
+}
+
+void IoUringAcceptSocket::onCancel(Request* req, int32_t result, bool injected) {
+  IoUringSocketEntry::onCancel(req, result, injected);
+  ASSERT(!injected);
+  accept_cancel_req_ = nullptr;
+  if (status_ == Closed && accept_req_ == nullptr) {
+    closeInternal();
+  }
+}
+
+os_fd_t IoUringAcceptSocket::popAcceptedFd() {
+  if (accepted_fds_.empty()) {
+    return INVALID_SOCKET;
+  }
+  const os_fd_t fd = accepted_fds_.front();
+  accepted_fds_.pop_front();
+  return fd;
+}
+
+void IoUringAcceptSocket::submitAcceptRequest() {
+  if (accept_req_ == nullptr) {
+    accept_req_ = parent_.submitAcceptRequest(*this);
+  }
+}
+
+void IoUringAcceptSocket::cancelAcceptRequest() {
+  if (accept_req_ != nullptr && accept_cancel_req_ == nullptr) {
+    ENVOY_LOG(trace, "cancel the accept request, fd = {}", fd_);
+    accept_cancel_req_ = parent_.submitCancelRequest(*this, accept_req_);
+  }
+}
+
+void IoUringAcceptSocket::closeInternal() {
+  // The listening file descriptor is owned by the caller, so only the pending connections are
+  // closed.
+  for (const os_fd_t fd : accepted_fds_) {
+    ::close(fd);
+  }
+  accepted_fds_.clear();
+  if (on_closed_cb_) {
+    Buffer::OwnedImpl empty;
+    on_closed_cb_(empty);
+  }
+  cleanup();
+}
+
 IoUringClientSocket::IoUringClientSocket(os_fd_t fd, IoUringWorkerImpl& parent,
                                          Event::FileReadyCb cb, uint32_t write_timeout_ms,
                                          bool enable_close_event)
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <deque>
+
 #include "envoy/common/io/io_uring.h"
 
 #include "source/common/buffer/buffer_impl.h"
@@ -13,9 +15,16 @@ namespace Io {
 class ReadRequest : public Request {
 public:
   ReadRequest(IoUringSocket& socket, uint32_t size);
+  // Creates a multishot read request, which receives into the worker's provided buffers.
+  explicit ReadRequest(IoUringSocket& socket);
+
+  bool multishot() const { return multishot_; }
 
   std::unique_ptr<uint8_t[]> buf_;
   std::unique_ptr<struct iovec> iov_;
+
+private:
+  const bool multishot_{false};
 };
 
 class WriteRequest : public Request {
@@ -30,11 +39,16 @@ using IoUringSocketEntryPtr = std::unique_ptr<IoUringSocketEntry>;
 
 class IoUringWorkerImpl : public IoUringWorker, private Logger::Loggable<Logger::Id::io> {
 public:
+  /**
+   * @param num_provided_buffers is the number of read_buffer_size buffers registered with the
+   * kernel for multishot reads. Zero, or a kernel without provided buffer rings, keeps one readv
+   * request per read.
+   */
   IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                     uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                    Event::Dispatcher& dispatcher);
+                    uint32_t num_provided_buffers, Event::Dispatcher& dispatcher);
   IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                    Event::Dispatcher& dispatcher);
+                    uint32_t num_provided_buffers, Event::Dispatcher& dispatcher);
   ~IoUringWorkerImpl() override;
 
   // IoUringWorker
@@ -44,7 +58,9 @@ public:
                                  bool enable_close_event) override;
   IoUringSocket& addClientSocket(os_fd_t fd, Event::FileReadyCb cb,
                                  bool enable_close_event) override;
+  IoUringSocket& addAcceptSocket(os_fd_t fd, Event::FileReadyCb cb) override;
 
+  Request* submitAcceptRequest(IoUringSocket& socket) override;
   Request* submitConnectRequest(IoUringSocket& socket,
                                 const Network::Address::InstanceConstSharedPtr& address) override;
   Request* submitReadRequest(IoUringSocket& socket) override;
@@ -64,22 +80,44 @@ public:
   // Return the number of sockets in this worker.
   uint32_t getNumOfSockets() const override { return sockets_.size(); }
 
+  // Whether read requests are multishot requests receiving into provided buffers.
+  bool providedBuffersEnabled() const { return provided_buffers_enabled_; }
+
+  // Stop submitting multishot read requests, e.g. if the kernel doesn't support them.
+  void disableProvidedBuffers() { provided_buffers_enabled_ = false; }
+
+  // Whether accept requests are multishot requests.
+  bool multishotAcceptEnabled() const { return multishot_accept_enabled_; }
+
+  // Fall back to one accept request per connection if the kernel doesn't support multishot ones.
+  void disableMultishotAccept() { multishot_accept_enabled_ = false; }
+
+  // Wrap the provided buffer a read request completed with into a fragment, which returns the
+  // buffer to the kernel when it is drained. A fragment released on another thread posts the
+  // return to this worker's thread. The fragment must be released before the worker is destroyed.
+  Buffer::BufferFragment& takeProvidedBuffer(uint16_t buffer_id, size_t length);
+
 protected:
   // Add a socket to the worker.
   IoUringSocketEntry& addSocket(IoUringSocketEntryPtr&& socket);
   void onFileEvent();
   void submit();
+  void returnProvidedBuffer(uint16_t buffer_id);
 
   // The iouring instance.
   IoUringPtr io_uring_;
   const uint32_t read_buffer_size_;
   const uint32_t write_timeout_ms_;
+  bool provided_buffers_enabled_{false};
+  bool multishot_accept_enabled_{true};
   // The dispatcher of this worker is running on.
   Event::Dispatcher& dispatcher_;
   // The file event of iouring's eventfd.
   Event::FileEventPtr file_event_{nullptr};
   // All the sockets in this worker.
   std::list<IoUringSocketEntryPtr> sockets_;
+  // Lets provided buffer returns posted from other threads detect that the worker is gone.
+  std::shared_ptr<bool> still_alive_{std::make_shared<bool>(true)};
   // This is used to mark whether delay submit is enabled.
   // The IoUringWorker will delay the submit the requests which are submitted in request completion
   // callback.
@@ -151,6 +189,7 @@ public:
   const OptRef<WriteParam>& getWriteParam() const override { return write_param_; }
 
   void setFileReadyCb(Event::FileReadyCb cb) override { cb_ = std::move(cb); }
+  os_fd_t popAcceptedFd() override { PANIC("not implement"); }
 
 protected:
   /**
@@ -251,6 +290,39 @@ protected:
   void onWriteCompleted(int32_t result);
 };
 
+/**
+ * An accept socket keeps a multishot accept request on a listening socket and queues the accepted
+ * connections until they are popped from the file ready callback, which behaves like a level
+ * triggered read event. The listening file descriptor is owned by the caller and never closed by
+ * this socket.
+ */
+class IoUringAcceptSocket : public IoUringSocketEntry {
+public:
+  IoUringAcceptSocket(os_fd_t fd, IoUringWorkerImpl& parent, Event::FileReadyCb cb);
+  ~IoUringAcceptSocket() override;
+
+  // IoUringSocket
+  void close(bool keep_fd_open, IoUringSocketOnClosedCb cb = nullptr) override;
+  void enableRead() override;
+  void disableRead() override;
+  void write(Buffer::Instance&) override { PANIC("not implement"); }
+  uint64_t write(const Buffer::RawSlice*, uint64_t) override { PANIC("not implement"); }
+  void shutdown(int) override { PANIC("not implement"); }
+  void onAccept(Request* req, int32_t result, bool injected) override;
+  void onCancel(Request* req, int32_t result, bool injected) override;
+  os_fd_t popAcceptedFd() override;
+
+private:
+  void submitAcceptRequest();
+  void cancelAcceptRequest();
+  void closeInternal();
+
+  Request* accept_req_{nullptr};
+  Request* accept_cancel_req_{nullptr};
+  // Connections accepted by the kernel which haven't been popped yet.
+  std::deque<os_fd_t> accepted_fds_;
+};
+
 class IoUringClientSocket : public IoUringServerSocket {
 public:
   IoUringClientSocket(os_fd_t fd, IoUringWorkerImpl& parent, Event::FileReadyCb cb,
@@ -3,6 +3,7 @@
 #include <atomic>
 #include <cstdint>
 #include <memory>
+#include <typeinfo>
 
 #include "envoy/common/exception.h"
 #include "envoy/common/platform.h"
@@ -19,6 +20,8 @@
 #include "source/common/common/scope_tracker.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/network/connection_socket_impl.h"
+#include "source/common/network/io_socket_error_impl.h"
+#include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/network/raw_buffer_socket.h"
 #include "source/common/network/socket_option_factory.h"
 #include "source/common/network/socket_option_impl.h"
@@ -145,7 +148,7 @@ void ConnectionImpl::close(ConnectionCloseType type) {
     return;
   }
 
-  uint64_t data_to_write = write_buffer_->length();
+  uint64_t data_to_write = write_buffer_->length() + splicePipeBytes();
   ENVOY_CONN_LOG_EVENT(debug, "connection_closing", "closing data_to_write={} type={}", *this,
                        data_to_write, enumToInt(type));
 
@@ -164,8 +167,10 @@ void ConnectionImpl::close(ConnectionCloseType type) {
       type == ConnectionCloseType::Abort || !transport_socket_->canFlushClose()) {
     if (data_to_write > 0 && type != ConnectionCloseType::Abort) {
       // We aren't going to wait to flush, but try to write as much as we can if there is pending
-      // data.
-      transport_socket_->doWrite(*write_buffer_, true);
+      // data. Spliced data was read before anything in the write buffer, so it goes first.
+      if (splicePipeBytes() == 0 || flushSplicePipe()) {
+        transport_socket_->doWrite(*write_buffer_, true);
+      }
     }
 
     if (type != ConnectionCloseType::FlushWriteAndDelay || !delayed_close_timeout_set) {
@@ -274,6 +279,7 @@ void ConnectionImpl::closeSocket(ConnectionEvent close_type) {
   }
 
   ENVOY_CONN_LOG(debug, "closing socket: {}", *this, static_cast<uint32_t>(close_type));
+  stopSplice();
   transport_socket_->closeSocket(close_type);
 
   // Drain input and output buffers.
@@ -677,15 +683,21 @@ void ConnectionImpl::onReadReady() {
   // reading from the transport if the read buffer is above high watermark at the start of the
   // method.
   transport_wants_read_ = false;
-  IoResult result = transport_socket_->doRead(*read_buffer_);
+  const bool splicing = canSpliceRead();
+  IoResult result = splicing ? doSpliceRead() : transport_socket_->doRead(*read_buffer_);
   uint64_t new_buffer_size = read_buffer_->length();
   updateReadBufferStats(result.bytes_processed_, new_buffer_size);
+  // Spliced data never reaches the read buffer, so there is nothing to dispatch for it.
+  const uint64_t bytes_to_dispatch = splicing ? 0 : result.bytes_processed_;
+  if (splicing && result.bytes_processed_ != 0) {
+    spliced_bytes_cb_(result.bytes_processed_);
+  }
 
   // The socket is closed immediately when receiving RST.
   if (result.err_code_.has_value() &&
       result.err_code_ == Api::IoError::IoErrorCode::ConnectionReset) {
     ENVOY_CONN_LOG(trace, "read: rst close from peer", *this);
-    if (result.bytes_processed_ != 0) {
+    if (bytes_to_dispatch != 0) {
       onRead(new_buffer_size);
     }
     setDetectedCloseType(DetectedCloseType::RemoteReset);
@@ -701,7 +713,7 @@ void ConnectionImpl::onReadReady() {
   }
 
   read_end_stream_ |= result.end_stream_read_;
-  if (result.bytes_processed_ != 0 || result.end_stream_read_ ||
+  if (bytes_to_dispatch != 0 || result.end_stream_read_ ||
       (latched_dispatch_buffered_data && read_buffer_->length() > 0)) {
     // Skip onRead if no bytes were processed unless we explicitly want to force onRead for
     // buffered data. For instance, skip onRead if the connection was closed without producing
@@ -760,6 +772,23 @@ void ConnectionImpl::onWriteReady() {
     }
   }
 
+  if (splicePipeBytes() > 0) {
+    // Spliced data was read before anything in the write buffer, so it is written first. The next
+    // write event resumes if the socket fills up.
+    if (!flushSplicePipe()) {
+      return;
+    }
+    if (splice_source_ != nullptr) {
+      // The source stops splicing while the pipe is backed up, let it pick up where it left off.
+      // A source with reads disabled resumes once they are enabled again.
+      if (splice_source_->readEnabled()) {
+        splice_source_->ioHandle().activateFileEvents(Event::FileReadyType::Read);
+      }
+    } else {
+      splice_pipe_.reset();
+    }
+  }
+
   IoResult result = transport_socket_->doWrite(*write_buffer_, write_end_stream_);
   ASSERT(!result.end_stream_read_); // The interface guarantees that only read operations set this.
   uint64_t new_buffer_size = write_buffer_->length();
@@ -843,7 +872,107 @@ void ConnectionImpl::updateWriteBufferStats(uint64_t num_written, uint64_t new_s
 
 bool ConnectionImpl::bothSidesHalfClosed() {
   // If the write_buffer_ is not empty, then the end_stream has not been sent to the transport yet.
-  return read_end_stream_ && write_end_stream_ && write_buffer_->length() == 0;
+  return read_end_stream_ && write_end_stream_ && write_buffer_->length() == 0 &&
+         splicePipeBytes() == 0;
+}
+
+bool ConnectionImpl::startSplice(Connection& target, SplicedBytesCb cb) {
+  auto* target_impl = dynamic_cast<ConnectionImpl*>(&target);
+  if (target_impl == nullptr || target_impl == this || splice_target_ != nullptr ||
+      target_impl->splice_pipe_ != nullptr || !spliceSupported() ||
+      !target_impl->spliceSupported()) {
+    return false;
+  }
+  SplicePipePtr pipe = SplicePipe::create();
+  if (pipe == nullptr) {
+    return false;
+  }
+  ENVOY_CONN_LOG(debug, "splicing to connection {}", *this, target.id());
+  splice_target_ = target_impl;
+  spliced_bytes_cb_ = std::move(cb);
+  target_impl->splice_pipe_ = std::move(pipe);
+  target_impl->splice_source_ = this;
+  return true;
+}
+
+bool ConnectionImpl::spliceSupported() const {
+  // Splicing bypasses the transport socket and all filters but the one that starts it, so it is
+  // only possible if none of them would see different data.
+  return state() == State::Open && !connecting_ && !read_end_stream_ && !write_end_stream_ &&
+         filter_manager_.numReadFilters() <= 1 && filter_manager_.numWriteFilters() == 0 &&
+         typeid(*transport_socket_) == typeid(RawBufferSocket) &&
+         typeid(ioHandle()) == typeid(IoSocketHandleImpl);
+}
+
+bool ConnectionImpl::canSpliceRead() const {
+  // Data that is buffered anywhere along the way must be written before anything read now, so it
+  // has to go through the buffers as well.
+  return splice_target_ != nullptr && read_buffer_->length() == 0 &&
+         splice_target_->splicePipeBytes() == 0 && splice_target_->write_buffer_->length() == 0 &&
+         !splice_target_->write_end_stream_;
+}
+
+IoResult ConnectionImpl::doSpliceRead() {
+  SplicePipe& pipe = *splice_target_->splice_pipe_;
+  const os_fd_t fd = ioHandle().fdDoNotUse();
+  IoResult result{PostIoAction::KeepOpen, 0, false, absl::nullopt};
+  while (true) {
+    const Api::SysCallSizeResult rc = pipe.fill(fd);
+    if (rc.return_value_ > 0) {
+      result.bytes_processed_ += rc.return_value_;
+      if (!splice_target_->flushSplicePipe()) {
+        // The target resumes reading once it has written out the pipe.
+        break;
+      }
+      if (read_buffer_limit_ > 0 && result.bytes_processed_ >= read_buffer_limit_) {
+        // Yield like the transport socket does once the read buffer limit worth of data was read.
+        setTransportSocketIsReadable();
+        break;
+      }
+    } else if (rc.return_value_ == 0) {
+      result.end_stream_read_ = true;
+      break;
+    } else {
+      // The pipe was empty, so EAGAIN means that the socket has no more data.
+      if (rc.errno_ != SOCKET_ERROR_AGAIN) {
+        ENVOY_CONN_LOG(trace, "splice error: {}", *this, errorDetails(rc.errno_));
+        result.action_ = PostIoAction::Close;
+        result.err_code_ = IoSocketError::create(rc.errno_)->getErrorCode();
+      }
+      break;
+    }
+  }
+  return result;
+}
+
+bool ConnectionImpl::flushSplicePipe() {
+  const os_fd_t fd = ioHandle().fdDoNotUse();
+  while (splice_pipe_->bufferedBytes() > 0) {
+    const Api::SysCallSizeResult rc = splice_pipe_->drain(fd);
+    if (rc.return_value_ <= 0) {
+      // The socket is full, or failed in which case the error is picked up by the next socket
+      // event.
+      return false;
+    }
+    updateWriteBufferStats(rc.return_value_, write_buffer_->length());
+  }
+  return true;
+}
+
+void ConnectionImpl::stopSplice() {
+  if (splice_target_ != nullptr) {
+    // The target keeps the pipe to write out what was already spliced.
+    splice_target_->splice_source_ = nullptr;
+    splice_target_ = nullptr;
+    spliced_bytes_cb_ = nullptr;
+  }
+  if (splice_source_ != nullptr) {
+    // Further data read by the source goes through its filters, which see this connection close.
+    splice_source_->splice_target_ = nullptr;
+    splice_source_->spliced_bytes_cb_ = nullptr;
+    splice_source_ = nullptr;
+  }
+  splice_pipe_.reset();
 }
 
 absl::string_view ConnectionImpl::transportFailureReason() const {
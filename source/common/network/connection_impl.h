@@ -12,6 +12,7 @@
 #include "source/common/buffer/watermark_buffer.h"
 #include "source/common/event/libevent.h"
 #include "source/common/network/connection_impl_base.h"
+#include "source/common/network/splice_pipe.h"
 #include "source/common/stream_info/stream_info_impl.h"
 
 #include "absl/types/optional.h"
@@ -110,6 +111,7 @@ public:
   const StreamInfo::StreamInfo& streamInfo() const override { return stream_info_; }
   absl::string_view transportFailureReason() const override;
   bool startSecureTransport() override { return transport_socket_->startSecureTransport(); }
+  bool startSplice(Connection& target, SplicedBytesCb cb) override;
   absl::optional<std::chrono::milliseconds> lastRoundTripTime() const override;
   void configureInitialCongestionWindow(uint64_t bandwidth_bits_per_sec,
                                         std::chrono::microseconds rtt) override;
@@ -218,9 +220,30 @@ private:
   // Set the detected close type for this connection.
   void setDetectedCloseType(DetectedCloseType close_type);
 
+  // Returns true if data can be spliced from or to this connection.
+  bool spliceSupported() const;
+  // Returns true if the next read can be spliced to the target without reordering data.
+  bool canSpliceRead() const;
+  // Splices data from this connection to the target, in place of a transport socket read.
+  IoResult doSpliceRead();
+  // Writes data spliced from the source connection. Returns true once the pipe is empty.
+  bool flushSplicePipe();
+  // Detaches this connection from splicing in both directions.
+  void stopSplice();
+  uint64_t splicePipeBytes() const {
+    return splice_pipe_ != nullptr ? splice_pipe_->bufferedBytes() : 0;
+  }
+
   static std::atomic<uint64_t> next_global_id_;
 
   std::list<BytesSentCb> bytes_sent_callbacks_;
+  // Set while data read from this connection is spliced to the socket of splice_target_.
+  ConnectionImpl* splice_target_{};
+  SplicedBytesCb spliced_bytes_cb_;
+  // Data spliced from splice_source_ which has not been written to the socket yet. The pipe is
+  // owned by the target, so that spliced data is still written after the source closes.
+  SplicePipePtr splice_pipe_;
+  ConnectionImpl* splice_source_{};
   // Should be set with setFailureReason.
   std::string failure_reason_;
   // Tracks the number of times reads have been disabled. If N different components call
@@ -112,6 +112,8 @@ public:
   void onRead();
   FilterStatus onWrite();
   bool startUpstreamSecureTransport();
+  size_t numReadFilters() const { return upstream_filters_.size(); }
+  size_t numWriteFilters() const { return downstream_filters_.size(); }
 
 private:
   struct ActiveReadFilter : public ReadFilterCallbacks, LinkedObject<ActiveReadFilter> {
@@ -14,6 +14,10 @@
 #include "absl/container/fixed_array.h"
 #include "absl/types/optional.h"
 
+#if ENVOY_PLATFORM_ENABLE_ZEROCOPY_SEND
+#include <linux/errqueue.h>
+#endif
+
 using Envoy::Api::SysCallIntResult;
 using Envoy::Api::SysCallSizeResult;
 
@@ -535,6 +539,45 @@ Api::IoCallUint64Result IoSocketHandleImpl::recv(void* buffer, size_t length, in
   return sysCallResultToIoCallResult(result);
 }
 
+Api::IoCallUint64Result
+IoSocketHandleImpl::recvZeroCopyCompletions([[maybe_unused]] const ZeroCopyCompletionCb& cb) {
+#if ENVOY_PLATFORM_ENABLE_ZEROCOPY_SEND
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+  uint64_t num_completions = 0;
+  while (true) {
+    // The extended error may be followed by the offender address, which is unused for zero-copy
+    // notifications but still has to fit.
+    char control[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+    msghdr message{};
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    const Api::SysCallSizeResult result = os_sys_calls.recvmsg(fd_, &message, MSG_ERRQUEUE);
+    if (result.return_value_ < 0) {
+      if (result.errno_ == SOCKET_ERROR_AGAIN) {
+        // The error queue is drained.
+        return {num_completions, Api::IoError::none()};
+      }
+      return sysCallResultToIoCallResult(result);
+    }
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&message); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&message, cmsg)) {
+      if (!(cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) &&
+          !(cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR)) {
+        continue;
+      }
+      sock_extended_err err;
+      memcpy(&err, CMSG_DATA(cmsg), sizeof(err));
+      if (err.ee_errno == 0 && err.ee_origin == SO_EE_ORIGIN_ZEROCOPY) {
+        num_completions++;
+        cb(err.ee_info, err.ee_data, (err.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0);
+      }
+    }
+  }
+#else
+  return {0, IoSocketError::create(SOCKET_ERROR_NOT_SUP)};
+#endif
+}
+
 Api::SysCallIntResult IoSocketHandleImpl::bind(Address::InstanceConstSharedPtr address) {
   return Api::OsSysCallsSingleton::get().bind(fd_, address->sockAddr(), address->sockAddrLen());
 }
@@ -62,6 +62,7 @@ public:
                                    const UdpSaveCmsgConfig& save_cmsg_config,
                                    RecvMsgOutput& output) override;
   Api::IoCallUint64Result recv(void* buffer, size_t length, int flags) override;
+  Api::IoCallUint64Result recvZeroCopyCompletions(const ZeroCopyCompletionCb& cb) override;
 
   Api::SysCallIntResult bind(Address::InstanceConstSharedPtr address) override;
   Api::SysCallIntResult listen(int backlog) override;
@@ -12,6 +12,7 @@
 #include "source/common/network/io_socket_error_impl.h"
 #include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/network/socket_interface_impl.h"
+#include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
 namespace Network {
@@ -46,6 +47,12 @@ IoUringSocketHandleImpl::~IoUringSocketHandleImpl() {
       io_uring_socket_.ref().close(false);
     }
   } else {
+    // The accept socket doesn't own the listening file descriptor, stop it before closing the fd.
+    if (io_uring_socket_type_ == IoUringSocketType::Accept &&
+        io_uring_worker_factory_.currentThreadRegistered() && io_uring_socket_.has_value() &&
+        io_uring_socket_->getStatus() != Io::IoUringSocketStatus::Closed) {
+      io_uring_socket_.ref().close(true);
+    }
     // The TLS slot has been shut down by this moment with io_uring wiped out, thus use the
     // POSIX system call instead of IoUringSocketHandleImpl::close().
     ::close(fd_);
@@ -62,6 +69,11 @@ Api::IoCallUint64Result IoUringSocketHandleImpl::close() {
     if (file_event_) {
       file_event_.reset();
     }
+    // The accept socket doesn't own the listening file descriptor.
+    if (io_uring_socket_.has_value()) {
+      io_uring_socket_.ref().close(true);
+      io_uring_socket_.reset();
+    }
     ::close(fd_);
   } else {
     io_uring_socket_.ref().close(false);
@@ -165,6 +177,12 @@ Api::IoCallUint64Result IoUringSocketHandleImpl::recv(void* buffer, size_t lengt
   return copyOut(length, &slice, 1);
 }
 
+Api::IoCallUint64Result
+IoUringSocketHandleImpl::recvZeroCopyCompletions(const ZeroCopyCompletionCb&) {
+  // Writes go through the io_uring worker, which does not send with MSG_ZEROCOPY.
+  return {0, Network::IoSocketError::create(SOCKET_ERROR_NOT_SUP)};
+}
+
 Api::SysCallIntResult IoUringSocketHandleImpl::bind(Address::InstanceConstSharedPtr address) {
   ENVOY_LOG(trace, "bind {}, fd = {}, io_uring_socket_type = {}", address->asString(), fd_,
             ioUringSocketTypeStr());
@@ -186,6 +204,23 @@ IoHandlePtr IoUringSocketHandleImpl::accept(struct sockaddr* addr, socklen_t* ad
 
   ASSERT(io_uring_socket_type_ == IoUringSocketType::Accept);
 
+  if (io_uring_socket_.has_value()) {
+    const os_fd_t fd = io_uring_socket_->popAcceptedFd();
+    if (SOCKET_INVALID(fd)) {
+      return nullptr;
+    }
+    // Multishot accept doesn't report the peer address.
+    Api::SysCallIntResult result = Api::OsSysCallsSingleton::get().getpeername(fd, addr, addrlen);
+    if (result.return_value_ != 0) {
+      ENVOY_LOG(debug, "getpeername failed for accepted fd = {}: {}", fd,
+                errorDetails(result.errno_));
+      ::close(fd);
+      return nullptr;
+    }
+    return std::make_unique<IoUringSocketHandleImpl>(io_uring_worker_factory_, fd, socket_v6only_,
+                                                     domain_, true);
+  }
+
   Envoy::Api::SysCallSocketResult result =
       Api::OsSysCallsSingleton::get().accept(fd_, addr, addrlen);
   if (SOCKET_INVALID(result.return_value_)) {
@@ -277,6 +312,15 @@ void IoUringSocketHandleImpl::initializeFileEvent(Event::Dispatcher& dispatcher,
 
   switch (io_uring_socket_type_) {
   case IoUringSocketType::Accept:
+    // Accept through io_uring if the current thread runs an io_uring worker. The listener still
+    // sees a level triggered read event, and accept() hands out the queued connections.
+    if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.io_uring_multishot_accept") &&
+        io_uring_worker_factory_.currentThreadRegistered() &&
+        io_uring_worker_factory_.getIoUringWorker().has_value()) {
+      ASSERT(&io_uring_worker_factory_.getIoUringWorker()->dispatcher() == &dispatcher);
+      io_uring_socket_ = io_uring_worker_factory_.getIoUringWorker()->addAcceptSocket(fd_, cb);
+      break;
+    }
     file_event_ = dispatcher.createFileEvent(fd_, cb, trigger, events);
     break;
   case IoUringSocketType::Server:
@@ -297,6 +341,12 @@ void IoUringSocketHandleImpl::activateFileEvents(uint32_t events) {
             ioUringSocketTypeStr());
 
   if (io_uring_socket_type_ == IoUringSocketType::Accept) {
+    if (io_uring_socket_.has_value()) {
+      if (events & Event::FileReadyType::Read) {
+        io_uring_socket_->injectCompletion(Io::Request::RequestType::Accept);
+      }
+      return;
+    }
     ASSERT(file_event_ != nullptr);
     file_event_->activate(events);
     return;
@@ -315,6 +365,14 @@ void IoUringSocketHandleImpl::enableFileEvents(uint32_t events) {
             ioUringSocketTypeStr());
 
   if (io_uring_socket_type_ == IoUringSocketType::Accept) {
+    if (io_uring_socket_.has_value()) {
+      if (events & Event::FileReadyType::Read) {
+        io_uring_socket_->enableRead();
+      } else {
+        io_uring_socket_->disableRead();
+      }
+      return;
+    }
     ASSERT(file_event_ != nullptr);
     file_event_->setEnabled(events);
     return;
@@ -333,6 +391,10 @@ void IoUringSocketHandleImpl::resetFileEvents() {
 
   if (io_uring_socket_type_ == IoUringSocketType::Accept) {
     file_event_.reset();
+    if (io_uring_socket_.has_value()) {
+      io_uring_socket_.ref().close(true);
+      io_uring_socket_.reset();
+    }
     return;
   }
 
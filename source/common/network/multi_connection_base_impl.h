@@ -95,6 +95,8 @@ public:
   void setDelayedCloseTimeout(std::chrono::milliseconds timeout) override;
   void setBufferLimits(uint32_t limit) override;
   bool startSecureTransport() override;
+  // Splicing is not supported while the wrapped connection may still change.
+  bool startSplice(Connection&, SplicedBytesCb) override { return false; }
   absl::optional<std::chrono::milliseconds> lastRoundTripTime() const override;
   void configureInitialCongestionWindow(uint64_t, std::chrono::microseconds) override {}
   absl::optional<uint64_t> congestionWindowInBytes() const override;
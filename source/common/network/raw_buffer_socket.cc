@@ -1,19 +1,142 @@
 #include "source/common/network/raw_buffer_socket.h"
 
-#include "source/common/api/os_sys_calls_impl.h"
+#include "envoy/common/platform.h"
+
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/empty_string.h"
+#include "source/common/common/utility.h"
 #include "source/common/http/headers.h"
 
 namespace Envoy {
 namespace Network {
 
+namespace {
+
+// How long zero-copy sends may stay in flight after their socket closes. This is far longer than a
+// responsive peer takes to acknowledge what is left in the socket send buffer.
+constexpr std::chrono::seconds ZeroCopyLingerTimeout{60};
+
+} // namespace
+
+void ZeroCopySendQueue::pin(Buffer::Instance& buffer, uint64_t length) {
+  ASSERT(length <= buffer.length());
+  // Every send call that queues data gets the next id, so ids are assigned in order here.
+  Send& send = sends_.emplace_back();
+  send.id_ = next_id_++;
+  while (length > 0) {
+    const Buffer::RawSlice front = buffer.frontSlice();
+    auto pinned = std::make_unique<Buffer::OwnedImpl>();
+    if (front.len_ <= length) {
+      pinned->move(buffer, front.len_);
+      length -= front.len_;
+    } else {
+      // The kernel references the sent head of this slice, so the whole slice is pinned and its
+      // unsent tail is copied back to the front of the buffer.
+      Buffer::OwnedImpl tail(static_cast<const uint8_t*>(front.mem_) + length,
+                             front.len_ - length);
+      pinned->move(buffer, front.len_);
+      buffer.prepend(tail);
+      length = 0;
+    }
+    send.slices_.push_back(std::move(pinned));
+  }
+}
+
+void ZeroCopySendQueue::complete(uint32_t first_id, uint32_t last_id) {
+  const uint32_t count = last_id - first_id + 1;
+  for (Send& send : sends_) {
+    if (send.id_ - first_id < count) {
+      send.completed_ = true;
+    }
+  }
+  // pin() moves every sent slice into exactly one send, so any completed send could be released.
+  // Completions almost always arrive in order though, so the queue is only popped from the front,
+  // and a send that completes early is released together with the ones before it.
+  while (!sends_.empty() && sends_.front().completed_) {
+    sends_.pop_front();
+  }
+}
+
+ZeroCopyLingeringSends::~ZeroCopyLingeringSends() {
+  for (LingeringSocketPtr& socket : sockets_) {
+    closeSocket(*socket, true);
+  }
+}
+
+void ZeroCopyLingeringSends::add(IoHandlePtr&& io_handle, ZeroCopySendQueue&& sends) {
+  auto socket = std::make_unique<LingeringSocket>(std::move(io_handle), std::move(sends));
+  LingeringSocket& lingering = *socket;
+  // The duplicate keeps the socket open once the connection closes its descriptor, so the FIN is
+  // sent from here instead.
+  lingering.io_handle_->shutdown(ENVOY_SHUT_WR);
+  // Completions wake the socket up like an error, which is reported as a read event.
+  lingering.io_handle_->initializeFileEvent(
+      dispatcher_,
+      [this, &lingering](uint32_t) {
+        onCompletions(lingering);
+        return absl::OkStatus();
+      },
+      Event::PlatformDefaultTriggerType, Event::FileReadyType::Read);
+  lingering.timeout_timer_ = dispatcher_.createTimer([this, &lingering]() {
+    ENVOY_LOG_MISC(debug, "resetting socket with zero-copy sends in flight after {}ms",
+                   timeout_.count());
+    release(lingering, true);
+  });
+  lingering.timeout_timer_->enableTimer(timeout_);
+  LinkedList::moveIntoList(std::move(socket), sockets_);
+  // Completions which arrived after the connection last read them have not woken anything up.
+  onCompletions(lingering);
+}
+
+void ZeroCopyLingeringSends::onCompletions(LingeringSocket& socket) {
+  const Api::IoCallUint64Result result = socket.io_handle_->recvZeroCopyCompletions(
+      [&socket](uint32_t first_id, uint32_t last_id, bool) {
+        socket.sends_.complete(first_id, last_id);
+      });
+  if (!result.ok()) {
+    release(socket, true);
+  } else if (socket.sends_.empty()) {
+    release(socket, false);
+  }
+}
+
+void ZeroCopyLingeringSends::release(LingeringSocket& socket, bool reset) {
+  closeSocket(socket, reset);
+  // This may run from the socket's own file event or timer, so deletion is deferred.
+  dispatcher_.deferredDelete(socket.removeFromList(sockets_));
+}
+
+void ZeroCopyLingeringSends::closeSocket(LingeringSocket& socket, bool reset) {
+  socket.timeout_timer_->disableTimer();
+  if (reset) {
+    // Resetting the connection stops the kernel transmitting from the pinned slices, so they can be
+    // released before their completions arrive.
+    const struct linger so_linger = {1, 0};
+    socket.io_handle_->setOption(SOL_SOCKET, SO_LINGER, &so_linger, sizeof(so_linger));
+  }
+  socket.io_handle_->close();
+}
+
+RawBufferSocketZeroCopyConfig::RawBufferSocketZeroCopyConfig(uint64_t threshold,
+                                                             Stats::Scope& scope,
+                                                             ThreadLocal::SlotAllocator& tls)
+    : threshold_(threshold),
+      stats_{ALL_RAW_BUFFER_SOCKET_STATS(POOL_COUNTER_PREFIX(scope, "raw_buffer_socket."))},
+      lingering_sends_(ThreadLocal::TypedSlot<ZeroCopyLingeringSends>::makeUnique(tls)) {
+  lingering_sends_->set([](Event::Dispatcher& dispatcher) {
+    return std::make_shared<ZeroCopyLingeringSends>(dispatcher, ZeroCopyLingerTimeout);
+  });
+}
+
 void RawBufferSocket::setTransportSocketCallbacks(TransportSocketCallbacks& callbacks) {
   ASSERT(!callbacks_);
   callbacks_ = &callbacks;
 }
 
 IoResult RawBufferSocket::doRead(Buffer::Instance& buffer) {
+  // Zero-copy completions wake the socket up like an error, which surfaces as a read event.
+  reapZeroCopyCompletions();
   PostIoAction action = PostIoAction::KeepOpen;
   uint64_t bytes_read = 0;
   bool end_stream = false;
@@ -53,6 +176,7 @@ IoResult RawBufferSocket::doWrite(Buffer::Instance& buffer, bool end_stream) {
   uint64_t bytes_written = 0;
   absl::optional<Api::IoError::IoErrorCode> err = absl::nullopt;
   ASSERT(!shutdown_ || buffer.length() == 0);
+  reapZeroCopyCompletions();
   do {
     if (buffer.length() == 0) {
       if (end_stream && !shutdown_) {
@@ -64,7 +188,9 @@ IoResult RawBufferSocket::doWrite(Buffer::Instance& buffer, bool end_stream) {
       action = PostIoAction::KeepOpen;
       break;
     }
-    Api::IoCallUint64Result result = callbacks_->ioHandle().write(buffer);
+    Api::IoCallUint64Result result = shouldWriteZeroCopy(buffer)
+                                         ? writeZeroCopy(buffer)
+                                         : callbacks_->ioHandle().write(buffer);
 
     if (result.ok()) {
       ENVOY_CONN_LOG(trace, "write returns: {}", callbacks_->connection(), result.return_value_);
@@ -85,6 +211,109 @@ IoResult RawBufferSocket::doWrite(Buffer::Instance& buffer, bool end_stream) {
   return {action, bytes_written, false, err};
 }
 
+void RawBufferSocket::closeSocket(Network::ConnectionEvent) {
+  reapZeroCopyCompletions();
+  if (zerocopy_sends_.empty()) {
+    return;
+  }
+  const DetectedCloseType close_type = callbacks_->connection().detectedCloseType();
+  if (close_type == DetectedCloseType::LocalReset ||
+      close_type == DetectedCloseType::RemoteReset) {
+    // The connection is reset as its socket closes, which stops the kernel transmitting from the
+    // pinned slices.
+    return;
+  }
+  // The kernel keeps transmitting from the pinned slices until the peer acknowledges the data,
+  // which may be well after the connection is gone.
+  (*zerocopy_config_->lingering_sends_)
+      ->add(callbacks_->ioHandle().duplicate(), std::move(zerocopy_sends_));
+}
+
+bool RawBufferSocket::shouldWriteZeroCopy(const Buffer::Instance& buffer) {
+  if (zerocopy_config_ == nullptr || buffer.length() < zerocopy_config_->threshold_) {
+    return false;
+  }
+  if (zerocopy_state_ == ZeroCopyState::Unknown) {
+#if ENVOY_PLATFORM_ENABLE_ZEROCOPY_SEND
+    // Handles which do not write to the socket directly, e.g. io_uring ones, have no completions
+    // to read. The error queue is still empty, so this reads nothing otherwise.
+    const Api::IoCallUint64Result probe =
+        callbacks_->ioHandle().recvZeroCopyCompletions([](uint32_t, uint32_t, bool) {});
+    // SO_ZEROCOPY is only set once a write is large enough, so that connections which never send
+    // large writes do not pay for error queue polling.
+    const int enable = 1;
+    const Api::SysCallIntResult result =
+        !probe.ok() && probe.err_->getErrorCode() == Api::IoError::IoErrorCode::NoSupport
+            ? Api::SysCallIntResult{-1, SOCKET_ERROR_NOT_SUP}
+            : callbacks_->ioHandle().setOption(SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable));
+    if (result.return_value_ == 0) {
+      zerocopy_state_ = ZeroCopyState::Enabled;
+    } else {
+      ENVOY_CONN_LOG(debug, "zero-copy send unavailable: {}", callbacks_->connection(),
+                     errorDetails(result.errno_));
+      zerocopy_state_ = ZeroCopyState::Disabled;
+    }
+#else
+    zerocopy_state_ = ZeroCopyState::Disabled;
+#endif
+  }
+  if (zerocopy_state_ == ZeroCopyState::Enabled) {
+    return true;
+  }
+  zerocopy_config_->stats_.zerocopy_fallback_.inc();
+  return false;
+}
+
+Api::IoCallUint64Result RawBufferSocket::writeZeroCopy(Buffer::Instance& buffer) {
+#if ENVOY_PLATFORM_ENABLE_ZEROCOPY_SEND
+  constexpr uint64_t MaxSlices = 16;
+  const Buffer::RawSliceVector slices = buffer.getRawSlices(MaxSlices);
+  // The peer address is ignored for connected stream sockets.
+  Api::IoCallUint64Result result = callbacks_->ioHandle().sendmsg(
+      slices.data(), slices.size(), MSG_ZEROCOPY, nullptr,
+      *callbacks_->connection().connectionInfoProvider().remoteAddress());
+  if (result.ok()) {
+    if (result.return_value_ > 0) {
+      zerocopy_config_->stats_.zerocopy_send_.inc();
+      zerocopy_sends_.pin(buffer, result.return_value_);
+    }
+    return result;
+  }
+  if (result.err_->getSystemErrorCode() == ENOBUFS) {
+    // The pinned sends exhausted the socket's option memory, copy until completions free it up.
+    zerocopy_config_->stats_.zerocopy_fallback_.inc();
+    return callbacks_->ioHandle().write(buffer);
+  }
+  return result;
+#else
+  return callbacks_->ioHandle().write(buffer);
+#endif
+}
+
+void RawBufferSocket::reapZeroCopyCompletions() {
+  if (zerocopy_sends_.empty()) {
+    return;
+  }
+  const Api::IoCallUint64Result result = callbacks_->ioHandle().recvZeroCopyCompletions(
+      [this](uint32_t first_id, uint32_t last_id, bool copied) {
+        onZeroCopyCompletion(first_id, last_id, copied);
+      });
+  if (!result.ok()) {
+    ENVOY_CONN_LOG(debug, "reading zero-copy completions failed: {}", callbacks_->connection(),
+                   result.err_->getErrorDetails());
+  }
+}
+
+void RawBufferSocket::onZeroCopyCompletion(uint32_t first_id, uint32_t last_id, bool copied) {
+  zerocopy_sends_.complete(first_id, last_id);
+  if (copied) {
+    // The kernel had to copy anyway, e.g. over loopback or a device without scatter-gather
+    // support. Pinning then only adds overhead, so the socket goes back to plain writes.
+    zerocopy_config_->stats_.zerocopy_copied_.add(last_id - first_id + 1);
+    zerocopy_state_ = ZeroCopyState::Disabled;
+  }
+}
+
 std::string RawBufferSocket::protocol() const { return EMPTY_STRING; }
 absl::string_view RawBufferSocket::failureReason() const { return EMPTY_STRING; }
 
@@ -93,11 +322,11 @@ void RawBufferSocket::onConnected() { callbacks_->raiseEvent(ConnectionEvent::Co
 TransportSocketPtr
 RawBufferSocketFactory::createTransportSocket(TransportSocketOptionsConstSharedPtr,
                                               Upstream::HostDescriptionConstSharedPtr) const {
-  return std::make_unique<RawBufferSocket>();
+  return std::make_unique<RawBufferSocket>(zerocopy_config_);
 }
 
 TransportSocketPtr RawBufferSocketFactory::createDownstreamTransportSocket() const {
-  return std::make_unique<RawBufferSocket>();
+  return std::make_unique<RawBufferSocket>(zerocopy_config_);
 }
 
 bool RawBufferSocketFactory::implementsSecureTransport() const { return false; }
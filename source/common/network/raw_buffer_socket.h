@@ -1,23 +1,147 @@
 #pragma once
 
+#include <chrono>
+#include <deque>
+#include <list>
+#include <memory>
+#include <vector>
+
 #include "envoy/buffer/buffer.h"
+#include "envoy/event/deferred_deletable.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
 #include "envoy/network/connection.h"
 #include "envoy/network/transport_socket.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+#include "envoy/thread_local/thread_local.h"
 
+#include "source/common/common/linked_object.h"
 #include "source/common/common/logger.h"
 #include "source/common/network/transport_socket_options_impl.h"
 
 namespace Envoy {
 namespace Network {
 
+/**
+ * All raw buffer socket stats. @see stats_macros.h
+ */
+#define ALL_RAW_BUFFER_SOCKET_STATS(COUNTER)                                                       \
+  COUNTER(zerocopy_send)                                                                           \
+  COUNTER(zerocopy_copied)                                                                         \
+  COUNTER(zerocopy_fallback)
+
+/**
+ * Struct definition for all raw buffer socket stats. @see stats_macros.h
+ */
+struct RawBufferSocketStats {
+  ALL_RAW_BUFFER_SOCKET_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+/**
+ * Writes sent with MSG_ZEROCOPY on one socket. The kernel transmits straight from the buffer
+ * memory, so the slices are pinned until the completion notification with the send's id is read
+ * from the socket error queue.
+ */
+class ZeroCopySendQueue {
+public:
+  /**
+   * Moves the first bytes of the buffer, which were just sent, into a new send.
+   * @param buffer supplies the buffer the send was made from.
+   * @param length supplies the number of bytes the kernel accepted.
+   */
+  void pin(Buffer::Instance& buffer, uint64_t length);
+
+  /**
+   * Marks the sends in [first_id, last_id] complete and releases the ones no longer referenced by
+   * the kernel. Ids wrap around.
+   */
+  void complete(uint32_t first_id, uint32_t last_id);
+
+  bool empty() const { return sends_.empty(); }
+
+private:
+  struct Send {
+    uint32_t id_;
+    bool completed_{};
+    // One buffer per slice, so that moving a slice in never coalesces it into another one.
+    std::vector<Buffer::InstancePtr> slices_;
+  };
+
+  // The id the kernel assigns to the next successful MSG_ZEROCOPY send.
+  uint32_t next_id_{};
+  std::deque<Send> sends_;
+};
+
+/**
+ * Per-worker owner of zero-copy sends which were still in flight when their socket closed. The
+ * kernel keeps transmitting from the pinned slices until the peer acknowledges the data, so each
+ * queue is held along with a duplicate of its socket, which keeps the error queue readable, until
+ * its last completion arrives. Sockets which do not finish within the timeout are reset, which
+ * stops the transmission, before their slices are released.
+ */
+class ZeroCopyLingeringSends : public ThreadLocal::ThreadLocalObject {
+public:
+  ZeroCopyLingeringSends(Event::Dispatcher& dispatcher, std::chrono::milliseconds timeout)
+      : dispatcher_(dispatcher), timeout_(timeout) {}
+  ~ZeroCopyLingeringSends() override;
+
+  /**
+   * Takes over the in-flight sends of a closing socket.
+   * @param io_handle supplies a duplicate of the socket the sends were made on.
+   * @param sends supplies the sends which have not completed yet.
+   */
+  void add(IoHandlePtr&& io_handle, ZeroCopySendQueue&& sends);
+
+  size_t size() const { return sockets_.size(); }
+
+private:
+  struct LingeringSocket : public LinkedObject<LingeringSocket>, public Event::DeferredDeletable {
+    LingeringSocket(IoHandlePtr&& io_handle, ZeroCopySendQueue&& sends)
+        : io_handle_(std::move(io_handle)), sends_(std::move(sends)) {}
+
+    IoHandlePtr io_handle_;
+    ZeroCopySendQueue sends_;
+    Event::TimerPtr timeout_timer_;
+  };
+  using LingeringSocketPtr = std::unique_ptr<LingeringSocket>;
+
+  void onCompletions(LingeringSocket& socket);
+  void release(LingeringSocket& socket, bool reset);
+  static void closeSocket(LingeringSocket& socket, bool reset);
+
+  Event::Dispatcher& dispatcher_;
+  const std::chrono::milliseconds timeout_;
+  std::list<LingeringSocketPtr> sockets_;
+};
+
+/**
+ * Zero-copy transmit settings shared by all sockets created by a RawBufferSocketFactory.
+ */
+struct RawBufferSocketZeroCopyConfig {
+  RawBufferSocketZeroCopyConfig(uint64_t threshold, Stats::Scope& scope,
+                                ThreadLocal::SlotAllocator& tls);
+
+  // Writes are sent with MSG_ZEROCOPY while at least this many bytes are buffered.
+  const uint64_t threshold_;
+  RawBufferSocketStats stats_;
+  ThreadLocal::TypedSlotPtr<ZeroCopyLingeringSends> lingering_sends_;
+};
+
+using RawBufferSocketZeroCopyConfigSharedPtr = std::shared_ptr<RawBufferSocketZeroCopyConfig>;
+
 class RawBufferSocket : public TransportSocket, protected Logger::Loggable<Logger::Id::connection> {
 public:
+  RawBufferSocket() = default;
+  explicit RawBufferSocket(RawBufferSocketZeroCopyConfigSharedPtr zerocopy_config)
+      : zerocopy_config_(std::move(zerocopy_config)) {}
+
   // Network::TransportSocket
   void setTransportSocketCallbacks(TransportSocketCallbacks& callbacks) override;
   std::string protocol() const override;
   absl::string_view failureReason() const override;
   bool canFlushClose() override { return true; }
-  void closeSocket(Network::ConnectionEvent) override {}
+  void closeSocket(Network::ConnectionEvent) override;
   void onConnected() override;
   IoResult doRead(Buffer::Instance& buffer) override;
   IoResult doWrite(Buffer::Instance& buffer, bool end_stream) override;
@@ -29,13 +153,27 @@ protected:
   TransportSocketCallbacks* transportSocketCallbacks() const { return callbacks_; };
 
 private:
+  enum class ZeroCopyState { Unknown, Enabled, Disabled };
+
+  bool shouldWriteZeroCopy(const Buffer::Instance& buffer);
+  Api::IoCallUint64Result writeZeroCopy(Buffer::Instance& buffer);
+  void reapZeroCopyCompletions();
+  void onZeroCopyCompletion(uint32_t first_id, uint32_t last_id, bool copied);
+
   bool shutdown_{};
   TransportSocketCallbacks* callbacks_{};
+  const RawBufferSocketZeroCopyConfigSharedPtr zerocopy_config_;
+  ZeroCopyState zerocopy_state_{ZeroCopyState::Unknown};
+  ZeroCopySendQueue zerocopy_sends_;
 };
 
 class RawBufferSocketFactory : public DownstreamTransportSocketFactory,
                                public CommonUpstreamTransportSocketFactory {
 public:
+  RawBufferSocketFactory() = default;
+  explicit RawBufferSocketFactory(RawBufferSocketZeroCopyConfigSharedPtr zerocopy_config)
+      : zerocopy_config_(std::move(zerocopy_config)) {}
+
   // Network::UpstreamTransportSocketFactory
   TransportSocketPtr createTransportSocket(TransportSocketOptionsConstSharedPtr,
                                            Upstream::HostDescriptionConstSharedPtr) const override;
@@ -43,6 +181,9 @@ public:
   absl::string_view defaultServerNameIndication() const override { return ""; }
   // Network::DownstreamTransportSocketFactory
   TransportSocketPtr createDownstreamTransportSocket() const override;
+
+private:
+  const RawBufferSocketZeroCopyConfigSharedPtr zerocopy_config_;
 };
 
 } // namespace Network
@@ -0,0 +1,67 @@
+#include "source/common/network/splice_pipe.h"
+
+#include "source/common/common/assert.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/api/os_sys_calls_impl_linux.h"
+#endif
+
+namespace Envoy {
+namespace Network {
+
+#if defined(__linux__)
+namespace {
+
+// The default pipe capacity on Linux. Asking for more than the pipe holds is harmless, splice()
+// moves what fits.
+constexpr size_t PipeCapacity = 64 * 1024;
+
+} // namespace
+
+SplicePipe::~SplicePipe() {
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+  os_sys_calls.close(read_fd_);
+  os_sys_calls.close(write_fd_);
+}
+
+SplicePipePtr SplicePipe::create() {
+  int fds[2];
+  if (Api::LinuxOsSysCallsSingleton::get().pipe2(fds, O_NONBLOCK | O_CLOEXEC).return_value_ != 0) {
+    return nullptr;
+  }
+  return SplicePipePtr{new SplicePipe(fds[0], fds[1])};
+}
+
+Api::SysCallSizeResult SplicePipe::fill(os_fd_t fd) {
+  const Api::SysCallSizeResult result = Api::LinuxOsSysCallsSingleton::get().splice(
+      fd, write_fd_, PipeCapacity, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+  if (result.return_value_ > 0) {
+    buffered_bytes_ += result.return_value_;
+  }
+  return result;
+}
+
+Api::SysCallSizeResult SplicePipe::drain(os_fd_t fd) {
+  ASSERT(buffered_bytes_ > 0);
+  const Api::SysCallSizeResult result = Api::LinuxOsSysCallsSingleton::get().splice(
+      read_fd_, fd, buffered_bytes_, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+  if (result.return_value_ > 0) {
+    buffered_bytes_ -= result.return_value_;
+  }
+  return result;
+}
+#else
+SplicePipe::~SplicePipe() = default;
+
+SplicePipePtr SplicePipe::create() { return nullptr; }
+
+Api::SysCallSizeResult SplicePipe::fill(os_fd_t) { PANIC("not implemented"); }
+
+Api::SysCallSizeResult SplicePipe::drain(os_fd_t) { PANIC("not implemented"); }
+#endif
+
+} // namespace Network
+} // namespace Envoy
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "envoy/api/os_sys_calls_common.h"
+#include "envoy/common/platform.h"
+
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+namespace Network {
+
+class SplicePipe;
+using SplicePipePtr = std::unique_ptr<SplicePipe>;
+
+/**
+ * A kernel pipe through which data is moved from one socket to another with splice(2), so that it
+ * is never copied into user space. Only supported on Linux.
+ */
+class SplicePipe : NonCopyable {
+public:
+  ~SplicePipe();
+
+  /**
+   * @return a new pipe, or nullptr if splicing is not supported on this platform or the pipe could
+   *         not be created.
+   */
+  static SplicePipePtr create();
+
+  /**
+   * Moves as much data as the pipe can take from the socket `fd` into the pipe.
+   * @return the number of bytes moved, 0 once the peer has shut down its side of the socket, or
+   *         the error. EAGAIN means that either the socket has no data or the pipe is full.
+   */
+  Api::SysCallSizeResult fill(os_fd_t fd);
+
+  /**
+   * Moves data buffered in the pipe to the socket `fd`.
+   * @return the number of bytes moved or the error.
+   */
+  Api::SysCallSizeResult drain(os_fd_t fd);
+
+  /**
+   * @return the number of bytes buffered in the pipe.
+   */
+  uint64_t bufferedBytes() const { return buffered_bytes_; }
+
+private:
+  SplicePipe(int read_fd, int write_fd) : read_fd_(read_fd), write_fd_(write_fd) {}
+
+  const int read_fd_;
+  const int write_fd_;
+  uint64_t buffered_bytes_{};
+};
+
+} // namespace Network
+} // namespace Envoy
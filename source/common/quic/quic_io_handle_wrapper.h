@@ -84,6 +84,13 @@ public:
     }
     return io_handle_.recv(buffer, length, flags);
   }
+  Api::IoCallUint64Result recvZeroCopyCompletions(const ZeroCopyCompletionCb& cb) override {
+    if (closed_) {
+      ASSERT(false, "recvZeroCopyCompletions called after close.");
+      return {0, Network::IoSocketError::getIoSocketEbadfError()};
+    }
+    return io_handle_.recvZeroCopyCompletions(cb);
+  }
   bool supportsMmsg() const override { return io_handle_.supportsMmsg(); }
   bool supportsUdpGro() const override { return io_handle_.supportsUdpGro(); }
   Api::SysCallIntResult bind(Network::Address::InstanceConstSharedPtr address) override {
@@ -2030,7 +2030,97 @@ VirtualHostImpl::VirtualHostImpl(
       SET_AND_RETURN_IF_NOT_OK(route_or_error.status(), creation_status);
       routes_.emplace_back(route_or_error.value());
     }
+    if (routes_.size() >= MinRoutesForRouteIndex &&
+        Runtime::runtimeFeatureEnabled("envoy.reloadable_features.compiled_route_index")) {
+      route_index_ = std::make_unique<const RouteIndex>(
+          routes_,
+          shared_virtual_host_->globalRouteConfig().ignorePathParametersInPathMatching());
+    }
+  }
+}
+
+VirtualHostImpl::RouteIndex::RouteIndex(absl::Span<const RouteEntryImplBaseConstSharedPtr> routes,
+                                        bool ignore_path_parameters)
+    : ignore_path_parameters_(ignore_path_parameters) {
+  // Split the routes into runs of indexable and non-indexable routes. Indexable runs which are
+  // too short to benefit from the trie are merged into the surrounding linear segments.
+  uint32_t begin = 0;
+  while (begin < routes.size()) {
+    const bool indexed = RouteIndex::indexable(*routes[begin]);
+    uint32_t end = begin + 1;
+    while (end < routes.size() && RouteIndex::indexable(*routes[end]) == indexed) {
+      ++end;
+    }
+    const bool use_index = indexed && end - begin >= MinRoutesForRouteIndex;
+    if (!segments_.empty() && !segments_.back().indexed_ && !use_index) {
+      segments_.back().end_ = end;
+    } else {
+      segments_.push_back({begin, end, use_index});
+    }
+    begin = end;
+  }
+
+  for (const Segment& segment : segments_) {
+    if (!segment.indexed_) {
+      continue;
+    }
+    for (uint32_t i = segment.begin_; i < segment.end_; ++i) {
+      const RouteEntryImplBase& route = *routes[i];
+      auto [it, inserted] = entries_.try_emplace(route.matcher());
+      PathEntry& entry = it->second;
+      if (inserted) {
+        trie_.add(route.matcher(), &entry);
+      }
+      switch (route.matchType()) {
+      case PathMatchType::Exact:
+        entry.exact_.push_back(i);
+        break;
+      case PathMatchType::Prefix:
+        entry.prefix_.push_back(i);
+        break;
+      case PathMatchType::PathSeparatedPrefix:
+        entry.path_separated_prefix_.push_back(i);
+        break;
+      default:
+        PANIC("unexpected route type in route index");
+      }
+    }
+  }
+}
+
+bool VirtualHostImpl::RouteIndex::indexable(const RouteEntryImplBase& route) {
+  if (!route.case_sensitive()) {
+    return false;
+  }
+  switch (route.matchType()) {
+  case PathMatchType::Exact:
+  case PathMatchType::Prefix:
+  case PathMatchType::PathSeparatedPrefix:
+    return true;
+  default:
+    return false;
+  }
+}
+
+void VirtualHostImpl::RouteIndex::findCandidates(
+    absl::string_view path, absl::InlinedVector<uint32_t, 8>& candidates) const {
+  // Mirror the path normalization done by the route entries before path matching.
+  if (ignore_path_parameters_) {
+    path = path.substr(0, path.find(';'));
   }
+  path = Http::PathUtil::removeQueryAndFragment(path);
+
+  trie_.forEachPrefix(path, [&](size_t length, const PathEntry* entry) {
+    candidates.insert(candidates.end(), entry->prefix_.begin(), entry->prefix_.end());
+    if (length == path.size()) {
+      candidates.insert(candidates.end(), entry->exact_.begin(), entry->exact_.end());
+    }
+    if (length == path.size() || path[length] == '/') {
+      candidates.insert(candidates.end(), entry->path_separated_prefix_.begin(),
+                        entry->path_separated_prefix_.end());
+    }
+  });
+  std::sort(candidates.begin(), candidates.end());
 }
 
 const VirtualHost& SslRedirectRoute::virtualHost() const { return *virtual_host_; }
@@ -2040,31 +2130,81 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromRoutes(
     const StreamInfo::StreamInfo& stream_info, uint64_t random_value,
     absl::Span<const RouteEntryImplBaseConstSharedPtr> routes) const {
   for (auto route = routes.begin(); route != routes.end(); ++route) {
-    if (!headers.Path() && !(*route)->supportsPathlessHeaders()) {
-      continue;
+    absl::optional<RouteConstSharedPtr> result = evaluateRoute(
+        cb, **route, headers, stream_info, random_value, std::next(route) == routes.end());
+    if (result.has_value()) {
+      return std::move(result.value());
     }
+  }
 
-    RouteConstSharedPtr route_entry = (*route)->matches(headers, stream_info, random_value);
-    if (route_entry == nullptr) {
-      continue;
-    }
+  ENVOY_LOG(debug, "route was resolved but final route list did not match incoming request");
+  return nullptr;
+}
 
-    if (cb == nullptr) {
-      return route_entry;
-    }
+absl::optional<RouteConstSharedPtr>
+VirtualHostImpl::evaluateRoute(const RouteCallback& cb, const RouteEntryImplBase& route,
+                               const Http::RequestHeaderMap& headers,
+                               const StreamInfo::StreamInfo& stream_info, uint64_t random_value,
+                               bool last_route) const {
+  if (!headers.Path() && !route.supportsPathlessHeaders()) {
+    return absl::nullopt;
+  }
 
-    RouteEvalStatus eval_status = (std::next(route) == routes.end())
-                                      ? RouteEvalStatus::NoMoreRoutes
-                                      : RouteEvalStatus::HasMoreRoutes;
-    RouteMatchStatus match_status = cb(route_entry, eval_status);
-    if (match_status == RouteMatchStatus::Accept) {
-      return route_entry;
+  RouteConstSharedPtr route_entry = route.matches(headers, stream_info, random_value);
+  if (route_entry == nullptr) {
+    return absl::nullopt;
+  }
+
+  if (cb == nullptr) {
+    return route_entry;
+  }
+
+  RouteEvalStatus eval_status =
+      last_route ? RouteEvalStatus::NoMoreRoutes : RouteEvalStatus::HasMoreRoutes;
+  RouteMatchStatus match_status = cb(route_entry, eval_status);
+  if (match_status == RouteMatchStatus::Accept) {
+    return route_entry;
+  }
+  if (match_status == RouteMatchStatus::Continue && eval_status == RouteEvalStatus::NoMoreRoutes) {
+    ENVOY_LOG(debug, "return null when route match status is Continue but there is no more routes");
+    return RouteConstSharedPtr{};
+  }
+  return absl::nullopt;
+}
+
+RouteConstSharedPtr VirtualHostImpl::getRouteFromRouteIndex(
+    const RouteCallback& cb, const Http::RequestHeaderMap& headers,
+    const StreamInfo::StreamInfo& stream_info, uint64_t random_value) const {
+  const size_t last_route = routes_.size() - 1;
+  // The candidates of all indexed segments are found with a single lookup. They are in ascending
+  // order, so each indexed segment continues from where the previous one stopped. Indexed routes
+  // all require a path.
+  absl::InlinedVector<uint32_t, 8> candidates;
+  if (headers.Path()) {
+    route_index_->findCandidates(headers.getPathValue(), candidates);
+  }
+  size_t next_candidate = 0;
+  for (const RouteIndex::Segment& segment : route_index_->segments()) {
+    if (!segment.indexed_) {
+      for (uint32_t i = segment.begin_; i < segment.end_; ++i) {
+        absl::optional<RouteConstSharedPtr> result =
+            evaluateRoute(cb, *routes_[i], headers, stream_info, random_value, i == last_route);
+        if (result.has_value()) {
+          return std::move(result.value());
+        }
+      }
+      continue;
     }
-    if (match_status == RouteMatchStatus::Continue &&
-        eval_status == RouteEvalStatus::NoMoreRoutes) {
-      ENVOY_LOG(debug,
-                "return null when route match status is Continue but there is no more routes");
-      return nullptr;
+
+    for (; next_candidate < candidates.size() && candidates[next_candidate] < segment.end_;
+         ++next_candidate) {
+      const uint32_t i = candidates[next_candidate];
+      ASSERT(i >= segment.begin_);
+      absl::optional<RouteConstSharedPtr> result =
+          evaluateRoute(cb, *routes_[i], headers, stream_info, random_value, i == last_route);
+      if (result.has_value()) {
+        return std::move(result.value());
+      }
     }
   }
 
@@ -2121,6 +2261,9 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb
   }
 
   // Check for a route that matches the request.
+  if (route_index_ != nullptr) {
+    return getRouteFromRouteIndex(cb, headers, stream_info, random_value);
+  }
   return getRouteFromRoutes(cb, headers, stream_info, random_value, routes_);
 }
 
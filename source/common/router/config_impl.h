@@ -23,6 +23,7 @@
 
 #include "source/common/common/matchers.h"
 #include "source/common/common/packed_struct.h"
+#include "source/common/common/trie_lookup_table.h"
 #include "source/common/config/datasource.h"
 #include "source/common/config/metadata.h"
 #include "source/common/http/hash_policy.h"
@@ -35,6 +36,7 @@
 #include "source/common/router/tls_context_match_criteria_impl.h"
 #include "source/common/stats/symbol_table.h"
 
+#include "absl/container/inlined_vector.h"
 #include "absl/container/node_hash_map.h"
 #include "absl/types/optional.h"
 
@@ -410,12 +412,80 @@ public:
 private:
   enum class SslRequirements : uint8_t { None, ExternalOnly, All };
 
+  // Below this number of consecutive indexable routes a linear scan is as cheap as the index.
+  static constexpr uint32_t MinRoutesForRouteIndex = 4;
+
+  /**
+   * Index over the routes of a virtual host, compiled at config load. The route list is split
+   * into segments. Runs of consecutive case sensitive exact, prefix and path separated prefix
+   * routes are indexed by a trie keyed on their path pattern, so that a lookup only evaluates the
+   * routes of the run whose path can match the request. All other routes (regex, template,
+   * CONNECT, case insensitive, and runs too short to be worth indexing) are evaluated linearly
+   * between the indexed runs. Candidates are always evaluated through the route's own matches()
+   * in configuration order, so header, query parameter and runtime matchers as well as first
+   * match wins semantics are preserved.
+   */
+  class RouteIndex {
+  public:
+    RouteIndex(absl::Span<const RouteEntryImplBaseConstSharedPtr> routes,
+               bool ignore_path_parameters);
+
+    struct Segment {
+      // Half open range of route indices covered by the segment.
+      uint32_t begin_;
+      uint32_t end_;
+      // Whether the segment is served by the trie, or evaluated linearly.
+      bool indexed_;
+    };
+
+    const std::vector<Segment>& segments() const { return segments_; }
+
+    /**
+     * Collects the indices of the indexed routes whose path pattern matches the request path.
+     * @param path supplies the value of the :path header.
+     * @param candidates receives the route indices, in ascending order.
+     */
+    void findCandidates(absl::string_view path, absl::InlinedVector<uint32_t, 8>& candidates) const;
+
+    /**
+     * @return whether the route can be served by the index.
+     */
+    static bool indexable(const RouteEntryImplBase& route);
+
+  private:
+    // Routes sharing the same path pattern. Indices are global to the virtual host's route list.
+    struct PathEntry {
+      std::vector<uint32_t> exact_;
+      std::vector<uint32_t> prefix_;
+      std::vector<uint32_t> path_separated_prefix_;
+    };
+
+    std::vector<Segment> segments_;
+    // Owns the entries referenced by the trie. node_hash_map keeps their addresses stable.
+    absl::node_hash_map<std::string, PathEntry> entries_;
+    TrieLookupTable<const PathEntry*> trie_;
+    const bool ignore_path_parameters_;
+  };
+
+  // Evaluates a single route. Returns absl::nullopt if evaluation should continue with the next
+  // route, or the result of the lookup (which may be nullptr) otherwise.
+  absl::optional<RouteConstSharedPtr> evaluateRoute(const RouteCallback& cb,
+                                                    const RouteEntryImplBase& route,
+                                                    const Http::RequestHeaderMap& headers,
+                                                    const StreamInfo::StreamInfo& stream_info,
+                                                    uint64_t random_value, bool last_route) const;
+  RouteConstSharedPtr getRouteFromRouteIndex(const RouteCallback& cb,
+                                             const Http::RequestHeaderMap& headers,
+                                             const StreamInfo::StreamInfo& stream_info,
+                                             uint64_t random_value) const;
+
   CommonVirtualHostSharedPtr shared_virtual_host_;
 
   std::shared_ptr<const SslRedirectRoute> ssl_redirect_route_;
   SslRequirements ssl_requirements_;
 
   std::vector<RouteEntryImplBaseConstSharedPtr> routes_;
+  std::unique_ptr<const RouteIndex> route_index_;
   Matcher::MatchTreeSharedPtr<Http::HttpMatchingData> matcher_;
 };
 
@@ -677,6 +747,7 @@ public:
 
   bool matchRoute(const Http::RequestHeaderMap& headers, const StreamInfo::StreamInfo& stream_info,
                   uint64_t random_value) const;
+  bool case_sensitive() const { return case_sensitive_; }
   absl::Status
   validateClusters(const Upstream::ClusterManager::ClusterInfoMaps& cluster_info_maps) const;
 
@@ -1106,7 +1177,6 @@ protected:
   const std::string host_rewrite_;
   std::unique_ptr<ConnectConfig> connect_config_;
 
-  bool case_sensitive() const { return case_sensitive_; }
   RouteConstSharedPtr clusterEntry(const Http::RequestHeaderMap& headers,
                                    uint64_t random_value) const;
 
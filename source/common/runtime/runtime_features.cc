@@ -34,6 +34,7 @@ RUNTIME_GUARD(envoy_reloadable_features_async_host_selection);
 RUNTIME_GUARD(envoy_reloadable_features_avoid_dfp_cluster_removal_on_cds_update);
 RUNTIME_GUARD(envoy_reloadable_features_boolean_to_string_fix);
 RUNTIME_GUARD(envoy_reloadable_features_check_switch_protocol_websocket_handshake);
+RUNTIME_GUARD(envoy_reloadable_features_compiled_route_index);
 RUNTIME_GUARD(envoy_reloadable_features_consistent_header_validation);
 RUNTIME_GUARD(envoy_reloadable_features_dfp_fail_on_empty_host_header);
 RUNTIME_GUARD(envoy_reloadable_features_disallow_quic_client_udp_mmsg);
@@ -167,6 +168,37 @@ FALSE_RUNTIME_GUARD(envoy_reloadable_features_allow_multiplexed_upstream_half_cl
 // TODO(renjietang): Flip to true after prod testing.
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_use_network_type_socket_option);
 
+// Carves header map list nodes out of pooled contiguous blocks instead of allocating each one.
+// Blocks are only freed with the map, so watch resident memory of proxies with many long lived
+// streams whose headers are rewritten often before enabling.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_header_map_pooled_node_storage);
+// Allocates per-stream HCM and filter manager bookkeeping from an arena released with the stream.
+// Watch per-stream memory with large numbers of filters or long lived streams before enabling, as
+// nothing in the arena is freed before the stream ends.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_http_stream_arena);
+// Keeps freed buffer slice storage in per-thread size class caches for reuse. Watch the
+// server.buffer_slice_cache_* stats and per-worker resident memory before enabling.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_buffer_slice_storage_cache);
+// Accepts on io_uring listeners with one multishot accept instead of one submission per
+// connection. Kernels without multishot accept fall back to the old path; watch accept latency and
+// listener error stats before enabling.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_io_uring_multishot_accept);
+// Reads io_uring sockets with multishot recv into a ring of provided buffers shared by the worker.
+// Watch for reads being throttled when the buffer ring runs dry under load before enabling.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_io_uring_provided_buffers);
+// Moves data between the two connections of a TCP proxy through a kernel pipe with splice(2) when
+// neither side filters or encrypts it. Watch per-connection pipe descriptors against the process
+// file limit before enabling.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_tcp_proxy_splice);
+// Moves record encryption for data sent on eligible TLS 1.2 connections into the kernel. Needs the
+// tls kernel module; watch the kernel_tls_tx_failed and kernel_tls_close_notify_failed TLS stats
+// before enabling.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_tls_kernel_tx_offload);
+// Uses an O(1) interleaved weighted round robin scheduler in the round robin and least request
+// load balancers instead of EDF. Picks are spread differently within a round, so watch upstream
+// load distribution for heavily weighted hosts before enabling.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_lb_iwrr_scheduler);
+
 // Block of non-boolean flags. Use of int flags is deprecated. Do not add more.
 ABSL_FLAG(uint64_t, re2_max_program_size_error_level, 100, ""); // NOLINT
 ABSL_FLAG(uint64_t, re2_max_program_size_warn_level,            // NOLINT
@@ -112,6 +112,10 @@ public:
   }
   uint32_t use_count() const override { return ref_count_; }
 
+  // Clears the changed flag before the stat is read for a flush, so that a concurrent change
+  // marks it again.
+  void clearChanged() { flags_ &= static_cast<uint16_t>(~AllocatorImpl::ChangedFlag); }
+
   /**
    * We must atomically remove the counter/gauges from the allocator's sets when
    * our ref-count decrement hits zero. The counters and gauges are held in
@@ -120,6 +124,22 @@ public:
   virtual void removeFromSetLockHeld() ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc_.mutex_) PURE;
 
 protected:
+  // Sets `flags` and, while the allocator tracks changes to this type of stat, records the first
+  // change since the last forEachChangedSinked*() call. This folds into the atomic update of the
+  // flags that the stat does anyway, so tracking costs nothing on later changes.
+  void setFlagsOnChange(uint16_t flags, const std::atomic<uint16_t>& changed_flag) {
+    const uint16_t changed = changed_flag.load(std::memory_order_relaxed);
+    if (changed == 0) {
+      if (flags != 0) {
+        flags_ |= flags;
+      }
+      return;
+    }
+    if ((flags_.fetch_or(static_cast<uint16_t>(flags | changed)) & changed) == 0) {
+      alloc_.markChanged(static_cast<BaseClass*>(this));
+    }
+  }
+
   AllocatorImpl& alloc_;
 
   // ref_count_ can be incremented as an atomic, without taking a new lock, as
@@ -146,6 +166,8 @@ public:
     const size_t count = alloc_.counters_.erase(statName());
     ASSERT(count == 1);
     alloc_.sinked_counters_.erase(this);
+    Thread::LockGuard changed_lock(alloc_.changed_mutex_);
+    alloc_.changed_counters_.erase(this);
   }
 
   // Stats::Counter
@@ -154,7 +176,7 @@ public:
     // used(). From a system perspective this should be eventually consistent.
     value_ += amount;
     pending_increment_ += amount;
-    flags_ |= Flags::Used;
+    setFlagsOnChange(Flags::Used, alloc_.counter_changed_flag_);
   }
   void inc() override { add(1); }
   uint64_t latch() override { return pending_increment_.exchange(0); }
@@ -195,23 +217,26 @@ public:
     const size_t count = alloc_.gauges_.erase(statName());
     ASSERT(count == 1);
     alloc_.sinked_gauges_.erase(this);
+    Thread::LockGuard changed_lock(alloc_.changed_mutex_);
+    alloc_.changed_gauges_.erase(this);
   }
 
   // Stats::Gauge
   void add(uint64_t amount) override {
     child_value_ += amount;
-    flags_ |= Flags::Used;
+    setFlagsOnChange(Flags::Used, alloc_.gauge_changed_flag_);
   }
   void dec() override { sub(1); }
   void inc() override { add(1); }
   void set(uint64_t value) override {
     child_value_ = value;
-    flags_ |= Flags::Used;
+    setFlagsOnChange(Flags::Used, alloc_.gauge_changed_flag_);
   }
   void sub(uint64_t amount) override {
     ASSERT(child_value_ >= amount);
     ASSERT(used() || amount == 0);
     child_value_ -= amount;
+    setFlagsOnChange(0, alloc_.gauge_changed_flag_);
   }
   uint64_t value() const override { return child_value_ + parent_value_; }
 
@@ -260,7 +285,10 @@ public:
     }
   }
 
-  void setParentValue(uint64_t value) override { parent_value_ = value; }
+  void setParentValue(uint64_t value) override {
+    parent_value_ = value;
+    setFlagsOnChange(0, alloc_.gauge_changed_flag_);
+  }
 
 private:
   std::atomic<uint64_t> parent_value_{0};
@@ -439,6 +467,79 @@ void AllocatorImpl::forEachSinkedTextReadout(SizeFn f_size, StatFn<TextReadout>
   }
 }
 
+void AllocatorImpl::markChanged(Counter* counter) {
+  Thread::LockGuard lock(changed_mutex_);
+  changed_counters_.insert(counter);
+}
+
+void AllocatorImpl::markChanged(Gauge* gauge) {
+  Thread::LockGuard lock(changed_mutex_);
+  changed_gauges_.insert(gauge);
+}
+
+template <class StatType>
+void AllocatorImpl::forEachChangedSinked(const StatPointerSet<StatType>& changed,
+                                         const StatSet<StatType>& stats,
+                                         const StatPointerSet<StatType>& sinked, SizeFn f_size,
+                                         StatFn<StatType> f_stat) {
+  std::vector<StatType*> to_visit;
+  to_visit.reserve(changed.size());
+  for (StatType* stat : changed) {
+    static_cast<StatsSharedImpl<StatType>*>(stat)->clearChanged();
+    // The registered stat may wrap the one that recorded the change. Stats that were marked for
+    // deletion are no longer registered and are skipped.
+    auto iter = stats.find(stat->statName());
+    if (iter == stats.end()) {
+      continue;
+    }
+    StatType* registered = *iter;
+    if (sink_predicates_ != nullptr ? sinked.contains(registered) : !registered->hidden()) {
+      to_visit.push_back(registered);
+    }
+  }
+
+  if (f_size != nullptr) {
+    f_size(to_visit.size());
+  }
+  for (StatType* stat : to_visit) {
+    f_stat(*stat);
+  }
+}
+
+void AllocatorImpl::forEachChangedSinkedCounter(SizeFn f_size, StatFn<Counter> f_stat) {
+  if (counter_changed_flag_ == 0) {
+    // Changes have not been tracked so far, so this first call visits every sinked counter.
+    counter_changed_flag_ = ChangedFlag;
+    forEachSinkedCounter(f_size, f_stat);
+    return;
+  }
+
+  Thread::LockGuard lock(mutex_);
+  StatPointerSet<Counter> changed;
+  {
+    Thread::LockGuard changed_lock(changed_mutex_);
+    changed.swap(changed_counters_);
+  }
+  forEachChangedSinked(changed, counters_, sinked_counters_, f_size, f_stat);
+}
+
+void AllocatorImpl::forEachChangedSinkedGauge(SizeFn f_size, StatFn<Gauge> f_stat) {
+  if (gauge_changed_flag_ == 0) {
+    // Changes have not been tracked so far, so this first call visits every sinked gauge.
+    gauge_changed_flag_ = ChangedFlag;
+    forEachSinkedGauge(f_size, f_stat);
+    return;
+  }
+
+  Thread::LockGuard lock(mutex_);
+  StatPointerSet<Gauge> changed;
+  {
+    Thread::LockGuard changed_lock(changed_mutex_);
+    changed.swap(changed_gauges_);
+  }
+  forEachChangedSinked(changed, gauges_, sinked_gauges_, f_size, f_stat);
+}
+
 void AllocatorImpl::setSinkPredicates(std::unique_ptr<SinkPredicates>&& sink_predicates) {
   Thread::LockGuard lock(mutex_);
   ASSERT(sink_predicates_ == nullptr);
@@ -478,6 +579,8 @@ void AllocatorImpl::markCounterForDeletion(const CounterSharedPtr& counter) {
   deleted_counters_.emplace_back(*iter);
   counters_.erase(iter);
   sinked_counters_.erase(counter.get());
+  Thread::LockGuard changed_lock(changed_mutex_);
+  changed_counters_.erase(counter.get());
 }
 
 void AllocatorImpl::markGaugeForDeletion(const GaugeSharedPtr& gauge) {
@@ -492,6 +595,8 @@ void AllocatorImpl::markGaugeForDeletion(const GaugeSharedPtr& gauge) {
   deleted_gauges_.emplace_back(*iter);
   gauges_.erase(iter);
   sinked_gauges_.erase(gauge.get());
+  Thread::LockGuard changed_lock(changed_mutex_);
+  changed_gauges_.erase(gauge.get());
 }
 
 void AllocatorImpl::markTextReadoutForDeletion(const TextReadoutSharedPtr& text_readout) {
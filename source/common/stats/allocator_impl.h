@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <vector>
 
 #include "envoy/common/optref.h"
@@ -43,6 +44,8 @@ public:
   void forEachSinkedCounter(SizeFn f_size, StatFn<Counter> f_stat) const override;
   void forEachSinkedGauge(SizeFn f_size, StatFn<Gauge> f_stat) const override;
   void forEachSinkedTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) const override;
+  void forEachChangedSinkedCounter(SizeFn f_size, StatFn<Counter> f_stat) override;
+  void forEachChangedSinkedGauge(SizeFn f_size, StatFn<Gauge> f_stat) override;
 
   void setSinkPredicates(std::unique_ptr<SinkPredicates>&& sink_predicates) override;
 #ifndef ENVOY_CONFIG_COVERAGE
@@ -74,6 +77,19 @@ private:
   friend class TextReadoutImpl;
   friend class NotifyingAllocatorImpl;
 
+  template <typename StatType> using StatPointerSet = absl::flat_hash_set<StatType*>;
+
+  // Set in a stat's flags, beyond the bits of Metric::Flags, between its first change and the
+  // next forEachChangedSinked*() call.
+  static constexpr uint16_t ChangedFlag = 0x100;
+
+  void markChanged(Counter* counter);
+  void markChanged(Gauge* gauge);
+  template <class StatType>
+  void forEachChangedSinked(const StatPointerSet<StatType>& changed, const StatSet<StatType>& stats,
+                            const StatPointerSet<StatType>& sinked, SizeFn f_size,
+                            StatFn<StatType> f_stat) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   // A mutex is needed here to protect both the stats_ object from both
   // alloc() and free() operations. Although alloc() operations are called under existing locking,
   // free() operations are made from the destructors of the individual stat objects, which are not
@@ -84,12 +100,22 @@ private:
   StatSet<Gauge> gauges_ ABSL_GUARDED_BY(mutex_);
   StatSet<TextReadout> text_readouts_ ABSL_GUARDED_BY(mutex_);
 
-  template <typename StatType> using StatPointerSet = absl::flat_hash_set<StatType*>;
   // Stat pointers that participate in the flush to sink process.
   StatPointerSet<Counter> sinked_counters_ ABSL_GUARDED_BY(mutex_);
   StatPointerSet<Gauge> sinked_gauges_ ABSL_GUARDED_BY(mutex_);
   StatPointerSet<TextReadout> sinked_text_readouts_ ABSL_GUARDED_BY(mutex_);
 
+  // Change tracking for forEachChangedSinked*(). Stats add themselves to these sets on their first
+  // change after a flush, so the lock is taken at most once per stat and flush. The sets hold the
+  // allocator's own stat objects, which may be wrapped by the ones in counters_ and gauges_.
+  // The flags are ChangedFlag once tracking has started for the stat type, and 0 before.
+  // Lock ordering: mutex_ before changed_mutex_.
+  std::atomic<uint16_t> counter_changed_flag_{0};
+  std::atomic<uint16_t> gauge_changed_flag_{0};
+  mutable Thread::MutexBasicLockable changed_mutex_;
+  StatPointerSet<Counter> changed_counters_ ABSL_GUARDED_BY(changed_mutex_);
+  StatPointerSet<Gauge> changed_gauges_ ABSL_GUARDED_BY(changed_mutex_);
+
   // Predicates used to filter stats to be flushed.
   std::unique_ptr<SinkPredicates> sink_predicates_;
   SymbolTable& symbol_table_;
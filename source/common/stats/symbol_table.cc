@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "source/common/common/assert.h"
+#include "source/common/common/hash.h"
 #include "source/common/common/logger.h"
 #include "source/common/common/utility.h"
 
@@ -261,11 +262,8 @@ bool StatName::startsWith(StatName prefix) const {
 
 std::vector<absl::string_view> SymbolTable::decodeStrings(StatName stat_name) const {
   std::vector<absl::string_view> strings;
-  Thread::LockGuard lock(lock_);
   Encoding::decodeTokens(
-      stat_name,
-      [this, &strings](Symbol symbol)
-          ABSL_NO_THREAD_SAFETY_ANALYSIS { strings.push_back(fromSymbol(symbol)); },
+      stat_name, [this, &strings](Symbol symbol) { strings.push_back(fromSymbol(symbol)); },
       [&strings](absl::string_view str) { strings.push_back(str); });
   return strings;
 }
@@ -290,6 +288,16 @@ SymbolTable::SymbolTable()
     // Have to be explicitly initialized, if we want to use the ABSL_GUARDED_BY macro.
     : next_symbol_(FirstValidSymbol), monotonic_counter_(FirstValidSymbol) {}
 
+SymbolTable::EncodeShard& SymbolTable::encodeShard(absl::string_view token) {
+  // The maps hash with absl::Hash, so an unrelated hash picks the shard to
+  // keep the tokens within a shard spread across their map's slots.
+  return encode_shards_[HashUtil::xxHash64(token) % NumShards];
+}
+
+SymbolTable::DecodeShard& SymbolTable::decodeShard(Symbol symbol) const {
+  return decode_shards_[symbol % NumShards];
+}
+
 SymbolTable::~SymbolTable() {
   // To avoid leaks into the symbol table, we expect all StatNames to be freed.
   // Note: this could potentially be short-circuited if we decide a fast exit
@@ -312,28 +320,36 @@ void SymbolTable::addTokensToEncoding(const absl::string_view name, Encoding& en
   std::vector<Symbol> symbols;
   symbols.reserve(tokens.size());
 
-  // Now take the lock and populate the Symbol objects, which involves bumping
-  // ref-counts in this.
-  {
-    Thread::LockGuard lock(lock_);
-    recent_lookups_.lookup(name);
-    for (auto& token : tokens) {
-      // TODO(jmarantz): consider using StatNameDynamicStorage for tokens with
-      // length below some threshold, say 4 bytes. It might be preferable not to
-      // reserve Symbols for every 3 digit number found (for example) in ipv4
-      // addresses.
-      symbols.push_back(toSymbol(token));
-    }
+  // Now populate the Symbol objects, which involves bumping ref-counts in
+  // this. Each token only locks the shard it belongs to.
+  recordLookup(name);
+  for (auto& token : tokens) {
+    // TODO(jmarantz): consider using StatNameDynamicStorage for tokens with
+    // length below some threshold, say 4 bytes. It might be preferable not to
+    // reserve Symbols for every 3 digit number found (for example) in ipv4
+    // addresses.
+    symbols.push_back(toSymbol(token));
   }
 
   // Now efficiently encode the array of 32-bit symbols into a uint8_t array.
   encoding.addSymbols(symbols);
 }
 
+void SymbolTable::recordLookup(absl::string_view name) {
+  num_lookups_.fetch_add(1, std::memory_order_relaxed);
+  if (recent_lookup_capacity_.load(std::memory_order_relaxed) != 0) {
+    Thread::LockGuard lock(recent_lookups_lock_);
+    recent_lookups_.lookup(name);
+  }
+}
+
 uint64_t SymbolTable::numSymbols() const {
-  Thread::LockGuard lock(lock_);
-  ASSERT(encode_map_.size() == decode_map_.size());
-  return encode_map_.size();
+  uint64_t num_symbols = 0;
+  for (const EncodeShard& shard : encode_shards_) {
+    Thread::LockGuard lock(shard.lock_);
+    num_symbols += shard.map_.size();
+  }
+  return num_symbols;
 }
 
 std::string SymbolTable::toString(const StatName& stat_name) const {
@@ -344,16 +360,14 @@ void SymbolTable::incRefCount(const StatName& stat_name) {
   // Before taking the lock, decode the array of symbols from the SymbolTable::Storage.
   const SymbolVec symbols = Encoding::decodeSymbols(stat_name);
 
-  Thread::LockGuard lock(lock_);
   for (Symbol symbol : symbols) {
-    auto decode_search = decode_map_.find(symbol);
-
-    ASSERT(decode_search != decode_map_.end(),
-           "Please see "
-           "https://github.com/envoyproxy/envoy/blob/main/source/docs/stats.md#"
-           "debugging-symbol-table-assertions");
-    auto encode_search = encode_map_.find(decode_search->second->toStringView());
-    ASSERT(encode_search != encode_map_.end(),
+    // The token stays valid after the decode shard is unlocked, as stat_name
+    // holds a reference to it.
+    const absl::string_view token = fromSymbol(symbol);
+    EncodeShard& shard = encodeShard(token);
+    Thread::LockGuard lock(shard.lock_);
+    auto encode_search = shard.map_.find(token);
+    ASSERT(encode_search != shard.map_.end(),
            "Please see "
            "https://github.com/envoyproxy/envoy/blob/main/source/docs/stats.md#"
            "debugging-symbol-table-assertions");
@@ -366,13 +380,14 @@ void SymbolTable::free(const StatName& stat_name) {
   // Before taking the lock, decode the array of symbols from the SymbolTable::Storage.
   const SymbolVec symbols = Encoding::decodeSymbols(stat_name);
 
-  Thread::LockGuard lock(lock_);
   for (Symbol symbol : symbols) {
-    auto decode_search = decode_map_.find(symbol);
-    ASSERT(decode_search != decode_map_.end());
-
-    auto encode_search = encode_map_.find(decode_search->second->toStringView());
-    ASSERT(encode_search != encode_map_.end());
+    // The token can only be erased once its last reference is freed, which
+    // requires the encode shard lock taken below.
+    const absl::string_view token = fromSymbol(symbol);
+    EncodeShard& shard = encodeShard(token);
+    Thread::LockGuard lock(shard.lock_);
+    auto encode_search = shard.map_.find(token);
+    ASSERT(encode_search != shard.map_.end());
 
     // If that was the last remaining client usage of the symbol, erase the
     // current mappings and add the now-unused symbol to the reuse pool.
@@ -381,9 +396,14 @@ void SymbolTable::free(const StatName& stat_name) {
     // symbol_table_speed_test.cc, relative to breaking out the decrement into a
     // separate step, likely due to the non-trivial dereferences in EXPR.
     if (--encode_search->second.ref_count_ == 0) {
-      decode_map_.erase(decode_search);
-      encode_map_.erase(encode_search);
-      pool_.push(symbol);
+      // Erase the encode entry first, as its key points into the decoded string.
+      shard.map_.erase(encode_search);
+      {
+        DecodeShard& decode_shard = decodeShard(symbol);
+        Thread::LockGuard decode_lock(decode_shard.lock_);
+        decode_shard.map_.erase(symbol);
+      }
+      releaseSymbol(symbol);
     }
   }
 }
@@ -392,14 +412,14 @@ uint64_t SymbolTable::getRecentLookups(const RecentLookupsFn& iter) const {
   uint64_t total = 0;
   absl::flat_hash_map<std::string, uint64_t> name_count_map;
 
-  // We don't want to hold lock_ while calling the iterator, but we need it to
+  // We don't want to hold recent_lookups_lock_ while calling the iterator, but we need it to
   // access recent_lookups_, so we buffer in name_count_map.
   {
-    Thread::LockGuard lock(lock_);
+    Thread::LockGuard lock(recent_lookups_lock_);
     recent_lookups_.forEach(
         [&name_count_map](absl::string_view str, uint64_t count)
             ABSL_NO_THREAD_SAFETY_ANALYSIS { name_count_map[std::string(str)] += count; });
-    total += recent_lookups_.total();
+    total += num_lookups_.load(std::memory_order_relaxed);
   }
 
   // Now we have the collated name-count map data: we need to vectorize and
@@ -445,17 +465,19 @@ DynamicSpans SymbolTable::getDynamicSpans(StatName stat_name) const {
 }
 
 void SymbolTable::setRecentLookupCapacity(uint64_t capacity) {
-  Thread::LockGuard lock(lock_);
+  Thread::LockGuard lock(recent_lookups_lock_);
   recent_lookups_.setCapacity(capacity);
+  recent_lookup_capacity_.store(capacity, std::memory_order_relaxed);
 }
 
 void SymbolTable::clearRecentLookups() {
-  Thread::LockGuard lock(lock_);
+  Thread::LockGuard lock(recent_lookups_lock_);
   recent_lookups_.clear();
+  num_lookups_.store(0, std::memory_order_relaxed);
 }
 
 uint64_t SymbolTable::recentLookupCapacity() const {
-  Thread::LockGuard lock(lock_);
+  Thread::LockGuard lock(recent_lookups_lock_);
   return recent_lookups_.capacity();
 }
 
@@ -467,21 +489,23 @@ StatNameSetPtr SymbolTable::makeSet(absl::string_view name) {
 
 Symbol SymbolTable::toSymbol(absl::string_view sv) {
   Symbol result;
-  auto encode_find = encode_map_.find(sv);
+  EncodeShard& shard = encodeShard(sv);
+  Thread::LockGuard lock(shard.lock_);
+  auto encode_find = shard.map_.find(sv);
   // If the string segment doesn't already exist,
-  if (encode_find == encode_map_.end()) {
-    // We create the actual string, place it in the decode_map_, and then insert
-    // a string_view pointing to it in the encode_map_. This allows us to only
+  if (encode_find == shard.map_.end()) {
+    // We create the actual string, place it in the decode map, and then insert
+    // a string_view pointing to it in the encode map. This allows us to only
     // store the string once. We use unique_ptr so copies are not made as
     // flat_hash_map moves values around.
+    result = allocateSymbol();
     InlineStringPtr str = InlineString::create(sv);
-    auto encode_insert = encode_map_.insert({str->toStringView(), SharedSymbol(next_symbol_)});
+    auto encode_insert = shard.map_.insert({str->toStringView(), SharedSymbol(result)});
     ASSERT(encode_insert.second);
-    auto decode_insert = decode_map_.insert({next_symbol_, std::move(str)});
+    DecodeShard& decode_shard = decodeShard(result);
+    Thread::LockGuard decode_lock(decode_shard.lock_);
+    auto decode_insert = decode_shard.map_.insert({result, std::move(str)});
     ASSERT(decode_insert.second);
-
-    result = next_symbol_;
-    newSymbol();
   } else {
     // If the insertion didn't take place, return the actual value at that location and up the
     // refcount at that location
@@ -491,14 +515,27 @@ Symbol SymbolTable::toSymbol(absl::string_view sv) {
   return result;
 }
 
-absl::string_view SymbolTable::fromSymbol(const Symbol symbol) const
-    ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
-  auto search = decode_map_.find(symbol);
-  RELEASE_ASSERT(search != decode_map_.end(), "no such symbol");
+absl::string_view SymbolTable::fromSymbol(const Symbol symbol) const {
+  const DecodeShard& shard = decodeShard(symbol);
+  Thread::LockGuard lock(shard.lock_);
+  auto search = shard.map_.find(symbol);
+  RELEASE_ASSERT(search != shard.map_.end(), "no such symbol");
   return search->second->toStringView();
 }
 
-void SymbolTable::newSymbol() ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+Symbol SymbolTable::allocateSymbol() {
+  Thread::LockGuard lock(symbol_lock_);
+  const Symbol symbol = next_symbol_;
+  newSymbol();
+  return symbol;
+}
+
+void SymbolTable::releaseSymbol(Symbol symbol) {
+  Thread::LockGuard lock(symbol_lock_);
+  pool_.push(symbol);
+}
+
+void SymbolTable::newSymbol() ABSL_EXCLUSIVE_LOCKS_REQUIRED(symbol_lock_) {
   if (pool_.empty()) {
     next_symbol_ = ++monotonic_counter_;
   } else {
@@ -510,15 +547,6 @@ void SymbolTable::newSymbol() ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
 }
 
 bool SymbolTable::lessThan(const StatName& a, const StatName& b) const {
-  // Proactively take the table lock in anticipation that we'll need to
-  // convert at least one symbol to a string_view, and it's easier not to
-  // bother to lazily take the lock.
-  Thread::LockGuard lock(lock_);
-  return lessThanLockHeld(a, b);
-}
-
-bool SymbolTable::lessThanLockHeld(const StatName& a, const StatName& b) const
-    ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
   Encoding::TokenIter a_iter(a), b_iter(b);
   while (true) {
     Encoding::TokenIter::TokenType a_type = a_iter.next();
@@ -548,16 +576,16 @@ bool SymbolTable::lessThanLockHeld(const StatName& a, const StatName& b) const
 
 #ifndef ENVOY_CONFIG_COVERAGE
 void SymbolTable::debugPrint() const {
-  Thread::LockGuard lock(lock_);
-  std::vector<Symbol> symbols;
-  for (const auto& p : decode_map_) {
-    symbols.push_back(p.first);
+  std::vector<std::pair<absl::string_view, SharedSymbol>> symbols;
+  for (const EncodeShard& shard : encode_shards_) {
+    Thread::LockGuard lock(shard.lock_);
+    symbols.insert(symbols.end(), shard.map_.begin(), shard.map_.end());
   }
-  std::sort(symbols.begin(), symbols.end());
-  for (Symbol symbol : symbols) {
-    const InlineString& token = *decode_map_.find(symbol)->second;
-    const SharedSymbol& shared_symbol = encode_map_.find(token.toStringView())->second;
-    ENVOY_LOG_MISC(info, "{}: '{}' ({})", symbol, token.toStringView(), shared_symbol.ref_count_);
+  std::sort(symbols.begin(), symbols.end(), [](const auto& a, const auto& b) {
+    return a.second.symbol_ < b.second.symbol_;
+  });
+  for (const auto& [token, shared_symbol] : symbols) {
+    ENVOY_LOG_MISC(info, "{}: '{}' ({})", shared_symbol.symbol_, token, shared_symbol.ref_count_);
   }
 }
 #endif
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <memory>
 #include <stack>
 #include <string>
@@ -324,8 +326,6 @@ public:
    */
   DynamicSpans getDynamicSpans(StatName stat_name) const;
 
-  bool lessThanLockHeld(const StatName& a, const StatName& b) const;
-
   template <class GetStatName, class Obj> struct StatNameCompare {
     StatNameCompare(const SymbolTable& symbol_table, GetStatName getter)
         : symbol_table_(symbol_table), getter_(getter) {}
@@ -337,9 +337,9 @@ public:
   };
 
   /**
-   * Sorts a range by StatName. This API is more efficient than
-   * calling std::sort directly as it takes a single lock for the
-   * entire sort, rather than locking on each comparison.
+   * Sorts a range by StatName. Comparisons only consult the symbol table
+   * when two names differ in a symbol, so sorting names that share long
+   * prefixes takes few locks.
    *
    * @param begin the beginning of the range to sort
    * @param end the end of the range to sort
@@ -347,9 +347,6 @@ public:
    */
   template <class Obj, class Iter, class GetStatName>
   void sortByStatNames(Iter begin, Iter end, GetStatName get_stat_name) const {
-    // Grab the lock once before sorting begins, so we don't have to re-take
-    // it on every comparison.
-    Thread::LockGuard lock(lock_);
     StatNameCompare<GetStatName, Obj> compare(*this, get_stat_name);
     std::sort(begin, end, compare);
   }
@@ -402,8 +399,31 @@ private:
     uint32_t ref_count_{1};
   };
 
-  // This must be held during both encode() and free().
-  mutable Thread::MutexBasicLockable lock_;
+  // The number of shards the symbol maps are split across. A token's encode
+  // shard is picked by hashing the token, and a symbol's decode shard by its
+  // value, so threads symbolizing different tokens rarely contend.
+  static constexpr uint32_t NumShards = 16;
+
+  // Bitmap implementation.
+  // The encode map stores both the symbol and the ref count of that symbol.
+  // Using absl::string_view lets us only store the complete string once, in the decode map.
+  using EncodeMap = absl::flat_hash_map<absl::string_view, SharedSymbol>;
+  using DecodeMap = absl::flat_hash_map<Symbol, InlineStringPtr>;
+
+  struct EncodeShard {
+    mutable Thread::MutexBasicLockable lock_;
+    EncodeMap map_ ABSL_GUARDED_BY(lock_);
+  };
+
+  struct DecodeShard {
+    mutable Thread::MutexBasicLockable lock_;
+    DecodeMap map_ ABSL_GUARDED_BY(lock_);
+  };
+
+  // Shard locks are taken in the order: encode shard, decode shard,
+  // symbol_lock_. No two shards of the same kind are held at once.
+  EncodeShard& encodeShard(absl::string_view token);
+  DecodeShard& decodeShard(Symbol symbol) const;
 
   /**
    * Decodes a uint8_t array into an array of period-delimited strings. Note
@@ -426,7 +446,7 @@ private:
    * @param sv the individual string to be encoded as a symbol.
    * @return Symbol the encoded string.
    */
-  Symbol toSymbol(absl::string_view sv) ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  Symbol toSymbol(absl::string_view sv);
 
   /**
    * Convenience function for decode(), decoding one symbol at a time.
@@ -434,12 +454,24 @@ private:
    * @param symbol the individual symbol to be decoded.
    * @return absl::string_view the decoded string.
    */
-  absl::string_view fromSymbol(Symbol symbol) const ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  absl::string_view fromSymbol(Symbol symbol) const;
+
+  /**
+   * @return the symbol for a newly inserted token.
+   */
+  Symbol allocateSymbol();
+
+  /**
+   * Returns a symbol that is no longer in use to the free pool.
+   *
+   * @param symbol the symbol to release.
+   */
+  void releaseSymbol(Symbol symbol);
 
   /**
    * Stages a new symbol for use. To be called after a successful insertion.
    */
-  void newSymbol();
+  void newSymbol() ABSL_EXCLUSIVE_LOCKS_REQUIRED(symbol_lock_);
 
   /**
    * Tokenizes name, finds or allocates symbols for each token, and adds them
@@ -450,31 +482,43 @@ private:
    */
   void addTokensToEncoding(absl::string_view name, Encoding& encoding);
 
+  /**
+   * Counts a lookup of name, and tracks it if recent lookups are enabled.
+   *
+   * @param name the name being symbolized.
+   */
+  void recordLookup(absl::string_view name);
+
   Symbol monotonicCounter() {
-    Thread::LockGuard lock(lock_);
+    Thread::LockGuard lock(symbol_lock_);
     return monotonic_counter_;
   }
 
+  std::array<EncodeShard, NumShards> encode_shards_;
+  mutable std::array<DecodeShard, NumShards> decode_shards_;
+
+  // Guards symbol allocation, which is only needed when a token is inserted
+  // or its last reference is freed.
+  Thread::MutexBasicLockable symbol_lock_;
+
   // Stores the symbol to be used at next insertion. This should exist ahead of insertion time so
   // that if insertion succeeds, the value written is the correct one.
-  Symbol next_symbol_ ABSL_GUARDED_BY(lock_);
+  Symbol next_symbol_ ABSL_GUARDED_BY(symbol_lock_);
 
   // If the free pool is exhausted, we monotonically increase this counter.
-  Symbol monotonic_counter_;
-
-  // Bitmap implementation.
-  // The encode map stores both the symbol and the ref count of that symbol.
-  // Using absl::string_view lets us only store the complete string once, in the decode map.
-  using EncodeMap = absl::flat_hash_map<absl::string_view, SharedSymbol>;
-  using DecodeMap = absl::flat_hash_map<Symbol, InlineStringPtr>;
-  EncodeMap encode_map_ ABSL_GUARDED_BY(lock_);
-  DecodeMap decode_map_ ABSL_GUARDED_BY(lock_);
+  Symbol monotonic_counter_ ABSL_GUARDED_BY(symbol_lock_);
 
   // Free pool of symbols for re-use.
   // TODO(ambuc): There might be an optimization here relating to storing ranges of freed symbols
   // using an Envoy::IntervalSet.
-  std::stack<Symbol> pool_ ABSL_GUARDED_BY(lock_);
-  RecentLookups recent_lookups_ ABSL_GUARDED_BY(lock_);
+  std::stack<Symbol> pool_ ABSL_GUARDED_BY(symbol_lock_);
+
+  // Lookups are counted without a lock, and only take recent_lookups_lock_
+  // to be tracked by name when a capacity has been set.
+  std::atomic<uint64_t> num_lookups_{0};
+  std::atomic<uint64_t> recent_lookup_capacity_{0};
+  mutable Thread::MutexBasicLockable recent_lookups_lock_;
+  RecentLookups recent_lookups_ ABSL_GUARDED_BY(recent_lookups_lock_);
 };
 
 // Base class for holding the backing-storing for a StatName. The two derived
@@ -1065,7 +1109,7 @@ template <class GetStatName, class Obj>
 bool SymbolTable::StatNameCompare<GetStatName, Obj>::operator()(const Obj& a, const Obj& b) const {
   StatName a_stat_name = getter_(a);
   StatName b_stat_name = getter_(b);
-  return symbol_table_.lessThanLockHeld(a_stat_name, b_stat_name);
+  return symbol_table_.lessThan(a_stat_name, b_stat_name);
 }
 
 using SymbolTablePtr = std::unique_ptr<SymbolTable>;
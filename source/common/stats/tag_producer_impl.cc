@@ -1,16 +1,33 @@
 #include "source/common/stats/tag_producer_impl.h"
 
+#include <algorithm>
 #include <string>
 
 #include "envoy/common/exception.h"
 #include "envoy/config/metrics/v3/stats.pb.h"
 
+#include "source/common/common/logger.h"
 #include "source/common/common/utility.h"
 #include "source/common/stats/tag_extractor_impl.h"
 
 namespace Envoy {
 namespace Stats {
 
+namespace {
+
+absl::string_view re2Regex(const Config::TagNameValues::Descriptor& desc) {
+  return desc.re_type_ == Regex::Type::Re2 ? absl::string_view(desc.regex_) : absl::string_view();
+}
+
+re2::RE2::Options re2SetOptions() {
+  re2::RE2::Options options;
+  // Custom std::regex patterns that RE2 does not support are expected, and are simply left out.
+  options.set_log_errors(false);
+  return options;
+}
+
+} // namespace
+
 absl::StatusOr<Stats::TagProducerPtr>
 TagProducerImpl::createTagProducer(const envoy::config::metrics::v3::StatsConfig& config,
                                    const Stats::TagVector& cli_tags) {
@@ -21,7 +38,8 @@ TagProducerImpl::createTagProducer(const envoy::config::metrics::v3::StatsConfig
 }
 
 TagProducerImpl::TagProducerImpl(const envoy::config::metrics::v3::StatsConfig& config,
-                                 const Stats::TagVector& cli_tags, absl::Status& creation_status) {
+                                 const Stats::TagVector& cli_tags, absl::Status& creation_status)
+    : re2_set_(std::make_unique<re2::RE2::Set>(re2SetOptions(), re2::RE2::UNANCHORED)) {
   reserveResources(config);
   creation_status = addDefaultExtractors(config);
 
@@ -51,7 +69,9 @@ TagProducerImpl::TagProducerImpl(const envoy::config::metrics::v3::StatsConfig&
           creation_status = extractor_or_error.status();
           return;
         }
-        addExtractor(std::move(extractor_or_error.value()));
+        // Custom regexes are std::regex. The ones RE2 also accepts go into the set as well, while
+        // RE2 rejects constructs such as backreferences and lookarounds.
+        addExtractor(std::move(extractor_or_error.value()), tag_specifier.regex());
       }
     } else if (tag_specifier.tag_value_case() ==
                envoy::config::metrics::v3::TagSpecifier::TagValueCase::kFixedValue) {
@@ -59,6 +79,16 @@ TagProducerImpl::TagProducerImpl(const envoy::config::metrics::v3::StatsConfig&
       fixed_tags_.push_back(Tag{name, tag_specifier.fixed_value()});
     }
   }
+
+  if (std::none_of(tag_extractors_without_prefix_.begin(), tag_extractors_without_prefix_.end(),
+                   [](const ExtractorEntry& entry) { return entry.re2_set_index_ >= 0; })) {
+    // Nothing to filter, so skip the scan.
+    re2_set_.reset();
+  } else if (!re2_set_->Compile()) {
+    // Without the set every extractor is tried, as it was before the set was added.
+    ENVOY_LOG_MISC(warn, "failed to compile the combined tag extraction regex");
+    re2_set_.reset();
+  }
 }
 
 absl::Status TagProducerImpl::addExtractorsMatching(absl::string_view name) {
@@ -70,7 +100,7 @@ absl::Status TagProducerImpl::addExtractorsMatching(absl::string_view name) {
       if (!extractor_or_error.ok()) {
         return extractor_or_error.status();
       }
-      addExtractor(std::move(extractor_or_error.value()));
+      addExtractor(std::move(extractor_or_error.value()), re2Regex(desc));
       ++num_found;
     }
   }
@@ -87,7 +117,7 @@ absl::Status TagProducerImpl::addExtractorsMatching(absl::string_view name) {
   return absl::OkStatus();
 }
 
-void TagProducerImpl::addExtractor(TagExtractorPtr extractor) {
+void TagProducerImpl::addExtractor(TagExtractorPtr extractor, absl::string_view re2_regex) {
   auto insertion = extractor_map_.insert(std::make_pair(extractor->name(), std::ref(*extractor)));
   if (!insertion.second) {
     extractor->setOtherExtractorWithSameNameExists(true);
@@ -95,40 +125,68 @@ void TagProducerImpl::addExtractor(TagExtractorPtr extractor) {
     other.get().setOtherExtractorWithSameNameExists(true);
   }
 
+  // Extractors with a prefix only run for names starting with it, which the prefix map already
+  // resolves, so only the extractors without one are filtered through the set.
   const absl::string_view prefix = extractor->prefixToken();
+  int re2_set_index = -1;
+  if (prefix.empty() && !re2_regex.empty() && re2_set_ != nullptr) {
+    re2_set_index = re2_set_->Add(re2_regex, nullptr);
+  }
+
   if (prefix.empty()) {
-    tag_extractors_without_prefix_.emplace_back(std::move(extractor));
+    tag_extractors_without_prefix_.push_back({std::move(extractor), re2_set_index});
   } else {
-    tag_extractor_prefix_map_[prefix].emplace_back(std::move(extractor));
+    tag_extractor_prefix_map_[prefix].push_back({std::move(extractor), re2_set_index});
   }
 }
 
-void TagProducerImpl::forEachExtractorMatching(
-    absl::string_view stat_name, std::function<void(const TagExtractorPtr&)> f) const {
-  IntervalSetImpl<size_t> remove_characters;
-  for (const TagExtractorPtr& tag_extractor : tag_extractors_without_prefix_) {
-    f(tag_extractor);
+template <class Fn>
+void TagProducerImpl::forEachEntryMatching(absl::string_view stat_name, Fn f) const {
+  for (const ExtractorEntry& entry : tag_extractors_without_prefix_) {
+    f(entry);
   }
   const absl::string_view::size_type dot = stat_name.find('.');
   if (dot != std::string::npos) {
     const absl::string_view token = absl::string_view(stat_name.data(), dot);
     const auto iter = tag_extractor_prefix_map_.find(token);
     if (iter != tag_extractor_prefix_map_.end()) {
-      for (const TagExtractorPtr& tag_extractor : iter->second) {
-        f(tag_extractor);
+      for (const ExtractorEntry& entry : iter->second) {
+        f(entry);
       }
     }
   }
 }
 
+void TagProducerImpl::forEachExtractorMatching(
+    absl::string_view stat_name, std::function<void(const TagExtractorPtr&)> f) const {
+  forEachEntryMatching(stat_name, [&f](const ExtractorEntry& entry) { f(entry.extractor_); });
+}
+
 std::string TagProducerImpl::produceTags(absl::string_view metric_name, TagVector& tags) const {
   // TODO(jmarantz): Skip the creation of string-based tags, creating a StatNameTagVector instead.
   IntervalSetImpl<size_t> remove_characters;
   TagExtractionContext tag_extraction_context(metric_name);
-  std::vector<absl::string_view> tokens;
   absl::flat_hash_set<absl::string_view> dup_set;
-  forEachExtractorMatching(metric_name, [&remove_characters, &tags, &tag_extraction_context,
-                                         &dup_set](const TagExtractorPtr& tag_extractor) {
+
+  // Find every extractor without a prefix whose regex matches in one pass over the name. If the
+  // set cannot answer, for example because its DFA ran out of memory, all extractors are tried.
+  std::vector<int> re2_matches;
+  bool use_re2_matches = false;
+  if (re2_set_ != nullptr) {
+    re2::RE2::Set::ErrorInfo error_info;
+    use_re2_matches = re2_set_->Match(metric_name, &re2_matches, &error_info) ||
+                      error_info.kind == re2::RE2::Set::kNoError;
+  }
+
+  forEachEntryMatching(metric_name, [&remove_characters, &tags, &tag_extraction_context, &dup_set,
+                                     &re2_matches,
+                                     use_re2_matches](const ExtractorEntry& entry) {
+    if (use_re2_matches && entry.re2_set_index_ >= 0 &&
+        std::find(re2_matches.begin(), re2_matches.end(), entry.re2_set_index_) ==
+            re2_matches.end()) {
+      return;
+    }
+    const TagExtractorPtr& tag_extractor = entry.extractor_;
     // It is relatively cheap to populate a set of string_view for every tag,
     // but it saves 2% CPU time to only populate and check dup_set for tag-names
     // where there is more than one extractor. This is rare. For built-in
@@ -159,7 +217,7 @@ TagProducerImpl::addDefaultExtractors(const envoy::config::metrics::v3::StatsCon
       auto extractor_or_error = TagExtractorImplBase::createTagExtractor(
           desc.name_, desc.regex_, desc.substr_, desc.negative_match_, desc.re_type_);
       RETURN_IF_NOT_OK_REF(extractor_or_error.status());
-      addExtractor(std::move(extractor_or_error.value()));
+      addExtractor(std::move(extractor_or_error.value()), re2Regex(desc));
     }
     for (const auto& desc : Config::TagNames::get().tokenizedDescriptorVec()) {
       addExtractor(std::make_unique<TagExtractorTokensImpl>(desc.name_, desc.pattern_));
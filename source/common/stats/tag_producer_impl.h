@@ -18,6 +18,7 @@
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_set.h"
 #include "absl/strings/string_view.h"
+#include "re2/set.h"
 
 namespace Envoy {
 namespace Stats {
@@ -61,8 +62,11 @@ private:
    * Adds a TagExtractor to the collection of tags, tracking prefixes to help make
    * produceTags run efficiently by trying only extractors that have a chance to match.
    * @param extractor TagExtractorPtr the extractor to add.
+   * @param re2_regex the regex the extractor matches with, if any. If the extractor has no
+   *        prefix and RE2 accepts the regex, it is added to re2_set_ so that the extractor is
+   *        skipped for the names its regex cannot match.
    */
-  void addExtractor(TagExtractorPtr extractor);
+  void addExtractor(TagExtractorPtr extractor, absl::string_view re2_regex = "");
 
   /**
    * Adds all default extractors matching the specified tag name. In this model,
@@ -104,12 +108,28 @@ private:
   void forEachExtractorMatching(absl::string_view stat_name,
                                 std::function<void(const TagExtractorPtr&)> f) const;
 
-  std::vector<TagExtractorPtr> tag_extractors_without_prefix_;
+  // A TagExtractor, and the index of its regex in re2_set_, or -1 if it is not in the set.
+  struct ExtractorEntry {
+    TagExtractorPtr extractor_;
+    int re2_set_index_;
+  };
+
+  /**
+   * Like forEachExtractorMatching, but calls f with the ExtractorEntry.
+   */
+  template <class Fn> void forEachEntryMatching(absl::string_view stat_name, Fn f) const;
+
+  std::vector<ExtractorEntry> tag_extractors_without_prefix_;
 
   // Maps a prefix word extracted out of a regex to a vector of TagExtractors. Note that
   // the storage for the prefix string is owned by the TagExtractor, which, depending on
   // implementation, may need make a copy of the prefix.
-  absl::flat_hash_map<absl::string_view, std::vector<TagExtractorPtr>> tag_extractor_prefix_map_;
+  absl::flat_hash_map<absl::string_view, std::vector<ExtractorEntry>> tag_extractor_prefix_map_;
+
+  // Holds the regexes of the regex extractors without a prefix, so a single scan of a stat name
+  // finds every one that matches it. The per-extractor regexes then only run, to pull out the tag
+  // values, for extractors whose regex matched. nullptr if there is nothing to filter.
+  std::unique_ptr<re2::RE2::Set> re2_set_;
 
   // Keep track of which names have extractors. If an extractor is added and there's
   // already one for that name, we set a bit in the extractor so we can decide whether
@@ -203,6 +203,12 @@ public:
   void forEachSinkedGauge(SizeFn f_size, StatFn<Gauge> f_stat) const override;
   void forEachSinkedTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) const override;
   void forEachSinkedHistogram(SizeFn f_size, StatFn<ParentHistogram> f_stat) const override;
+  void forEachChangedSinkedCounter(SizeFn f_size, StatFn<Counter> f_stat) override {
+    alloc_.forEachChangedSinkedCounter(f_size, f_stat);
+  }
+  void forEachChangedSinkedGauge(SizeFn f_size, StatFn<Gauge> f_stat) override {
+    alloc_.forEachChangedSinkedGauge(f_size, f_stat);
+  }
 
   void setSinkPredicates(std::unique_ptr<SinkPredicates>&& sink_predicates) override;
   OptRef<SinkPredicates> sinkPredicates() override { return sink_predicates_; }
@@ -503,6 +509,11 @@ private:
                                  StatNameStorageSet& central_rejected_stats,
                                  StatNameHashSet* tls_rejected_stats);
   TlsCache& tlsCache() { return **tls_cache_; }
+  // Threads that are not registered with thread local storage, such as health check session
+  // threads, look their stats up in the central cache instead.
+  bool useTlsCache() {
+    return !shutting_down_ && tls_cache_ != nullptr && tls_cache_->currentThreadRegistered();
+  }
   void addScope(std::shared_ptr<ScopeImpl>& new_scope);
 
   OptRef<SinkPredicates> sink_predicates_;
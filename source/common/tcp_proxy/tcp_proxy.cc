@@ -929,11 +929,35 @@ void Filter::onUpstreamConnection() {
     }
   }
 
+  if (upstream_ &&
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.tcp_proxy_splice")) {
+    startSplice();
+  }
+
   if (config_->flushAccessLogOnConnected()) {
     flushAccessLog(AccessLog::AccessLogType::TcpUpstreamConnected);
   }
 }
 
+void Filter::startSplice() {
+  // Spliced data never reaches onData() and onUpstreamData(), so the accounting done there is
+  // repeated for it here.
+  const bool spliced = upstream_->startSplice(
+      read_callbacks_->connection(),
+      [this](uint64_t bytes) {
+        getStreamInfo().getDownstreamBytesMeter()->addWireBytesReceived(bytes);
+        getStreamInfo().getUpstreamBytesMeter()->addWireBytesSent(bytes);
+        resetIdleTimer();
+      },
+      [this](uint64_t bytes) {
+        getStreamInfo().getUpstreamBytesMeter()->addWireBytesReceived(bytes);
+        getStreamInfo().getDownstreamBytesMeter()->addWireBytesSent(bytes);
+        resetIdleTimer();
+      });
+  ENVOY_CONN_LOG(debug, "TCP: splicing {}", read_callbacks_->connection(),
+                 spliced ? "enabled" : "unavailable");
+}
+
 void Filter::onIdleTimeout() {
   ENVOY_CONN_LOG(debug, "Session timed out", read_callbacks_->connection());
   config_->stats().idle_timeout_.inc();
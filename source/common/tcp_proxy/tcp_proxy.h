@@ -621,6 +621,7 @@ protected:
   void onUpstreamData(Buffer::Instance& data, bool end_stream);
   void onUpstreamEvent(Network::ConnectionEvent event);
   void onUpstreamConnection();
+  void startSplice();
   void onIdleTimeout();
   void resetIdleTimer();
   void disableIdleTimer();
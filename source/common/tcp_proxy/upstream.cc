@@ -59,6 +59,20 @@ Ssl::ConnectionInfoConstSharedPtr TcpUpstream::getUpstreamConnectionSslInfo() {
   return nullptr;
 }
 
+bool TcpUpstream::startSplice(Network::Connection& downstream,
+                              Network::Connection::SplicedBytesCb downstream_cb,
+                              Network::Connection::SplicedBytesCb upstream_cb) {
+  if (upstream_conn_data_ == nullptr) {
+    return false;
+  }
+  Network::Connection& upstream = upstream_conn_data_->connection();
+  if (!downstream.startSplice(upstream, std::move(downstream_cb))) {
+    return false;
+  }
+  upstream.startSplice(downstream, std::move(upstream_cb));
+  return true;
+}
+
 Tcp::ConnectionPool::ConnectionData*
 TcpUpstream::onDownstreamEvent(Network::ConnectionEvent event) {
   // TODO(botengyao): propagate RST back to upstream connection if RST is received from downstream.
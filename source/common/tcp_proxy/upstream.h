@@ -177,6 +177,9 @@ public:
   Tcp::ConnectionPool::ConnectionData* onDownstreamEvent(Network::ConnectionEvent event) override;
   bool startUpstreamSecureTransport() override;
   Ssl::ConnectionInfoConstSharedPtr getUpstreamConnectionSslInfo() override;
+  bool startSplice(Network::Connection& downstream,
+                   Network::Connection::SplicedBytesCb downstream_cb,
+                   Network::Connection::SplicedBytesCb upstream_cb) override;
 
 private:
   Tcp::ConnectionPool::ConnectionDataPtr upstream_conn_data_;
@@ -205,6 +208,11 @@ public:
   // HTTP upstream must not implement converting upstream transport
   // socket from non-secure to secure mode.
   bool startUpstreamSecureTransport() override { return false; }
+  // HTTP upstreams frame the data, so it can not be spliced.
+  bool startSplice(Network::Connection&, Network::Connection::SplicedBytesCb,
+                   Network::Connection::SplicedBytesCb) override {
+    return false;
+  }
 
   // Http::StreamCallbacks
   void onResetStream(Http::StreamResetReason reason,
@@ -307,6 +315,10 @@ public:
   // socket from non-secure to secure mode.
   bool startUpstreamSecureTransport() override { return false; }
   Ssl::ConnectionInfoConstSharedPtr getUpstreamConnectionSslInfo() override { return nullptr; }
+  bool startSplice(Network::Connection&, Network::Connection::SplicedBytesCb,
+                   Network::Connection::SplicedBytesCb) override {
+    return false;
+  }
 
   // Router::RouterFilterInterface
   void onUpstreamHeaders(uint64_t response_code, Http::ResponseHeaderMapPtr&& headers,
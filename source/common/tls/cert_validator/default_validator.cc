@@ -73,12 +73,9 @@ absl::StatusOr<int> DefaultCertValidator::initializeSslContexts(std::vector<SSL_
 
   if (config_ != nullptr && !config_->caCert().empty() && !provides_certificates) {
     ca_file_path_ = config_->caCertPath();
-    bssl::UniquePtr<BIO> bio(
-        BIO_new_mem_buf(const_cast<char*>(config_->caCert().data()), config_->caCert().size()));
-    RELEASE_ASSERT(bio != nullptr, "");
-    // Based on BoringSSL's X509_load_cert_crl_file().
-    bssl::UniquePtr<STACK_OF(X509_INFO)> list(
-        PEM_X509_INFO_read_bio(bio.get(), nullptr, nullptr, nullptr));
+    trusted_ca_bundle_ =
+        TrustedCaBundleCache::get(context_.singletonManager())->getOrParse(config_->caCert());
+    const TrustedCaBundleSharedPtr& list = trusted_ca_bundle_;
     if (list == nullptr) {
       return absl::InvalidArgumentError(
           absl::StrCat("Failed to load trusted CA certificates from ", config_->caCertPath()));
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <deque>
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -21,6 +22,7 @@
 #include "source/common/stats/symbol_table.h"
 #include "source/common/tls/cert_validator/cert_validator.h"
 #include "source/common/tls/cert_validator/san_matcher.h"
+#include "source/common/tls/cert_validator/trusted_ca_bundle_cache.h"
 #include "source/common/tls/stats.h"
 
 #include "absl/synchronization/mutex.h"
@@ -114,6 +116,8 @@ private:
   Server::Configuration::CommonFactoryContext& context_;
 
   bssl::UniquePtr<X509> ca_cert_;
+  // Held so that validators trusting the same CAs share one parsed bundle.
+  TrustedCaBundleSharedPtr trusted_ca_bundle_;
   std::string ca_file_path_;
   std::vector<SanMatcherPtr> subject_alt_name_matchers_;
   std::vector<std::vector<uint8_t>> verify_certificate_hash_list_;
@@ -0,0 +1,155 @@
+#include "source/common/tls/cert_validator/trusted_ca_bundle_cache.h"
+
+#include <algorithm>
+
+#include "envoy/extensions/transport_sockets/tls/v3/tls.pb.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/config/datasource.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/container/flat_hash_set.h"
+#include "openssl/pem.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+SINGLETON_MANAGER_REGISTRATION(trusted_ca_bundle_cache);
+
+std::shared_ptr<TrustedCaBundleCache>
+TrustedCaBundleCache::get(Singleton::Manager& singleton_manager) {
+  // Pinned, so that bundles stay shared across updates that do not hold the cache.
+  return singleton_manager.getTyped<TrustedCaBundleCache>(
+      SINGLETON_MANAGER_REGISTERED_NAME(trusted_ca_bundle_cache),
+      [] { return std::make_shared<TrustedCaBundleCache>(); }, true);
+}
+
+TrustedCaBundleSharedPtr TrustedCaBundleCache::getOrParse(absl::string_view pem) {
+  const Key pem_key = key(pem);
+  if (TrustedCaBundleSharedPtr bundle = find(pem_key); bundle != nullptr) {
+    return bundle;
+  }
+  TrustedCaBundleSharedPtr bundle = parse(pem);
+  if (bundle != nullptr) {
+    insert(pem_key, bundle);
+  }
+  return bundle;
+}
+
+std::vector<TrustedCaBundleSharedPtr> TrustedCaBundleCache::prepare(
+    const std::vector<const envoy::config::core::v3::TransportSocket*>& transport_sockets,
+    Api::Api& api, Thread::HelperThreadPool& pool) {
+  struct Pending {
+    absl::optional<std::string> pem_;
+    Key key_;
+    TrustedCaBundleSharedPtr bundle_;
+  };
+
+  // Read the bundles and compute their keys on the pool.
+  std::vector<Pending> pending(transport_sockets.size());
+  uint32_t tasks = std::min<size_t>(pool.concurrency(), pending.size());
+  pool.run(tasks, [&](uint32_t task) {
+    for (size_t i = task; i < pending.size(); i += tasks) {
+      pending[i].pem_ = readTrustedCa(*transport_sockets[i], api);
+      if (pending[i].pem_.has_value()) {
+        pending[i].key_ = key(*pending[i].pem_);
+      }
+    }
+  });
+
+  // Find the bundles that are not cached yet, in the order of the sockets.
+  std::vector<TrustedCaBundleSharedPtr> bundles;
+  std::vector<Pending*> to_parse;
+  absl::flat_hash_set<Key> seen;
+  for (Pending& entry : pending) {
+    if (!entry.pem_.has_value() || !seen.insert(entry.key_).second) {
+      continue;
+    }
+    if (TrustedCaBundleSharedPtr bundle = find(entry.key_); bundle != nullptr) {
+      bundles.push_back(std::move(bundle));
+    } else {
+      to_parse.push_back(&entry);
+    }
+  }
+
+  // Parse them on the pool.
+  tasks = std::min<size_t>(pool.concurrency(), to_parse.size());
+  pool.run(tasks, [&](uint32_t task) {
+    for (size_t i = task; i < to_parse.size(); i += tasks) {
+      to_parse[i]->bundle_ = parse(*to_parse[i]->pem_);
+    }
+  });
+
+  // Cache them on this thread, in the order of the sockets.
+  for (Pending* entry : to_parse) {
+    if (entry->bundle_ != nullptr) {
+      insert(entry->key_, entry->bundle_);
+      bundles.push_back(std::move(entry->bundle_));
+    }
+  }
+  return bundles;
+}
+
+TrustedCaBundleCache::Key TrustedCaBundleCache::key(absl::string_view pem) {
+  Key pem_key;
+  SHA256(reinterpret_cast<const uint8_t*>(pem.data()), pem.size(), pem_key.data());
+  return pem_key;
+}
+
+TrustedCaBundleSharedPtr TrustedCaBundleCache::parse(absl::string_view pem) {
+  bssl::UniquePtr<BIO> bio(BIO_new_mem_buf(pem.data(), pem.size()));
+  RELEASE_ASSERT(bio != nullptr, "");
+  // Based on BoringSSL's X509_load_cert_crl_file().
+  STACK_OF(X509_INFO)* list = PEM_X509_INFO_read_bio(bio.get(), nullptr, nullptr, nullptr);
+  if (list == nullptr) {
+    return nullptr;
+  }
+  return {list, [](STACK_OF(X509_INFO) * stack) { sk_X509_INFO_pop_free(stack, X509_INFO_free); }};
+}
+
+absl::optional<std::string> TrustedCaBundleCache::readTrustedCa(
+    const envoy::config::core::v3::TransportSocket& transport_socket, Api::Api& api) {
+  if (!transport_socket.has_typed_config() ||
+      !transport_socket.typed_config()
+           .Is<envoy::extensions::transport_sockets::tls::v3::UpstreamTlsContext>()) {
+    return absl::nullopt;
+  }
+  envoy::extensions::transport_sockets::tls::v3::UpstreamTlsContext tls_context;
+  if (!MessageUtil::unpackTo(transport_socket.typed_config(), tls_context).ok()) {
+    return absl::nullopt;
+  }
+  const auto& common_tls_context = tls_context.common_tls_context();
+  const envoy::config::core::v3::DataSource& trusted_ca =
+      common_tls_context.has_combined_validation_context()
+          ? common_tls_context.combined_validation_context()
+                .default_validation_context()
+                .trusted_ca()
+          : common_tls_context.validation_context().trusted_ca();
+  absl::StatusOr<std::string> pem = Config::DataSource::read(trusted_ca, true, api);
+  if (!pem.ok() || pem->empty()) {
+    return absl::nullopt;
+  }
+  return std::move(pem.value());
+}
+
+TrustedCaBundleSharedPtr TrustedCaBundleCache::find(const Key& bundle_key) const {
+  auto it = bundles_.find(bundle_key);
+  return it != bundles_.end() ? it->second.lock() : nullptr;
+}
+
+void TrustedCaBundleCache::insert(const Key& bundle_key, const TrustedCaBundleSharedPtr& bundle) {
+  bundles_[bundle_key] = bundle;
+  if (bundles_.size() < prune_at_) {
+    return;
+  }
+  // Erase the entries of released bundles, which keeps the cost amortized over the inserts.
+  absl::erase_if(bundles_, [](const auto& entry) { return entry.second.expired(); });
+  prune_at_ = std::max(MinPruneAt, 2 * bundles_.size());
+}
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
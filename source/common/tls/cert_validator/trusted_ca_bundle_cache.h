@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/api/api.h"
+#include "envoy/config/core/v3/base.pb.h"
+#include "envoy/singleton/instance.h"
+#include "envoy/singleton/manager.h"
+
+#include "source/common/common/helper_thread_pool.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "openssl/sha.h"
+#include "openssl/x509.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+/**
+ * The certificates and CRLs of a PEM bundle of trusted CAs. The stack must not be modified, and
+ * may be released from any thread.
+ */
+using TrustedCaBundleSharedPtr = std::shared_ptr<STACK_OF(X509_INFO)>;
+
+/**
+ * Parsed trusted CA bundles by the SHA-256 digest of their PEM. Many contexts usually trust the
+ * same bundle, e.g. the clusters of a large CDS update, so a bundle is parsed once and shared for
+ * as long as any context holds it. The cache itself is only accessed from the main thread.
+ */
+class TrustedCaBundleCache : public Singleton::Instance {
+public:
+  using Key = std::array<uint8_t, SHA256_DIGEST_LENGTH>;
+
+  /**
+   * @return the cache of the process, which is created on first use.
+   */
+  static std::shared_ptr<TrustedCaBundleCache> get(Singleton::Manager& singleton_manager);
+
+  /**
+   * @return the cached bundle of the PEM, which is parsed and cached if no context holds it, or
+   *         nullptr if it cannot be parsed.
+   */
+  TrustedCaBundleSharedPtr getOrParse(absl::string_view pem);
+
+  /**
+   * Reads and parses the trusted CA bundles referenced by the upstream TLS transport sockets on
+   * the helper pool, and caches them in the order of the sockets. Transport sockets of other types
+   * and bundles that cannot be read or parsed are skipped, as creating their contexts reports the
+   * error.
+   * @return the bundles, which are only kept in the cache for as long as they are held.
+   */
+  std::vector<TrustedCaBundleSharedPtr>
+  prepare(const std::vector<const envoy::config::core::v3::TransportSocket*>& transport_sockets,
+          Api::Api& api, Thread::HelperThreadPool& pool);
+
+  /**
+   * @return the key of the PEM in the cache.
+   */
+  static Key key(absl::string_view pem);
+
+  /**
+   * @return the bundle of the PEM, without the cache, or nullptr if it cannot be parsed.
+   */
+  static TrustedCaBundleSharedPtr parse(absl::string_view pem);
+
+  /**
+   * @return the PEM of the trusted CA bundle of an upstream TLS transport socket, or
+   *         absl::nullopt if it does not have one or it cannot be read.
+   */
+  static absl::optional<std::string>
+  readTrustedCa(const envoy::config::core::v3::TransportSocket& transport_socket, Api::Api& api);
+
+private:
+  static constexpr size_t MinPruneAt = 16;
+
+  TrustedCaBundleSharedPtr find(const Key& bundle_key) const;
+  void insert(const Key& bundle_key, const TrustedCaBundleSharedPtr& bundle);
+
+  absl::flat_hash_map<Key, std::weak_ptr<STACK_OF(X509_INFO)>> bundles_;
+  // The number of entries at which the entries of released bundles are next erased.
+  size_t prune_at_{MinPruneAt};
+};
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -93,6 +93,11 @@ public:
 
   SslStats& stats() { return stats_; }
 
+  /**
+   * @return whether connections created by this context may renegotiate after the handshake.
+   */
+  virtual bool allowsRenegotiation() const { return false; }
+
   /**
    * The global SSL-library index used for storing a pointer to the SslExtendedSocketInfo
    * class in the SSL instance, for retrieval in callbacks.
@@ -4,11 +4,15 @@
 #include <cstddef>
 #include <functional>
 #include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
 
 #include "envoy/stats/scope.h"
 
 #include "source/common/common/assert.h"
 #include "source/common/config/utility.h"
+#include "source/common/tls/cert_validator/trusted_ca_bundle_cache.h"
 #include "source/common/tls/client_context_impl.h"
 #include "source/common/tls/context_impl.h"
 
@@ -17,6 +21,23 @@ namespace Extensions {
 namespace TransportSockets {
 namespace Tls {
 
+namespace {
+
+// Bounds the threads that prepare client contexts, including the main thread.
+constexpr uint32_t MaxPrepareConcurrency = 4;
+
+class PreparedClientContextsImpl : public Envoy::Ssl::PreparedClientContexts {
+public:
+  explicit PreparedClientContextsImpl(std::vector<TrustedCaBundleSharedPtr> trusted_ca_bundles)
+      : trusted_ca_bundles_(std::move(trusted_ca_bundles)) {}
+
+private:
+  // Held so that the contexts created meanwhile find the bundles in the cache.
+  const std::vector<TrustedCaBundleSharedPtr> trusted_ca_bundles_;
+};
+
+} // namespace
+
 ContextManagerImpl::ContextManagerImpl(Server::Configuration::CommonFactoryContext& factory_context)
     : factory_context_(factory_context) {}
 
@@ -34,6 +55,20 @@ ContextManagerImpl::createSslClientContext(Stats::Scope& scope,
   return context;
 }
 
+Envoy::Ssl::PreparedClientContextsPtr ContextManagerImpl::prepareClientContexts(
+    const std::vector<const envoy::config::core::v3::TransportSocket*>& transport_sockets) {
+  ASSERT_IS_MAIN_OR_TEST_THREAD();
+  if (prepare_pool_ == nullptr) {
+    const uint32_t concurrency =
+        std::max(1U, std::min(MaxPrepareConcurrency, std::thread::hardware_concurrency()));
+    prepare_pool_ = std::make_unique<Thread::HelperThreadPool>(
+        factory_context_.api().threadFactory(), concurrency - 1, "tls_prepare");
+  }
+  return std::make_unique<PreparedClientContextsImpl>(
+      TrustedCaBundleCache::get(factory_context_.singletonManager())
+          ->prepare(transport_sockets, factory_context_.api(), *prepare_pool_));
+}
+
 absl::StatusOr<Envoy::Ssl::ServerContextSharedPtr> ContextManagerImpl::createSslServerContext(
     Stats::Scope& scope, const Envoy::Ssl::ServerContextConfig& config,
     const std::vector<std::string>& server_names, Ssl::ContextAdditionalInitFunc additional_init) {
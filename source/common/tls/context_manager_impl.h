@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <functional>
 #include <list>
+#include <memory>
+#include <vector>
 
 #include "envoy/common/time.h"
 #include "envoy/server/factory_context.h"
@@ -10,6 +12,7 @@
 #include "envoy/ssl/private_key/private_key.h"
 #include "envoy/stats/scope.h"
 
+#include "source/common/common/helper_thread_pool.h"
 #include "source/common/tls/private_key/private_key_manager_impl.h"
 
 namespace Envoy {
@@ -32,6 +35,9 @@ public:
   absl::StatusOr<Ssl::ClientContextSharedPtr>
   createSslClientContext(Stats::Scope& scope,
                          const Envoy::Ssl::ClientContextConfig& config) override;
+  Ssl::PreparedClientContextsPtr prepareClientContexts(
+      const std::vector<const envoy::config::core::v3::TransportSocket*>& transport_sockets)
+      override;
   absl::StatusOr<Ssl::ServerContextSharedPtr>
   createSslServerContext(Stats::Scope& scope, const Envoy::Ssl::ServerContextConfig& config,
                          const std::vector<std::string>& server_names,
@@ -48,6 +54,8 @@ private:
   Server::Configuration::CommonFactoryContext& factory_context_;
   absl::flat_hash_set<Envoy::Ssl::ContextSharedPtr> contexts_;
   PrivateKeyMethodManagerImpl private_key_method_manager_{};
+  // Created on the first prepareClientContexts() call.
+  std::unique_ptr<Thread::HelperThreadPool> prepare_pool_;
 };
 
 } // namespace Tls
@@ -88,6 +88,21 @@ const BIO_METHOD* BIO_s_io_handle(void) {
   return method;
 }
 
+// NOLINTNEXTLINE(readability-identifier-naming)
+int discard_write(BIO*, const char*, int inl) { return inl; }
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+const BIO_METHOD* BIO_s_discard(void) {
+  static const BIO_METHOD* method = [&] {
+    BIO_METHOD* ret = BIO_meth_new(BIO_TYPE_NONE, "discard");
+    RELEASE_ASSERT(ret != nullptr, "");
+    RELEASE_ASSERT(BIO_meth_set_write(ret, discard_write), "");
+    RELEASE_ASSERT(BIO_meth_set_ctrl(ret, io_handle_ctrl), "");
+    return ret;
+  }();
+  return method;
+}
+
 } // namespace
 
 // NOLINTNEXTLINE(readability-identifier-naming)
@@ -104,6 +119,14 @@ BIO* BIO_new_io_handle(Envoy::Network::IoHandle* io_handle) {
   return b;
 }
 
+// NOLINTNEXTLINE(readability-identifier-naming)
+BIO* BIO_new_discard() {
+  BIO* b = BIO_new(BIO_s_discard());
+  RELEASE_ASSERT(b != nullptr, "");
+  BIO_set_init(b, 1);
+  return b;
+}
+
 } // namespace Tls
 } // namespace TransportSockets
 } // namespace Extensions
@@ -17,6 +17,13 @@ namespace Tls {
 // NOLINTNEXTLINE(readability-identifier-naming)
 BIO* BIO_new_io_handle(Envoy::Network::IoHandle* io_handle);
 
+/**
+ * Creates a custom BIO that accepts and discards everything written to it, for an SSL connection
+ * that must no longer write to its socket.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)
+BIO* BIO_new_discard();
+
 } // namespace Tls
 } // namespace TransportSockets
 } // namespace Extensions
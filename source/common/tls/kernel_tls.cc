@@ -0,0 +1,186 @@
+#include "source/common/tls/kernel_tls.h"
+
+#include <cstring>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/safe_memcpy.h"
+#include "source/common/common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "openssl/mem.h"
+
+#if defined(__linux__)
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+#endif
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace KernelTls {
+
+#if defined(__linux__)
+
+namespace {
+
+// Older libc headers do not define these.
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+
+constexpr uint8_t AlertRecordType = 21;
+constexpr uint8_t AlertLevelWarning = 1;
+constexpr uint8_t AlertCloseNotify = 0;
+
+// The TLS 1.2 key block, as laid out by RFC 5246 section 6.3 for AEAD ciphers, which have no MAC
+// keys: client key, server key, client IV, server IV.
+struct KeyBlock {
+  KeyBlock(size_t key_len, size_t iv_len) : key_len_(key_len), iv_len_(iv_len) {}
+  ~KeyBlock() { OPENSSL_cleanse(data_, sizeof(data_)); }
+
+  size_t size() const { return 2 * (key_len_ + iv_len_); }
+  const uint8_t* key(bool server) const { return data_ + (server ? key_len_ : 0); }
+  const uint8_t* iv(bool server) const { return data_ + 2 * key_len_ + (server ? iv_len_ : 0); }
+
+  const size_t key_len_;
+  const size_t iv_len_;
+  // Large enough for two 256 bit keys and two 96 bit IVs.
+  uint8_t data_[88];
+};
+
+template <class CryptoInfo> void setRecordSequence(CryptoInfo& info, uint64_t sequence) {
+  const uint64_t big_endian = htobe64(sequence);
+  static_assert(sizeof(info.rec_seq) == sizeof(big_endian));
+  safeMemcpyUnsafeDst(info.rec_seq, &big_endian);
+}
+
+absl::Status installTxKeys(os_fd_t fd, const void* crypto_info, socklen_t length) {
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+  const Api::SysCallIntResult ulp = os_sys_calls.setsockopt(fd, IPPROTO_TCP, TCP_ULP, "tls", 3);
+  if (ulp.return_value_ != 0) {
+    return absl::UnavailableError(
+        absl::StrCat("kernel TLS is unavailable: ", errorDetails(ulp.errno_)));
+  }
+  const Api::SysCallIntResult tx =
+      os_sys_calls.setsockopt(fd, SOL_TLS, TLS_TX, crypto_info, length);
+  if (tx.return_value_ != 0) {
+    return absl::UnavailableError(
+        absl::StrCat("kernel TLS rejected the keys: ", errorDetails(tx.errno_)));
+  }
+  return absl::OkStatus();
+}
+
+} // namespace
+
+absl::Status enableTx(SSL* ssl, os_fd_t fd) {
+  if (SSL_version(ssl) != TLS1_2_VERSION) {
+    return absl::UnimplementedError("kernel TLS is only used for TLS 1.2");
+  }
+  if (SSL_in_false_start(ssl)) {
+    return absl::FailedPreconditionError("handshake is in False Start");
+  }
+
+  const int cipher_nid = SSL_CIPHER_get_cipher_nid(SSL_get_current_cipher(ssl));
+  size_t key_len;
+  size_t iv_len;
+  switch (cipher_nid) {
+  case NID_aes_128_gcm:
+    key_len = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+    iv_len = TLS_CIPHER_AES_GCM_128_SALT_SIZE;
+    break;
+  case NID_aes_256_gcm:
+    key_len = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+    iv_len = TLS_CIPHER_AES_GCM_256_SALT_SIZE;
+    break;
+  case NID_chacha20_poly1305:
+    key_len = TLS_CIPHER_CHACHA20_POLY1305_KEY_SIZE;
+    iv_len = TLS_CIPHER_CHACHA20_POLY1305_IV_SIZE;
+    break;
+  default:
+    return absl::UnimplementedError(
+        absl::StrCat("cipher ", SSL_get_cipher_name(ssl), " is not supported by kernel TLS"));
+  }
+
+  KeyBlock key_block(key_len, iv_len);
+  if (static_cast<size_t>(SSL_get_key_block_len(ssl)) != key_block.size() ||
+      !SSL_generate_key_block(ssl, key_block.data_, key_block.size())) {
+    return absl::InternalError("failed to export the TLS key block");
+  }
+
+  const bool server = SSL_is_server(ssl);
+  const uint64_t sequence = SSL_get_write_sequence(ssl);
+  if (cipher_nid == NID_chacha20_poly1305) {
+    tls12_crypto_info_chacha20_poly1305 info{};
+    info.info.version = TLS_1_2_VERSION;
+    info.info.cipher_type = TLS_CIPHER_CHACHA20_POLY1305;
+    memcpy(info.key, key_block.key(server), sizeof(info.key));
+    memcpy(info.iv, key_block.iv(server), sizeof(info.iv));
+    setRecordSequence(info, sequence);
+    absl::Status status = installTxKeys(fd, &info, sizeof(info));
+    OPENSSL_cleanse(&info, sizeof(info));
+    return status;
+  }
+
+  // AES-GCM and AES-256-GCM share a layout apart from the key size. BoringSSL uses the record
+  // sequence number as the explicit part of the nonce, so the kernel is seeded with it too.
+  const auto fill = [&](auto& info, uint16_t cipher_type) {
+    info.info.version = TLS_1_2_VERSION;
+    info.info.cipher_type = cipher_type;
+    memcpy(info.key, key_block.key(server), sizeof(info.key));
+    memcpy(info.salt, key_block.iv(server), sizeof(info.salt));
+    setRecordSequence(info, sequence);
+    memcpy(info.iv, info.rec_seq, sizeof(info.iv));
+  };
+  if (cipher_nid == NID_aes_128_gcm) {
+    tls12_crypto_info_aes_gcm_128 info{};
+    fill(info, TLS_CIPHER_AES_GCM_128);
+    absl::Status status = installTxKeys(fd, &info, sizeof(info));
+    OPENSSL_cleanse(&info, sizeof(info));
+    return status;
+  }
+  tls12_crypto_info_aes_gcm_256 info{};
+  fill(info, TLS_CIPHER_AES_GCM_256);
+  absl::Status status = installTxKeys(fd, &info, sizeof(info));
+  OPENSSL_cleanse(&info, sizeof(info));
+  return status;
+}
+
+Api::SysCallSizeResult sendCloseNotify(os_fd_t fd) {
+  uint8_t alert[CloseNotifySize] = {AlertLevelWarning, AlertCloseNotify};
+  iovec iov{alert, sizeof(alert)};
+  alignas(cmsghdr) uint8_t control[CMSG_SPACE(sizeof(uint8_t))]{};
+
+  msghdr message{};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+  cmsg->cmsg_level = SOL_TLS;
+  cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(uint8_t));
+  *CMSG_DATA(cmsg) = AlertRecordType;
+
+  return Api::OsSysCallsSingleton::get().sendmsg(fd, &message, 0);
+}
+
+#else
+
+absl::Status enableTx(SSL*, os_fd_t) {
+  return absl::UnimplementedError("kernel TLS is only supported on Linux");
+}
+
+Api::SysCallSizeResult sendCloseNotify(os_fd_t) { PANIC("not implemented"); }
+
+#endif
+
+} // namespace KernelTls
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
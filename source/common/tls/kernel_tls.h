@@ -0,0 +1,52 @@
+#pragma once
+
+#include "envoy/api/os_sys_calls.h"
+#include "envoy/common/platform.h"
+
+#include "absl/status/status.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace KernelTls {
+
+/**
+ * Moves record encryption for data sent on a connection into the kernel (kTLS). On success the
+ * kernel owns the connection's write keys and sequence number: application data must then be
+ * written to the socket in the clear, and BoringSSL must not write to the socket again.
+ *
+ * Only the transmit direction of TLS 1.2 connections using AES-GCM or ChaCha20-Poly1305 is
+ * offloaded. TLS 1.3 key updates and post-handshake messages, and TLS 1.2 renegotiation, need
+ * BoringSSL to keep control of the keys, so callers must not offload connections that may
+ * renegotiate.
+ * @param ssl supplies a connection whose handshake has completed.
+ * @param fd supplies the connection's socket.
+ * @return OkStatus if the keys were installed, or an error describing why the connection must
+ *         stay on the user space path. The socket is unchanged unless only the final step failed,
+ *         in which case it keeps the "tls" upper layer protocol without any keys, which is
+ *         equivalent to a plain socket.
+ */
+absl::Status enableTx(SSL* ssl, os_fd_t fd);
+
+/**
+ * The size of a close_notify alert: the alert level and the alert description.
+ */
+constexpr uint64_t CloseNotifySize = 2;
+
+/**
+ * Sends a close_notify alert as a single alert record on a socket with kernel TLS transmit
+ * enabled. The alert is always sent whole: if the socket is full, the call fails with EAGAIN and
+ * the whole alert has to be sent again later, since a fragment of it would be sent as a record of
+ * its own.
+ * @param fd supplies the connection's socket.
+ * @return the result of the sendmsg() call carrying the alert.
+ */
+Api::SysCallSizeResult sendCloseNotify(os_fd_t fd);
+
+} // namespace KernelTls
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
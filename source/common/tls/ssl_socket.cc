@@ -6,7 +6,9 @@
 #include "source/common/common/empty_string.h"
 #include "source/common/common/hex.h"
 #include "source/common/http/headers.h"
+#include "source/common/runtime/runtime_features.h"
 #include "source/common/tls/io_handle_bio.h"
+#include "source/common/tls/kernel_tls.h"
 #include "source/common/tls/ssl_handshaker.h"
 #include "source/common/tls/utility.h"
 
@@ -201,9 +203,34 @@ void SslSocket::onSuccess(SSL* ssl) {
     callbacks_->connection().streamInfo().downstreamTiming().onDownstreamHandshakeComplete(
         callbacks_->connection().dispatcher().timeSource());
   }
+  enableKernelTlsTx(ssl);
   callbacks_->raiseEvent(Network::ConnectionEvent::Connected);
 }
 
+void SslSocket::enableKernelTlsTx(SSL* ssl) {
+  // The kernel cannot follow a renegotiation, so such connections stay on the user space path.
+  if (!Runtime::runtimeFeatureEnabled("envoy.reloadable_features.tls_kernel_tx_offload") ||
+      ctx_->allowsRenegotiation() || !SOCKET_VALID(callbacks_->ioHandle().fdDoNotUse())) {
+    return;
+  }
+
+  const absl::Status status = KernelTls::enableTx(ssl, callbacks_->ioHandle().fdDoNotUse());
+  if (!status.ok()) {
+    ENVOY_CONN_LOG(debug, "not using kernel TLS: {}", callbacks_->connection(), status.message());
+    if (absl::IsUnavailable(status)) {
+      ctx_->stats().kernel_tls_tx_failed_.inc();
+    }
+    return;
+  }
+
+  // The kernel now owns the write keys and sequence number, so BoringSSL must not write to the
+  // socket again. Anything it would still send, such as a fatal alert after a read error, is
+  // discarded; the connection is closed in that case anyway.
+  SSL_set0_wbio(ssl, BIO_new_discard());
+  kernel_tls_tx_ = true;
+  ctx_->stats().kernel_tls_tx_.inc();
+}
+
 void SslSocket::onFailure() { drainErrorQueue(); }
 
 PostIoAction SslSocket::doHandshake() { return info_->doHandshake(); }
@@ -263,6 +290,10 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
     }
   }
 
+  if (kernel_tls_tx_) {
+    return doKernelTlsWrite(write_buffer, end_stream);
+  }
+
   uint64_t bytes_to_write;
   if (bytes_to_retry_) {
     bytes_to_write = bytes_to_retry_;
@@ -313,6 +344,32 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
   return {PostIoAction::KeepOpen, total_bytes_written, false};
 }
 
+Network::IoResult SslSocket::doKernelTlsWrite(Buffer::Instance& write_buffer, bool end_stream) {
+  // The kernel frames and encrypts whatever is written to the socket, so this is the plain socket
+  // write path.
+  uint64_t total_bytes_written = 0;
+  while (write_buffer.length() > 0) {
+    Api::IoCallUint64Result result = callbacks_->ioHandle().write(write_buffer);
+    if (!result.ok()) {
+      ENVOY_CONN_LOG(trace, "kernel TLS write error: {}", callbacks_->connection(),
+                     result.err_->getErrorDetails());
+      if (result.err_->getErrorCode() == Api::IoError::IoErrorCode::Again) {
+        break;
+      }
+      return {PostIoAction::Close, total_bytes_written, false, result.err_->getErrorCode()};
+    }
+    ENVOY_CONN_LOG(trace, "kernel TLS write returns: {}", callbacks_->connection(),
+                   result.return_value_);
+    total_bytes_written += result.return_value_;
+  }
+
+  if (write_buffer.length() == 0 && end_stream) {
+    shutdownSsl();
+  }
+
+  return {PostIoAction::KeepOpen, total_bytes_written, false};
+}
+
 void SslSocket::onConnected() { ASSERT(info_->state() == Ssl::SocketState::PreHandshake); }
 
 Ssl::ConnectionInfoConstSharedPtr SslSocket::ssl() const { return info_; }
@@ -321,6 +378,10 @@ void SslSocket::shutdownSsl() {
   ASSERT(info_->state() != Ssl::SocketState::PreHandshake);
   if (info_->state() != Ssl::SocketState::ShutdownSent &&
       callbacks_->connection().state() != Network::Connection::State::Closed) {
+    if (kernel_tls_tx_) {
+      shutdownKernelTls();
+      return;
+    }
     int rc = SSL_shutdown(rawSsl());
     if constexpr (Event::PlatformDefaultTriggerType == Event::FileTriggerType::EmulatedEdge) {
       // Windows operate under `EmulatedEdge`. These are level events that are artificially
@@ -339,6 +400,26 @@ void SslSocket::shutdownSsl() {
   }
 }
 
+void SslSocket::shutdownKernelTls() {
+  // BoringSSL can no longer write, so the close_notify alert goes through the kernel as one record.
+  // If the socket is full, the whole record is sent again on the next write event, or before the
+  // socket is closed.
+  const Api::SysCallSizeResult result =
+      KernelTls::sendCloseNotify(callbacks_->ioHandle().fdDoNotUse());
+  ENVOY_CONN_LOG(debug, "kernel TLS shutdown: rc={}", callbacks_->connection(),
+                 result.return_value_);
+  if (result.return_value_ < 0 && result.errno_ == SOCKET_ERROR_AGAIN) {
+    kernel_tls_close_notify_pending_ = true;
+    return;
+  }
+  if (result.return_value_ != static_cast<ssize_t>(KernelTls::CloseNotifySize)) {
+    // Sending the rest of a short write would split the alert into records of their own.
+    ctx_->stats().kernel_tls_close_notify_failed_.inc();
+  }
+  kernel_tls_close_notify_pending_ = false;
+  info_->setState(Ssl::SocketState::ShutdownSent);
+}
+
 void SslSocket::shutdownBasic() {
   if (info_->state() != Ssl::SocketState::ShutdownSent &&
       callbacks_->connection().state() != Network::Connection::State::Closed) {
@@ -360,6 +441,12 @@ void SslSocket::closeSocket(Network::ConnectionEvent) {
   if (info_->state() == Ssl::SocketState::HandshakeInProgress ||
       info_->state() == Ssl::SocketState::HandshakeComplete) {
     shutdownSsl();
+    if (kernel_tls_close_notify_pending_) {
+      // The socket is about to be closed, so the rest of the close_notify alert is lost.
+      ctx_->stats().kernel_tls_close_notify_failed_.inc();
+      kernel_tls_close_notify_pending_ = false;
+      info_->setState(Ssl::SocketState::ShutdownSent);
+    }
   } else {
     // We're not in a state to do the full SSL shutdown so perform a basic shutdown to flush any
     // outstanding alerts
@@ -94,8 +94,11 @@ private:
   ReadResult sslReadIntoSlice(Buffer::RawSlice& slice);
 
   Network::PostIoAction doHandshake();
+  void enableKernelTlsTx(SSL* ssl);
+  Network::IoResult doKernelTlsWrite(Buffer::Instance& write_buffer, bool end_stream);
   void drainErrorQueue();
   void shutdownSsl();
+  void shutdownKernelTls();
   void shutdownBasic();
   void resumeHandshake();
 
@@ -104,6 +107,10 @@ private:
   ContextImplSharedPtr ctx_;
   uint64_t bytes_to_retry_{};
   std::string failure_reason_;
+  // Whether record encryption for sent data has been moved into the kernel.
+  bool kernel_tls_tx_{false};
+  // Whether the close_notify alert still has to be sent once the socket has room for it.
+  bool kernel_tls_close_notify_pending_{false};
 
   SslHandshakerImplSharedPtr info_;
 };
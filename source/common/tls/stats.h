@@ -21,7 +21,10 @@ namespace Tls {
   COUNTER(ocsp_staple_omitted)                                                                     \
   COUNTER(ocsp_staple_responses)                                                                   \
   COUNTER(ocsp_staple_requests)                                                                    \
-  COUNTER(was_key_usage_invalid)
+  COUNTER(was_key_usage_invalid)                                                                   \
+  COUNTER(kernel_tls_tx)                                                                           \
+  COUNTER(kernel_tls_tx_failed)                                                                    \
+  COUNTER(kernel_tls_close_notify_failed)
 
 /**
  * Wrapper struct for SSL stats. @see stats_macros.h
@@ -4,6 +4,7 @@
 #include "envoy/config/cluster/v3/cluster.pb.h"
 #include "envoy/config/endpoint/v3/endpoint.pb.h"
 #include "envoy/config/grpc_mux.h"
+#include "envoy/ssl/context_manager.h"
 
 #include "source/common/common/fmt.h"
 #include "source/common/config/resource_name.h"
@@ -31,6 +32,25 @@ CdsApiHelper::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& adde
   ENVOY_LOG(info, "{}: add {} cluster(s), remove {} cluster(s)", name_, added_resources.size(),
             removed_resources.size());
 
+  // Parse the trusted CA bundles of the clusters on helper threads, so that creating their TLS
+  // contexts one by one below reuses them. Held until all the clusters have been applied.
+  std::vector<const envoy::config::core::v3::TransportSocket*> transport_sockets;
+  for (const auto& resource : added_resources) {
+    const auto* cluster =
+        dynamic_cast<const envoy::config::cluster::v3::Cluster*>(&resource.get().resource());
+    if (cluster == nullptr) {
+      continue;
+    }
+    if (cluster->has_transport_socket()) {
+      transport_sockets.push_back(&cluster->transport_socket());
+    }
+    for (const auto& match : cluster->transport_socket_matches()) {
+      transport_sockets.push_back(&match.transport_socket());
+    }
+  }
+  const Ssl::PreparedClientContextsPtr prepared_client_contexts =
+      cm_.clusterManagerFactory().sslContextManager().prepareClientContexts(transport_sockets);
+
   std::vector<std::string> exception_msgs;
   absl::flat_hash_set<std::string> cluster_names(added_resources.size());
   bool any_applied = false;
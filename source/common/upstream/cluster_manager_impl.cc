@@ -1370,7 +1370,11 @@ void ClusterManagerImpl::postThreadLocalClusterUpdate(ClusterManagerCluster& cm_
                                                         load_balancer_factory, host_map,
                                                         drop_overload, drop_category);
 
-  tls_.runOnAllThreads([info = cm_cluster.cluster().info(), params = std::move(params),
+  // The callback is copied for each worker, so the update is shared rather than copying the added
+  // and removed hosts for every worker. Workers adopt the shared host vectors by pointer.
+  tls_.runOnAllThreads([info = cm_cluster.cluster().info(),
+                        params = std::make_shared<const ThreadLocalClusterUpdateParams>(
+                            std::move(params)),
                         add_or_update_cluster, load_balancer_factory, map = std::move(host_map),
                         cluster_initialization_object = std::move(cluster_initialization_object),
                         drop_overload, drop_category = std::move(drop_category)](
@@ -1434,7 +1438,7 @@ void ClusterManagerImpl::postThreadLocalClusterUpdate(ClusterManagerCluster& cm_
         cluster_manager->thread_local_clusters_[info->name()]->setDropOverload(drop_overload);
         cluster_manager->thread_local_clusters_[info->name()]->setDropCategory(drop_category);
       }
-      for (const auto& per_priority : params.per_priority_update_params_) {
+      for (const auto& per_priority : params->per_priority_update_params_) {
         cluster_manager->updateClusterMembership(
             info->name(), per_priority.priority_, per_priority.update_hosts_params_,
             per_priority.locality_weights_, per_priority.hosts_added_, per_priority.hosts_removed_,
@@ -91,6 +91,7 @@ public:
                       const xds::core::v3::ResourceLocator* cds_resources_locator,
                       ClusterManager& cm) override;
   Secret::SecretManager& secretManager() override { return secret_manager_; }
+  Ssl::ContextManager& sslContextManager() override { return ssl_context_manager_; }
   Singleton::Manager& singletonManager() override { return context_.singletonManager(); }
 
 protected:
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <vector>
+
+#include "envoy/upstream/scheduler.h"
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Upstream {
+
+// Interleaved Weighted Round Robin (IWRR) Scheduler
+// -------------------------------------------------
+// Weights are quantized to one of Levels levels relative to the largest weight, and a cycle is made
+// of Levels rounds. Round r visits, in a fixed order, every entry whose level is above r, so an
+// entry of level q is picked q times per cycle. Entries are kept sorted by decreasing level, which
+// makes the entries of a round a prefix of that order: a pick only advances an index, and is O(1).
+// Rounds are visited in bit reversed order so that the rounds an entry takes part in are spread
+// over the cycle instead of being bunched at its start.
+//
+// Weights smaller than 1 / Levels of the largest weight are rounded up to it. A weight returned by
+// the calculate_weight callback of a pick is recorded in O(1) and takes effect when the schedule is
+// rebuilt, which happens in O(n + Levels) at the end of a cycle, or as soon as a quarter of the
+// entries' weights changed. Weights that change on every pick, as in the least request LB, thus
+// cost O(1) amortized per pick. Adding an entry also rebuilds the schedule on the next pick.
+template <class C> class IwrrScheduler : public Scheduler<C> {
+public:
+  // Must be a power of two for the bit reversed round order.
+  static constexpr uint32_t Levels = 256;
+
+  IwrrScheduler() = default;
+
+  // See scheduler.h for an explanation of each public method.
+  std::shared_ptr<C> peekAgain(std::function<double(const C&)> calculate_weight) override {
+    std::shared_ptr<C> ret = pickInternal(calculate_weight);
+    if (ret) {
+      prepick_list_.push(ret);
+    }
+    return ret;
+  }
+
+  std::shared_ptr<C> pickAndAdd(std::function<double(const C&)> calculate_weight) override {
+    while (!prepick_list_.empty()) {
+      // The weight of this entry was already updated by peekAgain.
+      std::shared_ptr<C> ret = prepick_list_.front().lock();
+      prepick_list_.pop();
+      if (ret) {
+        return ret;
+      }
+    }
+    return pickInternal(calculate_weight);
+  }
+
+  void add(double weight, std::shared_ptr<C> entry) override {
+    ASSERT(weight > 0);
+    entries_.push_back({entry, weight, 0});
+    rebuild_ = true;
+  }
+
+  bool empty() const override { return entries_.empty(); }
+
+  // Creates an IwrrScheduler with the given entries and positions it as if "picks" picks had
+  // already been performed without changing any weight.
+  static IwrrScheduler<C> createWithPicks(const std::vector<std::shared_ptr<C>>& entries,
+                                          std::function<double(const C&)> calculate_weight,
+                                          uint32_t picks) {
+    IwrrScheduler<C> scheduler;
+    scheduler.entries_.reserve(entries.size());
+    for (const auto& entry : entries) {
+      scheduler.add(calculate_weight(*entry), entry);
+    }
+    scheduler.rebuild();
+    if (scheduler.cycle_length_ == 0) {
+      return scheduler;
+    }
+    // A cycle is at most Levels * n picks, so this only walks over the rounds once.
+    uint64_t offset = picks % scheduler.cycle_length_;
+    while (offset >= scheduler.round_sizes_[scheduler.round_]) {
+      offset -= scheduler.round_sizes_[scheduler.round_];
+      ++scheduler.round_;
+    }
+    scheduler.index_ = offset;
+    return scheduler;
+  }
+
+private:
+  struct Entry {
+    std::weak_ptr<C> entry_;
+    double weight_;
+    // Number of rounds per cycle the entry takes part in, in [1, Levels].
+    uint32_t level_;
+  };
+
+  std::shared_ptr<C> pickInternal(const std::function<double(const C&)>& calculate_weight) {
+    while (true) {
+      if (rebuild_) {
+        rebuild();
+      }
+      if (entries_.empty()) {
+        return nullptr;
+      }
+      if (index_ >= round_sizes_[round_]) {
+        index_ = 0;
+        if (++round_ == Levels) {
+          round_ = 0;
+          rebuild_ = stale_ > 0;
+          continue;
+        }
+      }
+      Entry& entry = entries_[order_[index_++]];
+      std::shared_ptr<C> ret = entry.entry_.lock();
+      if (ret == nullptr) {
+        // Drop the expired entry.
+        rebuild_ = true;
+        continue;
+      }
+      const double weight = calculate_weight(*ret);
+      ASSERT(weight > 0);
+      if (weight != entry.weight_) {
+        entry.weight_ = weight;
+        rebuild_ = ++stale_ >= std::max<size_t>(1, entries_.size() / 4);
+      }
+      return ret;
+    }
+  }
+
+  // Recomputes the levels, the entry order and the round sizes. The position in the cycle is kept,
+  // so that rebuilding mid-cycle does not favor the entries at the start of a round.
+  void rebuild() {
+    rebuild_ = false;
+    stale_ = 0;
+    entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                  [](const Entry& entry) { return entry.entry_.expired(); }),
+                   entries_.end());
+    order_.resize(entries_.size());
+    cycle_length_ = 0;
+    if (entries_.empty()) {
+      return;
+    }
+
+    double max_weight = 0;
+    for (const Entry& entry : entries_) {
+      max_weight = std::max(max_weight, entry.weight_);
+    }
+    // Counting sort by decreasing level. at_least[l] ends up as the number of entries with a level
+    // of at least l, which is also where the entries of level l - 1 start in order_.
+    std::array<uint32_t, Levels + 2> at_least{};
+    for (Entry& entry : entries_) {
+      entry.level_ = std::clamp<int64_t>(std::lround(entry.weight_ / max_weight * Levels), 1,
+                                         Levels);
+      ++at_least[entry.level_];
+      cycle_length_ += entry.level_;
+    }
+    for (uint32_t level = Levels; level > 0; --level) {
+      at_least[level - 1] += at_least[level];
+    }
+    std::array<uint32_t, Levels + 1> next = {};
+    for (uint32_t level = 1; level <= Levels; ++level) {
+      next[level] = at_least[level + 1];
+    }
+    for (uint32_t i = 0; i < entries_.size(); ++i) {
+      order_[next[entries_[i].level_]++] = i;
+    }
+
+    // Round r of the cycle is made of the entries whose level is above reverse(r).
+    for (uint32_t round = 0; round < Levels; ++round) {
+      uint32_t reversed = 0;
+      for (uint32_t bit = 1; bit < Levels; bit <<= 1) {
+        reversed = (reversed << 1) | ((round & bit) != 0);
+      }
+      round_sizes_[round] = at_least[reversed + 1];
+    }
+  }
+
+  std::vector<Entry> entries_;
+  // Indexes of entries_ by decreasing level.
+  std::vector<uint32_t> order_;
+  // Number of entries visited by each round, in the order the rounds are visited. The largest
+  // weight has level Levels, so no round is empty.
+  std::array<uint32_t, Levels> round_sizes_{};
+  uint64_t cycle_length_{};
+  uint32_t round_{};
+  uint32_t index_{};
+  // Number of picks that changed a weight since the last rebuild.
+  size_t stale_{};
+  bool rebuild_{};
+  std::queue<std::weak_ptr<C>> prepick_list_;
+};
+
+} // namespace Upstream
+} // namespace Envoy
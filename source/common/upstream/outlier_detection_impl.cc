@@ -550,15 +550,38 @@ void DetectorImpl::notifyMainThreadConsecutiveError(
   //       3) If when running on the main thread the weak pointer can be converted to a strong
   //          pointer, the detector/cluster must still exist so we can safely fire callbacks.
   //          Otherwise we do nothing since the detector/cluster is already gone.
+  // During failure storms many hosts cross their thresholds at once. Errors are queued, and only
+  // the first error queued since the main thread last processed the queue posts to it.
+  bool post;
+  {
+    absl::MutexLock lock(&pending_consecutive_errors_lock_);
+    post = pending_consecutive_errors_.empty();
+    pending_consecutive_errors_.push_back({std::move(host), type});
+  }
+  if (!post) {
+    return;
+  }
   std::weak_ptr<DetectorImpl> weak_this = shared_from_this();
-  dispatcher_.post([weak_this, host, type]() -> void {
+  dispatcher_.post([weak_this]() -> void {
     std::shared_ptr<DetectorImpl> shared_this = weak_this.lock();
     if (shared_this) {
-      shared_this->onConsecutiveErrorWorker(host, type);
+      shared_this->onPendingConsecutiveErrors();
     }
   });
 }
 
+void DetectorImpl::onPendingConsecutiveErrors() {
+  std::vector<ConsecutiveError> errors;
+  {
+    absl::MutexLock lock(&pending_consecutive_errors_lock_);
+    errors.swap(pending_consecutive_errors_);
+  }
+  // Errors are processed in the order they were detected, as they would have been one post each.
+  for (const ConsecutiveError& error : errors) {
+    onConsecutiveErrorWorker(error.host_, error.type_);
+  }
+}
+
 void DetectorImpl::onConsecutive5xx(HostSharedPtr host) {
   notifyMainThreadConsecutiveError(host, envoy::data::cluster::v3::CONSECUTIVE_5XX);
 }
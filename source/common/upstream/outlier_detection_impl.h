@@ -24,6 +24,7 @@
 #include "source/common/upstream/upstream_impl.h"
 
 #include "absl/container/node_hash_map.h"
+#include "absl/synchronization/mutex.h"
 
 namespace Envoy {
 namespace Upstream {
@@ -435,6 +436,7 @@ private:
                                 envoy::data::cluster::v3::OutlierEjectionType type);
   void notifyMainThreadConsecutiveError(HostSharedPtr host,
                                         envoy::data::cluster::v3::OutlierEjectionType type);
+  void onPendingConsecutiveErrors();
   void onIntervalTimer();
   void runCallbacks(HostSharedPtr host);
   bool enforceEjection(envoy::data::cluster::v3::OutlierEjectionType type);
@@ -472,6 +474,16 @@ private:
   Common::CallbackHandlePtr member_update_cb_;
   Random::RandomGenerator& random_generator_;
 
+  struct ConsecutiveError {
+    HostSharedPtr host_;
+    envoy::data::cluster::v3::OutlierEjectionType type_;
+  };
+  // Consecutive errors detected on workers that the main thread has yet to process. A single post
+  // to the main thread is outstanding while it is not empty.
+  absl::Mutex pending_consecutive_errors_lock_;
+  std::vector<ConsecutiveError>
+      pending_consecutive_errors_ ABSL_GUARDED_BY(pending_consecutive_errors_lock_);
+
   // EjectionPair for external and local origin events.
   // When external/local origin events are not split, external_origin_sr_num_ are used for
   // both types of events: external and local. local_origin_sr_num_ is not used.
@@ -381,6 +381,23 @@ createUpstreamLocalAddressSelector(
   return selector_or_error.value();
 }
 
+// Replaces a partition with the current one if it holds the same hosts.
+template <class HostVectorT>
+void keepUnchangedHosts(std::shared_ptr<const HostVectorT>& partition,
+                        const std::shared_ptr<const HostVectorT>& current) {
+  if (current != nullptr && *partition == *current) {
+    partition = current;
+  }
+}
+
+void keepUnchangedHostsPerLocality(HostsPerLocalityConstSharedPtr& partition,
+                                   const HostsPerLocalityConstSharedPtr& current) {
+  if (current != nullptr && partition->hasLocalLocality() == current->hasLocalLocality() &&
+      partition->get() == current->get()) {
+    partition = current;
+  }
+}
+
 } // namespace
 
 // Allow disabling ALPN checks for transport sockets. See
@@ -841,6 +858,23 @@ HostSetImpl::partitionHosts(HostVectorConstSharedPtr hosts,
                            std::move(std::get<2>(healthy_degraded_excluded_hosts_per_locality)));
 }
 
+PrioritySet::UpdateHostsParams HostSetImpl::repartitionHosts(const HostSet& host_set) {
+  PrioritySet::UpdateHostsParams params =
+      partitionHosts(host_set.hostsPtr(), host_set.hostsPerLocalityPtr());
+  // Keep the current vectors of the partitions whose hosts did not change, so that whatever was
+  // built from them, e.g. the schedulers of the worker load balancers, is kept as well.
+  keepUnchangedHosts(params.healthy_hosts, host_set.healthyHostsPtr());
+  keepUnchangedHosts(params.degraded_hosts, host_set.degradedHostsPtr());
+  keepUnchangedHosts(params.excluded_hosts, host_set.excludedHostsPtr());
+  keepUnchangedHostsPerLocality(params.healthy_hosts_per_locality,
+                                host_set.healthyHostsPerLocalityPtr());
+  keepUnchangedHostsPerLocality(params.degraded_hosts_per_locality,
+                                host_set.degradedHostsPerLocalityPtr());
+  keepUnchangedHostsPerLocality(params.excluded_hosts_per_locality,
+                                host_set.excludedHostsPerLocalityPtr());
+  return params;
+}
+
 double HostSetImpl::effectiveLocalityWeight(uint32_t index,
                                             const HostsPerLocality& eligible_hosts_per_locality,
                                             const HostsPerLocality& excluded_hosts_per_locality,
@@ -1897,13 +1931,11 @@ void ClusterImplBase::reloadHealthyHostsHelper(const HostSharedPtr&) {
   const auto& host_sets = prioritySet().hostSetsPerPriority();
   for (size_t priority = 0; priority < host_sets.size(); ++priority) {
     const auto& host_set = host_sets[priority];
-    // TODO(htuch): Can we skip these copies by exporting out const shared_ptr from HostSet?
-    HostVectorConstSharedPtr hosts_copy = std::make_shared<HostVector>(host_set->hosts());
-
-    HostsPerLocalityConstSharedPtr hosts_per_locality_copy = host_set->hostsPerLocality().clone();
-    prioritySet().updateHosts(
-        priority, HostSetImpl::partitionHosts(hosts_copy, hosts_per_locality_copy),
-        host_set->localityWeights(), {}, {}, random_.random(), absl::nullopt, absl::nullopt);
+    // Only health changed, so the immutable host vectors are shared with the new update instead of
+    // being copied. This also lets the worker load balancers keep what they built from them.
+    prioritySet().updateHosts(priority, HostSetImpl::repartitionHosts(*host_set),
+                              host_set->localityWeights(), {}, {}, random_.random(), absl::nullopt,
+                              absl::nullopt);
   }
 }
 
@@ -618,6 +618,11 @@ public:
   static PrioritySet::UpdateHostsParams updateHostsParams(const HostSet& host_set);
   static PrioritySet::UpdateHostsParams
   partitionHosts(HostVectorConstSharedPtr hosts, HostsPerLocalityConstSharedPtr hosts_per_locality);
+  /**
+   * Partitions the current hosts of a host set again, e.g. after health changes. The partitions
+   * whose hosts did not change keep their current vectors.
+   */
+  static PrioritySet::UpdateHostsParams repartitionHosts(const HostSet& host_set);
 
   void updateHosts(PrioritySet::UpdateHostsParams&& update_hosts_params,
                    LocalityWeightsConstSharedPtr locality_weights, const HostVector& hosts_added,
@@ -377,6 +377,14 @@ void EdsClusterImpl::reloadHealthyHostsHelper(const HostSharedPtr& host) {
   for (size_t priority = 0; priority < host_sets.size(); ++priority) {
     const auto& host_set = host_sets[priority];
 
+    if (host_to_exclude == nullptr) {
+      // Share the immutable host vectors with the new update rather than copying them.
+      prioritySet().updateHosts(priority, HostSetImpl::repartitionHosts(*host_set),
+                                host_set->localityWeights(), {}, {}, random_.random(),
+                                absl::nullopt, absl::nullopt);
+      continue;
+    }
+
     // Filter current hosts in case we need to exclude a host.
     HostVectorSharedPtr hosts_copy(new HostVector());
     std::copy_if(host_set->hosts().begin(), host_set->hosts().end(),
@@ -276,11 +276,19 @@ ClientImpl::PendingRequest::PendingRequest(ClientImpl& parent, ClientCallbacks&
   parent.host_->stats().rq_total_.inc();
   parent.host_->cluster().trafficStats()->upstream_rq_active_.inc();
   parent.host_->stats().rq_active_.inc();
+  if (OptRef<Upstream::HostLbPolicyData> lb_policy_data = parent.host_->lbPolicyData();
+      lb_policy_data.has_value()) {
+    lb_policy_data->onRequestActive();
+  }
 }
 
 ClientImpl::PendingRequest::~PendingRequest() {
   parent_.host_->cluster().trafficStats()->upstream_rq_active_.dec();
   parent_.host_->stats().rq_active_.dec();
+  if (OptRef<Upstream::HostLbPolicyData> lb_policy_data = parent_.host_->lbPolicyData();
+      lb_policy_data.has_value()) {
+    lb_policy_data->onRequestInactive();
+  }
 }
 
 void ClientImpl::PendingRequest::cancel() {
@@ -5,9 +5,12 @@
 #include "envoy/data/core/v3/health_check_event.pb.h"
 #include "envoy/stats/scope.h"
 
+#include "source/common/common/fmt.h"
 #include "source/common/network/utility.h"
 #include "source/common/router/router.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -43,7 +46,8 @@ HealthCheckerImplBase::HealthCheckerImplBase(const Cluster& cluster,
           [this](const HostVector& hosts_added, const HostVector& hosts_removed) -> absl::Status {
             onClusterMemberUpdate(hosts_added, hosts_removed);
             return absl::OkStatus();
-          })} {}
+          })},
+      session_thread_count_(config.session_threads()) {}
 
 std::shared_ptr<const Network::TransportSocketOptionsImpl>
 HealthCheckerImplBase::initTransportSocketOptions(
@@ -84,6 +88,97 @@ HealthCheckerImplBase::~HealthCheckerImplBase() {
   }
 }
 
+void HealthCheckerImplBase::startSessionThreads(Api::Api& api) {
+  ASSERT(session_threads_.empty());
+  for (uint32_t i = 0; i < session_thread_count_; ++i) {
+    SessionThread& session_thread = session_threads_.emplace_back();
+    session_thread.dispatcher_ = api.allocateDispatcher(fmt::format("health_check_{}", i));
+    Event::Dispatcher& dispatcher = *session_thread.dispatcher_;
+    session_thread.thread_ = api.threadFactory().createThread(
+        [&dispatcher]() { dispatcher.run(Event::Dispatcher::RunType::RunUntilExit); },
+        Thread::Options{fmt::format("hc:{}", i)});
+  }
+}
+
+void HealthCheckerImplBase::stopSessionThreads() {
+  if (session_threads_.empty()) {
+    return;
+  }
+  // Nothing waits for the callbacks of the sessions destroyed below.
+  callbacks_.clear();
+  // Sessions, including their connections, are destroyed on their own threads. Anything a session
+  // queued for the main thread is dropped, as the health checker is gone by the time it would run.
+  absl::flat_hash_map<Event::Dispatcher*, std::vector<ActiveHealthCheckSessionPtr>> sessions;
+  for (auto& session : active_sessions_) {
+    sessions[&session.second->dispatcher()].push_back(std::move(session.second));
+  }
+  active_sessions_.clear();
+  for (SessionThread& session_thread : session_threads_) {
+    Event::Dispatcher& dispatcher = *session_thread.dispatcher_;
+    dispatcher.post([&dispatcher, sessions = std::move(sessions[&dispatcher])]() mutable {
+      for (ActiveHealthCheckSessionPtr& session : sessions) {
+        session->onDeferredDeleteBase();
+      }
+      sessions.clear();
+      dispatcher.clearDeferredDeleteList();
+      dispatcher.exit();
+    });
+  }
+  for (SessionThread& session_thread : session_threads_) {
+    session_thread.thread_->join();
+  }
+}
+
+Event::Dispatcher& HealthCheckerImplBase::nextSessionDispatcher() {
+  if (session_threads_.empty()) {
+    return dispatcher_;
+  }
+  return *session_threads_[next_session_thread_++ % session_threads_.size()].dispatcher_;
+}
+
+void HealthCheckerImplBase::runOnMainThread(Event::PostCb callback) {
+  if (session_threads_.empty()) {
+    callback();
+    return;
+  }
+  bool schedule;
+  {
+    absl::MutexLock lock(&pending_lock_);
+    schedule = pending_.empty();
+    pending_.push_back(std::move(callback));
+  }
+  if (schedule) {
+    // A single post drains everything queued until it runs.
+    std::weak_ptr<HealthCheckerImplBase> weak_this = weak_from_this();
+    dispatcher_.post([weak_this]() {
+      std::shared_ptr<HealthCheckerImplBase> shared_this = weak_this.lock();
+      if (shared_this != nullptr) {
+        shared_this->runPendingOnMainThread();
+      }
+    });
+  }
+}
+
+void HealthCheckerImplBase::runPendingOnMainThread() {
+  std::vector<Event::PostCb> pending;
+  {
+    absl::MutexLock lock(&pending_lock_);
+    pending.swap(pending_);
+  }
+  for (Event::PostCb& callback : pending) {
+    callback();
+  }
+}
+
+const Runtime::Snapshot&
+HealthCheckerImplBase::runtimeSnapshot(Runtime::SnapshotConstSharedPtr& holder) const {
+  if (session_threads_.empty()) {
+    return runtime_.snapshot();
+  }
+  holder = runtime_.threadsafeSnapshot();
+  return *holder;
+}
+
 void HealthCheckerImplBase::decHealthy() { stats_.healthy_.sub(1); }
 
 void HealthCheckerImplBase::decDegraded() { stats_.degraded_.sub(1); }
@@ -149,9 +244,11 @@ HealthCheckerImplBase::intervalWithJitter(uint64_t base_time_ms,
     base_time_ms += (random_.random() % interval_jitter.count());
   }
 
-  const uint64_t min_interval = runtime_.snapshot().getInteger("health_check.min_interval", 0);
-  const uint64_t max_interval = runtime_.snapshot().getInteger(
-      "health_check.max_interval", std::numeric_limits<uint64_t>::max());
+  Runtime::SnapshotConstSharedPtr snapshot_holder;
+  const Runtime::Snapshot& snapshot = runtimeSnapshot(snapshot_holder);
+  const uint64_t min_interval = snapshot.getInteger("health_check.min_interval", 0);
+  const uint64_t max_interval =
+      snapshot.getInteger("health_check.max_interval", std::numeric_limits<uint64_t>::max());
 
   uint64_t final_ms = std::min(base_time_ms, max_interval);
   // We force a non-zero final MS, to prevent live lock.
@@ -164,10 +261,15 @@ void HealthCheckerImplBase::addHosts(const HostVector& hosts) {
     if (host->disableActiveHealthCheck()) {
       continue;
     }
-    active_sessions_[host] = makeSession(host);
+    ActiveHealthCheckSession& session = *(active_sessions_[host] = makeSession(host));
     host->setHealthChecker(
         HealthCheckHostMonitorPtr{new HealthCheckHostMonitorImpl(shared_from_this(), host)});
-    active_sessions_[host]->start();
+    if (&session.dispatcher() == &dispatcher_) {
+      session.start();
+    } else {
+      // The session is destroyed on its thread, after anything posted to it before.
+      session.dispatcher().post([&session]() { session.start(); });
+    }
   }
 }
 
@@ -180,9 +282,18 @@ void HealthCheckerImplBase::onClusterMemberUpdate(const HostVector& hosts_added,
     }
     auto session_iter = active_sessions_.find(host);
     ASSERT(active_sessions_.end() != session_iter);
-    // This deletion can happen inline in response to a host failure, so we deferred delete.
-    session_iter->second->onDeferredDeleteBase();
-    dispatcher_.deferredDelete(std::move(session_iter->second));
+    Event::Dispatcher& session_dispatcher = session_iter->second->dispatcher();
+    if (&session_dispatcher == &dispatcher_) {
+      // This deletion can happen inline in response to a host failure, so we deferred delete.
+      session_iter->second->onDeferredDeleteBase();
+      dispatcher_.deferredDelete(std::move(session_iter->second));
+    } else {
+      session_dispatcher.post([&session_dispatcher,
+                               session = std::move(session_iter->second)]() mutable {
+        session->onDeferredDeleteBase();
+        session_dispatcher.deferredDelete(std::move(session));
+      });
+    }
     active_sessions_.erase(session_iter);
   }
 }
@@ -227,7 +338,15 @@ void HealthCheckerImplBase::setUnhealthyCrossThread(const HostSharedPtr& host,
       return;
     }
 
-    session->second->setUnhealthy(envoy::data::core::v3::PASSIVE, /*retriable=*/false);
+    ActiveHealthCheckSession& active_session = *session->second;
+    if (&active_session.dispatcher() == &shared_this->dispatcher_) {
+      active_session.setUnhealthy(envoy::data::core::v3::PASSIVE, /*retriable=*/false);
+    } else {
+      // The session is destroyed on its thread, after anything posted to it before.
+      active_session.dispatcher().post([&active_session]() {
+        active_session.setUnhealthy(envoy::data::core::v3::PASSIVE, /*retriable=*/false);
+      });
+    }
   });
 }
 
@@ -239,10 +358,13 @@ void HealthCheckerImplBase::start() {
 
 HealthCheckerImplBase::ActiveHealthCheckSession::ActiveHealthCheckSession(
     HealthCheckerImplBase& parent, HostSharedPtr host)
-    : host_(host), parent_(parent),
-      interval_timer_(parent.dispatcher_.createTimer([this]() -> void { onIntervalBase(); })),
-      timeout_timer_(parent.dispatcher_.createTimer([this]() -> void { onTimeoutBase(); })),
-      time_source_(parent.dispatcher_.timeSource()) {
+    : host_(host), parent_(parent), dispatcher_(parent.nextSessionDispatcher()),
+      time_source_(dispatcher_.timeSource()) {
+  // Timers are created on the thread they fire on, which for session threads happens in start().
+  if (&dispatcher_ == &parent.dispatcher_) {
+    interval_timer_ = dispatcher_.createTimer([this]() -> void { onIntervalBase(); });
+    timeout_timer_ = dispatcher_.createTimer([this]() -> void { onTimeoutBase(); });
+  }
 
   if (!host->healthFlagGet(Host::HealthFlag::FAILED_ACTIVE_HC)) {
     parent.incHealthy();
@@ -259,6 +381,14 @@ HealthCheckerImplBase::ActiveHealthCheckSession::~ActiveHealthCheckSession() {
   ASSERT(interval_timer_ == nullptr && timeout_timer_ == nullptr);
 }
 
+void HealthCheckerImplBase::ActiveHealthCheckSession::start() {
+  if (interval_timer_ == nullptr) {
+    interval_timer_ = dispatcher_.createTimer([this]() -> void { onIntervalBase(); });
+    timeout_timer_ = dispatcher_.createTimer([this]() -> void { onTimeoutBase(); });
+  }
+  onInitialInterval();
+}
+
 void HealthCheckerImplBase::ActiveHealthCheckSession::onDeferredDeleteBase() {
   HealthState state = HealthState::Unhealthy;
   // The session is about to be deferred deleted. Make sure all timers are gone and any
@@ -276,7 +406,9 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::onDeferredDeleteBase() {
 
   // Run callbacks in case something is waiting for health checks to run which will now never run.
   if (first_check_) {
-    parent_.runCallbacks(host_, HealthTransition::Unchanged, state);
+    parent_.runOnMainThread([&parent = parent_, host = host_, state]() {
+      parent.runCallbacks(host, HealthTransition::Unchanged, state);
+    });
   }
 }
 
@@ -301,17 +433,23 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::handleSuccess(bool degrade
       parent_.incHealthy();
       changed_state = HealthTransition::Changed;
       if (parent_.event_logger_) {
-        parent_.event_logger_->logAddHealthy(parent_.healthCheckerType(), host_, first_check_);
+        parent_.runOnMainThread([&parent = parent_, host = host_, first_check = first_check_]() {
+          parent.event_logger_->logAddHealthy(parent.healthCheckerType(), host, first_check);
+        });
       }
     } else {
       changed_state = HealthTransition::ChangePending;
     }
-    host_->setLastHcPassTime(time_source_.monotonicTime());
+    parent_.runOnMainThread([host = host_, now = time_source_.monotonicTime()]() {
+      host->setLastHcPassTime(now);
+    });
   }
 
   if (changed_state != HealthTransition::Changed && parent_.always_log_health_check_success_ &&
       parent_.event_logger_) {
-    parent_.event_logger_->logSuccessfulHealthCheck(parent_.healthCheckerType(), host_);
+    parent_.runOnMainThread([&parent = parent_, host = host_]() {
+      parent.event_logger_->logSuccessfulHealthCheck(parent.healthCheckerType(), host);
+    });
   }
 
   changed_state = clearPendingFlag(changed_state);
@@ -321,11 +459,15 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::handleSuccess(bool degrade
       host_->healthFlagSet(Host::HealthFlag::DEGRADED_ACTIVE_HC);
       parent_.incDegraded();
       if (parent_.event_logger_) {
-        parent_.event_logger_->logDegraded(parent_.healthCheckerType(), host_);
+        parent_.runOnMainThread([&parent = parent_, host = host_]() {
+          parent.event_logger_->logDegraded(parent.healthCheckerType(), host);
+        });
       }
     } else {
       if (parent_.event_logger_) {
-        parent_.event_logger_->logNoLongerDegraded(parent_.healthCheckerType(), host_);
+        parent_.runOnMainThread([&parent = parent_, host = host_]() {
+          parent.event_logger_->logNoLongerDegraded(parent.healthCheckerType(), host);
+        });
       }
       host_->healthFlagClear(Host::HealthFlag::DEGRADED_ACTIVE_HC);
     }
@@ -340,7 +482,9 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::handleSuccess(bool degrade
 
   parent_.stats_.success_.inc();
   first_check_ = false;
-  parent_.runCallbacks(host_, changed_state, HealthState::Healthy);
+  parent_.runOnMainThread([&parent = parent_, host = host_, changed_state]() {
+    parent.runCallbacks(host, changed_state, HealthState::Healthy);
+  });
 
   timeout_timer_->disableTimer();
   interval_timer_->enableTimer(parent_.interval(HealthState::Healthy, changed_state));
@@ -367,7 +511,9 @@ HealthTransition HealthCheckerImplBase::ActiveHealthCheckSession::setUnhealthy(
       parent_.decHealthy();
       changed_state = HealthTransition::Changed;
       if (parent_.event_logger_) {
-        parent_.event_logger_->logEjectUnhealthy(parent_.healthCheckerType(), host_, type);
+        parent_.runOnMainThread([&parent = parent_, host = host_, type]() {
+          parent.event_logger_->logEjectUnhealthy(parent.healthCheckerType(), host, type);
+        });
       }
     } else {
       changed_state = HealthTransition::ChangePending;
@@ -387,7 +533,9 @@ HealthTransition HealthCheckerImplBase::ActiveHealthCheckSession::setUnhealthy(
   changed_state = clearPendingFlag(changed_state);
 
   if ((first_check_ || parent_.always_log_health_check_failures_) && parent_.event_logger_) {
-    parent_.event_logger_->logUnhealthy(parent_.healthCheckerType(), host_, type, first_check_);
+    parent_.runOnMainThread([&parent = parent_, host = host_, type, first_check = first_check_]() {
+      parent.event_logger_->logUnhealthy(parent.healthCheckerType(), host, type, first_check);
+    });
   }
 
   parent_.stats_.failure_.inc();
@@ -398,7 +546,9 @@ HealthTransition HealthCheckerImplBase::ActiveHealthCheckSession::setUnhealthy(
   }
 
   first_check_ = false;
-  parent_.runCallbacks(host_, changed_state, HealthState::Unhealthy);
+  parent_.runOnMainThread([&parent = parent_, host = host_, changed_state]() {
+    parent.runCallbacks(host, changed_state, HealthState::Unhealthy);
+  });
   return changed_state;
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "envoy/access_log/access_log.h"
+#include "envoy/api/api.h"
 #include "envoy/common/callback.h"
 #include "envoy/common/random_generator.h"
 #include "envoy/config/core/v3/health_check.pb.h"
@@ -8,6 +9,7 @@
 #include "envoy/event/timer.h"
 #include "envoy/runtime/runtime.h"
 #include "envoy/stats/scope.h"
+#include "envoy/thread/thread.h"
 #include "envoy/type/matcher/string.pb.h"
 #include "envoy/upstream/health_checker.h"
 
@@ -15,6 +17,8 @@
 #include "source/common/common/matchers.h"
 #include "source/common/network/transport_socket_options_impl.h"
 
+#include "absl/synchronization/mutex.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -40,11 +44,35 @@ struct HealthCheckerStats {
 
 /**
  * Base implementation for all health checkers.
+ *
+ * If session_threads is configured and the health checker was created with create(), sessions run
+ * on dedicated dispatcher threads. A session only touches its host's atomic health flags, the
+ * stats and the constant configuration from its thread. Host callbacks, event logging and the
+ * last pass time are handed to the main thread, where they run in batches. Session threads are not
+ * registered with thread local storage, so they read a thread safe runtime snapshot, and the stats
+ * store serves the stats they look up, such as codec and TLS handshake stats, from its central
+ * cache.
  */
 class HealthCheckerImplBase : public HealthChecker,
                               protected Logger::Loggable<Logger::Id::hc>,
                               public std::enable_shared_from_this<HealthCheckerImplBase> {
 public:
+  /**
+   * Creates a health checker and starts the session threads it is configured with. The threads
+   * are stopped, and the sessions on them destroyed, before the health checker is destroyed.
+   * @param api supplies the API used to create the session threads.
+   * @param args supplies the arguments of the health checker's constructor.
+   */
+  template <class T, class... Args>
+  static std::shared_ptr<T> create(Api::Api& api, Args&&... args) {
+    std::shared_ptr<T> health_checker(new T(std::forward<Args>(args)...), [](T* health_checker) {
+      health_checker->stopSessionThreads();
+      delete health_checker;
+    });
+    health_checker->startSessionThreads(api);
+    return health_checker;
+  }
+
   // Upstream::HealthChecker
   void addHostCheckCompleteCb(HostStatusCb callback) override { callbacks_.push_back(callback); }
   void start() override;
@@ -62,7 +90,8 @@ protected:
     HealthTransition setUnhealthy(envoy::data::core::v3::HealthCheckFailureType type,
                                   bool retriable);
     void onDeferredDeleteBase();
-    void start() { onInitialInterval(); }
+    void start();
+    Event::Dispatcher& dispatcher() { return dispatcher_; }
 
   protected:
     ActiveHealthCheckSession(HealthCheckerImplBase& parent, HostSharedPtr host);
@@ -85,6 +114,7 @@ protected:
     void onInitialInterval();
 
     HealthCheckerImplBase& parent_;
+    Event::Dispatcher& dispatcher_;
     Event::TimerPtr interval_timer_;
     Event::TimerPtr timeout_timer_;
     uint32_t num_unhealthy_{};
@@ -103,6 +133,14 @@ protected:
   virtual ActiveHealthCheckSessionPtr makeSession(HostSharedPtr host) PURE;
   virtual envoy::data::core::v3::HealthCheckerType healthCheckerType() const PURE;
 
+  /**
+   * Returns the runtime snapshot to use on the calling session thread. Session threads are not
+   * registered with thread local storage, so they read a thread safe snapshot that is kept alive
+   * by the holder.
+   * @param holder supplies the storage for the thread safe snapshot.
+   */
+  const Runtime::Snapshot& runtimeSnapshot(Runtime::SnapshotConstSharedPtr& holder) const;
+
   const bool always_log_health_check_failures_;
   const bool always_log_health_check_success_;
   const Cluster& cluster_;
@@ -129,6 +167,11 @@ private:
     std::weak_ptr<Host> host_;
   };
 
+  struct SessionThread {
+    Event::DispatcherPtr dispatcher_;
+    Thread::ThreadPtr thread_;
+  };
+
   void addHosts(const HostVector& hosts);
   void decHealthy();
   void decDegraded();
@@ -141,6 +184,13 @@ private:
   void onClusterMemberUpdate(const HostVector& hosts_added, const HostVector& hosts_removed);
   void runCallbacks(HostSharedPtr host, HealthTransition changed_state,
                     HealthState current_check_result);
+  // Runs the callback inline without session threads. Otherwise queues it for the next batch of
+  // callbacks run on the main thread.
+  void runOnMainThread(Event::PostCb callback);
+  void runPendingOnMainThread();
+  Event::Dispatcher& nextSessionDispatcher();
+  void startSessionThreads(Api::Api& api);
+  void stopSessionThreads();
   void setUnhealthyCrossThread(const HostSharedPtr& host,
                                HealthCheckHostMonitor::UnhealthyType type);
   static std::shared_ptr<const Network::TransportSocketOptionsImpl>
@@ -162,6 +212,11 @@ private:
   const std::shared_ptr<const Network::TransportSocketOptionsImpl> transport_socket_options_;
   const MetadataConstSharedPtr transport_socket_match_metadata_;
   const Common::CallbackHandlePtr member_update_cb_;
+  const uint32_t session_thread_count_;
+  std::vector<SessionThread> session_threads_;
+  uint32_t next_session_thread_{};
+  absl::Mutex pending_lock_;
+  std::vector<Event::PostCb> pending_ ABSL_GUARDED_BY(pending_lock_);
 };
 
 } // namespace Upstream
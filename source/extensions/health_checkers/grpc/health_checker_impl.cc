@@ -45,8 +45,8 @@ const std::string& getHostname(const HostSharedPtr& host,
 Upstream::HealthCheckerSharedPtr GrpcHealthCheckerFactory::createCustomHealthChecker(
     const envoy::config::core::v3::HealthCheck& config,
     Server::Configuration::HealthCheckerFactoryContext& context) {
-  return std::make_shared<ProdGrpcHealthCheckerImpl>(
-      context.cluster(), config, context.mainThreadDispatcher(), context.runtime(),
+  return HealthCheckerImplBase::create<ProdGrpcHealthCheckerImpl>(
+      context.api(), context.cluster(), config, context.mainThreadDispatcher(), context.runtime(),
       context.api().randomGenerator(), context.eventLogger());
 }
 
@@ -179,14 +179,14 @@ void GrpcHealthCheckerImpl::GrpcActiveHealthCheckSession::onEvent(Network::Conne
     // For the raw disconnect event, we are either between intervals in which case we already have
     // a timer setup, or we did the close or got a reset, in which case we already setup a new
     // timer. There is nothing to do here other than blow away the client.
-    parent_.dispatcher_.deferredDelete(std::move(client_));
+    dispatcher().deferredDelete(std::move(client_));
   }
 }
 
 void GrpcHealthCheckerImpl::GrpcActiveHealthCheckSession::onInterval() {
   if (!client_) {
     Upstream::Host::CreateConnectionData conn =
-        host_->createHealthCheckConnection(parent_.dispatcher_, parent_.transportSocketOptions(),
+        host_->createHealthCheckConnection(dispatcher(), parent_.transportSocketOptions(),
                                            parent_.transportSocketMatchMetadata().get());
     client_ = parent_.createCodecClient(conn);
     client_->addConnectionCallbacks(connection_callback_impl_);
@@ -204,7 +204,7 @@ void GrpcHealthCheckerImpl::GrpcActiveHealthCheckSession::onInterval() {
   headers_message->headers().setReferenceUserAgent(
       Http::Headers::get().UserAgentValues.EnvoyHealthChecker);
 
-  StreamInfo::StreamInfoImpl stream_info(Http::Protocol::Http2, parent_.dispatcher_.timeSource(),
+  StreamInfo::StreamInfoImpl stream_info(Http::Protocol::Http2, dispatcher().timeSource(),
                                          local_connection_info_provider_,
                                          StreamInfo::FilterState::LifeSpan::FilterChain);
   stream_info.setUpstreamInfo(std::make_shared<StreamInfo::UpstreamInfoImpl>());
@@ -392,8 +392,11 @@ void GrpcHealthCheckerImpl::GrpcActiveHealthCheckSession::logHealthCheckStatus(
 
 Http::CodecClientPtr
 ProdGrpcHealthCheckerImpl::createCodecClient(Upstream::Host::CreateConnectionData& data) {
+  // The connection belongs to the dispatcher of the session, which is not the main one with
+  // session threads.
+  Event::Dispatcher& dispatcher = data.connection_->dispatcher();
   return std::make_unique<Http::CodecClientProd>(
-      Http::CodecType::HTTP2, std::move(data.connection_), data.host_description_, dispatcher_,
+      Http::CodecType::HTTP2, std::move(data.connection_), data.host_description_, dispatcher,
       random_generator_, transportSocketOptions());
 }
 
@@ -48,8 +48,8 @@ getMethod(const envoy::config::core::v3::RequestMethod config_method) {
 Upstream::HealthCheckerSharedPtr HttpHealthCheckerFactory::createCustomHealthChecker(
     const envoy::config::core::v3::HealthCheck& config,
     Server::Configuration::HealthCheckerFactoryContext& context) {
-  return std::make_shared<ProdHttpHealthCheckerImpl>(context.cluster(), config, context,
-                                                     context.eventLogger());
+  return HealthCheckerImplBase::create<ProdHttpHealthCheckerImpl>(
+      context.api(), context.cluster(), config, context, context.eventLogger());
 }
 
 REGISTER_FACTORY(HttpHealthCheckerFactory, Server::Configuration::CustomHealthCheckerFactory);
@@ -238,7 +238,7 @@ void HttpHealthCheckerImpl::HttpActiveHealthCheckSession::onEvent(Network::Conne
     // timer. There is nothing to do here other than blow away the client.
     response_headers_.reset();
     response_body_->drain(response_body_->length());
-    parent_.dispatcher_.deferredDelete(std::move(client_));
+    dispatcher().deferredDelete(std::move(client_));
   }
 }
 
@@ -246,7 +246,7 @@ void HttpHealthCheckerImpl::HttpActiveHealthCheckSession::onEvent(Network::Conne
 void HttpHealthCheckerImpl::HttpActiveHealthCheckSession::onInterval() {
   if (!client_) {
     Upstream::Host::CreateConnectionData conn =
-        host_->createHealthCheckConnection(parent_.dispatcher_, parent_.transportSocketOptions(),
+        host_->createHealthCheckConnection(dispatcher(), parent_.transportSocketOptions(),
                                            parent_.transportSocketMatchMetadata().get());
     client_.reset(parent_.createCodecClient(conn));
     client_->addConnectionCallbacks(connection_callback_impl_);
@@ -269,7 +269,7 @@ void HttpHealthCheckerImpl::HttpActiveHealthCheckSession::onInterval() {
       // Here there is no downstream connection so scheme will be based on
       // upstream crypto
       false, host_->transportSocketFactory().implementsSecureTransport(), true);
-  StreamInfo::StreamInfoImpl stream_info(protocol_, parent_.dispatcher_.timeSource(),
+  StreamInfo::StreamInfoImpl stream_info(protocol_, dispatcher().timeSource(),
                                          local_connection_info_provider_,
                                          StreamInfo::FilterState::LifeSpan::FilterChain);
   stream_info.setUpstreamInfo(std::make_shared<StreamInfo::UpstreamInfoImpl>());
@@ -358,8 +358,10 @@ HttpHealthCheckerImpl::HttpActiveHealthCheckSession::healthCheckResult() {
 
   const auto degraded = response_headers_->EnvoyDegraded() != nullptr;
 
+  Runtime::SnapshotConstSharedPtr snapshot_holder;
   if (parent_.service_name_matcher_.has_value() &&
-      parent_.runtime_.snapshot().featureEnabled("health_check.verify_cluster", 100UL)) {
+      parent_.runtimeSnapshot(snapshot_holder)
+          .featureEnabled("health_check.verify_cluster", 100UL)) {
     parent_.stats_.verify_cluster_.inc();
     std::string service_cluster_healthchecked =
         response_headers_->EnvoyUpstreamHealthCheckedCluster()
@@ -444,8 +446,11 @@ HttpHealthCheckerImpl::codecClientType(const envoy::type::v3::CodecClientType& t
 
 Http::CodecClient*
 ProdHttpHealthCheckerImpl::createCodecClient(Upstream::Host::CreateConnectionData& data) {
+  // The connection belongs to the dispatcher of the session, which is not the main one with
+  // session threads.
+  Event::Dispatcher& dispatcher = data.connection_->dispatcher();
   return new Http::CodecClientProd(codec_client_type_, std::move(data.connection_),
-                                   data.host_description_, dispatcher_, random_generator_,
+                                   data.host_description_, dispatcher, random_generator_,
                                    transportSocketOptions());
 }
 
@@ -16,8 +16,8 @@ namespace RedisHealthChecker {
 Upstream::HealthCheckerSharedPtr RedisHealthCheckerFactory::createCustomHealthChecker(
     const envoy::config::core::v3::HealthCheck& config,
     Server::Configuration::HealthCheckerFactoryContext& context) {
-  return std::make_shared<RedisHealthChecker>(
-      context.cluster(), config,
+  return Upstream::HealthCheckerImplBase::create<RedisHealthChecker>(
+      context.api(), context.cluster(), config,
       getRedisHealthCheckConfig(config, context.messageValidationVisitor()),
       context.mainThreadDispatcher(), context.runtime(), context.eventLogger(), context.api(),
       NetworkFilters::Common::Redis::Client::ClientFactoryImpl::instance_);
@@ -36,8 +36,8 @@ namespace Upstream {
 Upstream::HealthCheckerSharedPtr TcpHealthCheckerFactory::createCustomHealthChecker(
     const envoy::config::core::v3::HealthCheck& config,
     Server::Configuration::HealthCheckerFactoryContext& context) {
-  return std::make_shared<TcpHealthCheckerImpl>(
-      context.cluster(), config, context.mainThreadDispatcher(), context.runtime(),
+  return HealthCheckerImplBase::create<TcpHealthCheckerImpl>(
+      context.api(), context.cluster(), config, context.mainThreadDispatcher(), context.runtime(),
       context.api().randomGenerator(), context.eventLogger());
 }
 
@@ -103,7 +103,7 @@ void TcpHealthCheckerImpl::TcpActiveHealthCheckSession::onEvent(Network::Connect
                      *client_, host_->healthCheckAddress()->asString());
       handleFailure(envoy::data::core::v3::NETWORK);
     }
-    parent_.dispatcher_.deferredDelete(std::move(client_));
+    dispatcher().deferredDelete(std::move(client_));
   }
 
   if (event == Network::ConnectionEvent::Connected && parent_.receive_bytes_.empty()) {
@@ -134,7 +134,7 @@ void TcpHealthCheckerImpl::TcpActiveHealthCheckSession::onInterval() {
   if (!client_) {
     client_ =
         host_
-            ->createHealthCheckConnection(parent_.dispatcher_, parent_.transportSocketOptions(),
+            ->createHealthCheckConnection(dispatcher(), parent_.transportSocketOptions(),
                                           parent_.transportSocketMatchMetadata().get())
             .connection_;
     session_callbacks_ = std::make_shared<TcpSessionCallbacks>(*this);
@@ -15,8 +15,8 @@ namespace ThriftHealthChecker {
 Upstream::HealthCheckerSharedPtr ThriftHealthCheckerFactory::createCustomHealthChecker(
     const envoy::config::core::v3::HealthCheck& config,
     Server::Configuration::HealthCheckerFactoryContext& context) {
-  return std::make_shared<ThriftHealthChecker>(
-      context.cluster(), config,
+  return Upstream::HealthCheckerImplBase::create<ThriftHealthChecker>(
+      context.api(), context.cluster(), config,
       getThriftHealthCheckConfig(config, context.messageValidationVisitor()),
       context.mainThreadDispatcher(), context.runtime(), context.eventLogger(), context.api(),
       ClientFactoryImpl::instance_);
@@ -40,6 +40,9 @@ inline constexpr std::array<uint32_t, 8> kGenericHeaderValueCharTable = {
     0b11111111111111111111111111111111,
 };
 
+inline constexpr ::Envoy::Http::VectorizedCharTable kGenericHeaderValueVectorizedCharTable{
+    kGenericHeaderValueCharTable};
+
 // :method header character table.
 // From RFC 9110: https://www.rfc-editor.org/rfc/rfc9110.html#section-9.1
 //
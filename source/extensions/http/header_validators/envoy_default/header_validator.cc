@@ -193,26 +193,19 @@ HeaderValidator::validateGenericHeaderName(const HeaderString& name) {
 
   const bool reject_header_names_with_underscores =
       config_.headers_with_underscores_action() == HeaderValidatorConfig::REJECT_REQUEST;
-  bool is_valid = true;
-  bool reject_due_to_underscore = false;
-  char c = '\0';
-
-  for (auto iter = key_string_view.begin();
-       iter != key_string_view.end() && is_valid && !reject_due_to_underscore; ++iter) {
-    c = *iter;
-    if (c != '_') {
-      is_valid &= testCharInTable(::Envoy::Http::kGenericHeaderNameCharTable, c);
-    } else {
-      reject_due_to_underscore = reject_header_names_with_underscores;
-    }
-  }
-
-  if (!is_valid) {
+  // '_' is a tchar, so an underscore is only reported if it precedes the first invalid character.
+  const size_t invalid_position = ::Envoy::Http::findFirstNotInCharTable(
+      ::Envoy::Http::kGenericHeaderNameVectorizedCharTable, key_string_view);
+  const size_t underscore_position = reject_header_names_with_underscores
+                                         ? key_string_view.find('_')
+                                         : absl::string_view::npos;
+
+  if (invalid_position != absl::string_view::npos && invalid_position < underscore_position) {
     return {HeaderEntryValidationResult::Action::Reject,
             UhvResponseCodeDetail::get().InvalidNameCharacters};
   }
 
-  if (reject_due_to_underscore) {
+  if (underscore_position != absl::string_view::npos) {
     stats_.incRequestsRejectedWithUnderscoresInHeaders();
     return {HeaderEntryValidationResult::Action::Reject,
             UhvResponseCodeDetail::get().InvalidUnderscore};
@@ -236,14 +229,8 @@ HeaderValidator::validateGenericHeaderValue(const HeaderString& value) {
   //
   // VCHAR          =  %x21-7E
   //                   ; visible (printing) characters
-  const auto& value_string_view = value.getStringView();
-  bool is_valid = true;
-
-  for (auto iter = value_string_view.begin(); iter != value_string_view.end() && is_valid; ++iter) {
-    is_valid &= testCharInTable(kGenericHeaderValueCharTable, *iter);
-  }
-
-  if (!is_valid) {
+  if (!::Envoy::Http::allCharsInTable(kGenericHeaderValueVectorizedCharTable,
+                                     value.getStringView())) {
     return {HeaderValueValidationResult::Action::Reject,
             UhvResponseCodeDetail::get().InvalidValueCharacters};
   }
@@ -67,6 +67,9 @@ public:
                                    const Network::IoHandle::UdpSaveCmsgConfig& udp_save_cmsg_config,
                                    RecvMsgOutput& output) override;
   Api::IoCallUint64Result recv(void* buffer, size_t length, int flags) override;
+  Api::IoCallUint64Result recvZeroCopyCompletions(const ZeroCopyCompletionCb&) override {
+    return {0, Network::IoSocketError::create(SOCKET_ERROR_NOT_SUP)};
+  }
   bool supportsMmsg() const override;
   bool supportsUdpGro() const override;
   Api::SysCallIntResult bind(Network::Address::InstanceConstSharedPtr address) override;
@@ -28,7 +28,7 @@ public:
         lb_config, cluster_info, priority_set, runtime, random, time_source));
   }
 
-private:
+protected:
   class LbFactory : public Upstream::LoadBalancerFactory {
   public:
     LbFactory(OptRef<const Upstream::LoadBalancerConfig> lb_config,
@@ -905,9 +905,20 @@ void EdfLoadBalancerBase::recalculateHostsInSlowStart(const HostVector& hosts) {
 }
 
 void EdfLoadBalancerBase::refresh(uint32_t priority) {
-  const auto add_hosts_source = [this](HostsSource source, const HostVector& hosts) {
+  const auto add_hosts_source = [this](HostsSource source, const HostVector& hosts,
+                                       std::shared_ptr<const void> hosts_ptr) {
+    // Host vectors are immutable and shared across updates, so the scheduler of a source is kept
+    // when the update carries the vector it was built from, e.g. for the hosts of a health change.
+    // Slow start weights change over time, so those schedulers are always rebuilt.
+    auto it = scheduler_.find(source);
+    if (!isSlowStartEnabled() && hosts_ptr != nullptr && it != scheduler_.end() &&
+        it->second.hosts_ == hosts_ptr) {
+      return;
+    }
+
     // Nuke existing scheduler if it exists.
     auto& scheduler = scheduler_[source] = Scheduler{};
+    scheduler.hosts_ = std::move(hosts_ptr);
     refreshHostSource(source);
     if (isSlowStartEnabled()) {
       recalculateHostsInSlowStart(hosts);
@@ -934,32 +945,43 @@ void EdfLoadBalancerBase::refresh(uint32_t priority) {
     // weighted 1. This is because currently we don't refresh host sets if only weights change.
     // We should probably change this to refresh at all times. See the comment in
     // BaseDynamicClusterImpl::updateDynamicHostList about this.
-    scheduler.edf_ = std::make_unique<EdfScheduler<Host>>(EdfScheduler<Host>::createWithPicks(
-        hosts,
-        // We use a fixed weight here. While the weight may change without
-        // notification, this will only be stale until this host is next picked,
-        // at which point it is reinserted into the EdfScheduler with its new
-        // weight in chooseHost().
-        [this](const Host& host) { return hostWeight(host); }, seed_));
+    // We use a fixed weight here. While the weight may change without
+    // notification, this will only be stale until this host is next picked,
+    // at which point its new weight is passed to the scheduler in
+    // chooseHost().
+    const auto host_weight = [this](const Host& host) { return hostWeight(host); };
+    if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.lb_iwrr_scheduler")) {
+      // O(1) picks and an O(n) rebuild. Weights seen on picks are applied in batches.
+      scheduler.edf_ = std::make_unique<IwrrScheduler<Host>>(
+          IwrrScheduler<Host>::createWithPicks(hosts, host_weight, seed_));
+    } else {
+      scheduler.edf_ = std::make_unique<EdfScheduler<Host>>(
+          EdfScheduler<Host>::createWithPicks(hosts, host_weight, seed_));
+    }
   };
   // Populate EdfSchedulers for each valid HostsSource value for the host set at this priority.
   const auto& host_set = priority_set_.hostSetsPerPriority()[priority];
-  add_hosts_source(HostsSource(priority, HostsSource::SourceType::AllHosts), host_set->hosts());
+  add_hosts_source(HostsSource(priority, HostsSource::SourceType::AllHosts), host_set->hosts(),
+                   host_set->hostsPtr());
   add_hosts_source(HostsSource(priority, HostsSource::SourceType::HealthyHosts),
-                   host_set->healthyHosts());
+                   host_set->healthyHosts(), host_set->healthyHostsPtr());
   add_hosts_source(HostsSource(priority, HostsSource::SourceType::DegradedHosts),
-                   host_set->degradedHosts());
+                   host_set->degradedHosts(), host_set->degradedHostsPtr());
+  const HostsPerLocalityConstSharedPtr healthy_hosts_per_locality =
+      host_set->healthyHostsPerLocalityPtr();
   for (uint32_t locality_index = 0;
        locality_index < host_set->healthyHostsPerLocality().get().size(); ++locality_index) {
     add_hosts_source(
         HostsSource(priority, HostsSource::SourceType::LocalityHealthyHosts, locality_index),
-        host_set->healthyHostsPerLocality().get()[locality_index]);
+        host_set->healthyHostsPerLocality().get()[locality_index], healthy_hosts_per_locality);
   }
+  const HostsPerLocalityConstSharedPtr degraded_hosts_per_locality =
+      host_set->degradedHostsPerLocalityPtr();
   for (uint32_t locality_index = 0;
        locality_index < host_set->degradedHostsPerLocality().get().size(); ++locality_index) {
     add_hosts_source(
         HostsSource(priority, HostsSource::SourceType::LocalityDegradedHosts, locality_index),
-        host_set->degradedHostsPerLocality().get()[locality_index]);
+        host_set->degradedHostsPerLocality().get()[locality_index], degraded_hosts_per_locality);
   }
 }
 
@@ -22,6 +22,7 @@
 #include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_protos.h"
 #include "source/common/upstream/edf_scheduler.h"
+#include "source/common/upstream/iwrr_scheduler.h"
 #include "source/common/upstream/load_balancer_context_base.h"
 
 namespace Envoy {
@@ -482,10 +483,14 @@ public:
 
 protected:
   struct Scheduler {
-    // EdfScheduler for weighted LB. The edf_ is only created when the original
-    // host weights of 2 or more hosts differ. When not present, the
+    // Scheduler for weighted LB, an EdfScheduler or, with the
+    // envoy.reloadable_features.lb_iwrr_scheduler runtime feature, an IwrrScheduler. The edf_ is
+    // only created when the original host weights of 2 or more hosts differ. When not present, the
     // implementation of chooseHostOnce falls back to unweightedHostPick.
-    std::unique_ptr<EdfScheduler<Host>> edf_;
+    std::unique_ptr<Upstream::Scheduler<Host>> edf_;
+    // Immutable host vector, or hosts per locality, the scheduler was built from. Holding it
+    // keeps a new one from reusing its address.
+    std::shared_ptr<const void> hosts_;
   };
 
   void initialize();
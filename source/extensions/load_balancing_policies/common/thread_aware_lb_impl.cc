@@ -132,8 +132,9 @@ absl::Status ThreadAwareLoadBalancerBase::refresh() {
                                            normalized_host_weights, min_normalized_weight,
                                            max_normalized_weight, locality_weighted_balancing_);
     RETURN_IF_NOT_OK(status);
-    per_priority_state->current_lb_ = createLoadBalancer(
-        std::move(normalized_host_weights), min_normalized_weight, max_normalized_weight);
+    per_priority_state->current_lb_ =
+        createLoadBalancer(priority, std::move(normalized_host_weights), min_normalized_weight,
+                           max_normalized_weight);
   }
 
   {
@@ -15,8 +15,27 @@ LegacyLeastRequestLbConfig::LegacyLeastRequestLbConfig(const ClusterProto& clust
   }
 }
 
-TypedLeastRequestLbConfig::TypedLeastRequestLbConfig(const LeastRequestLbProto& lb_config)
-    : lb_config_(lb_config) {}
+TypedLeastRequestLbConfig::TypedLeastRequestLbConfig(const LeastRequestLbProto& lb_config,
+                                                     uint32_t concurrency)
+    : lb_config_(lb_config), concurrency_(concurrency) {}
+
+Upstream::ThreadAwareLoadBalancerPtr
+Factory::create(OptRef<const Upstream::LoadBalancerConfig> lb_config,
+                const Upstream::ClusterInfo& cluster_info,
+                const Upstream::PrioritySet& priority_set, Runtime::Loader& runtime,
+                Envoy::Random::RandomGenerator& random, TimeSource& time_source) {
+  auto factory = std::make_shared<LbFactory>(lb_config, cluster_info, priority_set, runtime, random,
+                                             time_source);
+  const auto* typed_config = dynamic_cast<const TypedLeastRequestLbConfig*>(lb_config.ptr());
+  if (typed_config == nullptr || !typed_config->lb_config_.has_per_worker_active_requests()) {
+    return std::make_unique<ThreadAwareLb>(std::move(factory));
+  }
+  // The main thread sends requests too, e.g. from async clients, so it gets a count of its own.
+  return std::make_unique<Upstream::PerWorkerActiveRequestsLoadBalancer>(
+      std::move(factory), priority_set, typed_config->concurrency_ + 1,
+      std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(
+          typed_config->lb_config_.per_worker_active_requests(), aggregation_interval, 100)));
+}
 
 Upstream::LoadBalancerPtr LeastRequestCreator::operator()(
     Upstream::LoadBalancerParams params, OptRef<const Upstream::LoadBalancerConfig> lb_config,
@@ -40,9 +40,11 @@ private:
  */
 class TypedLeastRequestLbConfig : public Upstream::LoadBalancerConfig {
 public:
-  TypedLeastRequestLbConfig(const LeastRequestLbProto& lb_config);
+  TypedLeastRequestLbConfig(const LeastRequestLbProto& lb_config, uint32_t concurrency);
 
   const LeastRequestLbProto lb_config_;
+  // The number of workers, used to size the per worker active request counts.
+  const uint32_t concurrency_;
 };
 
 struct LeastRequestCreator : public Logger::Loggable<Logger::Id::upstream> {
@@ -58,13 +60,21 @@ class Factory : public Common::FactoryBase<LeastRequestLbProto, LeastRequestCrea
 public:
   Factory() : FactoryBase("envoy.load_balancing_policies.least_request") {}
 
+  Upstream::ThreadAwareLoadBalancerPtr create(OptRef<const Upstream::LoadBalancerConfig> lb_config,
+                                              const Upstream::ClusterInfo& cluster_info,
+                                              const Upstream::PrioritySet& priority_set,
+                                              Runtime::Loader& runtime,
+                                              Envoy::Random::RandomGenerator& random,
+                                              TimeSource& time_source) override;
+
   absl::StatusOr<Upstream::LoadBalancerConfigPtr>
-  loadConfig(Server::Configuration::ServerFactoryContext&,
+  loadConfig(Server::Configuration::ServerFactoryContext& context,
              const Protobuf::Message& config) override {
     ASSERT(dynamic_cast<const LeastRequestLbProto*>(&config) != nullptr);
     const LeastRequestLbProto& typed_config = dynamic_cast<const LeastRequestLbProto&>(config);
     // TODO(wbocode): to merge the legacy and typed config and related constructors into one.
-    return Upstream::LoadBalancerConfigPtr{new TypedLeastRequestLbConfig(typed_config)};
+    return Upstream::LoadBalancerConfigPtr{
+        new TypedLeastRequestLbConfig(typed_config, context.options().concurrency())};
   }
 
   absl::StatusOr<Upstream::LoadBalancerConfigPtr>
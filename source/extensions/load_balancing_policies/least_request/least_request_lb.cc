@@ -3,6 +3,86 @@
 namespace Envoy {
 namespace Upstream {
 
+PerWorkerActiveRequests::PerWorkerActiveRequests(uint32_t num_shards,
+                                                 std::chrono::milliseconds aggregation_interval)
+    : num_shards_(num_shards),
+      aggregation_interval_(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(aggregation_interval).count()),
+      shards_(std::make_unique<Shard[]>(num_shards)) {}
+
+PerWorkerActiveRequests::Shard& PerWorkerActiveRequests::shard() const {
+  // Threads are numbered in the order they first count a request, which gives the workers
+  // distinct shards when there are at least as many shards as workers. Threads that share a shard
+  // are still counted correctly, as the counts are atomic.
+  static std::atomic<uint32_t> next_thread_index{0};
+  thread_local const uint32_t thread_index = next_thread_index.fetch_add(1);
+  return shards_[thread_index % num_shards_];
+}
+
+uint64_t PerWorkerActiveRequests::activeRequests(MonotonicTime now) const {
+  Shard& local = shard();
+  const int64_t now_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+  if (now_ns >= local.next_aggregation_.load(std::memory_order_relaxed)) {
+    aggregate(local, now_ns);
+  }
+  const int64_t active = local.total_.load(std::memory_order_relaxed) +
+                         local.active_.load(std::memory_order_relaxed) -
+                         local.aggregated_.load(std::memory_order_relaxed);
+  return std::max<int64_t>(active, 0);
+}
+
+void PerWorkerActiveRequests::aggregate(Shard& local, int64_t now) const {
+  // Only this read touches the other workers' cache lines, and only once per interval.
+  int64_t total = 0;
+  for (uint32_t i = 0; i < num_shards_; ++i) {
+    total += shards_[i].active_.load(std::memory_order_relaxed);
+  }
+  local.total_.store(total, std::memory_order_relaxed);
+  local.aggregated_.store(local.active_.load(std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+  local.next_aggregation_.store(now + aggregation_interval_, std::memory_order_relaxed);
+}
+
+PerWorkerActiveRequestsLoadBalancer::PerWorkerActiveRequestsLoadBalancer(
+    LoadBalancerFactorySharedPtr factory, const PrioritySet& priority_set, uint32_t num_shards,
+    std::chrono::milliseconds aggregation_interval)
+    : factory_(std::move(factory)), priority_set_(priority_set), num_shards_(num_shards),
+      aggregation_interval_(aggregation_interval) {}
+
+absl::Status PerWorkerActiveRequestsLoadBalancer::initialize() {
+  for (const HostSetPtr& host_set : priority_set_.hostSetsPerPriority()) {
+    addPolicyData(host_set->hosts());
+  }
+  priority_update_cb_ = priority_set_.addPriorityUpdateCb(
+      [this](uint32_t, const HostVector& hosts_added, const HostVector&) -> absl::Status {
+        addPolicyData(hosts_added);
+        return absl::OkStatus();
+      });
+  return absl::OkStatus();
+}
+
+void PerWorkerActiveRequestsLoadBalancer::addPolicyData(const HostVector& hosts) const {
+  for (const HostSharedPtr& host : hosts) {
+    if (!host->lbPolicyData().has_value()) {
+      host->setLbPolicyData(
+          std::make_unique<PerWorkerActiveRequests>(num_shards_, aggregation_interval_));
+    }
+  }
+}
+
+uint64_t LeastRequestLoadBalancer::activeRequests(const Host& host) const {
+  if (per_worker_active_requests_) {
+    OptRef<PerWorkerActiveRequests> active_requests =
+        host.typedLbPolicyData<PerWorkerActiveRequests>();
+    // Hosts that cannot hold policy data, such as logical hosts, fall back to the gauge.
+    if (active_requests.has_value()) {
+      return active_requests->activeRequests(time_source_.monotonicTime());
+    }
+  }
+  return host.stats().rq_active_.value();
+}
+
 double LeastRequestLoadBalancer::hostWeight(const Host& host) const {
   // This method is called to calculate the dynamic weight as following when all load balancing
   // weights are not equal:
@@ -27,10 +107,10 @@ double LeastRequestLoadBalancer::hostWeight(const Host& host) const {
   // If the value of active requests is the max value, adding +1 will overflow
   // it and cause a divide by zero. This won't happen in normal cases but stops
   // failing fuzz tests
-  const uint64_t active_request_value =
-      host.stats().rq_active_.value() != std::numeric_limits<uint64_t>::max()
-          ? host.stats().rq_active_.value() + 1
-          : host.stats().rq_active_.value();
+  const uint64_t active_requests = activeRequests(host);
+  const uint64_t active_request_value = active_requests != std::numeric_limits<uint64_t>::max()
+                                            ? active_requests + 1
+                                            : active_requests;
 
   if (active_request_bias_ == 1.0) {
     host_weight = static_cast<double>(host.weight()) / active_request_value;
@@ -89,8 +169,8 @@ HostSharedPtr LeastRequestLoadBalancer::unweightedHostPickFullScan(const HostVec
       continue;
     }
 
-    const auto candidate_active_rq = candidate_host->stats().rq_active_.value();
-    const auto sampled_active_rq = sampled_host->stats().rq_active_.value();
+    const auto candidate_active_rq = activeRequests(*candidate_host);
+    const auto sampled_active_rq = activeRequests(*sampled_host);
 
     if (sampled_active_rq < candidate_active_rq) {
       // Reset the count of known tied hosts.
@@ -129,8 +209,8 @@ HostSharedPtr LeastRequestLoadBalancer::unweightedHostPickNChoices(const HostVec
       continue;
     }
 
-    const auto candidate_active_rq = candidate_host->stats().rq_active_.value();
-    const auto sampled_active_rq = sampled_host->stats().rq_active_.value();
+    const auto candidate_active_rq = activeRequests(*candidate_host);
+    const auto sampled_active_rq = activeRequests(*sampled_host);
 
     if (sampled_active_rq < candidate_active_rq) {
       candidate_host = sampled_host;
@@ -1,10 +1,64 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+#include "envoy/common/time.h"
+
 #include "source/extensions/load_balancing_policies/common/load_balancer_impl.h"
 
 namespace Envoy {
 namespace Upstream {
 
+/**
+ * Active requests of a host, counted by every worker in a cache line of its own so that workers
+ * do not write to the same memory. Each worker sums the counts of all the workers when it reads
+ * them, at most once per aggregation interval, and estimates the active requests in between from
+ * its last sum and its own count.
+ */
+class PerWorkerActiveRequests final : public HostLbPolicyData {
+public:
+  /**
+   * @param num_shards the number of counts, which should be the number of threads sending requests
+   *        to the host.
+   * @param aggregation_interval how often a thread sums the counts of all the threads.
+   */
+  PerWorkerActiveRequests(uint32_t num_shards, std::chrono::milliseconds aggregation_interval);
+
+  // HostLbPolicyData
+  void onRequestActive() override { shard().active_.fetch_add(1, std::memory_order_relaxed); }
+  void onRequestInactive() override { shard().active_.fetch_sub(1, std::memory_order_relaxed); }
+
+  /**
+   * @param now supplies the current time. The counts of all the threads are summed again if the
+   *        calling thread's last sum is older than the aggregation interval.
+   * @return the active requests of the host as of the calling thread's last sum, corrected by the
+   *         requests that it started and finished since.
+   */
+  uint64_t activeRequests(MonotonicTime now) const;
+
+  uint32_t numShards() const { return num_shards_; }
+
+private:
+  struct alignas(64) Shard {
+    std::atomic<int64_t> active_{};
+    // The sum of all the shards' active_, and the value of this shard's active_, as of the last
+    // time the thread summed them.
+    std::atomic<int64_t> total_{};
+    std::atomic<int64_t> aggregated_{};
+    // When the thread sums the counts next, in nanoseconds of monotonic time.
+    std::atomic<int64_t> next_aggregation_{};
+  };
+
+  Shard& shard() const;
+  void aggregate(Shard& local, int64_t now) const;
+
+  const uint32_t num_shards_;
+  const int64_t aggregation_interval_;
+  const std::unique_ptr<Shard[]> shards_;
+};
+
 /**
  * Weighted Least Request load balancer.
  *
@@ -68,7 +122,8 @@ public:
                 ? absl::optional<Runtime::Double>(
                       {least_request_config.active_request_bias(), runtime})
                 : absl::nullopt),
-        selection_method_(least_request_config.selection_method()) {
+        selection_method_(least_request_config.selection_method()),
+        per_worker_active_requests_(least_request_config.has_per_worker_active_requests()) {
     initialize();
   }
 
@@ -97,6 +152,7 @@ private:
                                         const HostsSource& source) override;
   HostSharedPtr unweightedHostPickFullScan(const HostVector& hosts_to_use);
   HostSharedPtr unweightedHostPickNChoices(const HostVector& hosts_to_use);
+  uint64_t activeRequests(const Host& host) const;
 
   const uint32_t choice_count_;
 
@@ -108,6 +164,32 @@ private:
   const absl::optional<Runtime::Double> active_request_bias_runtime_;
   const envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest::SelectionMethod
       selection_method_{};
+  const bool per_worker_active_requests_{};
+};
+
+/**
+ * Thread aware least request load balancer used when active requests are counted per worker. On
+ * the main thread, it attaches a PerWorkerActiveRequests to every host. The worker load balancers
+ * are created by the given factory.
+ */
+class PerWorkerActiveRequestsLoadBalancer : public ThreadAwareLoadBalancer {
+public:
+  PerWorkerActiveRequestsLoadBalancer(LoadBalancerFactorySharedPtr factory,
+                                      const PrioritySet& priority_set, uint32_t num_shards,
+                                      std::chrono::milliseconds aggregation_interval);
+
+  // ThreadAwareLoadBalancer
+  LoadBalancerFactorySharedPtr factory() override { return factory_; }
+  absl::Status initialize() override;
+
+private:
+  void addPolicyData(const HostVector& hosts) const;
+
+  const LoadBalancerFactorySharedPtr factory_;
+  const PrioritySet& priority_set_;
+  const uint32_t num_shards_;
+  const std::chrono::milliseconds aggregation_interval_;
+  Common::CallbackHandlePtr priority_update_cb_;
 };
 
 } // namespace Upstream
@@ -1,5 +1,8 @@
 #include "source/extensions/load_balancing_policies/maglev/maglev_lb.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "envoy/config/cluster/v3/cluster.pb.h"
 
 #include "source/common/runtime/runtime_features.h"
@@ -30,6 +33,52 @@ bool shouldUseCompactTable(size_t num_hosts, uint64_t table_size) {
   return compact_maglev_cost < original_maglev_cost;
 }
 
+// Returns the inverse of value modulo a prime, by Fermat's little theorem. The prime is a table
+// size, so products of two values below it fit in 64 bits.
+uint64_t inverseModPrime(uint64_t value, uint64_t prime) {
+  uint64_t result = 1;
+  for (uint64_t exponent = prime - 2; exponent > 0; exponent >>= 1) {
+    if (exponent & 1) {
+      result = result * value % prime;
+    }
+    value = value * value % prime;
+  }
+  return result;
+}
+
+// Splits the table between the hosts in proportion to their weights, using the largest remainders
+// to assign the entries left over by rounding down. Every host gets at least one entry.
+std::vector<uint64_t> tableShares(const std::vector<double>& weights, uint64_t table_size) {
+  double total_weight = 0;
+  for (const double weight : weights) {
+    total_weight += weight;
+  }
+  std::vector<uint64_t> shares(weights.size());
+  std::vector<std::pair<double, uint32_t>> remainders;
+  remainders.reserve(weights.size());
+  uint64_t assigned = 0;
+  for (uint32_t i = 0; i < weights.size(); ++i) {
+    const double exact = weights[i] / total_weight * table_size;
+    shares[i] = std::max<uint64_t>(1, static_cast<uint64_t>(exact));
+    assigned += shares[i];
+    remainders.emplace_back(exact - shares[i], i);
+  }
+  if (assigned < table_size) {
+    std::sort(remainders.begin(), remainders.end(), [](const auto& a, const auto& b) {
+      return a.first > b.first || (a.first == b.first && a.second < b.second);
+    });
+    for (uint64_t i = 0; assigned < table_size && i < remainders.size(); ++i, ++assigned) {
+      shares[remainders[i].second]++;
+    }
+  }
+  // Hosts raised to one entry can leave too few entries for the others.
+  while (assigned > table_size) {
+    --*std::max_element(shares.begin(), shares.end());
+    --assigned;
+  }
+  return shares;
+}
+
 /**
  * Factory for creating the optimal Maglev table instance for the given parameters.
  */
@@ -38,10 +87,19 @@ public:
   static MaglevTableSharedPtr
   createMaglevTable(const NormalizedHostWeightVector& normalized_host_weights,
                     double max_normalized_weight, uint64_t table_size,
-                    bool use_hostname_for_hashing, MaglevLoadBalancerStats& stats) {
+                    bool use_hostname_for_hashing, MaglevLoadBalancerStats& stats,
+                    const CompactMaglevTable* previous) {
 
     MaglevTableSharedPtr maglev_table;
     if (shouldUseCompactTable(normalized_host_weights.size(), table_size)) {
+      if (previous != nullptr) {
+        maglev_table = std::make_shared<CompactMaglevTable>(
+            *previous, normalized_host_weights, max_normalized_weight, table_size,
+            use_hostname_for_hashing, stats);
+        ENVOY_LOG(debug, "updating compact maglev table given table size {} and number of hosts {}",
+                  table_size, normalized_host_weights.size());
+        return maglev_table;
+      }
       maglev_table =
           std::make_shared<CompactMaglevTable>(normalized_host_weights, max_normalized_weight,
                                                table_size, use_hostname_for_hashing, stats);
@@ -70,12 +128,22 @@ LegacyMaglevLbConfig::LegacyMaglevLbConfig(const ClusterProto& cluster) {
 TypedMaglevLbConfig::TypedMaglevLbConfig(const MaglevLbProto& lb_config) : lb_config_(lb_config) {}
 
 ThreadAwareLoadBalancerBase::HashingLoadBalancerSharedPtr
-MaglevLoadBalancer::createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
+MaglevLoadBalancer::createLoadBalancer(uint32_t priority,
+                                       const NormalizedHostWeightVector& normalized_host_weights,
                                        double /* min_normalized_weight */,
                                        double max_normalized_weight) {
-  HashingLoadBalancerSharedPtr maglev_lb =
+  const CompactMaglevTable* previous = nullptr;
+  if (incremental_table_update_) {
+    compact_tables_.resize(priority_set_.hostSetsPerPriority().size());
+    previous = compact_tables_[priority].get();
+  }
+  MaglevTableSharedPtr maglev_table =
       MaglevFactory::createMaglevTable(normalized_host_weights, max_normalized_weight, table_size_,
-                                       use_hostname_for_hashing_, stats_);
+                                       use_hostname_for_hashing_, stats_, previous);
+  if (incremental_table_update_) {
+    compact_tables_[priority] = std::dynamic_pointer_cast<const CompactMaglevTable>(maglev_table);
+  }
+  HashingLoadBalancerSharedPtr maglev_lb = std::move(maglev_table);
 
   if (hash_balance_factor_ == 0) {
     return maglev_lb;
@@ -94,6 +162,15 @@ void MaglevTable::constructMaglevTableInternal(
     return;
   }
 
+  std::vector<TableBuildEntry> table_build_entries =
+      createTableBuildEntries(normalized_host_weights, use_hostname_for_hashing);
+  constructImplementationInternals(table_build_entries, max_normalized_weight);
+  onTableConstructed(table_build_entries, use_hostname_for_hashing);
+}
+
+std::vector<MaglevTable::TableBuildEntry>
+MaglevTable::createTableBuildEntries(const NormalizedHostWeightVector& normalized_host_weights,
+                                     bool use_hostname_for_hashing) {
   // Prepare stable (sorted) vector of host_weight.
   // Maglev requires stable order of table_build_entries because the hash table will be filled in
   // the order. Unstable table_build_entries results the change of backend assignment.
@@ -121,9 +198,11 @@ void MaglevTable::constructMaglevTableInternal(
                                      (HashUtil::xxHash64(key_to_hash, 1) % (table_size_ - 1)) + 1,
                                      weight);
   }
+  return table_build_entries;
+}
 
-  constructImplementationInternals(table_build_entries, max_normalized_weight);
-
+void MaglevTable::onTableConstructed(const std::vector<TableBuildEntry>& table_build_entries,
+                                     bool use_hostname_for_hashing) {
   // Update Stats
   uint64_t min_entries_per_host = table_size_;
   uint64_t max_entries_per_host = 0;
@@ -226,6 +305,122 @@ void CompactMaglevTable::constructImplementationInternals(
   }
 }
 
+CompactMaglevTable::CompactMaglevTable(const CompactMaglevTable& previous,
+                                       const NormalizedHostWeightVector& normalized_host_weights,
+                                       double max_normalized_weight, uint64_t table_size,
+                                       bool use_hostname_for_hashing,
+                                       MaglevLoadBalancerStats& stats)
+    : MaglevTable(table_size, stats),
+      table_(absl::bit_width(normalized_host_weights.size()), table_size) {
+  if (normalized_host_weights.empty() || previous.host_table_.empty() ||
+      previous.table_size_ != table_size_) {
+    constructMaglevTableInternal(normalized_host_weights, max_normalized_weight,
+                                 use_hostname_for_hashing);
+    return;
+  }
+  std::vector<TableBuildEntry> table_build_entries =
+      createTableBuildEntries(normalized_host_weights, use_hostname_for_hashing);
+  constructFromPrevious(previous, table_build_entries, use_hostname_for_hashing);
+  onTableConstructed(table_build_entries, use_hostname_for_hashing);
+}
+
+void CompactMaglevTable::constructFromPrevious(const CompactMaglevTable& previous,
+                                               std::vector<TableBuildEntry>& table_build_entries,
+                                               bool use_hostname_for_hashing) {
+  constexpr uint32_t Unassigned = std::numeric_limits<uint32_t>::max();
+  host_table_.reserve(table_build_entries.size());
+  std::vector<absl::string_view> keys;
+  keys.reserve(table_build_entries.size());
+  std::vector<double> weights;
+  weights.reserve(table_build_entries.size());
+  for (const auto& entry : table_build_entries) {
+    host_table_.emplace_back(entry.host_);
+    keys.push_back(hashKey(entry.host_, use_hostname_for_hashing));
+    weights.push_back(entry.weight_);
+  }
+  host_table_.shrink_to_fit();
+
+  // Both host tables are sorted by hash key, so the hosts that are still present are matched by
+  // walking them together.
+  std::vector<uint32_t> previous_to_current(previous.host_table_.size(), Unassigned);
+  uint32_t current = 0;
+  for (uint32_t i = 0; i < previous.host_table_.size() && current < keys.size(); ++i) {
+    const absl::string_view key = hashKey(previous.host_table_[i], use_hostname_for_hashing);
+    while (current < keys.size() && keys[current] < key) {
+      ++current;
+    }
+    if (current < keys.size() && keys[current] == key) {
+      previous_to_current[i] = current++;
+    }
+  }
+
+  std::vector<uint32_t> owners(table_size_);
+  for (uint64_t c = 0; c < table_size_; ++c) {
+    owners[c] = previous_to_current[previous.table_.get(c)];
+    if (owners[c] != Unassigned) {
+      table_build_entries[owners[c]].count_++;
+    }
+  }
+
+  // Hosts with more entries than their share keep the ones that come first in their permutation,
+  // which are the ones a full construction would give them first.
+  const std::vector<uint64_t> shares = tableShares(weights, table_size_);
+  std::vector<std::vector<uint32_t>> excess_entries(table_build_entries.size());
+  for (uint64_t c = 0; c < table_size_; ++c) {
+    if (owners[c] != Unassigned && table_build_entries[owners[c]].count_ > shares[owners[c]]) {
+      excess_entries[owners[c]].push_back(c);
+    }
+  }
+  for (uint32_t i = 0; i < table_build_entries.size(); ++i) {
+    TableBuildEntry& entry = table_build_entries[i];
+    std::vector<uint32_t>& entries = excess_entries[i];
+    if (entries.empty()) {
+      continue;
+    }
+    const uint64_t inverse_skip = inverseModPrime(entry.skip_, table_size_);
+    const auto position = [&](uint32_t c) {
+      return (c + table_size_ - entry.offset_) % table_size_ * inverse_skip % table_size_;
+    };
+    std::nth_element(entries.begin(), entries.begin() + shares[i], entries.end(),
+                     [&](uint32_t a, uint32_t b) { return position(a) < position(b); });
+    for (auto it = entries.begin() + shares[i]; it != entries.end(); ++it) {
+      owners[*it] = Unassigned;
+    }
+    entry.count_ = shares[i];
+  }
+
+  // The hosts short of their share take free entries in turns, each in its permutation order, as
+  // in the full construction. The shares add up to the table size, so there are exactly enough.
+  std::vector<uint32_t> pending;
+  for (uint32_t i = 0; i < table_build_entries.size(); ++i) {
+    if (table_build_entries[i].count_ < shares[i]) {
+      pending.push_back(i);
+    }
+  }
+  while (!pending.empty()) {
+    size_t still_pending = 0;
+    for (const uint32_t i : pending) {
+      TableBuildEntry& entry = table_build_entries[i];
+      uint64_t c = permutation(entry);
+      while (owners[c] != Unassigned) {
+        entry.next_++;
+        c = permutation(entry);
+      }
+      owners[c] = i;
+      entry.next_++;
+      entry.count_++;
+      if (entry.count_ < shares[i]) {
+        pending[still_pending++] = i;
+      }
+    }
+    pending.resize(still_pending);
+  }
+
+  for (uint64_t c = 0; c < table_size_; ++c) {
+    table_.set(c, owners[c]);
+  }
+}
+
 void OriginalMaglevTable::logMaglevTable(bool use_hostname_for_hashing) const {
   for (uint64_t i = 0; i < table_.size(); ++i) {
     const absl::string_view key_to_hash = hashKey(table_[i], use_hostname_for_hashing);
@@ -326,7 +521,8 @@ MaglevLoadBalancer::MaglevLoadBalancer(
               ? config.consistent_hashing_lb_config().use_hostname_for_hashing()
               : false),
       hash_balance_factor_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.consistent_hashing_lb_config(),
-                                                           hash_balance_factor, 0)) {
+                                                           hash_balance_factor, 0)),
+      incremental_table_update_(config.incremental_table_update()) {
   ENVOY_LOG(debug, "maglev table size: {}", table_size_);
   // The table size must be prime number.
   if (!Primes::isPrime(table_size_)) {
@@ -102,6 +102,19 @@ protected:
   void constructMaglevTableInternal(const NormalizedHostWeightVector& normalized_host_weights,
                                     double max_normalized_weight, bool use_hostname_for_hashing);
 
+  /**
+   * Creates the table build entries of the hosts, sorted by hash key.
+   */
+  std::vector<TableBuildEntry>
+  createTableBuildEntries(const NormalizedHostWeightVector& normalized_host_weights,
+                          bool use_hostname_for_hashing);
+
+  /**
+   * Updates the stats once the table is constructed.
+   */
+  void onTableConstructed(const std::vector<TableBuildEntry>& table_build_entries,
+                          bool use_hostname_for_hashing);
+
   const uint64_t table_size_;
   MaglevLoadBalancerStats& stats_;
 
@@ -156,6 +169,16 @@ public:
   CompactMaglevTable(const NormalizedHostWeightVector& normalized_host_weights,
                      double max_normalized_weight, uint64_t table_size,
                      bool use_hostname_for_hashing, MaglevLoadBalancerStats& stats);
+  /**
+   * Constructs the table by updating a previous one. The entries of hosts that are still present
+   * are kept, except for those in excess of the host's share of the table, and the others are
+   * given to the hosts that are short of their share. See the incremental_table_update field of
+   * the Maglev config.
+   */
+  CompactMaglevTable(const CompactMaglevTable& previous,
+                     const NormalizedHostWeightVector& normalized_host_weights,
+                     double max_normalized_weight, uint64_t table_size,
+                     bool use_hostname_for_hashing, MaglevLoadBalancerStats& stats);
   ~CompactMaglevTable() override = default;
 
   // ThreadAwareLoadBalancerBase::HashingLoadBalancer
@@ -164,6 +187,9 @@ public:
 private:
   void constructImplementationInternals(std::vector<TableBuildEntry>& table_build_entries,
                                         double max_normalized_weight) override;
+  void constructFromPrevious(const CompactMaglevTable& previous,
+                             std::vector<TableBuildEntry>& table_build_entries,
+                             bool use_hostname_for_hashing);
   void logMaglevTable(bool use_hostname_for_hashing) const override;
 
   // Leverage a BitArray to more compactly fit represent the MaglevTable.
@@ -194,7 +220,7 @@ public:
 private:
   // ThreadAwareLoadBalancerBase
   HashingLoadBalancerSharedPtr
-  createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
+  createLoadBalancer(uint32_t priority, const NormalizedHostWeightVector& normalized_host_weights,
                      double /* min_normalized_weight */, double max_normalized_weight) override;
   static MaglevLoadBalancerStats generateStats(Stats::Scope& scope);
 
@@ -203,6 +229,9 @@ private:
   const uint64_t table_size_;
   const bool use_hostname_for_hashing_;
   const uint32_t hash_balance_factor_;
+  const bool incremental_table_update_{};
+  // The current table of each priority, kept to update it when incremental_table_update_ is set.
+  std::vector<std::shared_ptr<const CompactMaglevTable>> compact_tables_;
 };
 
 } // namespace Upstream
@@ -1,5 +1,10 @@
 #include "source/extensions/load_balancing_policies/ring_hash/config.h"
 
+#include <algorithm>
+#include <thread>
+
+#include "envoy/singleton/manager.h"
+
 #include "source/extensions/load_balancing_policies/ring_hash/ring_hash_lb.h"
 
 namespace Envoy {
@@ -7,6 +12,20 @@ namespace Extensions {
 namespace LoadBalancingPolices {
 namespace RingHash {
 
+SINGLETON_MANAGER_REGISTRATION(ring_hash_build_thread_pool);
+
+Upstream::RingBuildThreadPoolSharedPtr
+buildThreadPool(Server::Configuration::ServerFactoryContext& context) {
+  return context.singletonManager().getTyped<Upstream::RingBuildThreadPool>(
+      SINGLETON_MANAGER_REGISTERED_NAME(ring_hash_build_thread_pool), [&context] {
+        // The thread building the ring works on it too.
+        const uint32_t threads = std::min(Upstream::RingBuildThreadPool::MaxConcurrency,
+                                          std::max(1U, std::thread::hardware_concurrency()));
+        return std::make_shared<Upstream::RingBuildThreadPool>(context.api().threadFactory(),
+                                                               threads - 1);
+      });
+}
+
 Upstream::ThreadAwareLoadBalancerPtr
 Factory::create(OptRef<const Upstream::LoadBalancerConfig> lb_config,
                 const Upstream::ClusterInfo& cluster_info,
@@ -22,14 +41,15 @@ Factory::create(OptRef<const Upstream::LoadBalancerConfig> lb_config,
     return std::make_unique<Upstream::RingHashLoadBalancer>(
         priority_set, cluster_info.lbStats(), cluster_info.statsScope(), runtime, random,
         active_or_legacy.hasLegacy() ? active_or_legacy.legacy()->lbConfig() : absl::nullopt,
-        cluster_info.lbConfig());
+        cluster_info.lbConfig(),
+        active_or_legacy.hasLegacy() ? active_or_legacy.legacy()->buildPool() : nullptr);
   }
 
   return std::make_unique<Upstream::RingHashLoadBalancer>(
       priority_set, cluster_info.lbStats(), cluster_info.statsScope(), runtime, random,
       PROTOBUF_PERCENT_TO_ROUNDED_INTEGER_OR_DEFAULT(cluster_info.lbConfig(),
                                                      healthy_panic_threshold, 100, 50),
-      active_or_legacy.active()->lb_config_);
+      active_or_legacy.active()->lb_config_, active_or_legacy.active()->build_pool_);
 }
 
 /**
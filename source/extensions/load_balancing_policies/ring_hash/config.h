@@ -17,6 +17,13 @@ namespace RingHash {
 
 using RingHashLbProto = envoy::extensions::load_balancing_policies::ring_hash::v3::RingHash;
 
+/**
+ * @return the helper threads that large rings are built with, shared by all ring hash load
+ *         balancers of the server.
+ */
+Upstream::RingBuildThreadPoolSharedPtr
+buildThreadPool(Server::Configuration::ServerFactoryContext& context);
+
 class Factory : public Upstream::TypedLoadBalancerFactoryBase<RingHashLbProto> {
 public:
   Factory() : TypedLoadBalancerFactoryBase("envoy.load_balancing_policies.ring_hash") {}
@@ -29,18 +36,20 @@ public:
                                               TimeSource& time_source) override;
 
   absl::StatusOr<Upstream::LoadBalancerConfigPtr>
-  loadConfig(Server::Configuration::ServerFactoryContext&,
+  loadConfig(Server::Configuration::ServerFactoryContext& context,
              const Protobuf::Message& config) override {
     ASSERT(dynamic_cast<const RingHashLbProto*>(&config) != nullptr);
     const RingHashLbProto& typed_config = dynamic_cast<const RingHashLbProto&>(config);
     // TODO(wbocode): to merge the legacy and typed config and related constructors into one.
-    return Upstream::LoadBalancerConfigPtr{new Upstream::TypedRingHashLbConfig(typed_config)};
+    return Upstream::LoadBalancerConfigPtr{
+        new Upstream::TypedRingHashLbConfig(typed_config, buildThreadPool(context))};
   }
 
   absl::StatusOr<Upstream::LoadBalancerConfigPtr>
-  loadLegacy(Server::Configuration::ServerFactoryContext&,
+  loadLegacy(Server::Configuration::ServerFactoryContext& context,
              const Upstream::ClusterProto& cluster) override {
-    return Upstream::LoadBalancerConfigPtr{new Upstream::LegacyRingHashLbConfig(cluster)};
+    return Upstream::LoadBalancerConfigPtr{
+        new Upstream::LegacyRingHashLbConfig(cluster, buildThreadPool(context))};
   }
 };
 
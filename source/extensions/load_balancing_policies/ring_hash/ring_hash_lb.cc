@@ -1,6 +1,9 @@
 #include "source/extensions/load_balancing_policies/ring_hash/ring_hash_lb.h"
 
+#include <algorithm>
+#include <bit>
 #include <cstdint>
+#include <functional>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -15,20 +18,24 @@
 namespace Envoy {
 namespace Upstream {
 
-LegacyRingHashLbConfig::LegacyRingHashLbConfig(const ClusterProto& cluster) {
+LegacyRingHashLbConfig::LegacyRingHashLbConfig(const ClusterProto& cluster,
+                                               RingBuildThreadPoolSharedPtr build_pool)
+    : build_pool_(std::move(build_pool)) {
   if (cluster.has_ring_hash_lb_config()) {
     lb_config_ = cluster.ring_hash_lb_config();
   }
 }
 
-TypedRingHashLbConfig::TypedRingHashLbConfig(const RingHashLbProto& lb_config)
-    : lb_config_(lb_config) {}
+TypedRingHashLbConfig::TypedRingHashLbConfig(const RingHashLbProto& lb_config,
+                                             RingBuildThreadPoolSharedPtr build_pool)
+    : lb_config_(lb_config), build_pool_(std::move(build_pool)) {}
 
 RingHashLoadBalancer::RingHashLoadBalancer(
     const PrioritySet& priority_set, ClusterLbStats& stats, Stats::Scope& scope,
     Runtime::Loader& runtime, Random::RandomGenerator& random,
     OptRef<const envoy::config::cluster::v3::Cluster::RingHashLbConfig> config,
-    const envoy::config::cluster::v3::Cluster::CommonLbConfig& common_config)
+    const envoy::config::cluster::v3::Cluster::CommonLbConfig& common_config,
+    RingBuildThreadPoolSharedPtr build_pool)
     : ThreadAwareLoadBalancerBase(priority_set, stats, runtime, random,
                                   PROTOBUF_PERCENT_TO_ROUNDED_INTEGER_OR_DEFAULT(
                                       common_config, healthy_panic_threshold, 100, 50),
@@ -48,7 +55,8 @@ RingHashLoadBalancer::RingHashLoadBalancer(
               ? common_config.consistent_hashing_lb_config().use_hostname_for_hashing()
               : false),
       hash_balance_factor_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
-          common_config.consistent_hashing_lb_config(), hash_balance_factor, 0)) {
+          common_config.consistent_hashing_lb_config(), hash_balance_factor, 0)),
+      build_pool_(std::move(build_pool)) {
   // It's important to do any config validation here, rather than deferring to Ring's ctor,
   // because any exceptions thrown here will be caught and handled properly.
   if (min_ring_size_ > max_ring_size_) {
@@ -60,7 +68,8 @@ RingHashLoadBalancer::RingHashLoadBalancer(
 RingHashLoadBalancer::RingHashLoadBalancer(
     const PrioritySet& priority_set, ClusterLbStats& stats, Stats::Scope& scope,
     Runtime::Loader& runtime, Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
-    const envoy::extensions::load_balancing_policies::ring_hash::v3::RingHash& config)
+    const envoy::extensions::load_balancing_policies::ring_hash::v3::RingHash& config,
+    RingBuildThreadPoolSharedPtr build_pool)
     : ThreadAwareLoadBalancerBase(priority_set, stats, runtime, random, healthy_panic_threshold,
                                   config.has_locality_weighted_lb_config()),
       scope_(scope.createScope("ring_hash_lb.")), stats_(generateStats(*scope_)),
@@ -76,7 +85,8 @@ RingHashLoadBalancer::RingHashLoadBalancer(
       hash_balance_factor_(config.has_consistent_hashing_lb_config()
                                ? PROTOBUF_GET_WRAPPED_OR_DEFAULT(
                                      config.consistent_hashing_lb_config(), hash_balance_factor, 0)
-                               : PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, hash_balance_factor, 0)) {
+                               : PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, hash_balance_factor, 0)),
+      build_pool_(std::move(build_pool)) {
   // It's important to do any config validation here, rather than deferring to Ring's ctor,
   // because any exceptions thrown here will be caught and handled properly.
   if (min_ring_size_ > max_ring_size_) {
@@ -90,59 +100,93 @@ RingHashLoadBalancerStats RingHashLoadBalancer::generateStats(Stats::Scope& scop
 }
 
 HostSelectionResponse RingHashLoadBalancer::Ring::chooseHost(uint64_t h, uint32_t attempt) const {
-  if (ring_.empty()) {
+  // Index 0 of the ring is unused.
+  if (hashes_.size() < 2) {
     return {nullptr};
   }
 
-  // Ported from https://github.com/RJ/ketama/blob/master/libketama/ketama.c (ketama_get_server)
-  // I've generally kept the variable names to make the code easier to compare.
-  // NOTE: The algorithm depends on using signed integers for lowp, midp, and highp. Do not
-  //       change them!
-  int64_t lowp = 0;
-  int64_t highp = ring_.size();
-  int64_t midp = 0;
-  while (true) {
-    midp = (lowp + highp) / 2;
-
-    if (midp == static_cast<int64_t>(ring_.size())) {
-      midp = 0;
-      break;
-    }
+  // Look for the first hash that is at least h. At each node the search goes right if the node's
+  // hash is below h and left otherwise, which is recorded in the bits of k.
+  const uint64_t size = hashes_.size();
+  uint64_t k = 1;
+  while (k < size) {
+    k = 2 * k + (hashes_[k] < h);
+  }
+  // The first hash that is at least h is the last node the search went left at: drop the right
+  // moves made after it, then the left move. If h is above every hash, nothing is left and the
+  // ring wraps around.
+  k >>= std::countr_one(k) + 1;
+  if (k == 0) {
+    k = first();
+  }
 
-    uint64_t midval = ring_[midp].hash_;
-    uint64_t midval1 = midp == 0 ? 0 : ring_[midp - 1].hash_;
+  // If a retry host predicate is being applied, behave as if this host was not in the ring.
+  // Note that this does not guarantee a different host: e.g., attempt == ring size or
+  // when the offset causes us to select the same host at another location in the ring.
+  for (uint64_t steps = attempt % (size - 1); steps > 0; --steps) {
+    k = next(k);
+  }
 
-    if (h <= midval && h > midval1) {
-      break;
-    }
+  return hosts_[host_indexes_[k]];
+}
 
-    if (midval < h) {
-      lowp = midp + 1;
-    } else {
-      highp = midp - 1;
-    }
+uint64_t RingHashLoadBalancer::Ring::first() const {
+  uint64_t k = 1;
+  while (2 * k < hashes_.size()) {
+    k = 2 * k;
+  }
+  return k;
+}
 
-    if (lowp > highp) {
-      midp = 0;
-      break;
+uint64_t RingHashLoadBalancer::Ring::next(uint64_t k) const {
+  // The leftmost node of the right subtree, if there is one.
+  if (2 * k + 1 < hashes_.size()) {
+    k = 2 * k + 1;
+    while (2 * k < hashes_.size()) {
+      k = 2 * k;
     }
+    return k;
   }
-
-  // If a retry host predicate is being applied, behave as if this host was not in the ring.
-  // Note that this does not guarantee a different host: e.g., attempt == ring_.size() or
-  // when the offset causes us to select the same host at another location in the ring.
-  if (attempt > 0) {
-    midp = (midp + attempt) % ring_.size();
+  // Otherwise the first ancestor that k is in the left subtree of.
+  while (k & 1) {
+    k >>= 1;
   }
+  k >>= 1;
+  return k == 0 ? first() : k;
+}
 
-  return ring_[midp].host_;
+namespace {
+
+struct HashEntry {
+  uint64_t hash_;
+  uint32_t host_index_;
+
+  bool operator<(const HashEntry& other) const {
+    return hash_ < other.hash_ || (hash_ == other.hash_ && host_index_ < other.host_index_);
+  }
+};
+
+// Runs task(0) to task(tasks - 1) with the pool's threads, or one after the other on the calling
+// thread without a pool.
+void runTasks(RingBuildThreadPool* build_pool, uint32_t tasks,
+              const std::function<void(uint32_t)>& task) {
+  if (build_pool != nullptr) {
+    build_pool->run(tasks, task);
+    return;
+  }
+  for (uint32_t i = 0; i < tasks; ++i) {
+    task(i);
+  }
 }
 
+} // namespace
+
 using HashFunction = envoy::config::cluster::v3::Cluster::RingHashLbConfig::HashFunction;
 RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_host_weights,
                                  double min_normalized_weight, uint64_t min_ring_size,
                                  uint64_t max_ring_size, HashFunction hash_function,
-                                 bool use_hostname_for_hashing, RingHashLoadBalancerStats& stats)
+                                 bool use_hostname_for_hashing, RingHashLoadBalancerStats& stats,
+                                 RingBuildThreadPool* build_pool)
     : stats_(stats) {
   ENVOY_LOG(trace, "ring hash: building ring");
 
@@ -159,76 +203,119 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
   const double scale =
       std::min(std::ceil(min_normalized_weight * min_ring_size) / min_normalized_weight,
                static_cast<double>(max_ring_size));
-
-  // Reserve memory for the entire ring up front.
   const uint64_t ring_size = std::ceil(scale);
-  ring_.reserve(ring_size);
 
-  // Populate the hash ring by walking through the (host, weight) pairs in
+  // Count the hashes of each host by walking through the (host, weight) pairs in
   // normalized_host_weights, and generating (scale * weight) hashes for each host. Since these
   // aren't necessarily whole numbers, we maintain running sums -- current_hashes and
   // target_hashes -- which allows us to populate the ring in a mostly stable way.
   //
   // For example, suppose we have 4 hosts, each with a normalized weight of 0.25, and a scale of
   // 6.0 (because the max_ring_size is 6). That means we want to generate 1.5 hashes per host.
-  // We start the outer loop with current_hashes = 0 and target_hashes = 0.
-  //   - For the first host, we set target_hashes = 1.5. After one run of the inner loop,
-  //     current_hashes = 1. After another run, current_hashes = 2, so the inner loop ends.
+  // We start with current_hashes = 0 and target_hashes = 0.
+  //   - For the first host, we set target_hashes = 1.5. current_hashes is brought up to the next
+  //     whole number, 2, so the host gets two hashes.
   //   - For the second host, target_hashes becomes 3.0, and current_hashes is 2 from before.
-  //     After only one run of the inner loop, current_hashes = 3, so the inner loop ends.
+  //     current_hashes becomes 3, so the host gets one hash.
   //   - Likewise, the third host gets two hashes, and the fourth host gets one hash.
   //
   // For stats reporting, keep track of the minimum and maximum actual number of hashes per host.
   // Users should hopefully pay attention to these numbers and alert if min_hashes_per_host is too
   // low, since that implies an inaccurate request distribution.
-
-  absl::InlinedVector<char, 196> hash_key_buffer;
+  std::vector<absl::string_view> keys_to_hash;
+  keys_to_hash.reserve(normalized_host_weights.size());
+  hosts_.reserve(normalized_host_weights.size());
+  // The hashes of host i are entries first_hash[i] to first_hash[i + 1] - 1 of the ring.
+  std::vector<uint64_t> first_hash(1, 0);
+  first_hash.reserve(normalized_host_weights.size() + 1);
   double current_hashes = 0.0;
   double target_hashes = 0.0;
   uint64_t min_hashes_per_host = ring_size;
   uint64_t max_hashes_per_host = 0;
   for (const auto& entry : normalized_host_weights) {
-    const auto& host = entry.first;
-    const absl::string_view key_to_hash = hashKey(host, use_hostname_for_hashing);
-    ASSERT(!key_to_hash.empty());
-
-    hash_key_buffer.assign(key_to_hash.begin(), key_to_hash.end());
-    hash_key_buffer.emplace_back('_');
-    auto offset_start = hash_key_buffer.end();
+    keys_to_hash.push_back(hashKey(entry.first, use_hostname_for_hashing));
+    ASSERT(!keys_to_hash.back().empty());
+    hosts_.push_back(entry.first);
 
-    // As noted above: maintain current_hashes and target_hashes as running sums across the entire
-    // host set. `i` is needed only to construct the hash key, and tally min/max hashes per host.
     target_hashes += scale * entry.second;
-    uint64_t i = 0;
-    while (current_hashes < target_hashes) {
-      const std::string i_str = absl::StrCat("", i);
-      hash_key_buffer.insert(offset_start, i_str.begin(), i_str.end());
-
-      absl::string_view hash_key(static_cast<char*>(hash_key_buffer.data()),
-                                 hash_key_buffer.size());
-
-      const uint64_t hash =
-          (hash_function == HashFunction::Cluster_RingHashLbConfig_HashFunction_MURMUR_HASH_2)
-              ? MurmurHash::murmurHash2(hash_key, MurmurHash::STD_HASH_SEED)
-              : HashUtil::xxHash64(hash_key);
-
-      ENVOY_LOG(trace, "ring hash: hash_key={} hash={}", hash_key, hash);
-      ring_.push_back({hash, host});
-      ++i;
-      ++current_hashes;
-      hash_key_buffer.erase(offset_start, hash_key_buffer.end());
-    }
-    min_hashes_per_host = std::min(i, min_hashes_per_host);
-    max_hashes_per_host = std::max(i, max_hashes_per_host);
+    const double end_hashes = std::max(current_hashes, std::ceil(target_hashes));
+    const uint64_t hashes = end_hashes - current_hashes;
+    current_hashes = end_hashes;
+    first_hash.push_back(first_hash.back() + hashes);
+    min_hashes_per_host = std::min(hashes, min_hashes_per_host);
+    max_hashes_per_host = std::max(hashes, max_hashes_per_host);
+  }
+  const uint64_t num_hashes = first_hash.back();
+
+  // Large rings are hashed and sorted by several threads, each taking a run of hosts with about
+  // the same number of hashes. Rings are built on the main thread, and an 8M entries ring would
+  // otherwise block it for a long time.
+  const uint32_t max_threads = build_pool != nullptr ? build_pool->concurrency() : 1;
+  const uint32_t num_threads =
+      std::clamp<uint64_t>(num_hashes / MinHashesPerBuildThread, 1, max_threads);
+  // Thread t takes hosts first_host[t] to first_host[t + 1] - 1, and sorts entries bounds[t] to
+  // bounds[t + 1] - 1.
+  std::vector<size_t> first_host(num_threads + 1, hosts_.size());
+  std::vector<uint64_t> bounds(num_threads + 1, num_hashes);
+  for (uint32_t t = 0; t < num_threads; ++t) {
+    first_host[t] = std::lower_bound(first_hash.begin(), first_hash.end() - 1,
+                                     num_hashes * t / num_threads) -
+                    first_hash.begin();
+    bounds[t] = first_hash[first_host[t]];
   }
 
-  std::sort(ring_.begin(), ring_.end(), [](const RingEntry& lhs, const RingEntry& rhs) -> bool {
-    return lhs.hash_ < rhs.hash_;
+  std::vector<HashEntry> ring(num_hashes);
+  runTasks(build_pool, num_threads, [&](uint32_t t) {
+    absl::InlinedVector<char, 196> hash_key_buffer;
+    for (size_t host_index = first_host[t]; host_index < first_host[t + 1]; ++host_index) {
+      const absl::string_view key_to_hash = keys_to_hash[host_index];
+      hash_key_buffer.assign(key_to_hash.begin(), key_to_hash.end());
+      hash_key_buffer.emplace_back('_');
+      auto offset_start = hash_key_buffer.end();
+
+      // `i` is needed only to construct the hash key.
+      for (uint64_t i = 0; i < first_hash[host_index + 1] - first_hash[host_index]; ++i) {
+        const std::string i_str = absl::StrCat("", i);
+        hash_key_buffer.insert(offset_start, i_str.begin(), i_str.end());
+
+        absl::string_view hash_key(static_cast<char*>(hash_key_buffer.data()),
+                                   hash_key_buffer.size());
+
+        const uint64_t hash =
+            (hash_function == HashFunction::Cluster_RingHashLbConfig_HashFunction_MURMUR_HASH_2)
+                ? MurmurHash::murmurHash2(hash_key, MurmurHash::STD_HASH_SEED)
+                : HashUtil::xxHash64(hash_key);
+
+        ENVOY_LOG(trace, "ring hash: hash_key={} hash={}", hash_key, hash);
+        ring[first_hash[host_index] + i] = {hash, static_cast<uint32_t>(host_index)};
+        hash_key_buffer.erase(offset_start, hash_key_buffer.end());
+      }
+    }
+    std::sort(ring.begin() + bounds[t], ring.begin() + bounds[t + 1]);
   });
+  // Merge the sorted runs pairwise.
+  for (uint32_t width = 1; width < num_threads; width *= 2) {
+    const uint32_t merges = (num_threads - width + 2 * width - 1) / (2 * width);
+    runTasks(build_pool, merges, [&](uint32_t m) {
+      const uint32_t t = 2 * width * m;
+      std::inplace_merge(ring.begin() + bounds[t], ring.begin() + bounds[t + width],
+                         ring.begin() + bounds[std::min(t + 2 * width, num_threads)]);
+    });
+  }
+
+  // Visiting the nodes in order hands them the sorted hashes.
+  hashes_.resize(num_hashes + 1);
+  host_indexes_.resize(num_hashes + 1);
+  uint64_t k = first();
+  for (const HashEntry& entry : ring) {
+    hashes_[k] = entry.hash_;
+    host_indexes_[k] = entry.host_index_;
+    k = next(k);
+  }
   if (ENVOY_LOG_CHECK_LEVEL(trace)) {
-    for (const auto& entry : ring_) {
-      const absl::string_view key_to_hash = hashKey(entry.host_, use_hostname_for_hashing);
-      ENVOY_LOG(trace, "ring hash: host={} hash={}", key_to_hash, entry.hash_);
+    for (const HashEntry& entry : ring) {
+      ENVOY_LOG(trace, "ring hash: host={} hash={}", keys_to_hash[entry.host_index_],
+                entry.hash_);
     }
   }
 
@@ -1,15 +1,19 @@
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <vector>
 
 #include "envoy/config/cluster/v3/cluster.pb.h"
 #include "envoy/extensions/load_balancing_policies/ring_hash/v3/ring_hash.pb.h"
 #include "envoy/extensions/load_balancing_policies/ring_hash/v3/ring_hash.pb.validate.h"
 #include "envoy/runtime/runtime.h"
+#include "envoy/singleton/instance.h"
 #include "envoy/stats/scope.h"
 #include "envoy/stats/stats_macros.h"
 #include "envoy/upstream/load_balancer.h"
 
+#include "source/common/common/helper_thread_pool.h"
 #include "source/common/common/logger.h"
 #include "source/extensions/load_balancing_policies/common/thread_aware_lb_impl.h"
 
@@ -20,12 +24,27 @@ using RingHashLbProto = envoy::extensions::load_balancing_policies::ring_hash::v
 using ClusterProto = envoy::config::cluster::v3::Cluster;
 using LegacyRingHashLbProto = ClusterProto::RingHashLbConfig;
 
+/**
+ * The helper threads that large rings are hashed and sorted with, shared by all ring hash load
+ * balancers of the server.
+ */
+class RingBuildThreadPool : public Singleton::Instance, public Thread::HelperThreadPool {
+public:
+  // Rings are split into at most this many parts, which bounds the useful number of threads.
+  static constexpr uint32_t MaxConcurrency = 8;
+
+  RingBuildThreadPool(Thread::ThreadFactory& thread_factory, uint32_t helper_threads)
+      : HelperThreadPool(thread_factory, helper_threads, "ring_hash_build") {}
+};
+
+using RingBuildThreadPoolSharedPtr = std::shared_ptr<RingBuildThreadPool>;
+
 /**
  * Load balancer config that used to wrap legacy ring hash config.
  */
 class LegacyRingHashLbConfig : public Upstream::LoadBalancerConfig {
 public:
-  LegacyRingHashLbConfig(const ClusterProto& cluster);
+  LegacyRingHashLbConfig(const ClusterProto& cluster, RingBuildThreadPoolSharedPtr build_pool);
 
   OptRef<const LegacyRingHashLbProto> lbConfig() const {
     if (lb_config_.has_value()) {
@@ -33,9 +52,11 @@ public:
     }
     return {};
   };
+  const RingBuildThreadPoolSharedPtr& buildPool() const { return build_pool_; }
 
 private:
   absl::optional<LegacyRingHashLbProto> lb_config_;
+  const RingBuildThreadPoolSharedPtr build_pool_;
 };
 
 /**
@@ -43,9 +64,11 @@ private:
  */
 class TypedRingHashLbConfig : public Upstream::LoadBalancerConfig {
 public:
-  TypedRingHashLbConfig(const RingHashLbProto& lb_config);
+  TypedRingHashLbConfig(const RingHashLbProto& lb_config, RingBuildThreadPoolSharedPtr build_pool);
 
   const RingHashLbProto lb_config_;
+  // Used to build large rings with several threads.
+  const RingBuildThreadPoolSharedPtr build_pool_;
 };
 
 /**
@@ -77,32 +100,47 @@ public:
   RingHashLoadBalancer(const PrioritySet& priority_set, ClusterLbStats& stats, Stats::Scope& scope,
                        Runtime::Loader& runtime, Random::RandomGenerator& random,
                        OptRef<const envoy::config::cluster::v3::Cluster::RingHashLbConfig> config,
-                       const envoy::config::cluster::v3::Cluster::CommonLbConfig& common_config);
+                       const envoy::config::cluster::v3::Cluster::CommonLbConfig& common_config,
+                       RingBuildThreadPoolSharedPtr build_pool);
 
   RingHashLoadBalancer(
       const PrioritySet& priority_set, ClusterLbStats& stats, Stats::Scope& scope,
       Runtime::Loader& runtime, Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
-      const envoy::extensions::load_balancing_policies::ring_hash::v3::RingHash& config);
+      const envoy::extensions::load_balancing_policies::ring_hash::v3::RingHash& config,
+      RingBuildThreadPoolSharedPtr build_pool);
 
   const RingHashLoadBalancerStats& stats() const { return stats_; }
 
 private:
   using HashFunction = envoy::config::cluster::v3::Cluster::RingHashLbConfig::HashFunction;
 
-  struct RingEntry {
-    uint64_t hash_;
-    HostConstSharedPtr host_;
-  };
-
+  // The ring is stored in Eytzinger order: node k of an implicit binary search tree has its
+  // children at 2k and 2k + 1, and index 0 is unused. The first levels of the tree share a few
+  // cache lines, and the lookup descends without a data dependent branch.
   struct Ring : public HashingLoadBalancer {
+    // Large rings are built with the threads of build_pool, or on the calling thread alone
+    // without one.
     Ring(const NormalizedHostWeightVector& normalized_host_weights, double min_normalized_weight,
          uint64_t min_ring_size, uint64_t max_ring_size, HashFunction hash_function,
-         bool use_hostname_for_hashing, RingHashLoadBalancerStats& stats);
+         bool use_hostname_for_hashing, RingHashLoadBalancerStats& stats,
+         RingBuildThreadPool* build_pool);
 
     // ThreadAwareLoadBalancerBase::HashingLoadBalancer
     HostSelectionResponse chooseHost(uint64_t hash, uint32_t attempt) const override;
 
-    std::vector<RingEntry> ring_;
+    // Rings of at least this many hashes are hashed and sorted by several threads.
+    static constexpr uint64_t MinHashesPerBuildThread = 64 * 1024;
+
+    // Returns the ring node that comes first in hash order.
+    uint64_t first() const;
+    // Returns the ring node that follows node k in hash order, wrapping around the ring.
+    uint64_t next(uint64_t k) const;
+
+    // The ring's hashes, in Eytzinger order.
+    std::vector<uint64_t> hashes_;
+    // For each node of hashes_, the index of its host in hosts_.
+    std::vector<uint32_t> host_indexes_;
+    std::vector<HostConstSharedPtr> hosts_;
 
     RingHashLoadBalancerStats& stats_;
   };
@@ -110,11 +148,13 @@ private:
 
   // ThreadAwareLoadBalancerBase
   HashingLoadBalancerSharedPtr
-  createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
+  createLoadBalancer(uint32_t /* priority */,
+                     const NormalizedHostWeightVector& normalized_host_weights,
                      double min_normalized_weight, double /* max_normalized_weight */) override {
     HashingLoadBalancerSharedPtr ring_hash_lb =
         std::make_shared<Ring>(normalized_host_weights, min_normalized_weight, min_ring_size_,
-                               max_ring_size_, hash_function_, use_hostname_for_hashing_, stats_);
+                               max_ring_size_, hash_function_, use_hostname_for_hashing_, stats_,
+                               build_pool_.get());
     if (hash_balance_factor_ == 0) {
       return ring_hash_lb;
     }
@@ -135,6 +175,7 @@ private:
   const HashFunction hash_function_;
   const bool use_hostname_for_hashing_;
   const uint32_t hash_balance_factor_;
+  const RingBuildThreadPoolSharedPtr build_pool_;
 };
 
 } // namespace Upstream
@@ -1,5 +1,8 @@
 #include "source/extensions/stat_sinks/open_telemetry/open_telemetry_impl.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "source/common/tracing/null_span_impl.h"
 
 namespace Envoy {
@@ -7,6 +10,60 @@ namespace Extensions {
 namespace StatSinks {
 namespace OpenTelemetry {
 
+namespace {
+
+using ExponentialBuckets =
+    opentelemetry::proto::metrics::v1::ExponentialHistogramDataPoint::Buckets;
+// Counts of exponential histogram buckets, keyed by bucket index at the maximum scale.
+using IndexedCounts = std::vector<std::pair<int64_t, uint64_t>>;
+
+// The smallest scale allowed by the OTLP data model.
+constexpr int32_t MinExponentialScale = -10;
+
+// Returns the index of the exponential histogram bucket holding `value` at `scale`. Bucket i
+// holds values in (base^i, base^(i+1)], where base = 2^(2^-scale).
+int64_t exponentialBucketIndex(double value, int32_t scale) {
+  return static_cast<int64_t>(std::ceil(std::ldexp(std::log2(value), scale))) - 1;
+}
+
+// Returns how many scale steps are needed for the buckets in `counts` to fit in `max_buckets`.
+// Lowering the scale by one merges each pair of adjacent buckets, halving the bucket index.
+uint32_t scaleReduction(const IndexedCounts& counts, uint32_t max_buckets,
+                        uint32_t max_reduction) {
+  if (counts.empty()) {
+    return 0;
+  }
+  const auto [min, max] = std::minmax_element(
+      counts.begin(), counts.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+  uint32_t reduction = 0;
+  while (reduction < max_reduction &&
+         (max->first >> reduction) - (min->first >> reduction) >= max_buckets) {
+    reduction++;
+  }
+  return reduction;
+}
+
+void setExponentialBuckets(ExponentialBuckets& buckets, const IndexedCounts& counts,
+                           uint32_t reduction) {
+  if (counts.empty()) {
+    return;
+  }
+  int64_t offset = counts.front().first >> reduction;
+  int64_t last = offset;
+  for (const auto& [index, count] : counts) {
+    offset = std::min(offset, index >> reduction);
+    last = std::max(last, index >> reduction);
+  }
+  std::vector<uint64_t> bucket_counts(last - offset + 1);
+  for (const auto& [index, count] : counts) {
+    bucket_counts[(index >> reduction) - offset] += count;
+  }
+  buckets.set_offset(offset);
+  buckets.mutable_bucket_counts()->Add(bucket_counts.begin(), bucket_counts.end());
+}
+
+} // namespace
+
 OtlpOptions::OtlpOptions(const SinkConfig& sink_config)
     : report_counters_as_deltas_(sink_config.report_counters_as_deltas()),
       report_histograms_as_deltas_(sink_config.report_histograms_as_deltas()),
@@ -14,7 +71,12 @@ OtlpOptions::OtlpOptions(const SinkConfig& sink_config)
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(sink_config, emit_tags_as_attributes, true)),
       use_tag_extracted_name_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(sink_config, use_tag_extracted_name, true)),
-      stat_prefix_(!sink_config.prefix().empty() ? sink_config.prefix() + "." : "") {}
+      stat_prefix_(!sink_config.prefix().empty() ? sink_config.prefix() + "." : ""),
+      export_exponential_histograms_(sink_config.has_exponential_histogram()),
+      exponential_histogram_max_scale_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(sink_config.exponential_histogram(), max_scale, 20)),
+      exponential_histogram_max_buckets_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(sink_config.exponential_histogram(), max_buckets, 160)) {}
 
 OpenTelemetryGrpcMetricsExporterImpl::OpenTelemetryGrpcMetricsExporterImpl(
     const OtlpOptionsSharedPtr config, Grpc::RawAsyncClientSharedPtr raw_async_client)
@@ -74,7 +136,12 @@ MetricsExportRequestPtr OtlpMetricsFlusherImpl::flush(Stats::MetricSnapshot& sna
   }
 
   for (const auto& histogram : snapshot.histograms()) {
-    if (predicate_(histogram)) {
+    if (!predicate_(histogram)) {
+      continue;
+    }
+    if (config_->exportExponentialHistograms()) {
+      flushExponentialHistogram(*scope_metrics->add_metrics(), histogram, snapshot_time_ns);
+    } else {
       flushHistogram(*scope_metrics->add_metrics(), histogram, snapshot_time_ns);
     }
   }
@@ -143,32 +210,64 @@ void OtlpMetricsFlusherImpl::flushHistogram(opentelemetry::proto::metrics::v1::M
   data_point->add_bucket_counts(histogram_stats.outOfBoundCount());
 }
 
-template <class StatType>
-void OtlpMetricsFlusherImpl::setMetricCommon(
+void OtlpMetricsFlusherImpl::flushExponentialHistogram(
     opentelemetry::proto::metrics::v1::Metric& metric,
-    opentelemetry::proto::metrics::v1::NumberDataPoint& data_point, int64_t snapshot_time_ns,
-    const StatType& stat) const {
-  data_point.set_time_unix_nano(snapshot_time_ns);
-  // TODO(ohadvano): support ``start_time_unix_nano`` optional field
-  metric.set_name(absl::StrCat(config_->statPrefix(), config_->useTagExtractedName()
-                                                          ? stat.tagExtractedName()
-                                                          : stat.name()));
+    const Stats::ParentHistogram& parent_histogram, int64_t snapshot_time_ns) const {
+  auto* histogram = metric.mutable_exponential_histogram();
+  auto* data_point = histogram->add_data_points();
+  setMetricCommon(metric, *data_point, snapshot_time_ns, parent_histogram);
 
-  if (config_->emitTagsAsAttributes()) {
-    for (const auto& tag : stat.tags()) {
-      auto* attribute = data_point.add_attributes();
-      attribute->set_key(tag.name_);
-      attribute->mutable_value()->set_string_value(tag.value_);
+  const bool report_deltas = config_->reportHistogramsAsDeltas();
+  histogram->set_aggregation_temporality(
+      report_deltas ? AggregationTemporality::AGGREGATION_TEMPORALITY_DELTA
+                    : AggregationTemporality::AGGREGATION_TEMPORALITY_CUMULATIVE);
+
+  const Stats::HistogramStatistics& histogram_stats =
+      report_deltas ? parent_histogram.intervalStatistics()
+                    : parent_histogram.cumulativeStatistics();
+  data_point->set_count(histogram_stats.sampleCount());
+  data_point->set_sum(histogram_stats.sampleSum());
+
+  // Each log-linear bin is counted in the exponential bucket holding its midpoint. The bins are
+  // indexed at the maximum scale first, and the scale is then lowered until both the positive and
+  // the negative buckets fit.
+  const int32_t max_scale = config_->exponentialHistogramMaxScale();
+  const std::vector<Stats::ParentHistogram::Bucket> bins =
+      report_deltas ? parent_histogram.detailedIntervalBuckets()
+                    : parent_histogram.detailedTotalBuckets();
+  IndexedCounts positive;
+  IndexedCounts negative;
+  uint64_t zero_count = 0;
+  for (const Stats::ParentHistogram::Bucket& bin : bins) {
+    if (bin.count_ == 0) {
+      continue;
     }
+    // The lower bound is the bound closest to zero, so the midpoint is away from zero from it.
+    const double magnitude = std::abs(bin.lower_bound_) + bin.width_ / 2;
+    if (magnitude == 0) {
+      zero_count += bin.count_;
+      continue;
+    }
+    IndexedCounts& counts = bin.lower_bound_ < 0 ? negative : positive;
+    counts.emplace_back(exponentialBucketIndex(magnitude, max_scale), bin.count_);
   }
+
+  const uint32_t max_buckets = config_->exponentialHistogramMaxBuckets();
+  const uint32_t max_reduction = max_scale - MinExponentialScale;
+  const uint32_t reduction = std::max(scaleReduction(positive, max_buckets, max_reduction),
+                                      scaleReduction(negative, max_buckets, max_reduction));
+  data_point->set_scale(max_scale - static_cast<int32_t>(reduction));
+  data_point->set_zero_count(zero_count);
+  setExponentialBuckets(*data_point->mutable_positive(), positive, reduction);
+  setExponentialBuckets(*data_point->mutable_negative(), negative, reduction);
 }
 
-void OtlpMetricsFlusherImpl::setMetricCommon(
-    opentelemetry::proto::metrics::v1::Metric& metric,
-    opentelemetry::proto::metrics::v1::HistogramDataPoint& data_point, int64_t snapshot_time_ns,
-    const Stats::Metric& stat) const {
+template <class DataPointType, class StatType>
+void OtlpMetricsFlusherImpl::setMetricCommon(opentelemetry::proto::metrics::v1::Metric& metric,
+                                             DataPointType& data_point, int64_t snapshot_time_ns,
+                                             const StatType& stat) const {
   data_point.set_time_unix_nano(snapshot_time_ns);
-  // TODO(ohadvano): support ``start_time_unix_nano optional`` field
+  // TODO(ohadvano): support ``start_time_unix_nano`` optional field
   metric.set_name(absl::StrCat(config_->statPrefix(), config_->useTagExtractedName()
                                                           ? stat.tagExtractedName()
                                                           : stat.name()));
@@ -42,6 +42,9 @@ public:
   bool emitTagsAsAttributes() { return emit_tags_as_attributes_; }
   bool useTagExtractedName() { return use_tag_extracted_name_; }
   const std::string& statPrefix() { return stat_prefix_; }
+  bool exportExponentialHistograms() { return export_exponential_histograms_; }
+  int32_t exponentialHistogramMaxScale() { return exponential_histogram_max_scale_; }
+  uint32_t exponentialHistogramMaxBuckets() { return exponential_histogram_max_buckets_; }
 
 private:
   const bool report_counters_as_deltas_;
@@ -49,6 +52,9 @@ private:
   const bool emit_tags_as_attributes_;
   const bool use_tag_extracted_name_;
   const std::string stat_prefix_;
+  const bool export_exponential_histograms_;
+  const int32_t exponential_histogram_max_scale_;
+  const uint32_t exponential_histogram_max_buckets_;
 };
 
 using OtlpOptionsSharedPtr = std::shared_ptr<OtlpOptions>;
@@ -91,14 +97,14 @@ private:
                       const Stats::ParentHistogram& parent_histogram,
                       int64_t snapshot_time_ns) const;
 
-  template <class StatType>
-  void setMetricCommon(opentelemetry::proto::metrics::v1::Metric& metric,
-                       opentelemetry::proto::metrics::v1::NumberDataPoint& data_point,
-                       int64_t snapshot_time_ns, const StatType& stat) const;
+  void flushExponentialHistogram(opentelemetry::proto::metrics::v1::Metric& metric,
+                                 const Stats::ParentHistogram& parent_histogram,
+                                 int64_t snapshot_time_ns) const;
 
+  template <class DataPointType, class StatType>
   void setMetricCommon(opentelemetry::proto::metrics::v1::Metric& metric,
-                       opentelemetry::proto::metrics::v1::HistogramDataPoint& data_point,
-                       int64_t snapshot_time_ns, const Stats::Metric& stat) const;
+                       DataPointType& data_point, int64_t snapshot_time_ns,
+                       const StatType& stat) const;
 
   const OtlpOptionsSharedPtr config_;
   const std::function<bool(const Stats::Metric&)> predicate_;
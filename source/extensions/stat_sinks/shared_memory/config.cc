@@ -0,0 +1,52 @@
+#include "source/extensions/stat_sinks/shared_memory/config.h"
+
+#include "envoy/extensions/stat_sinks/shared_memory/v3/shared_memory.pb.h"
+#include "envoy/extensions/stat_sinks/shared_memory/v3/shared_memory.pb.validate.h"
+#include "envoy/registry/registry.h"
+
+#include "source/extensions/stat_sinks/shared_memory/shared_memory_impl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace StatSinks {
+namespace SharedMemory {
+
+namespace {
+constexpr uint32_t DefaultRegionSize = 64 * 1024 * 1024;
+// One flush in 12 reads every stat, which drops removed stats within a minute at the default flush
+// interval of 5 seconds.
+constexpr uint32_t DefaultReconcileFlushes = 12;
+} // namespace
+
+absl::StatusOr<Stats::SinkPtr>
+SharedMemorySinkFactory::createStatsSink(const Protobuf::Message& config,
+                                         Server::Configuration::ServerFactoryContext& server) {
+  const auto& sink_config = MessageUtil::downcastAndValidate<
+      const envoy::extensions::stat_sinks::shared_memory::v3::SharedMemorySink&>(
+      config, server.messageValidationContext().staticValidationVisitor());
+
+  auto sink_or_error = SharedMemoryStatsSink::create(
+      server.scope().store(), sink_config.path(),
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(sink_config, max_size_bytes, DefaultRegionSize),
+      server.statsConfig().flushChangedOnly(),
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(sink_config, removed_stats_reconcile_flushes,
+                                      DefaultReconcileFlushes));
+  RETURN_IF_NOT_OK_REF(sink_or_error.status());
+  return std::move(sink_or_error.value());
+}
+
+ProtobufTypes::MessagePtr SharedMemorySinkFactory::createEmptyConfigProto() {
+  return std::make_unique<envoy::extensions::stat_sinks::shared_memory::v3::SharedMemorySink>();
+}
+
+std::string SharedMemorySinkFactory::name() const { return SharedMemoryName; }
+
+/**
+ * Static registration for the shared memory stats sink factory. @see RegisterFactory.
+ */
+REGISTER_FACTORY(SharedMemorySinkFactory, Server::Configuration::StatsSinkFactory);
+
+} // namespace SharedMemory
+} // namespace StatSinks
+} // namespace Extensions
+} // namespace Envoy
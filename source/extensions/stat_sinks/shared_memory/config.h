@@ -0,0 +1,35 @@
+#pragma once
+
+#include "envoy/registry/registry.h"
+#include "envoy/server/instance.h"
+
+#include "source/server/configuration_impl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace StatSinks {
+namespace SharedMemory {
+
+constexpr char SharedMemoryName[] = "envoy.stat_sinks.shared_memory";
+
+/**
+ * Config registration for the shared memory stats sink. @see StatsSinkFactory.
+ */
+class SharedMemorySinkFactory : Logger::Loggable<Logger::Id::config>,
+                                public Server::Configuration::StatsSinkFactory {
+public:
+  absl::StatusOr<Stats::SinkPtr>
+  createStatsSink(const Protobuf::Message& config,
+                  Server::Configuration::ServerFactoryContext& server) override;
+
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override;
+
+  std::string name() const override;
+};
+
+DECLARE_FACTORY(SharedMemorySinkFactory);
+
+} // namespace SharedMemory
+} // namespace StatSinks
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace Envoy {
+namespace Extensions {
+namespace StatSinks {
+namespace SharedMemory {
+
+// The layout of the stats region published by the shared memory stat sink. This header has no
+// dependencies beyond the standard library so that out of process readers can include it.
+//
+// The region starts with a RegionHeader, followed by num_entries_ EntryRecords, num_tags_
+// TagRecords and the strings they refer to. All offsets are in bytes, and all integers are in the
+// host's byte order. Everything after the sequence number is only consistent while the sequence
+// number is even and unchanged: see reader.h.
+
+// "ENVOYSTS" read as a little endian integer.
+constexpr uint64_t RegionMagic = 0x535453594f564e45;
+// Bumped on any incompatible change to the structures below.
+constexpr uint32_t RegionVersion = 1;
+
+// Set in RegionHeader::flags_ when some stats did not fit in the region and were left out.
+constexpr uint32_t RegionFlagTruncated = 0x1;
+
+enum class StatType : uint8_t {
+  Counter = 1,
+  Gauge = 2,
+};
+
+struct RegionHeader {
+  // Written once when the region is created.
+  uint64_t magic_;
+  uint32_t version_;
+  uint32_t header_size_;
+  uint64_t region_size_;
+
+  // Odd while the writer updates the rest of the region.
+  std::atomic<uint64_t> sequence_;
+
+  // The number of bytes in use, starting from the beginning of the region.
+  uint64_t used_size_;
+  // When the values were last written, in milliseconds since the epoch.
+  uint64_t snapshot_time_ms_;
+  uint32_t num_entries_;
+  uint32_t num_tags_;
+  // Offsets of the entry, tag and string sections from the beginning of the region.
+  uint64_t entries_offset_;
+  uint64_t tags_offset_;
+  uint64_t strings_offset_;
+  uint32_t flags_;
+  uint32_t reserved_;
+};
+
+// String offsets are relative to RegionHeader::strings_offset_. Strings are not null terminated.
+struct EntryRecord {
+  // The cumulative value of a counter, or the value of a gauge.
+  uint64_t value_;
+  uint32_t name_offset_;
+  uint32_t name_size_;
+  uint32_t tag_extracted_name_offset_;
+  uint32_t tag_extracted_name_size_;
+  // The entry's tags are TagRecords [first_tag_, first_tag_ + num_tags_).
+  uint32_t first_tag_;
+  uint16_t num_tags_;
+  StatType type_;
+  uint8_t reserved_;
+};
+
+struct TagRecord {
+  uint32_t name_offset_;
+  uint32_t name_size_;
+  uint32_t value_offset_;
+  uint32_t value_size_;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "the sequence number must be usable across processes");
+static_assert(sizeof(RegionHeader) == 88);
+static_assert(sizeof(EntryRecord) == 32);
+static_assert(sizeof(TagRecord) == 16);
+
+} // namespace SharedMemory
+} // namespace StatSinks
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,169 @@
+#include "source/extensions/stat_sinks/shared_memory/reader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+#include "absl/strings/str_cat.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace StatSinks {
+namespace SharedMemory {
+
+absl::StatusOr<RegionSnapshot> decodeRegion(absl::string_view region) {
+  if (region.size() < sizeof(RegionHeader)) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("region of ", region.size(), " bytes is smaller than its header"));
+  }
+  if (reinterpret_cast<uintptr_t>(region.data()) % alignof(RegionHeader) != 0) {
+    return absl::InvalidArgumentError("region is not aligned");
+  }
+  const auto& header = *reinterpret_cast<const RegionHeader*>(region.data());
+  if (header.magic_ != RegionMagic) {
+    return absl::InvalidArgumentError("region does not start with the stats region magic");
+  }
+  if (header.version_ != RegionVersion) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("unsupported region version ", header.version_));
+  }
+  if (header.header_size_ != sizeof(RegionHeader)) {
+    return absl::InvalidArgumentError(absl::StrCat("unexpected header size ", header.header_size_));
+  }
+  if (header.used_size_ != region.size() || header.used_size_ > header.region_size_) {
+    return absl::InvalidArgumentError(absl::StrCat("used size ", header.used_size_,
+                                                   " does not match the region size ",
+                                                   region.size(), " of ", header.region_size_));
+  }
+  // The sections follow each other in order. The counts are 32 bits wide, so once the offsets are
+  // known to be within the region the section ends cannot overflow.
+  if (header.entries_offset_ < sizeof(RegionHeader) || header.tags_offset_ > region.size() ||
+      header.strings_offset_ > region.size() ||
+      header.entries_offset_ + uint64_t(header.num_entries_) * sizeof(EntryRecord) >
+          header.tags_offset_ ||
+      header.tags_offset_ + uint64_t(header.num_tags_) * sizeof(TagRecord) >
+          header.strings_offset_) {
+    return absl::InvalidArgumentError("region sections overlap or are out of bounds");
+  }
+
+  const absl::string_view strings = region.substr(header.strings_offset_);
+  const auto string_at = [strings](uint32_t offset,
+                                   uint32_t size) -> absl::optional<absl::string_view> {
+    if (uint64_t(offset) + size > strings.size()) {
+      return absl::nullopt;
+    }
+    return strings.substr(offset, size);
+  };
+
+  RegionSnapshot snapshot;
+  snapshot.sequence_ = header.sequence_.load(std::memory_order_relaxed);
+  snapshot.snapshot_time_ms_ = header.snapshot_time_ms_;
+  snapshot.truncated_ = (header.flags_ & RegionFlagTruncated) != 0;
+  snapshot.stats_.reserve(header.num_entries_);
+  for (uint32_t i = 0; i < header.num_entries_; ++i) {
+    EntryRecord entry;
+    memcpy(&entry, region.data() + header.entries_offset_ + i * sizeof(EntryRecord),
+           sizeof(entry));
+    if (entry.type_ != StatType::Counter && entry.type_ != StatType::Gauge) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("entry ", i, " has unknown type ", static_cast<int>(entry.type_)));
+    }
+    const absl::optional<absl::string_view> name = string_at(entry.name_offset_, entry.name_size_);
+    const absl::optional<absl::string_view> tag_extracted_name =
+        string_at(entry.tag_extracted_name_offset_, entry.tag_extracted_name_size_);
+    if (!name.has_value() || !tag_extracted_name.has_value()) {
+      return absl::InvalidArgumentError(absl::StrCat("entry ", i, " has a name out of bounds"));
+    }
+    if (uint64_t(entry.first_tag_) + entry.num_tags_ > header.num_tags_) {
+      return absl::InvalidArgumentError(absl::StrCat("entry ", i, " has tags out of bounds"));
+    }
+
+    StatSnapshot& stat = snapshot.stats_.emplace_back();
+    stat.name_ = std::string(*name);
+    stat.tag_extracted_name_ = std::string(*tag_extracted_name);
+    stat.type_ = entry.type_;
+    stat.value_ = entry.value_;
+    stat.tags_.reserve(entry.num_tags_);
+    for (uint32_t t = entry.first_tag_; t < entry.first_tag_ + entry.num_tags_; ++t) {
+      TagRecord tag;
+      memcpy(&tag, region.data() + header.tags_offset_ + t * sizeof(TagRecord), sizeof(tag));
+      const absl::optional<absl::string_view> tag_name =
+          string_at(tag.name_offset_, tag.name_size_);
+      const absl::optional<absl::string_view> tag_value =
+          string_at(tag.value_offset_, tag.value_size_);
+      if (!tag_name.has_value() || !tag_value.has_value()) {
+        return absl::InvalidArgumentError(absl::StrCat("tag ", t, " is out of bounds"));
+      }
+      stat.tags_.emplace_back(std::string(*tag_name), std::string(*tag_value));
+    }
+  }
+  return snapshot;
+}
+
+absl::StatusOr<std::unique_ptr<RegionReader>> RegionReader::open(const std::string& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    return absl::NotFoundError(absl::StrCat("cannot open ", path, ": ", strerror(errno)));
+  }
+  struct stat info;
+  if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(RegionHeader)) {
+    ::close(fd);
+    return absl::InvalidArgumentError(absl::StrCat(path, " is not a stats region"));
+  }
+  void* region = ::mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  const int error = errno;
+  ::close(fd);
+  if (region == MAP_FAILED) {
+    return absl::UnavailableError(absl::StrCat("cannot map ", path, ": ", strerror(error)));
+  }
+  return std::unique_ptr<RegionReader>(new RegionReader(region, info.st_size, true));
+}
+
+RegionReader::RegionReader(const void* region, size_t size, bool owned)
+    : region_(static_cast<const uint8_t*>(region)), size_(size), owned_(owned) {}
+
+RegionReader::~RegionReader() {
+  if (owned_) {
+    ::munmap(const_cast<uint8_t*>(region_), size_);
+  }
+}
+
+absl::StatusOr<RegionSnapshot> RegionReader::snapshot(uint32_t max_attempts) const {
+  if (size_ < sizeof(RegionHeader)) {
+    return absl::InvalidArgumentError("region is smaller than its header");
+  }
+  const auto& header = *reinterpret_cast<const RegionHeader*>(region_);
+  // Backed by 64 bit words so that the copy is aligned for RegionHeader.
+  std::vector<uint64_t> copy;
+  for (uint32_t attempt = 0; attempt < max_attempts; ++attempt) {
+    const uint64_t before = header.sequence_.load(std::memory_order_acquire);
+    if (before % 2 == 1) {
+      std::this_thread::yield();
+      continue;
+    }
+    // The used size may be torn or stale if the writer is active; the sequence check below
+    // discards such copies.
+    const size_t used = std::min<uint64_t>(header.used_size_, size_);
+    copy.resize((used + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    memcpy(copy.data(), region_, used);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (header.sequence_.load(std::memory_order_relaxed) != before) {
+      continue;
+    }
+    return decodeRegion(absl::string_view(reinterpret_cast<const char*>(copy.data()), used));
+  }
+  return absl::UnavailableError(
+      absl::StrCat("region was being updated during ", max_attempts, " attempts"));
+}
+
+} // namespace SharedMemory
+} // namespace StatSinks
+} // namespace Extensions
+} // namespace Envoy
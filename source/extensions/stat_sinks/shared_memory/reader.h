@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "source/extensions/stat_sinks/shared_memory/layout.h"
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace StatSinks {
+namespace SharedMemory {
+
+// Reads the stats region published by the shared memory stat sink. This library only depends on
+// the standard library and Abseil so that it can be linked into agents outside of Envoy.
+
+struct StatSnapshot {
+  std::string name_;
+  std::string tag_extracted_name_;
+  std::vector<std::pair<std::string, std::string>> tags_;
+  StatType type_;
+  uint64_t value_;
+};
+
+struct RegionSnapshot {
+  // The sequence number the snapshot was taken at. It grows by two on every update.
+  uint64_t sequence_;
+  uint64_t snapshot_time_ms_;
+  // True if some stats did not fit in the region.
+  bool truncated_;
+  std::vector<StatSnapshot> stats_;
+};
+
+/**
+ * Checks that a copy of a region is well formed and decodes it.
+ * @param region supplies the bytes of the region, up to its used size. They must be aligned for
+ *        RegionHeader.
+ * @return the decoded region, or an error describing the first layout problem found.
+ */
+absl::StatusOr<RegionSnapshot> decodeRegion(absl::string_view region);
+
+class RegionReader {
+public:
+  /**
+   * Maps the region published at a path.
+   * @param path supplies the path the sink was configured with.
+   */
+  static absl::StatusOr<std::unique_ptr<RegionReader>> open(const std::string& path);
+
+  /**
+   * Reads a region that is already mapped. The memory must outlive the reader.
+   */
+  RegionReader(const void* region, size_t size) : RegionReader(region, size, false) {}
+  ~RegionReader();
+
+  /**
+   * Takes a consistent snapshot of the region: the region is copied while the sequence number is
+   * even, and the copy is kept if the sequence number did not change meanwhile.
+   * @param max_attempts supplies the number of copies to try before giving up.
+   * @return the decoded snapshot, an Unavailable error if every attempt raced with the writer, or
+   *         the error from decodeRegion().
+   */
+  absl::StatusOr<RegionSnapshot> snapshot(uint32_t max_attempts = 1000) const;
+
+private:
+  RegionReader(const void* region, size_t size, bool owned);
+
+  const uint8_t* const region_;
+  const size_t size_;
+  // True if the reader mapped the region and must unmap it.
+  const bool owned_;
+};
+
+} // namespace SharedMemory
+} // namespace StatSinks
+} // namespace Extensions
+} // namespace Envoy
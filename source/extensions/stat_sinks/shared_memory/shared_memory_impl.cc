@@ -0,0 +1,226 @@
+#include "source/extensions/stat_sinks/shared_memory/shared_memory_impl.h"
+
+#include <chrono>
+#include <cstring>
+
+#include "envoy/common/platform.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/fmt.h"
+#include "source/common/common/utility.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace StatSinks {
+namespace SharedMemory {
+
+absl::StatusOr<std::unique_ptr<SharedMemoryStatsSink>>
+SharedMemoryStatsSink::create(Stats::Store& store, const std::string& path, uint32_t size,
+                              bool flush_changed_only, uint32_t reconcile_flushes) {
+  Api::OsSysCalls& os_sys_calls = Api::OsSysCallsSingleton::get();
+  // Readers that still map a previous region would fault on its pages if it was truncated, so it
+  // is replaced with a new file instead.
+  os_sys_calls.unlink(path.c_str());
+  const Api::SysCallIntResult fd =
+      os_sys_calls.open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+  if (fd.return_value_ == -1) {
+    return absl::InvalidArgumentError(
+        fmt::format("cannot create stats region {}: {}", path, errorDetails(fd.errno_)));
+  }
+  Api::SysCallPtrResult mapped{MAP_FAILED, 0};
+  const Api::SysCallIntResult truncated = os_sys_calls.ftruncate(fd.return_value_, size);
+  if (truncated.return_value_ == 0) {
+    mapped = os_sys_calls.mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                               fd.return_value_, 0);
+  }
+  os_sys_calls.close(fd.return_value_);
+  if (mapped.return_value_ == MAP_FAILED) {
+    const int error = truncated.return_value_ == 0 ? mapped.errno_ : truncated.errno_;
+    return absl::InvalidArgumentError(
+        fmt::format("cannot map stats region {}: {}", path, errorDetails(error)));
+  }
+  return std::unique_ptr<SharedMemoryStatsSink>(new SharedMemoryStatsSink(
+      store, static_cast<uint8_t*>(mapped.return_value_), size, flush_changed_only,
+      reconcile_flushes));
+}
+
+SharedMemoryStatsSink::SharedMemoryStatsSink(Stats::Store& store, uint8_t* region, uint32_t size,
+                                             bool flush_changed_only, uint32_t reconcile_flushes)
+    : store_(store), symbol_table_(store.symbolTable()), region_(region), size_(size),
+      header_(reinterpret_cast<RegionHeader*>(region)), flush_changed_only_(flush_changed_only),
+      reconcile_flushes_(reconcile_flushes) {
+  ASSERT(reconcile_flushes_ > 0);
+  const uint64_t sequence = beginWrite();
+  header_->magic_ = RegionMagic;
+  header_->version_ = RegionVersion;
+  header_->header_size_ = sizeof(RegionHeader);
+  header_->region_size_ = size_;
+  writeLayout();
+  endWrite(sequence);
+}
+
+SharedMemoryStatsSink::~SharedMemoryStatsSink() {
+  // Clear the keys before the storage they point into.
+  index_.clear();
+  stats_.clear();
+  ::munmap(region_, size_);
+}
+
+void SharedMemoryStatsSink::flush(Stats::MetricSnapshot& snapshot) {
+  ++flushes_;
+  const uint64_t sequence = beginWrite();
+  bool new_stats = false;
+  size_t recorded = 0;
+  // With change tracking, snapshots only carry the stats that changed, so every reconcile_flushes_
+  // flushes all the stats are read from the store instead.
+  const bool reconcile = flush_changed_only_ && flushes_ % reconcile_flushes_ == 0;
+  if (reconcile) {
+    store_.forEachSinkedCounter([](std::size_t) {}, [&](Stats::Counter& counter) {
+      new_stats |= record(counter, StatType::Counter, counter.value());
+      ++recorded;
+    });
+    store_.forEachSinkedGauge([](std::size_t) {}, [&](Stats::Gauge& gauge) {
+      new_stats |= record(gauge, StatType::Gauge, gauge.value());
+      ++recorded;
+    });
+  } else {
+    for (const auto& counter : snapshot.counters()) {
+      new_stats |=
+          record(counter.counter_.get(), StatType::Counter, counter.counter_.get().value());
+    }
+    for (const auto& gauge : snapshot.gauges()) {
+      new_stats |= record(gauge.get(), StatType::Gauge, gauge.get().value());
+    }
+    recorded = snapshot.counters().size() + snapshot.gauges().size();
+  }
+  // When every stat was read, any stat that was not recorded above has been removed.
+  const bool removed = (!flush_changed_only_ || reconcile) && stats_.size() > recorded;
+  if (removed) {
+    removeStale();
+  }
+  if (new_stats || removed) {
+    writeLayout();
+  }
+  header_->snapshot_time_ms_ = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                   snapshot.snapshotTime().time_since_epoch())
+                                   .count();
+  endWrite(sequence);
+}
+
+bool SharedMemoryStatsSink::record(const Stats::Metric& metric, StatType type, uint64_t value) {
+  Stat* stat;
+  const auto it = index_.find(metric.statName());
+  const bool is_new = it == index_.end();
+  if (is_new) {
+    stat = stats_.emplace_back(std::make_unique<Stat>(metric, type, symbol_table_)).get();
+    index_.emplace(stat->stat_name_.statName(), stat);
+  } else {
+    stat = it->second;
+  }
+  stat->value_ = value;
+  stat->last_flush_ = flushes_;
+  if (stat->entry_ != NotInRegion) {
+    entries()[stat->entry_].value_ = value;
+  }
+  return is_new;
+}
+
+void SharedMemoryStatsSink::removeStale() {
+  index_.clear();
+  std::erase_if(stats_, [this](const std::unique_ptr<Stat>& stat) {
+    return stat->last_flush_ != flushes_;
+  });
+  for (const auto& stat : stats_) {
+    index_.emplace(stat->stat_name_.statName(), stat.get());
+  }
+}
+
+uint64_t SharedMemoryStatsSink::beginWrite() {
+  const uint64_t sequence = header_->sequence_.load(std::memory_order_relaxed);
+  header_->sequence_.store(sequence + 1, std::memory_order_relaxed);
+  // Keeps the writes below from becoming visible before the odd sequence number.
+  std::atomic_thread_fence(std::memory_order_release);
+  return sequence;
+}
+
+void SharedMemoryStatsSink::endWrite(uint64_t sequence) {
+  header_->sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+void SharedMemoryStatsSink::writeLayout() {
+  ++layouts_written_;
+  std::vector<EntryRecord> entries;
+  std::vector<TagRecord> tags;
+  std::string strings;
+  // Tag extracted names and tags are shared by many stats, so strings are stored once.
+  absl::flat_hash_map<std::string, uint32_t> string_offsets;
+  const auto intern = [&](absl::string_view str, uint32_t& offset, uint32_t& size) {
+    auto it = string_offsets.find(str);
+    if (it == string_offsets.end()) {
+      it = string_offsets.emplace(std::string(str), strings.size()).first;
+      strings.append(str.data(), str.size());
+    }
+    offset = it->second;
+    size = str.size();
+  };
+
+  bool truncated = false;
+  for (const auto& stat : stats_) {
+    stat->entry_ = NotInRegion;
+    if (truncated) {
+      continue;
+    }
+    const size_t tags_before = tags.size();
+    const size_t strings_before = strings.size();
+    EntryRecord& entry = entries.emplace_back();
+    entry.value_ = stat->value_;
+    entry.type_ = stat->type_;
+    intern(symbol_table_.toString(stat->stat_name_.statName()), entry.name_offset_,
+           entry.name_size_);
+    intern(stat->tag_extracted_name_, entry.tag_extracted_name_offset_,
+           entry.tag_extracted_name_size_);
+    entry.first_tag_ = tags.size();
+    entry.num_tags_ = stat->tags_.size();
+    for (const Stats::Tag& tag : stat->tags_) {
+      TagRecord& record = tags.emplace_back();
+      intern(tag.name_, record.name_offset_, record.name_size_);
+      intern(tag.value_, record.value_offset_, record.value_size_);
+    }
+    if (sizeof(RegionHeader) + entries.size() * sizeof(EntryRecord) +
+            tags.size() * sizeof(TagRecord) + strings.size() >
+        size_) {
+      // Leave this stat and all the following ones out.
+      entries.pop_back();
+      tags.resize(tags_before);
+      strings.resize(strings_before);
+      truncated = true;
+      continue;
+    }
+    stat->entry_ = entries.size() - 1;
+  }
+
+  header_->num_entries_ = entries.size();
+  header_->num_tags_ = tags.size();
+  header_->entries_offset_ = sizeof(RegionHeader);
+  header_->tags_offset_ = header_->entries_offset_ + entries.size() * sizeof(EntryRecord);
+  header_->strings_offset_ = header_->tags_offset_ + tags.size() * sizeof(TagRecord);
+  header_->used_size_ = header_->strings_offset_ + strings.size();
+  header_->flags_ = truncated ? RegionFlagTruncated : 0;
+  if (!entries.empty()) {
+    memcpy(region_ + header_->entries_offset_, entries.data(),
+           entries.size() * sizeof(EntryRecord));
+  }
+  if (!tags.empty()) {
+    memcpy(region_ + header_->tags_offset_, tags.data(), tags.size() * sizeof(TagRecord));
+  }
+  if (!strings.empty()) {
+    memcpy(region_ + header_->strings_offset_, strings.data(), strings.size());
+  }
+}
+
+} // namespace SharedMemory
+} // namespace StatSinks
+} // namespace Extensions
+} // namespace Envoy
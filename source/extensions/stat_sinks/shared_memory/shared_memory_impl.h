@@ -0,0 +1,106 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/stats/sink.h"
+#include "envoy/stats/store.h"
+
+#include "source/common/stats/symbol_table.h"
+#include "source/extensions/stat_sinks/shared_memory/layout.h"
+
+#include "absl/status/statusor.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace StatSinks {
+namespace SharedMemory {
+
+/**
+ * Publishes counters and gauges in a memory mapped file laid out as described in layout.h.
+ *
+ * The sink remembers every stat it has published, keyed by stat name, so a flush that brings no
+ * new stats only rewrites the values in place. The names, tags and string table are only rewritten
+ * when stats are added or removed. With change tracking, removed stats are found by reading all the
+ * stats from the store every few flushes.
+ */
+class SharedMemoryStatsSink : public Stats::Sink {
+public:
+  /**
+   * Creates the region file and maps it.
+   * @param store supplies the store of the stats that will be flushed.
+   * @param path supplies the path of the region. An existing file is replaced.
+   * @param size supplies the size of the region in bytes.
+   * @param flush_changed_only supplies whether snapshots only carry the stats that changed since
+   *        the previous flush, in which case stats missing from a snapshot are kept.
+   * @param reconcile_flushes supplies, with change tracking, how often the stats are read from the
+   *        store rather than from the snapshot, so that the stats removed since are dropped.
+   */
+  static absl::StatusOr<std::unique_ptr<SharedMemoryStatsSink>>
+  create(Stats::Store& store, const std::string& path, uint32_t size, bool flush_changed_only,
+         uint32_t reconcile_flushes);
+
+  ~SharedMemoryStatsSink() override;
+
+  // Stats::Sink
+  void flush(Stats::MetricSnapshot& snapshot) override;
+  void onHistogramComplete(const Stats::Histogram&, uint64_t) override {}
+
+  const RegionHeader& header() const { return *header_; }
+  uint64_t layoutsWritten() const { return layouts_written_; }
+
+private:
+  // Marks a stat that did not fit in the region.
+  static constexpr uint32_t NotInRegion = UINT32_MAX;
+
+  struct Stat {
+    Stat(const Stats::Metric& metric, StatType type, Stats::SymbolTable& symbol_table)
+        : stat_name_(metric.statName(), symbol_table),
+          tag_extracted_name_(metric.tagExtractedName()), tags_(metric.tags()), type_(type) {}
+
+    Stats::StatNameManagedStorage stat_name_;
+    std::string tag_extracted_name_;
+    Stats::TagVector tags_;
+    StatType type_;
+    uint64_t value_{};
+    // The last flush the stat was part of.
+    uint64_t last_flush_{};
+    // The stat's entry in the region, or NotInRegion.
+    uint32_t entry_{NotInRegion};
+  };
+
+  SharedMemoryStatsSink(Stats::Store& store, uint8_t* region, uint32_t size,
+                        bool flush_changed_only, uint32_t reconcile_flushes);
+
+  EntryRecord* entries() {
+    return reinterpret_cast<EntryRecord*>(region_ + header_->entries_offset_);
+  }
+  // Records the value of a stat, writing it to the region if the stat is there. Returns true if
+  // the stat is new.
+  bool record(const Stats::Metric& metric, StatType type, uint64_t value);
+  // Forgets the stats that were not part of the current flush.
+  void removeStale();
+  uint64_t beginWrite();
+  void endWrite(uint64_t sequence);
+  // Rewrites every section of the region from stats_.
+  void writeLayout();
+
+  Stats::Store& store_;
+  Stats::SymbolTable& symbol_table_;
+  uint8_t* const region_;
+  const uint32_t size_;
+  RegionHeader* const header_;
+  const bool flush_changed_only_;
+  const uint32_t reconcile_flushes_;
+  std::vector<std::unique_ptr<Stat>> stats_;
+  // Indexes stats_. The keys point into the stats' own storage.
+  Stats::StatNameHashMap<Stat*> index_;
+  uint64_t flushes_{};
+  uint64_t layouts_written_{};
+};
+
+} // namespace SharedMemory
+} // namespace StatSinks
+} // namespace Extensions
+} // namespace Envoy
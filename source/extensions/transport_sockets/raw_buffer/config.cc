@@ -6,23 +6,44 @@
 #include "envoy/extensions/transport_sockets/raw_buffer/v3/raw_buffer.pb.validate.h"
 
 #include "source/common/network/raw_buffer_socket.h"
+#include "source/common/protobuf/utility.h"
 
 namespace Envoy {
 namespace Extensions {
 namespace TransportSockets {
 namespace RawBuffer {
 
+namespace {
+
+Network::RawBufferSocketZeroCopyConfigSharedPtr
+zeroCopyConfig(const Protobuf::Message& message,
+               Server::Configuration::TransportSocketFactoryContext& context) {
+  const auto& config = MessageUtil::downcastAndValidate<
+      const envoy::extensions::transport_sockets::raw_buffer::v3::RawBuffer&>(
+      message, context.messageValidationVisitor());
+  if (!config.has_zerocopy_send_threshold()) {
+    return nullptr;
+  }
+  return std::make_shared<Network::RawBufferSocketZeroCopyConfig>(
+      config.zerocopy_send_threshold().value(), context.statsScope(),
+      context.serverFactoryContext().threadLocal());
+}
+
+} // namespace
+
 absl::StatusOr<Network::UpstreamTransportSocketFactoryPtr>
 UpstreamRawBufferSocketFactory::createTransportSocketFactory(
-    const Protobuf::Message&, Server::Configuration::TransportSocketFactoryContext&) {
-  return std::make_unique<Network::RawBufferSocketFactory>();
+    const Protobuf::Message& message,
+    Server::Configuration::TransportSocketFactoryContext& context) {
+  return std::make_unique<Network::RawBufferSocketFactory>(zeroCopyConfig(message, context));
 }
 
 absl::StatusOr<Network::DownstreamTransportSocketFactoryPtr>
 DownstreamRawBufferSocketFactory::createTransportSocketFactory(
-    const Protobuf::Message&, Server::Configuration::TransportSocketFactoryContext&,
+    const Protobuf::Message& message,
+    Server::Configuration::TransportSocketFactoryContext& context,
     const std::vector<std::string>&) {
-  return std::make_unique<Network::RawBufferSocketFactory>();
+  return std::make_unique<Network::RawBufferSocketFactory>(zeroCopyConfig(message, context));
 }
 
 ProtobufTypes::MessagePtr RawBufferSocketFactory::createEmptyConfigProto() {
@@ -1,14 +1,18 @@
 #include "source/server/admin/prometheus_stats.h"
 
+#include <algorithm>
 #include <cmath>
+#include <iterator>
+#include <limits>
+#include <map>
 
-#include "source/common/common/empty_string.h"
 #include "source/common/common/macros.h"
 #include "source/common/common/regex.h"
 #include "source/common/stats/histogram_impl.h"
 #include "source/common/upstream/host_utility.h"
 
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
 #include "absl/strings/str_replace.h"
 
 namespace Envoy {
@@ -46,17 +50,6 @@ std::string sanitizeValue(const absl::string_view value) {
                                     });
 }
 
-/*
- * Comparator for Stats::Metric that does not require a string representation
- * to make the comparison, for memory efficiency.
- */
-struct MetricLessThan {
-  bool operator()(const Stats::Metric* a, const Stats::Metric* b) const {
-    ASSERT(&a->constSymbolTable() == &b->constSymbolTable());
-    return a->constSymbolTable().lessThan(a->statName(), b->statName());
-  }
-};
-
 struct PrimitiveMetricSnapshotLessThan {
   bool operator()(const Stats::PrimitiveMetricMetadata* a,
                   const Stats::PrimitiveMetricMetadata* b) {
@@ -70,149 +63,214 @@ std::string generateNumericOutput(uint64_t value, const Stats::TagVector& tags,
   return fmt::format("{0}{{{1}}} {2}\n", prefixed_tag_extracted_name, formatted_tags, value);
 }
 
-/*
- * Return the prometheus output for a numeric Stat (Counter or Gauge).
+using NameEntry = PrometheusNameCache::Entry;
+
+/**
+ * Formats doubles into an inline buffer, so that rendering a value does not allocate.
  */
-template <class StatType>
-std::string generateStatNumericOutput(const StatType& metric,
-                                      const std::string& prefixed_tag_extracted_name) {
-  return generateNumericOutput(metric.value(), metric.tags(), prefixed_tag_extracted_name);
+class DoubleFormatter {
+public:
+  // We want to print the bucket in a fixed point (non-scientific) format. The fmt library
+  // doesn't have a specific modifier to format as a fixed-point value only so we use the
+  // 'g' operator which prints the number in general fixed point format or scientific format
+  // with precision 50 to round the number up to 32 significant digits in fixed point format
+  // which should cover pretty much all cases
+  absl::string_view fixed(double value) {
+    buffer_.clear();
+    fmt::format_to(std::back_inserter(buffer_), "{:.32g}", value);
+    return {buffer_.data(), buffer_.size()};
+  }
+  absl::string_view shortest(double value) {
+    buffer_.clear();
+    fmt::format_to(std::back_inserter(buffer_), "{}", value);
+    return {buffer_.data(), buffer_.size()};
+  }
+
+private:
+  fmt::memory_buffer buffer_;
+};
+
+// Separates the labels of a stat from a label appended to them.
+absl::string_view labelSeparator(const NameEntry& name) { return name.labels_.empty() ? "" : ","; }
+
+void renderNumeric(const NameEntry& name, uint64_t value, Buffer::Instance& response) {
+  response.addFragments(
+      {name.metric_name_, "{", name.labels_, "} ", absl::AlphaNum(value).Piece(), "\n"});
 }
 
 /*
- * Returns the prometheus output for a TextReadout in gauge format.
+ * Renders a TextReadout in gauge format.
  * It is a workaround of a limitation of prometheus which stores only numeric metrics.
  * The output is a gauge named the same as a given text-readout. The value of returned gauge is
  * always equal to 0. Returned gauge contains all tags of a given text-readout and one additional
  * tag {"text_value":"textReadout.value"}.
  */
-std::string generateTextReadoutOutput(const Stats::TextReadout& text_readout,
-                                      const std::string& prefixed_tag_extracted_name) {
-  auto tags = text_readout.tags();
-  tags.push_back(Stats::Tag{"text_value", text_readout.value()});
-  const std::string formattedTags = PrometheusStatsFormatter::formattedTags(tags);
-  return fmt::format("{0}{{{1}}} 0\n", prefixed_tag_extracted_name, formattedTags);
+void renderTextReadout(const NameEntry& name, const Stats::TextReadout& text_readout,
+                       Buffer::Instance& response) {
+  response.addFragments({name.metric_name_, "{", name.labels_, labelSeparator(name),
+                         "text_value=\"", sanitizeValue(text_readout.value()), "\"} 0\n"});
 }
 
 /*
- * Returns the prometheus output for a histogram. The output is a multi-line string (with embedded
- * newlines) that contains all the individual bucket counts and sum/count for a single histogram
+ * Renders a histogram: all the individual bucket counts and sum/count for a single histogram
  * (metric_name plus all tags).
  */
-std::string generateHistogramOutput(const Stats::ParentHistogram& histogram,
-                                    const std::string& prefixed_tag_extracted_name) {
-  const std::string tags = PrometheusStatsFormatter::formattedTags(histogram.tags());
-  const std::string hist_tags = histogram.tags().empty() ? EMPTY_STRING : (tags + ",");
-
+void renderHistogram(const NameEntry& name, const Stats::ParentHistogram& histogram,
+                     Buffer::Instance& response) {
   const Stats::HistogramStatistics& stats = histogram.cumulativeStatistics();
   Stats::ConstSupportedBuckets& supported_buckets = stats.supportedBuckets();
   const std::vector<uint64_t>& computed_buckets = stats.computedBuckets();
-  std::string output;
+  const absl::string_view separator = labelSeparator(name);
+  DoubleFormatter formatter;
   for (size_t i = 0; i < supported_buckets.size(); ++i) {
-    double bucket = supported_buckets[i];
-    uint64_t value = computed_buckets[i];
-    // We want to print the bucket in a fixed point (non-scientific) format. The fmt library
-    // doesn't have a specific modifier to format as a fixed-point value only so we use the
-    // 'g' operator which prints the number in general fixed point format or scientific format
-    // with precision 50 to round the number up to 32 significant digits in fixed point format
-    // which should cover pretty much all cases
-    output.append(fmt::format("{0}_bucket{{{1}le=\"{2:.32g}\"}} {3}\n", prefixed_tag_extracted_name,
-                              hist_tags, bucket, value));
+    response.addFragments({name.metric_name_, "_bucket{", name.labels_, separator, "le=\"",
+                           formatter.fixed(supported_buckets[i]), "\"} ",
+                           absl::AlphaNum(computed_buckets[i]).Piece(), "\n"});
   }
+  const absl::AlphaNum sample_count(stats.sampleCount());
+  response.addFragments({name.metric_name_, "_bucket{", name.labels_, separator, "le=\"+Inf\"} ",
+                         sample_count.Piece(), "\n"});
+  response.addFragments({name.metric_name_, "_sum{", name.labels_, "} ",
+                         formatter.fixed(stats.sampleSum()), "\n"});
+  response.addFragments(
+      {name.metric_name_, "_count{", name.labels_, "} ", sample_count.Piece(), "\n"});
+}
 
-  output.append(fmt::format("{0}_bucket{{{1}le=\"+Inf\"}} {2}\n", prefixed_tag_extracted_name,
-                            hist_tags, stats.sampleCount()));
-  output.append(fmt::format("{0}_sum{{{1}}} {2:.32g}\n", prefixed_tag_extracted_name, tags,
-                            stats.sampleSum()));
-  output.append(fmt::format("{0}_count{{{1}}} {2}\n", prefixed_tag_extracted_name, tags,
-                            stats.sampleCount()));
-
-  return output;
-};
+/*
+ * Renders a summary: all the individual quantile values and sum/count for a single histogram
+ * (metric_name plus all tags).
+ */
+void renderSummary(const NameEntry& name, const Stats::ParentHistogram& histogram,
+                   Buffer::Instance& response) {
+  const Stats::HistogramStatistics& stats = histogram.intervalStatistics();
+  Stats::ConstSupportedBuckets& supported_quantiles = stats.supportedQuantiles();
+  const std::vector<double>& computed_quantiles = stats.computedQuantiles();
+  const absl::string_view separator = labelSeparator(name);
+  DoubleFormatter quantile_formatter;
+  DoubleFormatter value_formatter;
+  for (size_t i = 0; i < supported_quantiles.size(); ++i) {
+    response.addFragments({name.metric_name_, "{", name.labels_, separator, "quantile=\"",
+                           quantile_formatter.shortest(supported_quantiles[i]), "\"} ",
+                           value_formatter.fixed(computed_quantiles[i]), "\n"});
+  }
+  response.addFragments({name.metric_name_, "_sum{", name.labels_, "} ",
+                         value_formatter.fixed(stats.sampleSum()), "\n"});
+  response.addFragments({name.metric_name_, "_count{", name.labels_, "} ",
+                         absl::AlphaNum(stats.sampleCount()).Piece(), "\n"});
+}
 
 /**
- * Processes a stat type (counter, gauge, histogram) by generating all output lines, sorting
- * them by tag-extracted metric name, and then outputting them in the correct sorted order into
- * response.
- *
- * @param response The buffer to put the output into.
- * @param used_only Whether to only output stats that are used.
- * @param regex A filter on which stats to output.
- * @param metrics The metrics to output stats for. This must contain all stats of the given type
- *        to be included in the same output.
- * @param generate_output A function which returns the output text for this metric.
- * @param type The name of the prometheus metric type for used in TYPE annotations.
+ * Adds a stat to the items to render if it passes the filters and has a valid Prometheus name.
  */
 template <class StatType>
-uint64_t outputStatType(
-    Buffer::Instance& response, const StatsParams& params,
-    const std::vector<Stats::RefcountPtr<StatType>>& metrics,
-    const std::function<std::string(
-        const StatType& metric, const std::string& prefixed_tag_extracted_name)>& generate_output,
-    absl::string_view type, const Stats::CustomStatNamespaces& custom_namespaces) {
-
-  /*
-   * From
-   * https:*github.com/prometheus/docs/blob/master/content/docs/instrumenting/exposition_formats.md#grouping-and-sorting:
-   *
-   * All lines for a given metric must be provided as one single group, with the optional HELP and
-   * TYPE lines first (in no particular order). Beyond that, reproducible sorting in repeated
-   * expositions is preferred but not required, i.e. do not sort if the computational cost is
-   * prohibitive.
-   */
-
-  // This is an unsorted collection of dumb-pointers (no need to increment then decrement every
-  // refcount; ownership is held throughout by `metrics`). It is unsorted for efficiency, but will
-  // be sorted before producing the final output to satisfy the "preferred" ordering from the
-  // prometheus spec: metrics will be sorted by their tags' textual representation, which will be
-  // consistent across calls.
-  using StatTypeUnsortedCollection = std::vector<const StatType*>;
-
-  // Return early to avoid crashing when getting the symbol table from the first metric.
-  if (metrics.empty()) {
-    return 0;
+void addItem(PrometheusStatsRequest::StatItems<StatType>& items, StatType& stat,
+             const StatsParams& params, PrometheusNameCache& name_cache,
+             const Stats::CustomStatNamespaces& custom_namespaces) {
+  if (!params.shouldShowMetric(stat)) {
+    return;
   }
+  const NameEntry& name = name_cache.get(stat, custom_namespaces);
+  if (name.metric_name_.empty()) {
+    return;
+  }
+  items.emplace_back(&name, Stats::RefcountPtr<StatType>(&stat));
+}
 
-  // There should only be one symbol table for all of the stats in the admin
-  // interface. If this assumption changes, the name comparisons in this function
-  // will have to change to compare to convert all StatNames to strings before
-  // comparison.
-  const Stats::SymbolTable& global_symbol_table = metrics.front()->constSymbolTable();
+/**
+ * Sorts items by metric family and then by labels.
+ *
+ * From
+ * https://github.com/prometheus/docs/blob/master/content/docs/instrumenting/exposition_formats.md#grouping-and-sorting:
+ *
+ * All lines for a given metric must be provided as one single group, with the optional HELP and
+ * TYPE lines first (in no particular order). Beyond that, reproducible sorting in repeated
+ * expositions is preferred but not required, i.e. do not sort if the computational cost is
+ * prohibitive.
+ *
+ * Sorting on the cached strings keeps the output consistent across calls without going through
+ * the symbol table.
+ */
+template <class StatType> void sortItems(PrometheusStatsRequest::StatItems<StatType>& items) {
+  std::sort(items.begin(), items.end(), [](const auto& a, const auto& b) {
+    if (a.first->metric_name_ != b.first->metric_name_) {
+      return a.first->metric_name_ < b.first->metric_name_;
+    }
+    return a.first->labels_ < b.first->labels_;
+  });
+}
 
-  // Sorted collection of metrics sorted by their tagExtractedName, to satisfy the requirements
-  // of the exposition format.
-  std::map<Stats::StatName, StatTypeUnsortedCollection, Stats::StatNameLessThan> groups(
-      global_symbol_table);
+template <class StatType>
+PrometheusStatsRequest::StatItems<StatType>
+sortedItems(const std::vector<Stats::RefcountPtr<StatType>>& stats, const StatsParams& params,
+            PrometheusNameCache& name_cache,
+            const Stats::CustomStatNamespaces& custom_namespaces) {
+  PrometheusStatsRequest::StatItems<StatType> items;
+  items.reserve(stats.size());
+  for (const Stats::RefcountPtr<StatType>& stat : stats) {
+    addItem(items, *stat, params, name_cache, custom_namespaces);
+  }
+  sortItems(items);
+  return items;
+}
 
-  for (const auto& metric : metrics) {
-    ASSERT(&global_symbol_table == &metric->constSymbolTable());
-    if (!params.shouldShowMetric(*metric)) {
-      continue;
+/**
+ * Renders sorted items starting at next, writing a TYPE line at the start of each metric family,
+ * until the items run out or limit bytes have been written.
+ *
+ * @return the index of the first item that was not rendered.
+ */
+template <class StatType, class RenderFn>
+size_t renderItems(const PrometheusStatsRequest::StatItems<StatType>& items, size_t next,
+                   absl::string_view type, uint64_t limit, uint64_t& metric_families,
+                   Buffer::Instance& response, RenderFn render) {
+  const uint64_t starting_length = response.length();
+  for (; next < items.size() && response.length() - starting_length < limit; ++next) {
+    const NameEntry& name = *items[next].first;
+    if (next == 0 || items[next - 1].first->metric_name_ != name.metric_name_) {
+      response.addFragments({"# TYPE ", name.metric_name_, " ", type, "\n"});
+      ++metric_families;
     }
-    groups[metric->tagExtractedStatName()].push_back(metric.get());
+    render(name, *items[next].second, response);
   }
+  return next;
+}
 
-  auto result = groups.size();
-  for (auto& group : groups) {
-    const absl::optional<std::string> prefixed_tag_extracted_name =
-        PrometheusStatsFormatter::metricName(global_symbol_table.toString(group.first),
-                                             custom_namespaces);
-    if (!prefixed_tag_extracted_name.has_value()) {
-      --result;
-      continue;
-    }
-    response.add(fmt::format("# TYPE {0} {1}\n", prefixed_tag_extracted_name.value(), type));
+template <class StatType>
+size_t renderNumericItems(const PrometheusStatsRequest::StatItems<StatType>& items, size_t next,
+                          absl::string_view type, uint64_t limit, uint64_t& metric_families,
+                          Buffer::Instance& response) {
+  return renderItems(items, next, type, limit, metric_families, response,
+                     [](const NameEntry& name, const StatType& stat, Buffer::Instance& response) {
+                       renderNumeric(name, stat.value(), response);
+                     });
+}
 
-    // Sort before producing the final output to satisfy the "preferred" ordering from the
-    // prometheus spec: metrics will be sorted by their tags' textual representation, which will
-    // be consistent across calls.
-    std::sort(group.second.begin(), group.second.end(), MetricLessThan());
+size_t renderTextReadoutItems(const PrometheusStatsRequest::StatItems<Stats::TextReadout>& items,
+                              size_t next, uint64_t limit, uint64_t& metric_families,
+                              Buffer::Instance& response) {
+  // TextReadout stats are returned in gauge format, so "gauge" type is set intentionally.
+  return renderItems(items, next, "gauge", limit, metric_families, response, renderTextReadout);
+}
 
-    for (const auto& metric : group.second) {
-      response.add(generate_output(*metric, prefixed_tag_extracted_name.value()));
-    }
+size_t
+renderHistogramItems(const PrometheusStatsRequest::StatItems<Stats::ParentHistogram>& items,
+                     size_t next, Utility::HistogramBucketsMode mode, uint64_t limit,
+                     uint64_t& metric_families, Buffer::Instance& response) {
+  // validation of bucket modes is handled separately
+  switch (mode) {
+  case Utility::HistogramBucketsMode::Summary:
+    return renderItems(items, next, "summary", limit, metric_families, response, renderSummary);
+  case Utility::HistogramBucketsMode::Unset:
+  case Utility::HistogramBucketsMode::Cumulative:
+    return renderItems(items, next, "histogram", limit, metric_families, response,
+                       renderHistogram);
+  // "Detailed" and "Disjoint" don't make sense for prometheus histogram semantics
+  case Utility::HistogramBucketsMode::Detailed:
+  case Utility::HistogramBucketsMode::Disjoint:
+    IS_ENVOY_BUG("unsupported prometheus histogram bucket mode");
+    break;
   }
-  return result;
+  return items.size();
 }
 
 template <class StatType>
@@ -276,35 +334,6 @@ uint64_t outputPrimitiveStatType(Buffer::Instance& response, const StatsParams&
   return result;
 }
 
-/*
- * Returns the prometheus output for a summary. The output is a multi-line string (with embedded
- * newlines) that contains all the individual quantile values and sum/count for a single histogram
- * (metric_name plus all tags).
- */
-std::string generateSummaryOutput(const Stats::ParentHistogram& histogram,
-                                  const std::string& prefixed_tag_extracted_name) {
-  const std::string tags = PrometheusStatsFormatter::formattedTags(histogram.tags());
-  const std::string hist_tags = histogram.tags().empty() ? EMPTY_STRING : (tags + ",");
-
-  const Stats::HistogramStatistics& stats = histogram.intervalStatistics();
-  Stats::ConstSupportedBuckets& supported_quantiles = stats.supportedQuantiles();
-  const std::vector<double>& computed_quantiles = stats.computedQuantiles();
-  std::string output;
-  for (size_t i = 0; i < supported_quantiles.size(); ++i) {
-    double quantile = supported_quantiles[i];
-    double value = computed_quantiles[i];
-    output.append(fmt::format("{0}{{{1}quantile=\"{2}\"}} {3:.32g}\n", prefixed_tag_extracted_name,
-                              hist_tags, quantile, value));
-  }
-
-  output.append(fmt::format("{0}_sum{{{1}}} {2:.32g}\n", prefixed_tag_extracted_name, tags,
-                            stats.sampleSum()));
-  output.append(fmt::format("{0}_count{{{1}}} {2}\n", prefixed_tag_extracted_name, tags,
-                            stats.sampleCount()));
-
-  return output;
-};
-
 } // namespace
 
 std::string PrometheusStatsFormatter::formattedTags(const std::vector<Stats::Tag>& tags) {
@@ -365,38 +394,29 @@ uint64_t PrometheusStatsFormatter::statsAsPrometheus(
     const std::vector<Stats::TextReadoutSharedPtr>& text_readouts,
     const Upstream::ClusterManager& cluster_manager, Buffer::Instance& response,
     const StatsParams& params, const Stats::CustomStatNamespaces& custom_namespaces) {
+  // Names rendered for a single call have no later scrape to be reused by.
+  PrometheusNameCache name_cache(nullptr);
+  name_cache.beginScrape();
 
+  const uint64_t unlimited = std::numeric_limits<uint64_t>::max();
   uint64_t metric_name_count = 0;
-  metric_name_count += outputStatType<Stats::Counter>(response, params, counters,
-                                                      generateStatNumericOutput<Stats::Counter>,
-                                                      "counter", custom_namespaces);
-
-  metric_name_count += outputStatType<Stats::Gauge>(response, params, gauges,
-                                                    generateStatNumericOutput<Stats::Gauge>,
-                                                    "gauge", custom_namespaces);
-
-  // TextReadout stats are returned in gauge format, so "gauge" type is set intentionally.
-  metric_name_count += outputStatType<Stats::TextReadout>(
-      response, params, text_readouts, generateTextReadoutOutput, "gauge", custom_namespaces);
-
-  // validation of bucket modes is handled separately
-  switch (params.histogram_buckets_mode_) {
-  case Utility::HistogramBucketsMode::Summary:
-    metric_name_count += outputStatType<Stats::ParentHistogram>(
-        response, params, histograms, generateSummaryOutput, "summary", custom_namespaces);
-    break;
-  case Utility::HistogramBucketsMode::Unset:
-  case Utility::HistogramBucketsMode::Cumulative:
-    metric_name_count += outputStatType<Stats::ParentHistogram>(
-        response, params, histograms, generateHistogramOutput, "histogram", custom_namespaces);
-    break;
-  // "Detailed" and "Disjoint" don't make sense for prometheus histogram semantics
-  case Utility::HistogramBucketsMode::Detailed:
-  case Utility::HistogramBucketsMode::Disjoint:
-    IS_ENVOY_BUG("unsupported prometheus histogram bucket mode");
-    break;
-  }
+  renderNumericItems(sortedItems(counters, params, name_cache, custom_namespaces), 0, "counter",
+                     unlimited, metric_name_count, response);
+  renderNumericItems(sortedItems(gauges, params, name_cache, custom_namespaces), 0, "gauge",
+                     unlimited, metric_name_count, response);
+  renderTextReadoutItems(sortedItems(text_readouts, params, name_cache, custom_namespaces), 0,
+                         unlimited, metric_name_count, response);
+  renderHistogramItems(sortedItems(histograms, params, name_cache, custom_namespaces), 0,
+                       params.histogram_buckets_mode_, unlimited, metric_name_count, response);
+  name_cache.endScrape();
+
+  metric_name_count += renderHostMetrics(cluster_manager, response, params, custom_namespaces);
+  return metric_name_count;
+}
 
+uint64_t PrometheusStatsFormatter::renderHostMetrics(
+    const Upstream::ClusterManager& cluster_manager, Buffer::Instance& response,
+    const StatsParams& params, const Stats::CustomStatNamespaces& custom_namespaces) {
   // Note: This assumes that there is no overlap in stat name between per-endpoint stats and all
   // other stats. If this is not true, then the counters/gauges for per-endpoint need to be combined
   // with the above counter/gauge calls so that stats can be properly grouped.
@@ -409,6 +429,7 @@ uint64_t PrometheusStatsFormatter::statsAsPrometheus(
       },
       [&](Stats::PrimitiveGaugeSnapshot&& metric) { host_gauges.emplace_back(std::move(metric)); });
 
+  uint64_t metric_name_count = 0;
   metric_name_count +=
       outputPrimitiveStatType(response, params, host_counters, "counter", custom_namespaces);
 
@@ -418,5 +439,198 @@ uint64_t PrometheusStatsFormatter::statsAsPrometheus(
   return metric_name_count;
 }
 
+PrometheusNameCache::PrometheusNameCache(Stats::SymbolTable* symbol_table)
+    : symbol_table_(symbol_table) {}
+
+PrometheusNameCache::~PrometheusNameCache() { ASSERT(active_scrapes_ == 0); }
+
+void PrometheusNameCache::beginScrape() {
+  ++scrape_;
+  if (active_scrapes_++ == 0) {
+    oldest_active_scrape_ = scrape_;
+  }
+}
+
+void PrometheusNameCache::endScrape() {
+  ASSERT(active_scrapes_ > 0);
+  if (--active_scrapes_ > 0) {
+    return;
+  }
+  uncached_.clear();
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second->last_scrape_ < oldest_active_scrape_) {
+      entries_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+}
+
+const PrometheusNameCache::Entry&
+PrometheusNameCache::get(const Stats::Metric& metric,
+                         const Stats::CustomStatNamespaces& custom_namespaces) {
+  ASSERT(active_scrapes_ > 0);
+  if (symbol_table_ == nullptr || &metric.constSymbolTable() != symbol_table_) {
+    return uncached_.emplace_back(render(metric, custom_namespaces));
+  }
+  auto it = entries_.find(metric.statName());
+  if (it == entries_.end()) {
+    auto entry = std::make_unique<CachedEntry>(render(metric, custom_namespaces),
+                                               metric.statName(), *symbol_table_);
+    const Stats::StatName stat_name = entry->stat_name_.statName();
+    it = entries_.emplace(stat_name, std::move(entry)).first;
+  }
+  it->second->last_scrape_ = scrape_;
+  return *it->second;
+}
+
+PrometheusNameCache::Entry
+PrometheusNameCache::render(const Stats::Metric& metric,
+                            const Stats::CustomStatNamespaces& custom_namespaces) {
+  Entry entry;
+  absl::optional<std::string> metric_name =
+      PrometheusStatsFormatter::metricName(metric.tagExtractedName(), custom_namespaces);
+  if (metric_name.has_value()) {
+    entry.metric_name_ = std::move(metric_name.value());
+    entry.labels_ = PrometheusStatsFormatter::formattedTags(metric.tags());
+  }
+  return entry;
+}
+
+PrometheusStatsRequest::PrometheusStatsRequest(Stats::Store& stats, const StatsParams& params,
+                                               const Upstream::ClusterManager& cluster_manager,
+                                               const Stats::CustomStatNamespaces& custom_namespaces,
+                                               PrometheusNameCacheSharedPtr name_cache)
+    : stats_(stats), params_(params), cluster_manager_(cluster_manager),
+      custom_namespaces_(custom_namespaces), name_cache_(std::move(name_cache)) {}
+
+PrometheusStatsRequest::~PrometheusStatsRequest() {
+  if (started_) {
+    // Release the stats before the names they point to.
+    counters_.clear();
+    gauges_.clear();
+    text_readouts_.clear();
+    histograms_.clear();
+    name_cache_->endScrape();
+  }
+}
+
+Http::Code PrometheusStatsRequest::start(Http::ResponseHeaderMap&) {
+  name_cache_->beginScrape();
+  started_ = true;
+  startPhase();
+  return Http::Code::OK;
+}
+
+bool PrometheusStatsRequest::nextChunk(Buffer::Instance& response) {
+  // nextChunk's contract is to add up to chunk_size_ additional bytes. The
+  // caller is not required to drain the bytes after each call to nextChunk.
+  const uint64_t starting_length = response.length();
+  while (phase_ != Phase::Done) {
+    const uint64_t written = response.length() - starting_length;
+    if (written >= chunk_size_) {
+      return true;
+    }
+    if (!renderPhase(response, chunk_size_ - written)) {
+      continue;
+    }
+    switch (phase_) {
+    case Phase::Counters:
+      counters_ = {};
+      phase_ = Phase::Gauges;
+      break;
+    case Phase::Gauges:
+      gauges_ = {};
+      phase_ = params_.prometheus_text_readouts_ ? Phase::TextReadouts : Phase::Histograms;
+      break;
+    case Phase::TextReadouts:
+      text_readouts_ = {};
+      phase_ = Phase::Histograms;
+      break;
+    case Phase::Histograms:
+      histograms_ = {};
+      phase_ = Phase::HostMetrics;
+      break;
+    case Phase::HostMetrics:
+    case Phase::Done:
+      phase_ = Phase::Done;
+      break;
+    }
+    startPhase();
+  }
+  return false;
+}
+
+void PrometheusStatsRequest::startPhase() {
+  next_item_ = 0;
+  switch (phase_) {
+  case Phase::Counters:
+    stats_.forEachCounter(
+        [this](size_t size) { counters_.reserve(size); },
+        [this](Stats::Counter& counter) {
+          addItem(counters_, counter, params_, *name_cache_, custom_namespaces_);
+        });
+    sortItems(counters_);
+    break;
+  case Phase::Gauges:
+    stats_.forEachGauge(
+        [this](size_t size) { gauges_.reserve(size); },
+        [this](Stats::Gauge& gauge) {
+          addItem(gauges_, gauge, params_, *name_cache_, custom_namespaces_);
+        });
+    sortItems(gauges_);
+    break;
+  case Phase::TextReadouts:
+    stats_.forEachTextReadout(
+        [this](size_t size) { text_readouts_.reserve(size); },
+        [this](Stats::TextReadout& text_readout) {
+          addItem(text_readouts_, text_readout, params_, *name_cache_, custom_namespaces_);
+        });
+    sortItems(text_readouts_);
+    break;
+  case Phase::Histograms:
+    stats_.forEachHistogram(
+        [this](size_t size) { histograms_.reserve(size); },
+        [this](Stats::ParentHistogram& histogram) {
+          addItem(histograms_, histogram, params_, *name_cache_, custom_namespaces_);
+        });
+    sortItems(histograms_);
+    break;
+  case Phase::HostMetrics:
+  case Phase::Done:
+    break;
+  }
+}
+
+bool PrometheusStatsRequest::renderPhase(Buffer::Instance& response, uint64_t limit) {
+  switch (phase_) {
+  case Phase::Counters:
+    next_item_ =
+        renderNumericItems(counters_, next_item_, "counter", limit, metric_families_, response);
+    return next_item_ == counters_.size();
+  case Phase::Gauges:
+    next_item_ =
+        renderNumericItems(gauges_, next_item_, "gauge", limit, metric_families_, response);
+    return next_item_ == gauges_.size();
+  case Phase::TextReadouts:
+    next_item_ =
+        renderTextReadoutItems(text_readouts_, next_item_, limit, metric_families_, response);
+    return next_item_ == text_readouts_.size();
+  case Phase::Histograms:
+    next_item_ = renderHistogramItems(histograms_, next_item_, params_.histogram_buckets_mode_,
+                                      limit, metric_families_, response);
+    return next_item_ == histograms_.size();
+  case Phase::HostMetrics:
+    // There is no reference to hold on to host metrics, so they are rendered in one batch, as in
+    // StatsRequest::renderPerHostMetrics().
+    metric_families_ += PrometheusStatsFormatter::renderHostMetrics(cluster_manager_, response,
+                                                                    params_, custom_namespaces_);
+    return true;
+  case Phase::Done:
+    break;
+  }
+  return true;
+}
+
 } // namespace Server
 } // namespace Envoy
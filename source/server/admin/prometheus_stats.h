@@ -1,13 +1,19 @@
 #pragma once
 
+#include <deque>
+#include <memory>
 #include <regex>
 #include <string>
+#include <vector>
 
 #include "envoy/buffer/buffer.h"
+#include "envoy/server/admin.h"
 #include "envoy/stats/custom_stat_namespaces.h"
 #include "envoy/stats/histogram.h"
 #include "envoy/stats/stats.h"
+#include "envoy/stats/store.h"
 
+#include "source/common/stats/symbol_table.h"
 #include "source/server/admin/stats_params.h"
 
 namespace Envoy {
@@ -31,6 +37,14 @@ public:
                                     const Upstream::ClusterManager& cluster_manager,
                                     Buffer::Instance& response, const StatsParams& params,
                                     const Stats::CustomStatNamespaces& custom_namespaces);
+  /**
+   * Appends the per-endpoint metrics of the clusters that enable them to the response.
+   * @return uint64_t total number of metric types inserted in response.
+   */
+  static uint64_t renderHostMetrics(const Upstream::ClusterManager& cluster_manager,
+                                    Buffer::Instance& response, const StatsParams& params,
+                                    const Stats::CustomStatNamespaces& custom_namespaces);
+
   /**
    * Format the given tags, returning a string as a comma-separated list
    * of <tag_name>="<tag_value>" pairs.
@@ -53,5 +67,134 @@ public:
              const Stats::CustomStatNamespaces& custom_namespace_factory);
 };
 
+/**
+ * Caches the Prometheus rendering of stat names across scrapes. Turning a stat's tag-extracted
+ * name and tags into a sanitized metric name and label string is most of the cost of a scrape,
+ * and only depends on the stat's name, so it is done once per stat rather than once per scrape.
+ *
+ * Entries are keyed by StatName, so only stats from the cache's symbol table are cached; others
+ * are rendered for the duration of the scrape. Entries that no scrape has used since the oldest
+ * scrape in progress began are dropped when the last scrape in progress ends. The cache is only
+ * used from the main thread.
+ */
+class PrometheusNameCache {
+public:
+  struct Entry {
+    // The metric family name, or empty if the stat has no valid Prometheus name.
+    std::string metric_name_;
+    // The formatted tags, without the enclosing braces.
+    std::string labels_;
+  };
+
+  /**
+   * @param symbol_table supplies the symbol table of the stats to cache, or nullptr to render
+   *        every stat for the current scrape only.
+   */
+  explicit PrometheusNameCache(Stats::SymbolTable* symbol_table);
+  ~PrometheusNameCache();
+
+  /**
+   * Marks the start of a scrape. Entries returned by get() stay valid until the matching
+   * endScrape().
+   */
+  void beginScrape();
+
+  /**
+   * Marks the end of a scrape, dropping stale entries if no other scrape is in progress.
+   */
+  void endScrape();
+
+  /**
+   * @return the rendering of a stat's name, which must be looked up within a scrape.
+   */
+  const Entry& get(const Stats::Metric& metric,
+                   const Stats::CustomStatNamespaces& custom_namespaces);
+
+  /**
+   * @return the number of cached entries.
+   */
+  uint64_t size() const { return entries_.size(); }
+
+private:
+  struct CachedEntry : public Entry {
+    CachedEntry(Entry&& entry, Stats::StatName stat_name, Stats::SymbolTable& symbol_table)
+        : Entry(std::move(entry)), stat_name_(stat_name, symbol_table) {}
+
+    Stats::StatNameManagedStorage stat_name_;
+    // The last scrape that used the entry.
+    uint64_t last_scrape_{};
+  };
+
+  static Entry render(const Stats::Metric& metric,
+                      const Stats::CustomStatNamespaces& custom_namespaces);
+
+  Stats::SymbolTable* const symbol_table_;
+  // The keys point into the entries' own storage.
+  Stats::StatNameHashMap<std::unique_ptr<CachedEntry>> entries_;
+  // Renderings of stats from other symbol tables, dropped when no scrape is in progress.
+  std::deque<Entry> uncached_;
+  uint64_t scrape_{};
+  uint64_t oldest_active_scrape_{};
+  uint32_t active_scrapes_{};
+};
+
+using PrometheusNameCacheSharedPtr = std::shared_ptr<PrometheusNameCache>;
+
+/**
+ * Streams stats in the Prometheus text exposition format through the chunked admin request
+ * interface. Each stat type is collected from the store when the request gets to it, holding
+ * references so that removed stats can still be rendered, sorted by metric family and labels,
+ * and then written out a chunk at a time.
+ */
+class PrometheusStatsRequest : public Admin::Request {
+public:
+  // A stat with the rendering of its name.
+  template <class StatType>
+  using StatItems =
+      std::vector<std::pair<const PrometheusNameCache::Entry*, Stats::RefcountPtr<StatType>>>;
+
+  static constexpr uint64_t DefaultChunkSize = 2 * 1000 * 1000;
+
+  PrometheusStatsRequest(Stats::Store& stats, const StatsParams& params,
+                         const Upstream::ClusterManager& cluster_manager,
+                         const Stats::CustomStatNamespaces& custom_namespaces,
+                         PrometheusNameCacheSharedPtr name_cache);
+  ~PrometheusStatsRequest() override;
+
+  // Admin::Request
+  Http::Code start(Http::ResponseHeaderMap& response_headers) override;
+  bool nextChunk(Buffer::Instance& response) override;
+
+  // Sets the chunk size.
+  void setChunkSize(uint64_t chunk_size) { chunk_size_ = chunk_size; }
+
+  // Returns the number of metric families written so far.
+  uint64_t metricFamilies() const { return metric_families_; }
+
+private:
+  enum class Phase { Counters, Gauges, TextReadouts, Histograms, HostMetrics, Done };
+
+  // Collects and sorts the stats of the current phase.
+  void startPhase();
+  // Renders the current phase up to limit bytes, returning true once the phase is complete.
+  bool renderPhase(Buffer::Instance& response, uint64_t limit);
+
+  Stats::Store& stats_;
+  StatsParams params_;
+  const Upstream::ClusterManager& cluster_manager_;
+  const Stats::CustomStatNamespaces& custom_namespaces_;
+  PrometheusNameCacheSharedPtr name_cache_;
+  bool started_{false};
+  Phase phase_{Phase::Counters};
+  StatItems<Stats::Counter> counters_;
+  StatItems<Stats::Gauge> gauges_;
+  StatItems<Stats::TextReadout> text_readouts_;
+  StatItems<Stats::ParentHistogram> histograms_;
+  // The next item to render in the current phase.
+  size_t next_item_{0};
+  uint64_t metric_families_{0};
+  uint64_t chunk_size_{DefaultChunkSize};
+};
+
 } // namespace Server
 } // namespace Envoy
@@ -10,6 +10,7 @@
 #include "envoy/server/instance.h"
 
 #include "source/server/admin/handler_ctx.h"
+#include "source/server/admin/prometheus_stats.h"
 #include "source/server/admin/stats_request.h"
 #include "source/server/admin/utils.h"
 
@@ -33,42 +34,25 @@ public:
                                               Buffer::Instance& response, AdminStream&);
   Http::Code handlerStatsRecentLookupsEnable(Http::ResponseHeaderMap& response_headers,
                                              Buffer::Instance& response, AdminStream&);
-  Http::Code handlerPrometheusStats(Http::ResponseHeaderMap& response_headers,
-                                    Buffer::Instance& response, AdminStream&);
 
   /**
-   * Parses and executes a prometheus stats request.
-   *
-   * @param path_and_query the URL path and query
-   * @param response buffer into which to write response
-   * @return http response code
-   */
-  Http::Code prometheusStats(absl::string_view path_and_query, Buffer::Instance& response);
-
-  /**
-   * Checks the server_ to see if a flush is needed, and then renders the
-   * prometheus stats request.
-   *
-   * @params params the already-parsed parameters.
-   * @param response buffer into which to write response
-   */
-  Http::Code prometheusFlushAndRender(const StatsParams& params, Buffer::Instance& response);
-
-  /**
-   * Renders the stats as prometheus. This is broken out as a separately
+   * Creates a request streaming the stats as prometheus. This is broken out as a separately
    * callable API to facilitate the benchmark
    * (test/server/admin/stats_handler_speed_test.cc) which does not have a
    * server object.
    *
    * @params stats the stats store to read
+   * @params params the already-parsed and validated parameters.
    * @param custom_namespaces namespace mappings used for prometheus
-   * @params params the already-parsed parameters.
-   * @param response buffer into which to write response
+   * @param name_cache the metric names rendered by previous requests
+   * @return a request streaming the stats.
    */
-  static void prometheusRender(Stats::Store& stats,
-                               const Stats::CustomStatNamespaces& custom_namespaces,
-                               const Upstream::ClusterManager& cluster_manager,
-                               const StatsParams& params, Buffer::Instance& response);
+  static Admin::RequestPtr
+  makePrometheusRequest(Stats::Store& stats, const StatsParams& params,
+                        const Upstream::ClusterManager& cluster_manager,
+                        const Stats::CustomStatNamespaces& custom_namespaces,
+                        PrometheusNameCacheSharedPtr name_cache);
+  Admin::RequestPtr makePrometheusRequest(AdminStream& admin_stream);
 
   Http::Code handlerContention(Http::ResponseHeaderMap& response_headers,
                                Buffer::Instance& response, AdminStream&);
@@ -87,15 +71,23 @@ public:
    */
   Admin::UrlHandler statsHandler(bool active_mode);
 
+  /**
+   * @return a URL handler for /stats/prometheus.
+   */
+  Admin::UrlHandler prometheusStatsHandler();
+
   static Admin::RequestPtr makeRequest(Stats::Store& stats, const StatsParams& params,
                                        const Upstream::ClusterManager& cm,
                                        StatsRequest::UrlHandlerFn url_handler_fn = nullptr);
   Admin::RequestPtr makeRequest(AdminStream&);
 
 private:
-  static Http::Code prometheusStats(absl::string_view path_and_query, Buffer::Instance& response,
-                                    Stats::Store& stats,
-                                    Stats::CustomStatNamespaces& custom_namespaces);
+  // Flushes the stats if configured to and starts streaming them as prometheus.
+  Admin::RequestPtr prometheusRequest(const StatsParams& params);
+
+  // Shared by the prometheus requests so that metric names are only rendered on the first
+  // scrape that sees them. Created on first use.
+  PrometheusNameCacheSharedPtr prometheus_name_cache_;
 };
 
 } // namespace Server
@@ -163,26 +163,31 @@ void InstanceBase::failHealthcheck(bool fail) {
 
 MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store,
                                        Upstream::ClusterManager& cluster_manager,
-                                       TimeSource& time_source) {
-  store.forEachSinkedCounter(
-      [this](std::size_t size) {
-        snapped_counters_.reserve(size);
-        counters_.reserve(size);
-      },
-      [this](Stats::Counter& counter) {
-        snapped_counters_.push_back(Stats::CounterSharedPtr(&counter));
-        counters_.push_back({counter.latch(), counter});
-      });
-
-  store.forEachSinkedGauge(
-      [this](std::size_t size) {
-        snapped_gauges_.reserve(size);
-        gauges_.reserve(size);
-      },
-      [this](Stats::Gauge& gauge) {
-        snapped_gauges_.push_back(Stats::GaugeSharedPtr(&gauge));
-        gauges_.push_back(gauge);
-      });
+                                       TimeSource& time_source, bool changed_only) {
+  auto counter_size = [this](std::size_t size) {
+    snapped_counters_.reserve(size);
+    counters_.reserve(size);
+  };
+  auto counter_stat = [this](Stats::Counter& counter) {
+    snapped_counters_.push_back(Stats::CounterSharedPtr(&counter));
+    counters_.push_back({counter.latch(), counter});
+  };
+  auto gauge_size = [this](std::size_t size) {
+    snapped_gauges_.reserve(size);
+    gauges_.reserve(size);
+  };
+  auto gauge_stat = [this](Stats::Gauge& gauge) {
+    snapped_gauges_.push_back(Stats::GaugeSharedPtr(&gauge));
+    gauges_.push_back(gauge);
+  };
+  if (changed_only) {
+    // Counters that did not change have nothing to latch.
+    store.forEachChangedSinkedCounter(counter_size, counter_stat);
+    store.forEachChangedSinkedGauge(gauge_size, gauge_stat);
+  } else {
+    store.forEachSinkedCounter(counter_size, counter_stat);
+    store.forEachSinkedGauge(gauge_size, gauge_stat);
+  }
 
   store.forEachSinkedHistogram(
       [this](std::size_t size) {
@@ -217,12 +222,13 @@ MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store,
 }
 
 void InstanceUtil::flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, Stats::Store& store,
-                                       Upstream::ClusterManager& cm, TimeSource& time_source) {
+                                       Upstream::ClusterManager& cm, TimeSource& time_source,
+                                       bool changed_only) {
   // Create a snapshot and flush to all sinks.
   // NOTE: Even if there are no sinks, creating the snapshot has the important property that it
   //       latches all counters on a periodic basis. The hot restart code assumes this is being
   //       done so this should not be removed.
-  MetricSnapshotImpl snapshot(store, cm, time_source);
+  MetricSnapshotImpl snapshot(store, cm, time_source, changed_only);
   for (const auto& sink : sinks) {
     sink->flush(snapshot);
   }
@@ -260,6 +266,16 @@ void InstanceBase::updateServerStats() {
                                        parent_stats.parent_memory_allocated_);
   server_stats_->memory_heap_size_.set(Memory::Stats::totalCurrentlyReserved());
   server_stats_->memory_physical_size_.set(Memory::Stats::totalPhysicalBytes());
+  const Buffer::SliceStorageCache::Counters buffer_slice_cache =
+      Buffer::SliceStorageCache::counters();
+  server_stats_->buffer_slice_cache_hits_.add(buffer_slice_cache.hits_ -
+                                              buffer_slice_cache_counters_.hits_);
+  server_stats_->buffer_slice_cache_misses_.add(buffer_slice_cache.misses_ -
+                                                buffer_slice_cache_counters_.misses_);
+  server_stats_->buffer_slice_cache_overflows_.add(buffer_slice_cache.overflows_ -
+                                                   buffer_slice_cache_counters_.overflows_);
+  server_stats_->buffer_slice_cache_bytes_.set(buffer_slice_cache.cached_bytes_);
+  buffer_slice_cache_counters_ = buffer_slice_cache;
   if (!options().hotRestartDisabled()) {
     server_stats_->parent_connections_.set(parent_stats.parent_connections_);
   }
@@ -284,7 +300,7 @@ void InstanceBase::flushStatsInternal() {
   updateServerStats();
   auto& stats_config = config_.statsConfig();
   InstanceUtil::flushMetricsToSinks(stats_config.sinks(), stats_store_, clusterManager(),
-                                    timeSource());
+                                    timeSource(), stats_config.flushChangedOnly());
   // TODO(ramaraochavali): consider adding different flush interval for histograms.
   if (stat_flush_timer_ != nullptr) {
     stat_flush_timer_->enableTimer(stats_config.flushInterval());
@@ -532,6 +548,10 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
 
   memory_allocator_manager_ = std::make_unique<Memory::AllocatorManager>(
       *api_, *stats_store_.rootScope(), bootstrap_.memory_allocator_manager());
+  Buffer::SliceStorageCache::setMaxBytesPerThread(
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(bootstrap_.memory_allocator_manager(),
+                                      buffer_slice_cache_bytes_per_thread,
+                                      Buffer::SliceStorageCache::DefaultMaxBytesPerThread));
 
   initialization_timer_ = std::make_unique<Stats::HistogramCompletableTimespanImpl>(
       server_stats_->initialization_time_ms_, timeSource());
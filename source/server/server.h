@@ -25,6 +25,7 @@
 #include "envoy/tracing/tracer.h"
 
 #include "source/common/access_log/access_log_manager_impl.h"
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/cleanup.h"
 #include "source/common/common/logger_delegates.h"
@@ -76,6 +77,10 @@ struct ServerCompilationSettingsStats {
   COUNTER(static_unknown_fields)                                                                   \
   COUNTER(wip_protos)                                                                              \
   COUNTER(dropped_stat_flushes)                                                                    \
+  COUNTER(buffer_slice_cache_hits)                                                                 \
+  COUNTER(buffer_slice_cache_misses)                                                               \
+  COUNTER(buffer_slice_cache_overflows)                                                            \
+  GAUGE(buffer_slice_cache_bytes, NeverImport)                                                     \
   GAUGE(concurrency, NeverImport)                                                                  \
   GAUGE(days_until_first_cert_expiring, NeverImport)                                               \
   GAUGE(seconds_until_first_ocsp_response_expiring, NeverImport)                                   \
@@ -131,9 +136,12 @@ public:
    * flush() on each sink.
    * @param sinks supplies the list of sinks.
    * @param store provides the store being flushed.
+   * @param changed_only supplies whether to only flush the counters and gauges that changed since
+   *        the previous flush.
    */
   static void flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, Stats::Store& store,
-                                  Upstream::ClusterManager& cm, TimeSource& time_source);
+                                  Upstream::ClusterManager& cm, TimeSource& time_source,
+                                  bool changed_only = false);
 
   /**
    * Load a bootstrap config and perform validation.
@@ -381,6 +389,8 @@ private:
   time_t original_start_time_;
   Stats::StoreRoot& stats_store_;
   std::unique_ptr<ServerStats> server_stats_;
+  // The slice storage cache counters as of the last update of the server stats.
+  Buffer::SliceStorageCache::Counters buffer_slice_cache_counters_;
   std::unique_ptr<CompilationSettings::ServerCompilationSettingsStats>
       server_compilation_settings_stats_;
   Assert::ActionRegistrationPtr assert_action_registration_;
@@ -459,7 +469,7 @@ private:
 class MetricSnapshotImpl : public Stats::MetricSnapshot {
 public:
   explicit MetricSnapshotImpl(Stats::Store& store, Upstream::ClusterManager& cluster_manager,
-                              TimeSource& time_source);
+                              TimeSource& time_source, bool changed_only = false);
 
   // Stats::MetricSnapshot
   const std::vector<CounterSnapshot>& counters() override { return counters_; }
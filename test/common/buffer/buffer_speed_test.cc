@@ -4,6 +4,7 @@
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/buffer/watermark_buffer.h"
 #include "source/common/common/assert.h"
+#include "source/common/runtime/runtime_features.h"
 
 #include "absl/strings/string_view.h"
 #include "benchmark/benchmark.h"
@@ -320,6 +321,42 @@ BENCHMARK(bufferReserveCommit)
     ->Arg(64 * 1024)
     ->Arg(128 * 1024);
 
+// Test a proxy-style loop: read into a connection's read buffer, move the data to the upstream
+// connection's write buffer, and drain it as if it had been written. The first Arg is the read
+// size and the second Arg selects whether the slice storage cache is enabled.
+static void bufferProxyReadMoveWrite(benchmark::State& state) {
+  const uint64_t read_size = state.range(0);
+  Runtime::maybeSetRuntimeGuard("envoy.reloadable_features.buffer_slice_storage_cache",
+                                state.range(1) != 0);
+  Buffer::SliceStorageCache::clearThreadCacheForTest();
+
+  Buffer::OwnedImpl read_buffer;
+  Buffer::WatermarkBuffer write_buffer([]() {}, []() {}, []() {});
+  write_buffer.setWatermarks(MaxBufferLength);
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    Buffer::Reservation reservation = read_buffer.reserveForRead();
+    reservation.commit(std::min<uint64_t>(read_size, reservation.length()));
+    write_buffer.move(read_buffer);
+    write_buffer.drain(write_buffer.length());
+  }
+  benchmark::DoNotOptimize(write_buffer.length());
+
+  const Buffer::SliceStorageCache::Counters stats =
+      Buffer::SliceStorageCache::threadCountersForTest();
+  state.counters["cache_hits"] = stats.hits_;
+  state.counters["cache_misses"] = stats.misses_;
+  Runtime::maybeSetRuntimeGuard("envoy.reloadable_features.buffer_slice_storage_cache", false);
+  Buffer::SliceStorageCache::clearThreadCacheForTest();
+}
+BENCHMARK(bufferProxyReadMoveWrite)
+    ->Args({1024, 0})
+    ->Args({1024, 1})
+    ->Args({16 * 1024, 0})
+    ->Args({16 * 1024, 1})
+    ->Args({64 * 1024, 0})
+    ->Args({64 * 1024, 1});
+
 // Test the reserve+commit cycle, for the common case where the reserved space is
 // only partially used (and therefore the commit size is smaller than the reservation size).
 static void bufferReserveCommitPartial(benchmark::State& state) {
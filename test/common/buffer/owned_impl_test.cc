@@ -10,6 +10,7 @@
 #include "test/common/buffer/utility.h"
 #include "test/mocks/api/mocks.h"
 #include "test/test_common/logging.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/threadsafe_singleton_injector.h"
 #include "test/test_common/utility.h"
 
@@ -243,6 +244,107 @@ TEST_F(OwnedImplTest, Add) {
   EXPECT_EQ(string1 + string2 + big_suffix, buffer.toString());
 }
 
+// Slice storage of a size class is reused by the next buffer on the same thread.
+TEST_F(OwnedImplTest, SliceStorageCacheReuse) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.buffer_slice_storage_cache", "true"}});
+  SliceStorageCache::clearThreadCacheForTest();
+  const uint8_t* storage;
+  {
+    Buffer::OwnedImpl buffer;
+    buffer.add(std::string(100, 'a'));
+    storage = static_cast<const uint8_t*>(buffer.frontSlice().mem_);
+    expectSlices({{100, 3996, 4096}}, buffer);
+  }
+  EXPECT_EQ(4096, SliceStorageCache::threadCountersForTest().cached_bytes_);
+
+  {
+    // Moving the slice to another buffer and draining it there returns it too.
+    Buffer::OwnedImpl buffer;
+    buffer.add(std::string(100, 'b'));
+    EXPECT_EQ(storage, buffer.frontSlice().mem_);
+    Buffer::OwnedImpl other;
+    other.move(buffer);
+    other.drain(other.length());
+  }
+
+  // Reservations return their uncommitted slices.
+  {
+    Buffer::OwnedImpl buffer;
+    auto reservation = buffer.reserveForRead();
+    reservation.commit(1);
+  }
+
+  // Sizes which are not a size class bypass the cache.
+  {
+    Buffer::OwnedImpl buffer;
+    buffer.add(std::string(5000, 'c'));
+    expectSlices({{5000, 3192, 8192}}, buffer);
+  }
+
+  const SliceStorageCache::Counters stats = SliceStorageCache::threadCountersForTest();
+  EXPECT_EQ(1, stats.hits_);
+  EXPECT_EQ(1 + Reservation::MAX_SLICES_, stats.misses_);
+  EXPECT_EQ(0, stats.overflows_);
+  EXPECT_EQ(4096 + Reservation::MAX_SLICES_ * Slice::default_slice_size_, stats.cached_bytes_);
+  SliceStorageCache::clearThreadCacheForTest();
+}
+
+TEST_F(OwnedImplTest, SliceStorageCacheCap) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.buffer_slice_storage_cache", "true"}});
+  SliceStorageCache::clearThreadCacheForTest();
+  SliceStorageCache::setMaxBytesPerThread(64 * 1024);
+  const SliceStorageCache::Counters before = SliceStorageCache::counters();
+  {
+    Buffer::OwnedImpl buffer;
+    for (uint64_t i = 0; i < 17; i++) {
+      buffer.appendSliceForTest(std::string(10, 'a'));
+    }
+  }
+  const SliceStorageCache::Counters stats = SliceStorageCache::threadCountersForTest();
+  EXPECT_EQ(64 * 1024, stats.cached_bytes_);
+  EXPECT_EQ(1, stats.overflows_);
+
+  // The process wide counters include this thread's.
+  const SliceStorageCache::Counters after = SliceStorageCache::counters();
+  EXPECT_EQ(17, after.misses_ - before.misses_);
+  EXPECT_EQ(1, after.overflows_ - before.overflows_);
+
+  SliceStorageCache::setMaxBytesPerThread(SliceStorageCache::DefaultMaxBytesPerThread);
+  SliceStorageCache::clearThreadCacheForTest();
+}
+
+// Turning the guard off frees the storage cached by the thread on its next allocation.
+TEST_F(OwnedImplTest, SliceStorageCacheTurnedOff) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.buffer_slice_storage_cache", "true"}});
+  SliceStorageCache::clearThreadCacheForTest();
+  { Buffer::OwnedImpl buffer(std::string(10, 'a')); }
+  EXPECT_EQ(4096, SliceStorageCache::threadCountersForTest().cached_bytes_);
+
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.buffer_slice_storage_cache", "false"}});
+  { Buffer::OwnedImpl buffer(std::string(10, 'b')); }
+  const SliceStorageCache::Counters stats = SliceStorageCache::threadCountersForTest();
+  EXPECT_EQ(0, stats.hits_);
+  EXPECT_EQ(1, stats.misses_);
+  EXPECT_EQ(0, stats.cached_bytes_);
+  SliceStorageCache::clearThreadCacheForTest();
+}
+
+// The cache is not used unless the runtime guard is enabled.
+TEST_F(OwnedImplTest, SliceStorageCacheDisabled) {
+  SliceStorageCache::clearThreadCacheForTest();
+  {
+    Buffer::OwnedImpl buffer(std::string(10, 'a'));
+    Buffer::OwnedImpl other(std::string(10, 'b'));
+  }
+  const SliceStorageCache::Counters stats = SliceStorageCache::threadCountersForTest();
+  EXPECT_EQ(0, stats.hits_);
+  EXPECT_EQ(0, stats.misses_);
+  EXPECT_EQ(0, stats.cached_bytes_);
+}
+
 TEST_F(OwnedImplTest, Prepend) {
   const std::string suffix = "World!", prefix = "Hello, ";
   Buffer::OwnedImpl buffer;
@@ -0,0 +1,86 @@
+#include <cstdint>
+#include <string>
+
+#include "source/common/common/arena.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace {
+
+TEST(ArenaTest, BumpAllocation) {
+  Arena arena(1024);
+  EXPECT_EQ(0, arena.numBlocks());
+
+  void* first = arena.allocate(8, 8);
+  void* second = arena.allocate(8, 8);
+  EXPECT_EQ(1, arena.numBlocks());
+  EXPECT_EQ(static_cast<uint8_t*>(first) + 8, second);
+  EXPECT_EQ(16, arena.bytesAllocated());
+
+  // Alignment padding is honored within a block.
+  arena.allocate(1, 1);
+  void* aligned = arena.allocate(8, 8);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(aligned) % 8);
+  EXPECT_EQ(1, arena.numBlocks());
+
+  // Exhausting the block moves to a fresh one.
+  for (int i = 0; i < 10; ++i) {
+    arena.allocate(200, 8);
+  }
+  EXPECT_EQ(3, arena.numBlocks());
+}
+
+TEST(ArenaTest, LargeAllocationsGetDedicatedBlocks) {
+  Arena arena(1024);
+  void* small = arena.allocate(16);
+  void* large = arena.allocate(4096);
+  EXPECT_EQ(2, arena.numBlocks());
+  // The tail of the first block is still used.
+  void* small2 = arena.allocate(16);
+  EXPECT_EQ(static_cast<uint8_t*>(small) + 16, small2);
+  EXPECT_NE(nullptr, large);
+  EXPECT_EQ(2, arena.numBlocks());
+}
+
+TEST(ArenaTest, CopyString) {
+  Arena arena;
+  std::string source = "hello world";
+  absl::string_view copy = arena.copyString(source);
+  source = "overwritten";
+  EXPECT_EQ("hello world", copy);
+  EXPECT_TRUE(arena.copyString("").empty());
+}
+
+struct Tracked {
+  Tracked(int& destroyed) : destroyed_(destroyed) {}
+  virtual ~Tracked() { ++destroyed_; }
+  int& destroyed_;
+};
+
+struct DerivedTracked : public Tracked {
+  using Tracked::Tracked;
+  uint64_t payload_[4]{};
+};
+
+TEST(ArenaTest, ArenaPtrRunsDestructors) {
+  int destroyed = 0;
+  {
+    Arena arena;
+    {
+      ArenaPtr<Tracked> in_arena = makeArenaPtr<DerivedTracked>(arena, destroyed);
+      EXPECT_TRUE(in_arena.get_deleter().inArena());
+      EXPECT_EQ(1, arena.numBlocks());
+    }
+    EXPECT_EQ(1, destroyed);
+  }
+
+  {
+    ArenaPtr<Tracked> on_heap = makeArenaPtr<DerivedTracked>(absl::nullopt, destroyed);
+    EXPECT_FALSE(on_heap.get_deleter().inArena());
+  }
+  EXPECT_EQ(2, destroyed);
+}
+
+} // namespace
+} // namespace Envoy
@@ -0,0 +1,58 @@
+#include <atomic>
+#include <vector>
+
+#include "source/common/common/helper_thread_pool.h"
+
+#include "test/mocks/thread/mocks.h"
+#include "test/test_common/thread_factory_for_test.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Thread {
+namespace {
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+
+// Validate that every task runs exactly once, and that the helper threads are only started once.
+TEST(HelperThreadPoolTest, RunsEveryTask) {
+  NiceMock<MockThreadFactory> thread_factory;
+  EXPECT_CALL(thread_factory, createThread(_, _))
+      .Times(3)
+      .WillRepeatedly(Invoke([](std::function<void()> thread_routine, OptionsOptConstRef options) {
+        return threadFactoryForTest().createThread(thread_routine, options);
+      }));
+  HelperThreadPool pool(thread_factory, 3, "test_pool");
+  EXPECT_EQ(4, pool.concurrency());
+
+  for (uint32_t tasks : {1, 4, 100}) {
+    std::vector<std::atomic<uint32_t>> runs(tasks);
+    pool.run(tasks, [&runs](uint32_t i) { ++runs[i]; });
+    for (const std::atomic<uint32_t>& run : runs) {
+      EXPECT_EQ(1, run.load());
+    }
+  }
+}
+
+// Validate that tasks run on the calling thread if no helper thread can be created.
+TEST(HelperThreadPoolTest, RunsInlineWithoutThreads) {
+  NiceMock<MockThreadFactory> thread_factory;
+  EXPECT_CALL(thread_factory, createThread(_, _)).Times(2).WillRepeatedly(Return(nullptr));
+  HelperThreadPool pool(thread_factory, 2, "test_pool");
+
+  const ThreadId caller = threadFactoryForTest().currentThreadId();
+  uint32_t runs = 0;
+  pool.run(10, [&](uint32_t) {
+    EXPECT_EQ(caller, threadFactoryForTest().currentThreadId());
+    ++runs;
+  });
+  EXPECT_EQ(10, runs);
+}
+
+} // namespace
+} // namespace Thread
+} // namespace Envoy
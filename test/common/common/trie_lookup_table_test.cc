@@ -65,6 +65,42 @@ TEST(TrieLookupTable, LongestPrefix) {
   EXPECT_EQ(nullptr, trie.findLongestPrefix(" "));
 }
 
+TEST(TrieLookupTable, ForEachPrefix) {
+  TrieLookupTable<const char*> trie;
+  const char* cstr_a = "a";
+  const char* cstr_b = "b";
+  const char* cstr_c = "c";
+  const char* cstr_d = "d";
+
+  EXPECT_TRUE(trie.add("", cstr_a));
+  EXPECT_TRUE(trie.add("foo", cstr_b));
+  EXPECT_TRUE(trie.add("foo/bar", cstr_c));
+  EXPECT_TRUE(trie.add("fox", cstr_d));
+
+  std::vector<std::pair<size_t, const char*>> matches;
+  auto collect = [&matches](size_t length, const char* value) {
+    matches.emplace_back(length, value);
+  };
+
+  trie.forEachPrefix("foo/bar/baz", collect);
+  EXPECT_EQ((std::vector<std::pair<size_t, const char*>>{{0, cstr_a}, {3, cstr_b}, {7, cstr_c}}),
+            matches);
+
+  matches.clear();
+  trie.forEachPrefix("fo", collect);
+  EXPECT_EQ((std::vector<std::pair<size_t, const char*>>{{0, cstr_a}}), matches);
+
+  matches.clear();
+  trie.forEachPrefix("fox", collect);
+  EXPECT_EQ((std::vector<std::pair<size_t, const char*>>{{0, cstr_a}, {3, cstr_d}}), matches);
+
+  TrieLookupTable<const char*> no_root;
+  EXPECT_TRUE(no_root.add("foo", cstr_b));
+  matches.clear();
+  no_root.forEachPrefix("bar", collect);
+  EXPECT_TRUE(matches.empty());
+}
+
 TEST(TrieLookupTable, VeryDeepTrieDoesNotStackOverflowOnDestructor) {
   TrieLookupTable<const char*> trie;
   const char* cstr_a = "a";
@@ -0,0 +1,42 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+
+#include "source/common/http/character_set_validation.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Http {
+
+// Validates a header name of the given length, e.g. a large cookie-like value made of token
+// characters, with each of the table search implementations. The first Arg is the length and the
+// second Arg selects the CharTableSearchImpl.
+static void bmFindFirstNotInCharTable(benchmark::State& state) {
+  const auto impl = static_cast<CharTableSearchImpl>(state.range(1));
+  if (!charTableSearchImplSupported(impl)) {
+    state.SkipWithError("not supported by this CPU");
+    return;
+  }
+  const std::string value(state.range(0), 'a');
+  size_t result = 0;
+  for (auto _ : state) { // NOLINT
+    result += findFirstCharForTest(impl, kGenericHeaderNameVectorizedCharTable, value, false);
+  }
+  benchmark::DoNotOptimize(result);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(bmFindFirstNotInCharTable)
+    ->Args({16, 0})
+    ->Args({16, 1})
+    ->Args({16, 2})
+    ->Args({256, 0})
+    ->Args({256, 1})
+    ->Args({256, 2})
+    ->Args({4096, 0})
+    ->Args({4096, 1})
+    ->Args({4096, 2});
+
+} // namespace Http
+} // namespace Envoy
@@ -1,3 +1,5 @@
+#include <string>
+
 #include "source/common/http/character_set_validation.h"
 
 #include "gtest/gtest.h"
@@ -33,5 +35,75 @@ TEST(CharacterSetValidationTest, Test) {
   }
 }
 
+TEST(CharacterSetValidationTest, VectorizedCharTable) {
+  for (unsigned c = 0; c < 256; ++c) {
+    const uint8_t low = c & 0x0f;
+    const uint8_t high = c >> 4;
+    const uint8_t row = c < 0x80 ? kGenericHeaderNameVectorizedCharTable.ascii()[low]
+                                 : kGenericHeaderNameVectorizedCharTable.extended()[low];
+    EXPECT_EQ(testCharInTable(kGenericHeaderNameCharTable, static_cast<char>(c)),
+              (row & (1 << (high & 0x07))) != 0);
+  }
+}
+
+// Checks every search implementation supported by the CPU against a plain scalar loop, for
+// every character at every position of strings covering the vector widths and their tails.
+class FindFirstCharTest : public testing::TestWithParam<CharTableSearchImpl> {
+protected:
+  static size_t expected(const VectorizedCharTable& table, absl::string_view str, bool in_table) {
+    for (size_t i = 0; i < str.size(); ++i) {
+      if (table.contains(str[i]) == in_table) {
+        return i;
+      }
+    }
+    return absl::string_view::npos;
+  }
+
+  // Enables every other character, including extended ones.
+  static constexpr VectorizedCharTable kAlternatingTable{
+      std::array<uint32_t, 8>{0x55555555, 0x55555555, 0x55555555, 0x55555555, 0x55555555,
+                              0x55555555, 0x55555555, 0x55555555}};
+};
+
+INSTANTIATE_TEST_SUITE_P(Impls, FindFirstCharTest,
+                         testing::Values(CharTableSearchImpl::Scalar, CharTableSearchImpl::Sse42,
+                                         CharTableSearchImpl::Avx2));
+
+TEST_P(FindFirstCharTest, MatchesScalarLoop) {
+  const CharTableSearchImpl impl = GetParam();
+  if (!charTableSearchImplSupported(impl)) {
+    GTEST_SKIP() << "not supported by this CPU";
+  }
+
+  for (const VectorizedCharTable* table :
+       {&kGenericHeaderNameVectorizedCharTable, &kAlternatingTable}) {
+    for (const size_t length : {0, 1, 15, 16, 17, 31, 32, 33, 64, 100}) {
+      // 'a' is in both tables and ' ' in neither.
+      const std::string valid(length, 'a');
+      EXPECT_EQ(absl::string_view::npos, findFirstCharForTest(impl, *table, valid, false));
+      for (size_t position = 0; position < length; ++position) {
+        for (unsigned c = 0; c < 256; ++c) {
+          std::string str = valid;
+          str[position] = static_cast<char>(c);
+          ASSERT_EQ(expected(*table, str, false), findFirstCharForTest(impl, *table, str, false))
+              << length << " " << position << " " << c;
+        }
+        std::string delimited(length, ' ');
+        delimited[position] = 'a';
+        ASSERT_EQ(position, findFirstCharForTest(impl, *table, delimited, true));
+      }
+    }
+  }
+}
+
+TEST(CharacterSetValidationTest, FindFirstChar) {
+  const VectorizedCharTable& table = kGenericHeaderNameVectorizedCharTable;
+  EXPECT_EQ(3, findFirstNotInCharTable(table, "abc:def"));
+  EXPECT_EQ(40, findFirstNotInCharTable(table, std::string(40, 'a') + " "));
+  EXPECT_EQ(absl::string_view::npos, findFirstInCharTable(table, std::string(40, ' ')));
+  EXPECT_TRUE(allCharsInTable(table, std::string(40, 'a')));
+  EXPECT_FALSE(allCharsInTable(table, std::string(40, 'a') + "\x80"));
+}
+
 } // namespace Http
 } // namespace Envoy
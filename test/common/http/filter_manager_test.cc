@@ -139,6 +139,51 @@ TEST_F(FilterManagerTest, RequestHeadersOrResponseHeadersAccess) {
   filter_manager_->destroyFilters();
 }
 
+// Verifies that the filter wrappers are allocated from the per-stream arena when it is enabled.
+TEST_F(FilterManagerTest, StreamArena) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.http_stream_arena", "true"}});
+  initialize();
+  ASSERT_TRUE(filter_manager_->streamArena().has_value());
+  EXPECT_EQ(0, filter_manager_->streamArena()->bytesAllocated());
+
+  auto decoder_filter = std::make_shared<NiceMock<MockStreamDecoderFilter>>();
+  auto stream_filter = std::make_shared<NiceMock<MockStreamFilter>>();
+
+  EXPECT_CALL(filter_factory_, createFilterChain(_))
+      .WillOnce(Invoke([&](FilterChainManager& manager) -> bool {
+        auto decoder_factory = createDecoderFilterFactoryCb(decoder_filter);
+        manager.applyFilterFactoryCb({}, decoder_factory);
+        auto stream_factory = createStreamFilterFactoryCb(stream_filter);
+        manager.applyFilterFactoryCb({}, stream_factory);
+        return true;
+      }));
+  filter_manager_->createDownstreamFilterChain();
+
+  // Two decoder filter wrappers and one encoder filter wrapper.
+  EXPECT_EQ(2 * sizeof(ActiveStreamDecoderFilter) + sizeof(ActiveStreamEncoderFilter),
+            filter_manager_->streamArena()->bytesAllocated());
+  EXPECT_EQ(1, filter_manager_->streamArena()->numBlocks());
+
+  RequestHeaderMapPtr request_headers{
+      new TestRequestHeaderMapImpl{{":authority", "host"}, {":path", "/"}, {":method", "GET"}}};
+  ON_CALL(filter_manager_callbacks_, requestHeaders())
+      .WillByDefault(Return(makeOptRef(*request_headers)));
+  EXPECT_CALL(*decoder_filter, decodeHeaders(_, true));
+  EXPECT_CALL(*stream_filter, decodeHeaders(_, true));
+  filter_manager_->decodeHeaders(*request_headers, true);
+
+  EXPECT_CALL(*decoder_filter, onDestroy());
+  EXPECT_CALL(*stream_filter, onDestroy());
+  filter_manager_->destroyFilters();
+}
+
+TEST_F(FilterManagerTest, StreamArenaDisabledByDefault) {
+  initialize();
+  EXPECT_FALSE(filter_manager_->streamArena().has_value());
+  filter_manager_->destroyFilters();
+}
+
 // Verifies that the local reply persists the gRPC classification even if the request headers are
 // modified.
 TEST_F(FilterManagerTest, SendLocalReplyDuringDecodingGrpcClassiciation) {
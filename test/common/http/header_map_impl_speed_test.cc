@@ -1,5 +1,6 @@
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/headers.h"
+#include "source/common/runtime/runtime_features.h"
 
 #include "test/test_common/utility.h"
 
@@ -297,6 +298,70 @@ static void headerMapImplRemovePrefix(benchmark::State& state) {
 }
 BENCHMARK(headerMapImplRemovePrefix)->Arg(0)->Arg(1)->Arg(5)->Arg(10)->Arg(50);
 
+/**
+ * Measure the cost of building, iterating and destroying a request header map with a varying
+ * number of non-inline headers, comparing the default per-node heap allocation with the pooled
+ * node storage. The first Arg is the number of headers and the second Arg selects pooled storage.
+ */
+static void headerMapImplNodeStorage(benchmark::State& state) {
+  Runtime::maybeSetRuntimeGuard("envoy.reloadable_features.header_map_pooled_node_storage",
+                                state.range(1) != 0);
+  std::vector<LowerCaseString> keys;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    keys.emplace_back(absl::StrCat("x-edge-header-", i));
+  }
+  const std::string value("01234567890123456789");
+  size_t total_len = 0;
+  for (auto _ : state) { // NOLINT
+    auto headers = Http::RequestHeaderMapImpl::create();
+    headers->setReferenceMethod(Http::Headers::get().MethodValues.Get);
+    headers->setReferencePath(value);
+    for (const auto& key : keys) {
+      headers->addReference(key, value);
+    }
+    headers->iterate([&total_len](const HeaderEntry& header) -> HeaderMap::Iterate {
+      total_len += header.key().size() + header.value().size();
+      return HeaderMap::Iterate::Continue;
+    });
+  }
+  benchmark::DoNotOptimize(total_len);
+  Runtime::maybeSetRuntimeGuard("envoy.reloadable_features.header_map_pooled_node_storage", false);
+}
+BENCHMARK(headerMapImplNodeStorage)
+    ->Args({5, 0})
+    ->Args({5, 1})
+    ->Args({30, 0})
+    ->Args({30, 1})
+    ->Args({60, 0})
+    ->Args({60, 1});
+
+/**
+ * Measure the speed of iterating a long-lived header map, where node locality matters most. The
+ * first Arg is the number of headers and the second Arg selects pooled storage.
+ */
+static void headerMapImplNodeStorageIterate(benchmark::State& state) {
+  Runtime::maybeSetRuntimeGuard("envoy.reloadable_features.header_map_pooled_node_storage",
+                                state.range(1) != 0);
+  auto headers = Http::RequestHeaderMapImpl::create();
+  addDummyHeaders(*headers, state.range(0));
+  size_t total_len = 0;
+  for (auto _ : state) { // NOLINT
+    headers->iterate([&total_len](const HeaderEntry& header) -> HeaderMap::Iterate {
+      total_len += header.value().size();
+      return HeaderMap::Iterate::Continue;
+    });
+  }
+  benchmark::DoNotOptimize(total_len);
+  Runtime::maybeSetRuntimeGuard("envoy.reloadable_features.header_map_pooled_node_storage", false);
+}
+BENCHMARK(headerMapImplNodeStorageIterate)
+    ->Args({5, 0})
+    ->Args({5, 1})
+    ->Args({30, 0})
+    ->Args({30, 1})
+    ->Args({60, 0})
+    ->Args({60, 1});
+
 class StaticLookupBenchmarker {
 public:
   explicit StaticLookupBenchmarker(std::unique_ptr<HeaderMapImpl> impl)
@@ -1086,5 +1086,82 @@ TEST(HeaderMapImplTest, HeaderMapMaxLimits) {
   EXPECT_EQ(response_trailer->maxHeadersCount(), 3);
 }
 
+// Exercise insertion order, pseudo header ordering, removal and node reuse with pooled header list
+// storage enabled.
+TEST(HeaderMapImplTest, PooledNodeStorage) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.header_map_pooled_node_storage", "true"}});
+
+  auto headers = RequestHeaderMapImpl::create();
+  EXPECT_EQ(0UL, headers->storageBlocksForTest());
+
+  for (size_t i = 0; i < 20; ++i) {
+    headers->addCopy(LowerCaseString(absl::StrCat("x-header-", i)), absl::StrCat("value-", i));
+  }
+  headers->setMethod("GET");
+  headers->setPath("/");
+  EXPECT_EQ(22UL, headers->size());
+  // 4 + 8 + 16 nodes.
+  EXPECT_EQ(3UL, headers->storageBlocksForTest());
+  headers->verifyByteSizeInternalForTest();
+
+  std::vector<std::string> keys;
+  headers->iterate([&keys](const HeaderEntry& header) -> HeaderMap::Iterate {
+    keys.emplace_back(header.key().getStringView());
+    return HeaderMap::Iterate::Continue;
+  });
+  ASSERT_EQ(22UL, keys.size());
+  EXPECT_EQ(":method", keys[0]);
+  EXPECT_EQ(":path", keys[1]);
+  for (size_t i = 0; i < 20; ++i) {
+    EXPECT_EQ(absl::StrCat("x-header-", i), keys[i + 2]);
+  }
+
+  // Removed nodes are recycled rather than growing the pool.
+  EXPECT_EQ(10UL, headers->removeIf([](const HeaderEntry& entry) -> bool {
+    return absl::EndsWith(entry.key().getStringView(), "0") ||
+           absl::EndsWith(entry.key().getStringView(), "2") ||
+           absl::EndsWith(entry.key().getStringView(), "4") ||
+           absl::EndsWith(entry.key().getStringView(), "6") ||
+           absl::EndsWith(entry.key().getStringView(), "8");
+  }));
+  EXPECT_EQ(1UL, headers->removeMethod());
+  for (size_t i = 0; i < 11; ++i) {
+    headers->addCopy(LowerCaseString(absl::StrCat("y-header-", i)), "value");
+  }
+  headers->setMethod("POST");
+  EXPECT_EQ(3UL, headers->storageBlocksForTest());
+  EXPECT_EQ("POST", headers->getMethodValue());
+  EXPECT_EQ("value-1", headers->get(LowerCaseString("x-header-1"))[0]->value().getStringView());
+  headers->verifyByteSizeInternalForTest();
+
+  headers->clear();
+  EXPECT_TRUE(headers->empty());
+  EXPECT_EQ(nullptr, headers->Method());
+  headers->setPath("/foo");
+  EXPECT_EQ(3UL, headers->storageBlocksForTest());
+
+  // Copies use their own pool.
+  auto copy = createHeaderMap<RequestHeaderMapImpl>(*headers);
+  EXPECT_EQ(*headers, *copy);
+  EXPECT_EQ(1UL, copy->storageBlocksForTest());
+}
+
+// With pooled storage disabled no blocks are allocated.
+TEST(HeaderMapImplTest, HeapNodeStorage) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.header_map_pooled_node_storage", "false"}});
+
+  auto headers = ResponseHeaderMapImpl::create();
+  for (size_t i = 0; i < 10; ++i) {
+    headers->addCopy(LowerCaseString(absl::StrCat("x-header-", i)), "value");
+  }
+  headers->setStatus(200);
+  EXPECT_EQ(11UL, headers->size());
+  EXPECT_EQ(0UL, headers->storageBlocksForTest());
+  headers->verifyByteSizeInternalForTest();
+}
+
 } // namespace Http
 } // namespace Envoy
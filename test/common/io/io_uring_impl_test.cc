@@ -1,3 +1,7 @@
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
 #include <functional>
 
 #include "source/common/io/io_uring_impl.h"
@@ -401,6 +405,121 @@ TEST_F(IoUringImplTest, PrepareReadvQueueOverflow) {
   EXPECT_EQ(static_cast<char*>(iov3.iov_base)[1], 'f');
 }
 
+TEST_F(IoUringImplTest, PrepareRecvMultishotWithProvidedBuffers) {
+  if (!io_uring_->setupProvidedBuffers(2, 16)) {
+    GTEST_SKIP() << "provided buffer rings are not supported by the kernel";
+  }
+  EXPECT_EQ(2, io_uring_->numAvailableProvidedBuffers());
+
+  int fds[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+
+  auto dispatcher = api_->allocateDispatcher("test_thread");
+  os_fd_t event_fd = io_uring_->registerEventfd();
+  std::vector<std::string> received;
+  bool more = true;
+  auto file_event = dispatcher->createFileEvent(
+      event_fd,
+      [this, &received, &more](uint32_t) {
+        io_uring_->forEveryCompletion([this, &received, &more](Request* req, int32_t res, bool) {
+          more = req->completionFlags() & IORING_CQE_F_MORE;
+          if (res > 0) {
+            ASSERT_TRUE(req->completionFlags() & IORING_CQE_F_BUFFER);
+            const uint16_t buffer_id = req->completionFlags() >> IORING_CQE_BUFFER_SHIFT;
+            uint8_t* data = io_uring_->takeProvidedBuffer(buffer_id);
+            received.emplace_back(reinterpret_cast<char*>(data), res);
+            io_uring_->returnProvidedBuffer(buffer_id);
+          }
+        });
+        return absl::OkStatus();
+      },
+      Event::PlatformDefaultTriggerType, Event::FileReadyType::Read);
+
+  // A single request serves all the reads.
+  int data = 0;
+  TestRequest request(data);
+  EXPECT_EQ(IoUringResult::Ok, io_uring_->prepareRecvMultishot(fds[0], &request));
+  EXPECT_EQ(IoUringResult::Ok, io_uring_->submit());
+
+  ASSERT_EQ(5, write(fds[1], "hello", 5));
+  waitForCondition(*dispatcher, [&received]() { return received.size() == 1; });
+  ASSERT_EQ(5, write(fds[1], "world", 5));
+  waitForCondition(*dispatcher, [&received]() { return received.size() == 2; });
+  EXPECT_EQ("hello", received[0]);
+  EXPECT_EQ("world", received[1]);
+  EXPECT_TRUE(more);
+  EXPECT_EQ(2, io_uring_->numAvailableProvidedBuffers());
+
+  // The request terminates on remote close.
+  close(fds[1]);
+  waitForCondition(*dispatcher, [&more]() { return !more; });
+  close(fds[0]);
+}
+
+TEST_F(IoUringImplTest, PrepareMultishotAccept) {
+  os_fd_t listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+  ASSERT_TRUE(SOCKET_VALID(listen_fd));
+  auto local_addr = std::make_shared<Network::Address::Ipv4Instance>("127.0.0.1", 0);
+  ASSERT_EQ(0, bind(listen_fd, local_addr->sockAddr(), local_addr->sockAddrLen()));
+  ASSERT_EQ(0, listen(listen_fd, 4));
+  sockaddr_storage bound_addr;
+  socklen_t bound_addr_len = sizeof(bound_addr);
+  ASSERT_EQ(0, getsockname(listen_fd, reinterpret_cast<sockaddr*>(&bound_addr), &bound_addr_len));
+
+  auto dispatcher = api_->allocateDispatcher("test_thread");
+  os_fd_t event_fd = io_uring_->registerEventfd();
+  int data = 0;
+  TestRequest request(data);
+  std::vector<os_fd_t> accepted;
+  bool more = true;
+  auto file_event = dispatcher->createFileEvent(
+      event_fd,
+      [this, &request, &accepted, &more](uint32_t) {
+        io_uring_->forEveryCompletion(
+            [&request, &accepted, &more](Request* req, int32_t res, bool) {
+              if (req != &request) {
+                return;
+              }
+              more = req->completionFlags() & IORING_CQE_F_MORE;
+              if (res >= 0) {
+                accepted.push_back(res);
+              }
+            });
+        return absl::OkStatus();
+      },
+      Event::PlatformDefaultTriggerType, Event::FileReadyType::Read);
+
+  // A single request accepts all the connections.
+  EXPECT_EQ(IoUringResult::Ok, io_uring_->prepareMultishotAccept(listen_fd, &request));
+  EXPECT_EQ(IoUringResult::Ok, io_uring_->submit());
+
+  std::vector<os_fd_t> clients;
+  for (int i = 0; i < 2; ++i) {
+    clients.push_back(socket(AF_INET, SOCK_STREAM, 0));
+    ASSERT_EQ(0,
+              connect(clients.back(), reinterpret_cast<sockaddr*>(&bound_addr), bound_addr_len));
+  }
+  waitForCondition(*dispatcher, [&accepted]() { return accepted.size() == 2; });
+  EXPECT_TRUE(more);
+  // The accepted sockets are non-blocking.
+  EXPECT_TRUE(fcntl(accepted[0], F_GETFL) & O_NONBLOCK);
+
+  // Cancelling terminates the request.
+  int cancel_data = 0;
+  TestRequest cancel_request(cancel_data);
+  EXPECT_EQ(IoUringResult::Ok, io_uring_->prepareCancel(&request, &cancel_request));
+  EXPECT_EQ(IoUringResult::Ok, io_uring_->submit());
+  waitForCondition(*dispatcher, [&more]() { return !more; });
+
+  for (os_fd_t fd : accepted) {
+    close(fd);
+  }
+  for (os_fd_t fd : clients) {
+    close(fd);
+  }
+  close(listen_fd);
+}
+
 } // namespace
 } // namespace Io
 } // namespace Envoy
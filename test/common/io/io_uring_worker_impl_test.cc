@@ -34,8 +34,10 @@ public:
 
 class IoUringWorkerTestImpl : public IoUringWorkerImpl {
 public:
-  IoUringWorkerTestImpl(IoUringPtr io_uring_instance, Event::Dispatcher& dispatcher)
-      : IoUringWorkerImpl(std::move(io_uring_instance), 8192, 1000, dispatcher) {}
+  IoUringWorkerTestImpl(IoUringPtr io_uring_instance, Event::Dispatcher& dispatcher,
+                        uint32_t num_provided_buffers = 0)
+      : IoUringWorkerImpl(std::move(io_uring_instance), 8192, 1000, num_provided_buffers,
+                          dispatcher) {}
 
   IoUringSocket& addTestSocket(os_fd_t fd) {
     return addSocket(std::make_unique<IoUringSocketTestImpl>(fd, *this));
@@ -336,6 +338,379 @@ TEST(IoUringWorkerImplTest, ServerSocketInjectAfterRead) {
   EXPECT_EQ(0, worker.getSockets().size());
 }
 
+TEST(IoUringWorkerImplTest, ServerSocketMultishotReadWithProvidedBuffers) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  EXPECT_CALL(mock_io_uring, setupProvidedBuffers(4, 8192)).WillOnce(Return(true));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, 4);
+  EXPECT_TRUE(worker.providedBuffersEnabled());
+
+  os_fd_t fd = 11;
+  SET_SOCKET_INVALID(fd);
+
+  // The server socket submits a single multishot read request.
+  Request* read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, numAvailableProvidedBuffers()).WillOnce(Return(4));
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&read_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  uint32_t read_events = 0;
+  auto& io_uring_socket = worker.addServerSocket(
+      fd,
+      [&read_events](uint32_t events) {
+        EXPECT_EQ(Event::FileReadyType::Read, events);
+        read_events++;
+        return absl::OkStatus();
+      },
+      false);
+  Buffer::OwnedImpl& read_buf = dynamic_cast<IoUringServerSocket&>(io_uring_socket).getReadBuffer();
+
+  // Two completions of the same request land in provided buffers, which are added to the read
+  // buffer without copying. No read request is submitted since the multishot one is still active.
+  uint8_t buffers[2][8] = {{'h', 'e', 'l', 'l', 'o'}, {'w', 'o', 'r', 'l', 'd'}};
+  EXPECT_CALL(mock_io_uring, takeProvidedBuffer(1)).WillOnce(Return(buffers[0]));
+  EXPECT_CALL(mock_io_uring, takeProvidedBuffer(3)).WillOnce(Return(buffers[1]));
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req](const CompletionCb& cb) {
+        read_req->setCompletionFlags(IORING_CQE_F_MORE | IORING_CQE_F_BUFFER |
+                                     (1 << IORING_CQE_BUFFER_SHIFT));
+        cb(read_req, 5, false);
+        read_req->setCompletionFlags(IORING_CQE_F_MORE | IORING_CQE_F_BUFFER |
+                                     (3 << IORING_CQE_BUFFER_SHIFT));
+        cb(read_req, 3, false);
+      }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(2, read_events);
+  EXPECT_EQ("hellowor", read_buf.toString());
+  EXPECT_EQ(reinterpret_cast<void*>(buffers[0]), read_buf.frontSlice().mem_);
+
+  // Draining the data returns the buffers to the kernel.
+  EXPECT_CALL(mock_io_uring, returnProvidedBuffer(1));
+  read_buf.drain(5);
+
+  // A buffer drained on another thread is returned on the worker's thread.
+  Event::PostCb post_cb;
+  EXPECT_CALL(dispatcher, isThreadSafe()).WillOnce(Return(false)).WillRepeatedly(Return(true));
+  EXPECT_CALL(dispatcher, post(_)).WillOnce([&post_cb](Event::PostCb cb) {
+    post_cb = std::move(cb);
+  });
+  EXPECT_CALL(mock_io_uring, returnProvidedBuffer(3)).Times(0);
+  read_buf.drain(read_buf.length());
+  EXPECT_CALL(mock_io_uring, returnProvidedBuffer(3));
+  post_cb();
+
+  // Running out of provided buffers terminates the request, which is not an error. The socket
+  // falls back to readv until buffers are available again.
+  Request* readv_req = nullptr;
+  EXPECT_CALL(mock_io_uring, numAvailableProvidedBuffers()).WillOnce(Return(0));
+  EXPECT_CALL(mock_io_uring, prepareReadv(fd, _, _, _, _))
+      .WillOnce(DoAll(SaveArg<4>(&readv_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req](const CompletionCb& cb) {
+        read_req->setCompletionFlags(0);
+        cb(read_req, -ENOBUFS, false);
+      }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(2, read_events);
+
+  // Close the socket.
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareCancel(readv_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  io_uring_socket.close(false);
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&readv_req, &cancel_req](const CompletionCb& cb) {
+        cb(readv_req, -ECANCELED, false);
+        cb(cancel_req, 0, false);
+      }));
+  Request* close_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareClose(_, _))
+      .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false); }));
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_EQ(0, worker.getSockets().size());
+}
+
+TEST(IoUringWorkerImplTest, ServerSocketDisableReadCancelsMultishotRead) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  EXPECT_CALL(mock_io_uring, setupProvidedBuffers(4, 8192)).WillOnce(Return(true));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, 4);
+
+  os_fd_t fd = 11;
+  SET_SOCKET_INVALID(fd);
+
+  Request* read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, numAvailableProvidedBuffers()).WillOnce(Return(4));
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&read_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  uint32_t read_events = 0;
+  auto& io_uring_socket = worker.addServerSocket(
+      fd,
+      [&read_events](uint32_t events) {
+        EXPECT_EQ(Event::FileReadyType::Read, events);
+        read_events++;
+        return absl::OkStatus();
+      },
+      false);
+
+  // Disabling reads cancels the multishot read.
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareCancel(read_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  io_uring_socket.disableRead();
+
+  // Once the cancellation completes, a readv monitors the remote close without taking provided
+  // buffers.
+  Request* readv_req = nullptr;
+  EXPECT_CALL(mock_io_uring, numAvailableProvidedBuffers()).Times(0);
+  EXPECT_CALL(mock_io_uring, prepareReadv(fd, _, _, _, _))
+      .WillOnce(DoAll(SaveArg<4>(&readv_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req, &cancel_req](const CompletionCb& cb) {
+        read_req->setCompletionFlags(0);
+        cb(read_req, -ECANCELED, false);
+        cb(cancel_req, 0, false);
+      }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(0, read_events);
+
+  // Enabling reads keeps the pending readv, and the multishot read is submitted again once it
+  // completes.
+  io_uring_socket.enableRead();
+  EXPECT_CALL(mock_io_uring, numAvailableProvidedBuffers()).WillOnce(Return(4));
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&read_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&readv_req](const CompletionCb& cb) { cb(readv_req, 5, false); }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(1, read_events);
+
+  // Close the socket.
+  EXPECT_CALL(mock_io_uring, prepareCancel(read_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  io_uring_socket.close(false);
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req, &cancel_req](const CompletionCb& cb) {
+        read_req->setCompletionFlags(0);
+        cb(read_req, -ECANCELED, false);
+        cb(cancel_req, 0, false);
+      }));
+  Request* close_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareClose(_, _))
+      .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false); }));
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_EQ(0, worker.getSockets().size());
+}
+
+TEST(IoUringWorkerImplTest, AcceptSocketQueuesMultishotAccepts) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher);
+
+  os_fd_t fd = 11;
+  SET_SOCKET_INVALID(fd);
+
+  // A single accept request is submitted for the listening socket.
+  Request* accept_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareMultishotAccept(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&accept_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  std::vector<os_fd_t> accepted;
+  IoUringSocket* accept_socket = nullptr;
+  accept_socket = &worker.addAcceptSocket(fd, [&accepted, &accept_socket](uint32_t events) {
+    EXPECT_EQ(Event::FileReadyType::Read, events);
+    // Accept one connection per event.
+    const os_fd_t conn = accept_socket->popAcceptedFd();
+    if (SOCKET_VALID(conn)) {
+      accepted.push_back(conn);
+    }
+    return absl::OkStatus();
+  });
+
+  // Every accepted connection is delivered as a read event.
+  const os_fd_t conn1 = ::socket(AF_INET, SOCK_STREAM, 0);
+  const os_fd_t conn2 = ::socket(AF_INET, SOCK_STREAM, 0);
+  const os_fd_t conn3 = ::socket(AF_INET, SOCK_STREAM, 0);
+  ASSERT_TRUE(SOCKET_VALID(conn1) && SOCKET_VALID(conn2) && SOCKET_VALID(conn3));
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&accept_req, conn1](const CompletionCb& cb) {
+        accept_req->setCompletionFlags(IORING_CQE_F_MORE);
+        cb(accept_req, conn1, false);
+      }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(std::vector<os_fd_t>({conn1}), accepted);
+
+  // Disabling the socket cancels the accept request. Connections accepted before the
+  // cancellation are queued without calling back.
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareCancel(accept_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  accept_socket->disableRead();
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&accept_req, &cancel_req, conn2, conn3](const CompletionCb& cb) {
+        cb(accept_req, conn2, false);
+        cb(accept_req, conn3, false);
+        accept_req->setCompletionFlags(0);
+        cb(accept_req, -ECANCELED, false);
+        cb(cancel_req, 0, false);
+      }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(1, accepted.size());
+
+  // Enabling the socket again delivers the queued connections through injected completions, like
+  // a level triggered event, and submits a new accept request.
+  EXPECT_CALL(mock_io_uring, injectCompletion(fd, _, -EAGAIN))
+      .Times(2)
+      .WillRepeatedly(Invoke([](os_fd_t, Request* req, int32_t) { delete req; }));
+  EXPECT_CALL(mock_io_uring, prepareMultishotAccept(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&accept_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  accept_socket->enableRead();
+
+  Request injected_req(Request::RequestType::Accept, *accept_socket);
+  accept_socket->onAccept(&injected_req, -EAGAIN, true);
+  EXPECT_EQ(std::vector<os_fd_t>({conn1, conn2}), accepted);
+  accept_socket->onAccept(&injected_req, -EAGAIN, true);
+  EXPECT_EQ(std::vector<os_fd_t>({conn1, conn2, conn3}), accepted);
+
+  // Closing the socket cancels the accept request and keeps the listening fd open.
+  EXPECT_CALL(mock_io_uring, prepareCancel(accept_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  accept_socket->close(true);
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&accept_req, &cancel_req](const CompletionCb& cb) {
+        cb(accept_req, -ECANCELED, false);
+        cb(cancel_req, 0, false);
+      }));
+  EXPECT_CALL(mock_io_uring, prepareClose(_, _)).Times(0);
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(0, worker.getSockets().size());
+
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+  ::close(conn1);
+  ::close(conn2);
+  ::close(conn3);
+}
+
+TEST(IoUringWorkerImplTest, AcceptSocketFallsBackWithoutMultishotAccept) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher);
+
+  os_fd_t fd = 11;
+  SET_SOCKET_INVALID(fd);
+
+  Request* accept_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareMultishotAccept(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&accept_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  auto& accept_socket = worker.addAcceptSocket(fd, [](uint32_t) { return absl::OkStatus(); });
+
+  // The kernel rejects multishot accept, so the socket falls back to single shot accepts.
+  Request* single_accept_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareAccept(fd, nullptr, nullptr, _))
+      .WillOnce(DoAll(SaveArg<3>(&single_accept_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&accept_req](const CompletionCb& cb) { cb(accept_req, -EINVAL, false); }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_FALSE(worker.multishotAcceptEnabled());
+
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareCancel(single_accept_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  accept_socket.close(true);
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&single_accept_req, &cancel_req](const CompletionCb& cb) {
+        cb(cancel_req, 0, false);
+        cb(single_accept_req, -ECANCELED, false);
+      }));
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(0, worker.getSockets().size());
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+}
+
 TEST(IoUringWorkerImplTest, CloseAllSocketsWhenDestruction) {
   Event::MockDispatcher dispatcher;
   IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
@@ -496,7 +871,7 @@ TEST(IoUringWorkerImplTest, CloseDetected) {
       .WillOnce(DoAll(SaveArg<4>(&read_req2), Return<IoUringResult>(IoUringResult::Ok)));
   EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
   socket.onRead(read_req, 1, false);
-  socket.onRead(nullptr, 0, false);
+  socket.onRead(read_req2, 0, false);
 
   EXPECT_CALL(dispatcher, clearDeferredDeleteList());
   delete read_req;
@@ -13,6 +13,10 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#if ENVOY_PLATFORM_ENABLE_ZEROCOPY_SEND
+#include <linux/errqueue.h>
+#endif
+
 using testing::_;
 using testing::Eq;
 using testing::Invoke;
@@ -101,6 +105,48 @@ TEST(IoSocketHandleImpl, LastRoundTripTimeReturnsRttIfSuccessful) {
               Eq(std::chrono::duration_cast<std::chrono::milliseconds>(rtt)));
 }
 
+#if ENVOY_PLATFORM_ENABLE_ZEROCOPY_SEND
+TEST(IoSocketHandleImpl, RecvZeroCopyCompletions) {
+  NiceMock<Envoy::Api::MockOsSysCalls> os_sys_calls;
+  auto os_calls =
+      std::make_unique<Envoy::TestThreadsafeSingletonInjector<Envoy::Api::OsSysCallsImpl>>(
+          &os_sys_calls);
+
+  EXPECT_CALL(os_sys_calls, recvmsg(_, _, MSG_ERRQUEUE))
+      .WillOnce(Invoke([](os_fd_t, msghdr* message, int) -> Api::SysCallSizeResult {
+        sock_extended_err err{};
+        err.ee_origin = SO_EE_ORIGIN_ZEROCOPY;
+        err.ee_code = SO_EE_CODE_ZEROCOPY_COPIED;
+        err.ee_info = 3;
+        err.ee_data = 5;
+        cmsghdr* cmsg = CMSG_FIRSTHDR(message);
+        cmsg->cmsg_level = SOL_IPV6;
+        cmsg->cmsg_type = IPV6_RECVERR;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(err));
+        memcpy(CMSG_DATA(cmsg), &err, sizeof(err));
+        message->msg_controllen = CMSG_SPACE(sizeof(err));
+        return {0, 0};
+      }))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, SOCKET_ERROR_AGAIN}));
+
+  IoSocketHandleImpl io_handle;
+  std::vector<std::tuple<uint32_t, uint32_t, bool>> completions;
+  const Api::IoCallUint64Result result = io_handle.recvZeroCopyCompletions(
+      [&completions](uint32_t first_id, uint32_t last_id, bool copied) {
+        completions.emplace_back(first_id, last_id, copied);
+      });
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(1, result.return_value_);
+  EXPECT_THAT(completions, testing::ElementsAre(std::make_tuple(3, 5, true)));
+
+  EXPECT_CALL(os_sys_calls, recvmsg(_, _, MSG_ERRQUEUE))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, SOCKET_ERROR_BADF}));
+  EXPECT_EQ(Api::IoError::IoErrorCode::BadFd,
+            io_handle.recvZeroCopyCompletions([](uint32_t, uint32_t, bool) {})
+                .err_->getErrorCode());
+}
+#endif
+
 TEST(IoSocketHandleImpl, InterfaceNameWithPipe) {
   std::string path = TestEnvironment::unixDomainSocketPath("foo.sock");
 
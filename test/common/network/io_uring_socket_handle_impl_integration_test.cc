@@ -8,6 +8,7 @@
 #include "source/common/network/io_uring_socket_handle_impl.h"
 #include "source/common/thread_local/thread_local_impl.h"
 
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/test_time.h"
 #include "test/test_common/utility.h"
 
@@ -45,7 +46,7 @@ public:
     }
 
     io_uring_worker_factory_ =
-        std::make_unique<Io::IoUringWorkerFactoryImpl>(10, false, 8192, 1000, instance_);
+        std::make_unique<Io::IoUringWorkerFactoryImpl>(10, false, 8192, 1000, 0, instance_);
     io_uring_worker_factory_->onWorkerThreadInitialized();
 
     // Create the thread after the io_uring worker has been initialized, otherwise the dispatcher
@@ -207,6 +208,55 @@ TEST_F(IoUringSocketHandleImplIntegrationTest, Accept) {
   EXPECT_EQ(errno, EBADF);
 }
 
+TEST_F(IoUringSocketHandleImplIntegrationTest, MultishotAccept) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.io_uring_multishot_accept", "true"}});
+  initialize();
+  createAcceptConnection();
+
+  std::vector<IoHandlePtr> accepted;
+  io_uring_socket_handle_->initializeFileEvent(
+      *dispatcher_,
+      [this, &accepted](uint32_t) {
+        while (true) {
+          sockaddr_storage addr;
+          socklen_t addrlen = sizeof(addr);
+          auto handle =
+              io_uring_socket_handle_->accept(reinterpret_cast<sockaddr*>(&addr), &addrlen);
+          if (handle == nullptr) {
+            break;
+          }
+          // The peer address is filled in although multishot accept doesn't report it.
+          EXPECT_EQ(AF_INET, addr.ss_family);
+          accepted.push_back(std::move(handle));
+        }
+        return absl::OkStatus();
+      },
+      Event::FileTriggerType::Level, Event::FileReadyType::Read);
+
+  // Connect twice, both connections are accepted by the same accept request.
+  os_fd_t fd = Api::OsSysCallsSingleton::get()
+                   .socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, IPPROTO_TCP)
+                   .return_value_;
+  EXPECT_GE(fd, 0);
+  IoHandlePtr second_io_socket_handle = std::make_unique<IoSocketHandleImpl>(fd);
+  io_socket_handle_->connect(*io_uring_socket_handle_->localAddress());
+  second_io_socket_handle->connect(*io_uring_socket_handle_->localAddress());
+  while (accepted.size() < 2) {
+    dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  }
+
+  // Close safely.
+  accepted.clear();
+  io_socket_handle_->close();
+  second_io_socket_handle->close();
+  io_uring_socket_handle_->close();
+  while (fcntl(fd_, F_GETFD, 0) >= 0) {
+    dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  }
+  EXPECT_EQ(errno, EBADF);
+}
+
 TEST_F(IoUringSocketHandleImplIntegrationTest, AcceptError) {
   initialize();
   createAcceptConnection();
@@ -1,10 +1,26 @@
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/network/io_socket_error_impl.h"
 #include "source/common/network/raw_buffer_socket.h"
 #include "source/common/network/transport_socket_options_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
 
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/network/io_handle.h"
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/network_utility.h"
 
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+using testing::_;
+using testing::ByMove;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+using testing::ReturnRef;
+using testing::SaveArg;
+
 namespace Envoy {
 namespace Network {
 
@@ -19,5 +35,225 @@ TEST(RawBufferSocketFactory, RawBufferSocketFactory) {
   EXPECT_GT(keys.size(), 0);
 }
 
+#if ENVOY_PLATFORM_ENABLE_ZEROCOPY_SEND
+class RawBufferSocketZeroCopyTest : public testing::Test {
+protected:
+  RawBufferSocketZeroCopyTest()
+      : config_(std::make_shared<RawBufferSocketZeroCopyConfig>(1024, *store_.rootScope(), tls_)),
+        socket_(config_) {
+    ON_CALL(callbacks_, ioHandle()).WillByDefault(ReturnRef(io_handle_));
+    ON_CALL(io_handle_, recvZeroCopyCompletions(_)).WillByDefault(Invoke([](auto&) {
+      return Api::IoCallUint64Result(0, Api::IoError::none());
+    }));
+    socket_.setTransportSocketCallbacks(callbacks_);
+  }
+
+  // Reads a zero-copy notification for the sends in [first_id, last_id].
+  static void expectCompletion(MockIoHandle& io_handle, uint32_t first_id, uint32_t last_id,
+                               bool copied) {
+    EXPECT_CALL(io_handle, recvZeroCopyCompletions(_))
+        .WillOnce(Invoke([=](const IoHandle::ZeroCopyCompletionCb& cb) {
+          cb(first_id, last_id, copied);
+          return Api::IoCallUint64Result(1, Api::IoError::none());
+        }));
+  }
+
+  void expectEnableZeroCopy(int rc) {
+    EXPECT_CALL(io_handle_, setOption(SOL_SOCKET, SO_ZEROCOPY, _, _))
+        .WillOnce(Return(Api::SysCallIntResult{rc, rc == 0 ? 0 : ENOPROTOOPT}));
+  }
+
+  void expectSendZeroCopy(uint64_t rc) {
+    EXPECT_CALL(io_handle_, sendmsg(_, _, MSG_ZEROCOPY, nullptr, _))
+        .WillOnce(Return(ByMove(Api::IoCallUint64Result(rc, Api::IoError::none()))));
+  }
+
+  void doRead() {
+    EXPECT_CALL(io_handle_, read(_, _))
+        .WillOnce(Return(
+            ByMove(Api::IoCallUint64Result(0, IoSocketError::getIoSocketEagainError()))));
+    Buffer::OwnedImpl read_buffer;
+    socket_.doRead(read_buffer);
+  }
+
+  Stats::IsolatedStoreImpl store_;
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  RawBufferSocketZeroCopyConfigSharedPtr config_;
+  NiceMock<MockTransportSocketCallbacks> callbacks_;
+  NiceMock<MockIoHandle> io_handle_;
+  RawBufferSocket socket_;
+};
+
+// Slices sent with MSG_ZEROCOPY stay alive until the kernel reports the send complete.
+TEST_F(RawBufferSocketZeroCopyTest, PinsSlicesUntilCompletion) {
+  expectEnableZeroCopy(0);
+  expectSendZeroCopy(4096);
+
+  bool released = false;
+  Buffer::OwnedImpl buffer(std::string(4096, 'a'));
+  buffer.addDrainTracker([&released]() { released = true; });
+  const IoResult result = socket_.doWrite(buffer, false);
+  EXPECT_EQ(PostIoAction::KeepOpen, result.action_);
+  EXPECT_EQ(4096, result.bytes_processed_);
+  EXPECT_EQ(0, buffer.length());
+  EXPECT_FALSE(released);
+  EXPECT_EQ(1, config_->stats_.zerocopy_send_.value());
+
+  expectCompletion(io_handle_, 0, 0, false);
+  doRead();
+  EXPECT_TRUE(released);
+  EXPECT_EQ(0, config_->stats_.zerocopy_copied_.value());
+}
+
+// A short send pins the whole front slice and copies its unsent tail back into the buffer.
+TEST_F(RawBufferSocketZeroCopyTest, PartialSendKeepsUnsentTail) {
+  expectEnableZeroCopy(0);
+  EXPECT_CALL(io_handle_, sendmsg(_, _, MSG_ZEROCOPY, nullptr, _))
+      .WillOnce(Return(ByMove(Api::IoCallUint64Result(1000, Api::IoError::none()))))
+      .WillOnce(Return(
+          ByMove(Api::IoCallUint64Result(0, IoSocketError::getIoSocketEagainError()))));
+
+  std::string data;
+  for (int i = 0; i < 4096; ++i) {
+    data.push_back('a' + i % 26);
+  }
+  Buffer::OwnedImpl buffer(data);
+  const IoResult result = socket_.doWrite(buffer, false);
+  EXPECT_EQ(PostIoAction::KeepOpen, result.action_);
+  EXPECT_EQ(1000, result.bytes_processed_);
+  EXPECT_EQ(data.substr(1000), buffer.toString());
+}
+
+// Sends the kernel had to copy anyway switch the socket back to regular writes.
+TEST_F(RawBufferSocketZeroCopyTest, CopiedCompletionFallsBackToWrite) {
+  expectEnableZeroCopy(0);
+  expectSendZeroCopy(4096);
+  Buffer::OwnedImpl buffer(std::string(4096, 'a'));
+  socket_.doWrite(buffer, false);
+
+  expectCompletion(io_handle_, 0, 0, true);
+  EXPECT_CALL(io_handle_, write(_)).WillOnce(Invoke([](Buffer::Instance& buffer) {
+    const uint64_t length = buffer.length();
+    buffer.drain(length);
+    return Api::IoCallUint64Result(length, Api::IoError::none());
+  }));
+  buffer.add(std::string(4096, 'b'));
+  socket_.doWrite(buffer, false);
+  EXPECT_EQ(1, config_->stats_.zerocopy_copied_.value());
+  EXPECT_EQ(1, config_->stats_.zerocopy_fallback_.value());
+}
+
+// Sockets which do not support SO_ZEROCOPY, and writes below the threshold, use regular writes.
+TEST_F(RawBufferSocketZeroCopyTest, UnsupportedSocketUsesWrite) {
+  EXPECT_CALL(io_handle_, sendmsg(_, _, _, _, _)).Times(0);
+  EXPECT_CALL(io_handle_, write(_)).Times(2).WillRepeatedly(Invoke([](Buffer::Instance& buffer) {
+    const uint64_t length = buffer.length();
+    buffer.drain(length);
+    return Api::IoCallUint64Result(length, Api::IoError::none());
+  }));
+
+  Buffer::OwnedImpl small(std::string(100, 'a'));
+  socket_.doWrite(small, false);
+  EXPECT_EQ(0, config_->stats_.zerocopy_fallback_.value());
+
+  expectEnableZeroCopy(-1);
+  Buffer::OwnedImpl large(std::string(4096, 'a'));
+  socket_.doWrite(large, false);
+  EXPECT_EQ(0, large.length());
+  EXPECT_EQ(1, config_->stats_.zerocopy_fallback_.value());
+}
+
+// Handles which cannot read zero-copy completions never enable SO_ZEROCOPY.
+TEST_F(RawBufferSocketZeroCopyTest, HandleWithoutCompletionsUsesWrite) {
+  EXPECT_CALL(io_handle_, recvZeroCopyCompletions(_)).WillOnce(Invoke([](auto&) {
+    return Api::IoCallUint64Result(0, IoSocketError::create(SOCKET_ERROR_NOT_SUP));
+  }));
+  EXPECT_CALL(io_handle_, setOption(SOL_SOCKET, SO_ZEROCOPY, _, _)).Times(0);
+  EXPECT_CALL(io_handle_, write(_)).WillOnce(Invoke([](Buffer::Instance& buffer) {
+    const uint64_t length = buffer.length();
+    buffer.drain(length);
+    return Api::IoCallUint64Result(length, Api::IoError::none());
+  }));
+
+  Buffer::OwnedImpl buffer(std::string(4096, 'a'));
+  socket_.doWrite(buffer, false);
+  EXPECT_EQ(1, config_->stats_.zerocopy_fallback_.value());
+}
+
+// Sends still in flight when the socket closes stay pinned, with a duplicate of the socket, until
+// their completions arrive.
+TEST_F(RawBufferSocketZeroCopyTest, CloseKeepsInFlightSendsPinned) {
+  expectEnableZeroCopy(0);
+  expectSendZeroCopy(4096);
+  bool released = false;
+  Buffer::OwnedImpl buffer(std::string(4096, 'a'));
+  buffer.addDrainTracker([&released]() { released = true; });
+  socket_.doWrite(buffer, false);
+
+  auto* duplicate = new NiceMock<MockIoHandle>();
+  Event::FileReadyCb file_ready_cb;
+  EXPECT_CALL(io_handle_, duplicate()).WillOnce(Return(ByMove(IoHandlePtr{duplicate})));
+  EXPECT_CALL(*duplicate, shutdown(ENVOY_SHUT_WR));
+  EXPECT_CALL(*duplicate, createFileEvent_(_, _, _, Event::FileReadyType::Read))
+      .WillOnce(SaveArg<1>(&file_ready_cb));
+  EXPECT_CALL(*duplicate, recvZeroCopyCompletions(_)).WillOnce(Invoke([](auto&) {
+    return Api::IoCallUint64Result(0, Api::IoError::none());
+  }));
+  socket_.closeSocket(ConnectionEvent::LocalClose);
+  EXPECT_FALSE(released);
+  EXPECT_EQ(1, (*config_->lingering_sends_)->size());
+
+  expectCompletion(*duplicate, 0, 0, false);
+  EXPECT_CALL(*duplicate, setOption(SOL_SOCKET, SO_LINGER, _, _)).Times(0);
+  EXPECT_CALL(*duplicate, close())
+      .WillOnce(Return(ByMove(Api::IoCallUint64Result(0, Api::IoError::none()))));
+  EXPECT_TRUE(file_ready_cb(Event::FileReadyType::Read).ok());
+  EXPECT_TRUE(released);
+  EXPECT_EQ(0, (*config_->lingering_sends_)->size());
+}
+
+// Lingering sockets which do not complete in time are reset before their sends are released.
+TEST_F(RawBufferSocketZeroCopyTest, LingeringSendsResetAfterTimeout) {
+  expectEnableZeroCopy(0);
+  expectSendZeroCopy(4096);
+  bool released = false;
+  Buffer::OwnedImpl buffer(std::string(4096, 'a'));
+  buffer.addDrainTracker([&released]() { released = true; });
+  socket_.doWrite(buffer, false);
+
+  auto* duplicate = new NiceMock<MockIoHandle>();
+  ON_CALL(*duplicate, recvZeroCopyCompletions(_)).WillByDefault(Invoke([](auto&) {
+    return Api::IoCallUint64Result(0, Api::IoError::none());
+  }));
+  EXPECT_CALL(io_handle_, duplicate()).WillOnce(Return(ByMove(IoHandlePtr{duplicate})));
+  auto* timer = new NiceMock<Event::MockTimer>(&tls_.dispatcher_);
+  EXPECT_CALL(*timer, enableTimer(std::chrono::milliseconds(60000), _));
+  socket_.closeSocket(ConnectionEvent::LocalClose);
+  EXPECT_FALSE(released);
+
+  EXPECT_CALL(*duplicate, setOption(SOL_SOCKET, SO_LINGER, _, _));
+  EXPECT_CALL(*duplicate, close())
+      .WillOnce(Return(ByMove(Api::IoCallUint64Result(0, Api::IoError::none()))));
+  timer->invokeCallback();
+  EXPECT_EQ(0, (*config_->lingering_sends_)->size());
+  tls_.dispatcher_.clearDeferredDeleteList();
+  EXPECT_TRUE(released);
+}
+
+// A reset socket stops transmitting, so its in-flight sends do not outlive the connection.
+TEST_F(RawBufferSocketZeroCopyTest, ResetDoesNotKeepInFlightSends) {
+  expectEnableZeroCopy(0);
+  expectSendZeroCopy(4096);
+  Buffer::OwnedImpl buffer(std::string(4096, 'a'));
+  socket_.doWrite(buffer, false);
+
+  EXPECT_CALL(callbacks_.connection_, detectedCloseType())
+      .WillRepeatedly(Return(DetectedCloseType::LocalReset));
+  EXPECT_CALL(io_handle_, duplicate()).Times(0);
+  socket_.closeSocket(ConnectionEvent::LocalClose);
+  EXPECT_EQ(0, (*config_->lingering_sends_)->size());
+}
+#endif
+
 } // namespace Network
 } // namespace Envoy
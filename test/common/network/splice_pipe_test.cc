@@ -0,0 +1,62 @@
+#include <sys/socket.h>
+
+#include <string>
+
+#include "source/common/common/assert.h"
+#include "source/common/network/splice_pipe.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+#if defined(__linux__)
+class SplicePipeTest : public testing::Test {
+protected:
+  SplicePipeTest() {
+    RELEASE_ASSERT(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, source_) == 0, "");
+    RELEASE_ASSERT(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, target_) == 0, "");
+  }
+
+  ~SplicePipeTest() override {
+    for (const int fd : {source_[0], source_[1], target_[0], target_[1]}) {
+      close(fd);
+    }
+  }
+
+  int source_[2];
+  int target_[2];
+};
+
+TEST_F(SplicePipeTest, MovesDataBetweenSockets) {
+  SplicePipePtr pipe = SplicePipe::create();
+  ASSERT_NE(nullptr, pipe);
+
+  const std::string data = "hello world";
+  ASSERT_EQ(data.size(), write(source_[1], data.data(), data.size()));
+  Api::SysCallSizeResult result = pipe->fill(source_[0]);
+  EXPECT_EQ(data.size(), result.return_value_);
+  EXPECT_EQ(data.size(), pipe->bufferedBytes());
+
+  // The socket is drained.
+  result = pipe->fill(source_[0]);
+  EXPECT_EQ(-1, result.return_value_);
+  EXPECT_EQ(EAGAIN, result.errno_);
+
+  result = pipe->drain(target_[0]);
+  EXPECT_EQ(data.size(), result.return_value_);
+  EXPECT_EQ(0, pipe->bufferedBytes());
+  char buffer[64];
+  ASSERT_EQ(data.size(), read(target_[1], buffer, sizeof(buffer)));
+  EXPECT_EQ(data, std::string(buffer, data.size()));
+
+  // A shut down source reads as end of stream.
+  shutdown(source_[1], SHUT_WR);
+  EXPECT_EQ(0, pipe->fill(source_[0]).return_value_);
+}
+#endif
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
@@ -3,6 +3,7 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/router/config_impl.h"
+#include "source/common/runtime/runtime_features.h"
 
 #include "test/mocks/server/instance.h"
 #include "test/mocks/stream_info/mocks.h"
@@ -59,7 +60,7 @@ static RouteConfiguration genRouteConfig(benchmark::State& state,
       break;
     }
     case RouteMatch::PathSpecifierCase::kPath: {
-      match->set_prefix(absl::StrCat("/shelves/shelf_", i, "/route_", i));
+      match->set_path(absl::StrCat("/shelves/shelf_", i, "/route_", i));
       break;
     }
     case RouteMatch::PathSpecifierCase::kSafeRegex: {
@@ -311,9 +312,30 @@ static void bmRouteTableSizeWithPrefixMatcherTree(benchmark::State& state) {
   }
 }
 
+/**
+ * Benchmark the prefix and exact path route tables with the compiled route index disabled, i.e.
+ * with a linear scan of the route list, as a baseline for the benchmarks above.
+ */
+static void bmRouteTableSizeLinear(benchmark::State& state,
+                                   RouteMatch::PathSpecifierCase match_type) {
+  Runtime::maybeSetRuntimeGuard("envoy.reloadable_features.compiled_route_index", false);
+  bmRouteTableSize(state, match_type);
+  Runtime::maybeSetRuntimeGuard("envoy.reloadable_features.compiled_route_index", true);
+}
+
+static void bmRouteTableSizeWithPathPrefixMatchLinear(benchmark::State& state) {
+  bmRouteTableSizeLinear(state, RouteMatch::PathSpecifierCase::kPrefix);
+}
+
+static void bmRouteTableSizeWithExactPathMatchLinear(benchmark::State& state) {
+  bmRouteTableSizeLinear(state, RouteMatch::PathSpecifierCase::kPath);
+}
+
 BENCHMARK(bmRouteTableSizeWithPathPrefixMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithExactPathMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithRegexMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
+BENCHMARK(bmRouteTableSizeWithPathPrefixMatchLinear)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
+BENCHMARK(bmRouteTableSizeWithExactPathMatchLinear)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 
 BENCHMARK(bmRouteTableSizeWithExactMatcherTree)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithPrefixMatcherTree)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
@@ -8851,6 +8851,92 @@ virtual_hosts:
                 ->clusterName());
 }
 
+// Verifies that the compiled route index returns the same routes as a linear scan, for a route
+// list mixing indexed runs with routes which are always evaluated linearly.
+TEST_F(RouteMatcherTest, CompiledRouteIndex) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: index
+    domains: ["*"]
+    routes:
+      - match: { path: "/exact" }
+        route: { cluster: c0 }
+      - match: { prefix: "/api/v1" }
+        route: { cluster: c1 }
+      - match:
+          prefix: "/api"
+          headers:
+            - name: x-version
+              string_match: { exact: "2" }
+        route: { cluster: c2 }
+      - match: { path_separated_prefix: "/api/v2" }
+        route: { cluster: c3 }
+      - match: { prefix: "/api/v2/users" }
+        route: { cluster: c4 }
+      - match: { safe_regex: { regex: "/api/.*/regex" } }
+        route: { cluster: c5 }
+      - match: { prefix: "/API", case_sensitive: false }
+        route: { cluster: c6 }
+      - match: { path: "/exact" }
+        route: { cluster: c7 }
+      - match: { prefix: "/static" }
+        route: { cluster: c8 }
+      - match: { path_separated_prefix: "/static/img" }
+        route: { cluster: c9 }
+      - match: { path: "/static/index.html" }
+        route: { cluster: c10 }
+      - match: { prefix: "/" }
+        route: { cluster: c11 }
+  )EOF";
+
+  factory_context_.cluster_manager_.initializeClusters(
+      {"c0", "c1", "c2", "c3", "c4", "c5", "c6", "c7", "c8", "c9", "c10", "c11"}, {});
+
+  const std::vector<std::pair<std::string, std::string>> requests = {
+      {"/exact", "c0"},
+      {"/exact?query", "c0"},
+      {"/exact/", "c11"},
+      {"/api/v1/users", "c1"},
+      {"/api/v2", "c3"},
+      {"/api/v2#fragment", "c3"},
+      {"/api/v2/users", "c3"},
+      {"/api/v2users", "c6"},
+      {"/api/v3/regex", "c5"},
+      {"/Api/anything", "c6"},
+      {"/static/img/a.png", "c8"},
+      {"/other", "c11"},
+  };
+
+  for (const bool enabled : {false, true}) {
+    mergeValues({{"envoy.reloadable_features.compiled_route_index", enabled ? "true" : "false"}});
+    TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true,
+                          creation_status_);
+    for (const auto& [path, cluster] : requests) {
+      EXPECT_EQ(cluster, config.route(genHeaders("www.lyft.com", path, "GET"), 0)
+                             ->routeEntry()
+                             ->clusterName())
+          << path << " index enabled: " << enabled;
+    }
+
+    // Header matchers of indexed routes are still evaluated.
+    auto headers = genHeaders("www.lyft.com", "/api/v3", "GET");
+    headers.addCopy("x-version", "2");
+    EXPECT_EQ("c2", config.route(headers, 0)->routeEntry()->clusterName());
+
+    // The callback based lookup visits matching routes in configuration order.
+    std::vector<std::string> visited;
+    config.route(
+        [&visited](RouteConstSharedPtr route, RouteEvalStatus status) -> RouteMatchStatus {
+          visited.push_back(route->routeEntry()->clusterName());
+          EXPECT_EQ(route->routeEntry()->clusterName() == "c11",
+                    status == RouteEvalStatus::NoMoreRoutes);
+          return RouteMatchStatus::Continue;
+        },
+        genHeaders("www.lyft.com", "/static/img/index.html", "GET"));
+    EXPECT_THAT(visited, testing::ElementsAre("c8", "c9", "c11"));
+  }
+}
+
 TEST_F(RouteMatcherTest, PathSeparatedPrefixMatchRewrite) {
 
   const std::string yaml = R"EOF(
@@ -626,6 +626,88 @@ TEST_F(AllocatorImplTest, ForEachSinkedTextReadout) {
   EXPECT_EQ(num_iterations, 0);
 }
 
+TEST_F(AllocatorImplTest, ForEachChangedSinkedCounter) {
+  CounterSharedPtr c1 = alloc_.makeCounter(makeStat("counter.1"), StatName(), {});
+  CounterSharedPtr c2 = alloc_.makeCounter(makeStat("counter.2"), StatName(), {});
+  c1->inc();
+
+  std::vector<std::string> visited;
+  size_t size = 0;
+  auto visit = [this, &visited, &size]() {
+    visited.clear();
+    alloc_.forEachChangedSinkedCounter([&size](std::size_t s) { size = s; },
+                                       [&visited](Counter& counter) {
+                                         visited.push_back(counter.name());
+                                         counter.latch();
+                                       });
+  };
+
+  // The first call visits everything and starts tracking.
+  visit();
+  EXPECT_EQ(2, size);
+  EXPECT_THAT(visited, testing::UnorderedElementsAre("counter.1", "counter.2"));
+
+  visit();
+  EXPECT_EQ(0, size);
+  EXPECT_TRUE(visited.empty());
+
+  // Each counter is reported once per call however often it changed.
+  c2->inc();
+  c2->add(5);
+  visit();
+  EXPECT_EQ(1, size);
+  EXPECT_THAT(visited, testing::ElementsAre("counter.2"));
+
+  // A change after the flag was cleared is reported by the next call.
+  c2->inc();
+  visit();
+  EXPECT_THAT(visited, testing::ElementsAre("counter.2"));
+
+  // A counter that changed and was then destroyed is not reported.
+  c1->inc();
+  c1.reset();
+  visit();
+  EXPECT_TRUE(visited.empty());
+}
+
+TEST_F(AllocatorImplTest, ForEachChangedSinkedGauge) {
+  std::unique_ptr<TestUtil::TestSinkPredicates> moved_sink_predicates =
+      std::make_unique<TestUtil::TestSinkPredicates>();
+  TestUtil::TestSinkPredicates* sink_predicates = moved_sink_predicates.get();
+  alloc_.setSinkPredicates(std::move(moved_sink_predicates));
+
+  StatName sinked_name = makeStat("gauge.sinked");
+  sink_predicates->add(sinked_name);
+  GaugeSharedPtr sinked =
+      alloc_.makeGauge(sinked_name, StatName(), {}, Gauge::ImportMode::Accumulate);
+  GaugeSharedPtr unsinked =
+      alloc_.makeGauge(makeStat("gauge.unsinked"), StatName(), {}, Gauge::ImportMode::Accumulate);
+
+  std::vector<std::string> visited;
+  auto visit = [this, &visited]() {
+    visited.clear();
+    alloc_.forEachChangedSinkedGauge(nullptr,
+                                     [&visited](Gauge& gauge) { visited.push_back(gauge.name()); });
+  };
+
+  visit();
+  EXPECT_THAT(visited, testing::ElementsAre("gauge.sinked"));
+
+  // Changes to gauges that are not sinked are not reported.
+  unsinked->set(3);
+  visit();
+  EXPECT_TRUE(visited.empty());
+
+  // Decrements count as changes too.
+  sinked->set(2);
+  visit();
+  EXPECT_THAT(visited, testing::ElementsAre("gauge.sinked"));
+  sinked->dec();
+  visit();
+  EXPECT_THAT(visited, testing::ElementsAre("gauge.sinked"));
+  EXPECT_EQ(1, sinked->value());
+}
+
 } // namespace
 } // namespace Stats
 } // namespace Envoy
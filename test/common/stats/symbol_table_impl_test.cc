@@ -232,7 +232,6 @@ TEST_F(StatNameTest, TestSuccessfulDecode) {
 class StatNameDeathTest : public StatNameTest {
 public:
   void decodeSymbolVec(const SymbolVec& symbol_vec) {
-    Thread::LockGuard lock(table_.lock_);
     for (Symbol symbol : symbol_vec) {
       table_.fromSymbol(symbol);
     }
@@ -556,6 +555,34 @@ TEST_F(StatNameTest, RacingSymbolCreation) {
   }
 }
 
+// Threads encoding and freeing names made of shared and per-thread tokens must
+// leave every shard consistent: names decode correctly while in use, and all
+// symbols are released afterwards.
+TEST_F(StatNameTest, ConcurrentEncodeAndFree) {
+  Thread::ThreadFactory& thread_factory = Thread::threadFactoryForTest();
+  constexpr int num_threads = 16;
+  std::vector<Thread::ThreadPtr> threads;
+  threads.reserve(num_threads);
+  ConditionalInitializer start;
+  for (int i = 0; i < num_threads; ++i) {
+    threads.push_back(thread_factory.createThread([this, i, &start]() {
+      start.wait();
+      for (int count = 0; count < 200; ++count) {
+        const std::string name =
+            absl::StrCat("cluster.tenant_", i, ".route_", count % 10, ".upstream_rq");
+        StatNameStorage storage(name, table_);
+        EXPECT_EQ(name, table_.toString(storage.statName()));
+        storage.free(table_);
+      }
+    }));
+  }
+  start.setReady();
+  for (auto& thread : threads) {
+    thread->join();
+  }
+  EXPECT_EQ(0, table_.numSymbols());
+}
+
 TEST_F(StatNameTest, MutexContentionOnExistingSymbols) {
   Thread::ThreadFactory& thread_factory = Thread::threadFactoryForTest();
   MutexTracerImpl& mutex_tracer = MutexTracerImpl::getOrCreateTracer();
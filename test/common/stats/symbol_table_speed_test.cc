@@ -63,6 +63,40 @@ static void bmCreateRace(benchmark::State& state) {
 }
 BENCHMARK(bmCreateRace)->Unit(::benchmark::kMillisecond);
 
+// Measures encoding throughput when threads symbolize names for different
+// tenants, so most tokens are shared but each thread also inserts its own.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void bmEncodeTenantNames(benchmark::State& state) {
+  const int num_threads = state.range(0);
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    Envoy::Thread::ThreadFactory& thread_factory = Envoy::Thread::threadFactoryForTest();
+    std::vector<Envoy::Thread::ThreadPtr> threads;
+    threads.reserve(num_threads);
+    Envoy::ConditionalInitializer access;
+    Envoy::Stats::SymbolTableImpl table;
+
+    for (int i = 0; i < num_threads; ++i) {
+      threads.push_back(thread_factory.createThread([&access, &table, i]() {
+        access.wait();
+        for (int count = 0; count < 1000; ++count) {
+          // NOLINTNEXTLINE(clang-analyzer-unix.Malloc)
+          Envoy::Stats::StatNameStorage name(
+              absl::StrCat("http.ingress.tenant_", i, "_", count % 100, ".downstream_rq_2xx"),
+              table);
+          name.free(table);
+        }
+      }));
+    }
+
+    access.setReady();
+    for (auto& thread : threads) {
+      thread->join();
+    }
+  }
+}
+BENCHMARK(bmEncodeTenantNames)->Arg(1)->Arg(4)->Arg(16)->Unit(::benchmark::kMillisecond);
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void bmJoinStatNames(benchmark::State& state) {
   Envoy::Stats::SymbolTableImpl symbol_table;
@@ -108,6 +108,48 @@ void BM_ExtractTags(benchmark::State& state) {
 }
 BENCHMARK(BM_ExtractTags)->DenseRange(0, 26, 1);
 
+// Models the stat names created by a CDS push: every cluster gets the same set of
+// stats, so each name runs the cluster name extractor plus every extractor without
+// a prefix, most of which do not match.
+// NOLINTNEXTLINE(readability-identifier-naming)
+void BM_ExtractTagsCdsScale(benchmark::State& state) {
+  const Stats::TagVector tags;
+  auto tag_extractors =
+      TagProducerImpl::createTagProducer(envoy::config::metrics::v3::StatsConfig(), tags).value();
+  const std::vector<absl::string_view> suffixes = {
+      "upstream_cx_total",
+      "upstream_cx_active",
+      "upstream_rq_total",
+      "upstream_rq_2xx",
+      "upstream_rq_200",
+      "upstream_rq_503",
+      "upstream_rq_timeout",
+      "lb_healthy_panic",
+      "membership_healthy",
+      "outlier_detection.ejections_active",
+      "circuit_breakers.default.rq_open",
+      "ssl.ciphers.ECDHE-RSA-AES128-GCM-SHA256",
+      "ssl.versions.TLSv1.3",
+      "internal.upstream_rq_5xx",
+  };
+  std::vector<std::string> names;
+  for (int64_t cluster = 0; cluster < state.range(0); ++cluster) {
+    for (absl::string_view suffix : suffixes) {
+      names.push_back(absl::StrCat("cluster.service_", cluster, "_outbound.", suffix));
+    }
+  }
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    for (const std::string& name : names) {
+      TagVector tags;
+      benchmark::DoNotOptimize(tag_extractors->produceTags(name, tags));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+}
+BENCHMARK(BM_ExtractTagsCdsScale)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
 } // namespace
 } // namespace Stats
 } // namespace Envoy
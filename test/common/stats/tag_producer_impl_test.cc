@@ -131,6 +131,25 @@ TEST_F(TagProducerTest, DuplicateConfigCliTagBehavior) {
   }
 }
 
+// Validate that custom regexes without a prefix extract their tags whether or not RE2 accepts
+// them, and only for the names they match.
+TEST_F(TagProducerTest, CustomRegexWithoutPrefix) {
+  stats_config_.mutable_use_all_default_tags()->set_value(false);
+  addSpecifier("tenant", "\\.(tenant=(\\w+));");
+  // RE2 does not support lookaheads.
+  addSpecifier("shard", "\\.(shard=(\\d+)(?=;));");
+  auto producer = TagProducerImpl::createTagProducer(stats_config_, {}).value();
+
+  TagVector tags;
+  EXPECT_EQ("foo.;.;bar", producer->produceTags("foo.tenant=acme;.shard=12;bar", tags));
+  checkTags(TagVector{{"tenant", "acme"}, {"shard", "12"}}, tags);
+
+  tags.clear();
+  EXPECT_EQ("foo.tenant=;.shard=12.bar",
+            producer->produceTags("foo.tenant=;.shard=12.bar", tags));
+  EXPECT_TRUE(tags.empty());
+}
+
 TEST_F(TagProducerTest, Fixed) {
   const TagVector tag_config{{"my-tag", "fixed"}};
   auto producer(TagProducerImpl::createTagProducer(stats_config_, tag_config).value());
@@ -27,6 +27,7 @@
 #include "test/mocks/stats/mocks.h"
 #include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/logging.h"
+#include "test/test_common/thread_factory_for_test.h"
 #include "test/test_common/utility.h"
 
 #include "absl/strings/str_split.h"
@@ -1898,6 +1899,34 @@ TEST_F(OneWorkerThread, DeleteForEachRace) {
   wait_for_main();
 }
 
+// Validate that stats can be looked up and created on a thread that is not registered with
+// thread local storage, and that they are the same stats the registered threads get.
+TEST_F(OneWorkerThread, UnregisteredThread) {
+  Counter* counter = nullptr;
+  Gauge* gauge = nullptr;
+  TextReadout* text_readout = nullptr;
+  Histogram* histogram = nullptr;
+  Counter* new_counter = nullptr;
+  Thread::ThreadPtr thread = Thread::threadFactoryForTest().createThread([&]() {
+    counter = &scope_.counterFromString("counter");
+    gauge = &scope_.gaugeFromString("gauge", Gauge::ImportMode::Accumulate);
+    text_readout = &scope_.textReadoutFromString("text_readout");
+    histogram = &scope_.histogramFromString("histogram", Histogram::Unit::Unspecified);
+    new_counter = &scope_.counterFromString("new_counter");
+    new_counter->inc();
+  });
+  thread->join();
+
+  runOnAllWorkersBlocking([&]() {
+    EXPECT_EQ(counter, &scope_.counterFromString("counter"));
+    EXPECT_EQ(gauge, &scope_.gaugeFromString("gauge", Gauge::ImportMode::Accumulate));
+    EXPECT_EQ(text_readout, &scope_.textReadoutFromString("text_readout"));
+    EXPECT_EQ(histogram, &scope_.histogramFromString("histogram", Histogram::Unit::Unspecified));
+    EXPECT_EQ(1, scope_.counterFromString("new_counter").value());
+  });
+  EXPECT_EQ(new_counter, TestUtility::findCounter(*store_, "new_counter").get());
+}
+
 class ClusterShutdownCleanupStarvationTest : public ThreadLocalRealThreadsMixin,
                                              public testing::Test {
 protected:
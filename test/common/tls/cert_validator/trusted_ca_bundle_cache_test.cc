@@ -0,0 +1,91 @@
+#include <string>
+#include <vector>
+
+#include "envoy/config/core/v3/base.pb.h"
+#include "envoy/extensions/transport_sockets/tls/v3/tls.pb.h"
+
+#include "source/common/common/helper_thread_pool.h"
+#include "source/common/tls/cert_validator/trusted_ca_bundle_cache.h"
+
+#include "test/test_common/environment.h"
+#include "test/test_common/thread_factory_for_test.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace {
+
+std::string readTestData(const std::string& file) {
+  return TestEnvironment::readFileToStringForTest(
+      TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/" + file));
+}
+
+envoy::config::core::v3::TransportSocket tlsTransportSocket(const std::string& trusted_ca) {
+  envoy::extensions::transport_sockets::tls::v3::UpstreamTlsContext tls_context;
+  tls_context.mutable_common_tls_context()
+      ->mutable_validation_context()
+      ->mutable_trusted_ca()
+      ->set_inline_string(trusted_ca);
+  envoy::config::core::v3::TransportSocket transport_socket;
+  transport_socket.set_name("envoy.transport_sockets.tls");
+  transport_socket.mutable_typed_config()->PackFrom(tls_context);
+  return transport_socket;
+}
+
+// Validate that a bundle is parsed once while it is held, and parsed again once released.
+TEST(TrustedCaBundleCacheTest, GetOrParseShared) {
+  TrustedCaBundleCache cache;
+  const std::string pem = readTestData("ca_cert.pem");
+  TrustedCaBundleSharedPtr bundle = cache.getOrParse(pem);
+  ASSERT_NE(nullptr, bundle);
+  EXPECT_EQ(1, sk_X509_INFO_num(bundle.get()));
+  EXPECT_EQ(bundle, cache.getOrParse(pem));
+
+  X509* cert = sk_X509_INFO_value(bundle.get(), 0)->x509;
+  X509_up_ref(cert);
+  bssl::UniquePtr<X509> first_cert(cert);
+  bundle.reset();
+  bundle = cache.getOrParse(pem);
+  ASSERT_NE(nullptr, bundle);
+  EXPECT_NE(first_cert.get(), sk_X509_INFO_value(bundle.get(), 0)->x509);
+
+  EXPECT_EQ(nullptr, cache.getOrParse("not a certificate"));
+}
+
+// Validate that preparing parses each distinct bundle once, in the order of the sockets, and skips
+// the sockets without a bundle.
+TEST(TrustedCaBundleCacheTest, Prepare) {
+  TrustedCaBundleCache cache;
+  Api::ApiPtr api = Api::createApiForTest();
+  Thread::HelperThreadPool pool(Thread::threadFactoryForTest(), 2, "test");
+  const std::string ca_cert = readTestData("ca_cert.pem");
+  const std::string fake_ca_cert = readTestData("fake_ca_cert.pem");
+
+  envoy::config::core::v3::TransportSocket raw_buffer;
+  raw_buffer.set_name("envoy.transport_sockets.raw_buffer");
+  const std::vector<envoy::config::core::v3::TransportSocket> configs{
+      tlsTransportSocket(fake_ca_cert), raw_buffer, tlsTransportSocket(ca_cert),
+      tlsTransportSocket(fake_ca_cert), tlsTransportSocket("not a certificate")};
+  std::vector<const envoy::config::core::v3::TransportSocket*> transport_sockets;
+  for (const auto& config : configs) {
+    transport_sockets.push_back(&config);
+  }
+
+  std::vector<TrustedCaBundleSharedPtr> bundles = cache.prepare(transport_sockets, *api, pool);
+  ASSERT_EQ(2, bundles.size());
+  EXPECT_EQ(bundles[0], cache.getOrParse(fake_ca_cert));
+  EXPECT_EQ(bundles[1], cache.getOrParse(ca_cert));
+
+  // Bundles that are still held are not parsed again.
+  EXPECT_EQ(bundles, cache.prepare(transport_sockets, *api, pool));
+}
+
+} // namespace
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
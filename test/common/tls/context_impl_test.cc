@@ -10,6 +10,7 @@
 #include "source/common/json/json_loader.h"
 #include "source/common/secret/sds_api.h"
 #include "source/common/stats/isolated_store_impl.h"
+#include "source/common/tls/cert_validator/trusted_ca_bundle_cache.h"
 #include "source/common/tls/context_config_impl.h"
 #include "source/common/tls/context_impl.h"
 #include "source/common/tls/server_context_config_impl.h"
@@ -234,6 +235,38 @@ TEST_F(SslContextImplTest, TestExpiredCert) {
   EXPECT_EQ(absl::nullopt, context->daysUntilFirstCertExpires());
 }
 
+// Validate that the trusted CA bundles parsed by preparing client contexts are cached for as long
+// as the prepared handle is held.
+TEST_F(SslContextImplTest, PrepareClientContexts) {
+  const std::string ca_cert = TestEnvironment::readFileToStringForTest(
+      TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/ca_cert.pem"));
+  envoy::extensions::transport_sockets::tls::v3::UpstreamTlsContext tls_context;
+  tls_context.mutable_common_tls_context()
+      ->mutable_validation_context()
+      ->mutable_trusted_ca()
+      ->set_inline_string(ca_cert);
+  envoy::config::core::v3::TransportSocket transport_socket;
+  transport_socket.set_name("envoy.transport_sockets.tls");
+  transport_socket.mutable_typed_config()->PackFrom(tls_context);
+
+  Envoy::Ssl::PreparedClientContextsPtr prepared =
+      manager_.prepareClientContexts({&transport_socket});
+  ASSERT_NE(nullptr, prepared);
+  TrustedCaBundleSharedPtr bundle =
+      TrustedCaBundleCache::get(server_factory_context_.singletonManager())->getOrParse(ca_cert);
+  ASSERT_NE(nullptr, bundle);
+  EXPECT_EQ(2, bundle.use_count());
+
+  auto cfg = *ClientContextConfigImpl::create(tls_context, factory_context_);
+  Envoy::Ssl::ClientContextSharedPtr context(
+      *manager_.createSslClientContext(*store_.rootScope(), *cfg));
+  auto cleanup = cleanUpHelper(context);
+  EXPECT_EQ(3, bundle.use_count());
+
+  prepared.reset();
+  EXPECT_EQ(2, bundle.use_count());
+}
+
 // Validate that when the context is updated, the daysUntilFirstCertExpires returns the current
 // context value.
 TEST_F(SslContextImplTest, TestContextUpdate) {
@@ -45,6 +45,13 @@ TEST_F(IoHandleBioTest, TestMiscApis) {
   EXPECT_EQ(ret, 1);
 }
 
+TEST(DiscardBioTest, DiscardsWrites) {
+  bssl::UniquePtr<BIO> bio(BIO_new_discard());
+  ASSERT_NE(nullptr, bio);
+  EXPECT_EQ(5, BIO_write(bio.get(), "hello", 5));
+  EXPECT_EQ(1, BIO_flush(bio.get()));
+}
+
 } // namespace Tls
 } // namespace TransportSockets
 } // namespace Extensions
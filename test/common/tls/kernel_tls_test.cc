@@ -0,0 +1,195 @@
+#include <cstring>
+#include <string>
+
+#include "source/common/tls/kernel_tls.h"
+
+#include "test/mocks/api/mocks.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "openssl/aead.h"
+#include "openssl/ssl.h"
+
+#if defined(__linux__)
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+#endif
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace {
+
+#if defined(__linux__)
+
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+
+using testing::_;
+using testing::Invoke;
+using testing::Return;
+
+constexpr os_fd_t Fd = 42;
+
+class KernelTlsTest : public testing::Test {
+protected:
+  KernelTlsTest()
+      : client_ctx_(SSL_CTX_new(TLS_method())), server_ctx_(SSL_CTX_new(TLS_method())) {
+    const std::string cert = TestEnvironment::substitute(
+        "{{ test_rundir }}/test/common/tls/test_data/unittest_cert.pem");
+    const std::string key = TestEnvironment::substitute(
+        "{{ test_rundir }}/test/common/tls/test_data/unittest_key.pem");
+    EXPECT_EQ(1, SSL_CTX_use_certificate_chain_file(server_ctx_.get(), cert.c_str()));
+    EXPECT_EQ(1, SSL_CTX_use_PrivateKey_file(server_ctx_.get(), key.c_str(), SSL_FILETYPE_PEM));
+  }
+
+  // Runs an in-memory handshake between a client and the server.
+  void handshake(uint16_t version, const char* cipher) {
+    SSL_CTX_set_min_proto_version(client_ctx_.get(), version);
+    SSL_CTX_set_max_proto_version(client_ctx_.get(), version);
+    if (cipher != nullptr) {
+      ASSERT_EQ(1, SSL_CTX_set_strict_cipher_list(client_ctx_.get(), cipher));
+    }
+    client_.reset(SSL_new(client_ctx_.get()));
+    server_.reset(SSL_new(server_ctx_.get()));
+    SSL_set_connect_state(client_.get());
+    SSL_set_accept_state(server_.get());
+
+    BIO* client_bio;
+    BIO* server_bio;
+    ASSERT_EQ(1, BIO_new_bio_pair(&client_bio, 0, &server_bio, 0));
+    SSL_set_bio(client_.get(), client_bio, client_bio);
+    SSL_set_bio(server_.get(), server_bio, server_bio);
+
+    bool client_done = false;
+    bool server_done = false;
+    for (int i = 0; i < 10 && !(client_done && server_done); ++i) {
+      client_done = SSL_do_handshake(client_.get()) == 1;
+      server_done = SSL_do_handshake(server_.get()) == 1;
+    }
+    ASSERT_TRUE(client_done && server_done);
+  }
+
+  // Seals `plaintext` into a TLS 1.2 application data record using the parameters the kernel
+  // was given, as the kernel would, and checks that the client decrypts it.
+  void expectClientDecrypts(const tls12_crypto_info_aes_gcm_128& info,
+                            const std::string& plaintext) {
+    bssl::ScopedEVP_AEAD_CTX aead;
+    ASSERT_EQ(1, EVP_AEAD_CTX_init(aead.get(), EVP_aead_aes_128_gcm(), info.key, sizeof(info.key),
+                                   EVP_AEAD_DEFAULT_TAG_LENGTH, nullptr));
+    uint8_t nonce[sizeof(info.salt) + sizeof(info.iv)];
+    memcpy(nonce, info.salt, sizeof(info.salt));
+    memcpy(nonce + sizeof(info.salt), info.iv, sizeof(info.iv));
+    // The additional data is the record sequence number, type, version and plaintext length.
+    uint8_t additional_data[sizeof(info.rec_seq) + 5];
+    memcpy(additional_data, info.rec_seq, sizeof(info.rec_seq));
+    const uint8_t header[] = {23, 3, 3, 0, static_cast<uint8_t>(plaintext.size())};
+    memcpy(additional_data + sizeof(info.rec_seq), header, sizeof(header));
+
+    std::string record(5 + sizeof(info.iv) + plaintext.size() + 16, '\0');
+    uint8_t* out = reinterpret_cast<uint8_t*>(record.data());
+    const size_t body_len = record.size() - 5;
+    out[0] = 23;
+    out[1] = 3;
+    out[2] = 3;
+    out[3] = static_cast<uint8_t>(body_len >> 8);
+    out[4] = static_cast<uint8_t>(body_len);
+    memcpy(out + 5, info.iv, sizeof(info.iv));
+    size_t sealed_len;
+    ASSERT_EQ(1, EVP_AEAD_CTX_seal(aead.get(), out + 5 + sizeof(info.iv), &sealed_len,
+                                   plaintext.size() + 16, nonce, sizeof(nonce),
+                                   reinterpret_cast<const uint8_t*>(plaintext.data()),
+                                   plaintext.size(), additional_data, sizeof(additional_data)));
+
+    // Deliver the record to the client as if it came from the server's socket.
+    BIO* server_bio = SSL_get_wbio(server_.get());
+    ASSERT_EQ(static_cast<int>(record.size()), BIO_write(server_bio, record.data(), record.size()));
+    char received[64];
+    ASSERT_EQ(static_cast<int>(plaintext.size()),
+              SSL_read(client_.get(), received, sizeof(received)));
+    EXPECT_EQ(plaintext, std::string(received, plaintext.size()));
+  }
+
+  Api::MockOsSysCalls os_sys_calls_;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls_{&os_sys_calls_};
+  bssl::UniquePtr<SSL_CTX> client_ctx_;
+  bssl::UniquePtr<SSL_CTX> server_ctx_;
+  bssl::UniquePtr<SSL> client_;
+  bssl::UniquePtr<SSL> server_;
+};
+
+TEST_F(KernelTlsTest, InstallsTls12AesGcmWriteKeys) {
+  handshake(TLS1_2_VERSION, "ECDHE-RSA-AES128-GCM-SHA256");
+
+  tls12_crypto_info_aes_gcm_128 info{};
+  EXPECT_CALL(os_sys_calls_, setsockopt_(Fd, IPPROTO_TCP, TCP_ULP, _, 3))
+      .WillOnce(Invoke([](os_fd_t, int, int, const void* optval, socklen_t) {
+        EXPECT_EQ(0, memcmp("tls", optval, 3));
+        return 0;
+      }));
+  EXPECT_CALL(os_sys_calls_, setsockopt_(Fd, SOL_TLS, TLS_TX, _, sizeof(info)))
+      .WillOnce(Invoke([&info](os_fd_t, int, int, const void* optval, socklen_t) {
+        memcpy(&info, optval, sizeof(info));
+        return 0;
+      }));
+  EXPECT_TRUE(KernelTls::enableTx(server_.get(), Fd).ok());
+
+  EXPECT_EQ(TLS_1_2_VERSION, info.info.version);
+  EXPECT_EQ(TLS_CIPHER_AES_GCM_128, info.info.cipher_type);
+  const uint64_t sequence = htobe64(SSL_get_write_sequence(server_.get()));
+  EXPECT_EQ(0, memcmp(&sequence, info.rec_seq, sizeof(info.rec_seq)));
+  expectClientDecrypts(info, "hello from the kernel");
+}
+
+TEST_F(KernelTlsTest, Tls13IsNotOffloaded) {
+  handshake(TLS1_3_VERSION, nullptr);
+
+  EXPECT_CALL(os_sys_calls_, setsockopt_(_, _, _, _, _)).Times(0);
+  EXPECT_TRUE(absl::IsUnimplemented(KernelTls::enableTx(server_.get(), Fd)));
+}
+
+TEST_F(KernelTlsTest, UnsupportedCipherIsNotOffloaded) {
+  handshake(TLS1_2_VERSION, "ECDHE-RSA-AES128-SHA");
+
+  EXPECT_CALL(os_sys_calls_, setsockopt_(_, _, _, _, _)).Times(0);
+  EXPECT_TRUE(absl::IsUnimplemented(KernelTls::enableTx(server_.get(), Fd)));
+}
+
+TEST_F(KernelTlsTest, MissingKernelSupport) {
+  handshake(TLS1_2_VERSION, "ECDHE-RSA-CHACHA20-POLY1305");
+
+  EXPECT_CALL(os_sys_calls_, setsockopt_(Fd, IPPROTO_TCP, TCP_ULP, _, 3)).WillOnce(Return(-1));
+  EXPECT_TRUE(absl::IsUnavailable(KernelTls::enableTx(server_.get(), Fd)));
+}
+
+TEST_F(KernelTlsTest, SendCloseNotify) {
+  EXPECT_CALL(os_sys_calls_, sendmsg(Fd, _, 0))
+      .WillOnce(Invoke([](os_fd_t, const msghdr* message, int) {
+        const cmsghdr* cmsg = CMSG_FIRSTHDR(message);
+        EXPECT_EQ(SOL_TLS, cmsg->cmsg_level);
+        EXPECT_EQ(TLS_SET_RECORD_TYPE, cmsg->cmsg_type);
+        // Alert record carrying a warning level close_notify.
+        EXPECT_EQ(21, *CMSG_DATA(cmsg));
+        EXPECT_EQ(2, message->msg_iov[0].iov_len);
+        const uint8_t* alert = static_cast<const uint8_t*>(message->msg_iov[0].iov_base);
+        EXPECT_EQ(1, alert[0]);
+        EXPECT_EQ(0, alert[1]);
+        return Api::SysCallSizeResult{2, 0};
+      }));
+  EXPECT_EQ(2, KernelTls::sendCloseNotify(Fd).return_value_);
+}
+
+#endif
+
+} // namespace
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
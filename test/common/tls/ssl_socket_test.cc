@@ -12,6 +12,7 @@
 #include "source/common/event/dispatcher_impl.h"
 #include "source/common/json/json_loader.h"
 #include "source/common/network/address_impl.h"
+#include "source/common/network/io_socket_error_impl.h"
 #include "source/common/network/listen_socket_impl.h"
 #include "source/common/network/tcp_listener_impl.h"
 #include "source/common/network/transport_socket_options_impl.h"
@@ -20,6 +21,7 @@
 #include "source/common/tls/client_ssl_socket.h"
 #include "source/common/tls/context_config_impl.h"
 #include "source/common/tls/context_impl.h"
+#include "source/common/tls/kernel_tls.h"
 #include "source/common/tls/private_key/private_key_manager_impl.h"
 #include "source/common/tls/server_context_config_impl.h"
 #include "source/common/tls/server_ssl_socket.h"
@@ -43,6 +45,7 @@
 #include "test/common/tls/test_data/san_uri_cert_info.h"
 #include "test/common/tls/test_data/selfsigned_ecdsa_p256_cert_info.h"
 #include "test/common/tls/test_private_key_method_provider.h"
+#include "test/mocks/api/mocks.h"
 #include "test/mocks/buffer/mocks.h"
 #include "test/mocks/init/mocks.h"
 #include "test/mocks/local_info/mocks.h"
@@ -58,6 +61,7 @@
 #include "test/test_common/network_utility.h"
 #include "test/test_common/registry.h"
 #include "test/test_common/test_runtime.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
 #include "test/test_common/utility.h"
 
 #include "absl/strings/str_replace.h"
@@ -66,6 +70,11 @@
 #include "gtest/gtest.h"
 #include "openssl/ssl.h"
 
+#if defined(__linux__)
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+#endif
+
 using testing::_;
 using testing::ContainsRegex;
 using testing::DoAll;
@@ -6477,6 +6486,233 @@ TEST_P(SslSocketTest, TestTransportSocketCallback) {
   EXPECT_EQ(ssl_socket->transportSocketCallbacks(), &callbacks);
 }
 
+#if defined(__linux__)
+
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+
+// Runs a client SslSocket through a TLS 1.2 handshake with an in-memory server, with the kernel TLS
+// socket options and sends mocked out, to exercise the kernel TLS transmit path of the socket.
+class SslSocketKernelTlsTest : public SslCertsTest {
+protected:
+  static constexpr os_fd_t Fd = 42;
+
+  SslSocketKernelTlsTest() : server_ctx_(SSL_CTX_new(TLS_method())) {
+    scoped_runtime_.mergeValues({{"envoy.reloadable_features.tls_kernel_tx_offload", "true"}});
+    ON_CALL(factory_context_.server_context_, localInfo()).WillByDefault(ReturnRef(local_info_));
+    ON_CALL(callbacks_, ioHandle()).WillByDefault(ReturnRef(io_handle_));
+    ON_CALL(callbacks_, raiseEvent(Network::ConnectionEvent::Connected))
+        .WillByDefault(Invoke([this](Network::ConnectionEvent) { connected_ = true; }));
+    ON_CALL(io_handle_, fdDoNotUse()).WillByDefault(Return(Fd));
+
+    // Records written by BoringSSL go to the server, and the server's records are read back.
+    BIO* server_bio;
+    EXPECT_EQ(1, BIO_new_bio_pair(&client_bio_, 0, &server_bio, 0));
+    ON_CALL(io_handle_, writev(_, _))
+        .WillByDefault(Invoke([this](const Buffer::RawSlice* slices, uint64_t num_slices) {
+          uint64_t written = 0;
+          for (uint64_t i = 0; i < num_slices; ++i) {
+            EXPECT_EQ(static_cast<int>(slices[i].len_),
+                      BIO_write(client_bio_, slices[i].mem_, slices[i].len_));
+            written += slices[i].len_;
+          }
+          return Api::IoCallUint64Result(written, Api::IoError::none());
+        }));
+    ON_CALL(io_handle_, readv(_, _, _))
+        .WillByDefault(Invoke([this](uint64_t, Buffer::RawSlice* slices, uint64_t) {
+          const int rc = BIO_read(client_bio_, slices[0].mem_, slices[0].len_);
+          if (rc <= 0) {
+            return Api::IoCallUint64Result(0, Network::IoSocketError::getIoSocketEagainError());
+          }
+          return Api::IoCallUint64Result(rc, Api::IoError::none());
+        }));
+
+    const std::string cert = TestEnvironment::substitute(
+        "{{ test_rundir }}/test/common/tls/test_data/unittest_cert.pem");
+    const std::string key = TestEnvironment::substitute(
+        "{{ test_rundir }}/test/common/tls/test_data/unittest_key.pem");
+    EXPECT_EQ(1, SSL_CTX_use_certificate_chain_file(server_ctx_.get(), cert.c_str()));
+    EXPECT_EQ(1, SSL_CTX_use_PrivateKey_file(server_ctx_.get(), key.c_str(), SSL_FILETYPE_PEM));
+    server_.reset(SSL_new(server_ctx_.get()));
+    SSL_set_accept_state(server_.get());
+    SSL_set_bio(server_.get(), server_bio, server_bio);
+  }
+
+  ~SslSocketKernelTlsTest() override { BIO_free(client_bio_); }
+
+  void handshake() {
+    const std::string client_ctx_yaml = R"EOF(
+  common_tls_context:
+    tls_params:
+      tls_maximum_protocol_version: TLSv1_2
+      cipher_suites:
+      - ECDHE-RSA-AES128-GCM-SHA256
+)EOF";
+    envoy::extensions::transport_sockets::tls::v3::UpstreamTlsContext tls_context;
+    TestUtility::loadFromYaml(client_ctx_yaml, tls_context);
+    auto client_cfg = *ClientContextConfigImpl::create(tls_context, factory_context_);
+    socket_factory_ =
+        *ClientSslSocketFactory::create(std::move(client_cfg), manager_, *store_.rootScope());
+    socket_ = socket_factory_->createTransportSocket(nullptr, nullptr);
+    socket_->setTransportSocketCallbacks(callbacks_);
+
+    Buffer::OwnedImpl empty;
+    for (int i = 0; i < 10 && !connected_; ++i) {
+      EXPECT_EQ(Network::PostIoAction::KeepOpen, socket_->doWrite(empty, false).action_);
+      SSL_do_handshake(server_.get());
+    }
+    ASSERT_TRUE(connected_);
+  }
+
+  uint64_t counter(const std::string& name) {
+    return store_.counterFromString("ssl." + name).value();
+  }
+
+  // Accepts up to `bytes` of the plaintext written to the socket.
+  static Api::IoCallUint64Result acceptWrite(Buffer::Instance& buffer, uint64_t bytes) {
+    bytes = std::min(bytes, buffer.length());
+    buffer.drain(bytes);
+    return Api::IoCallUint64Result(bytes, Api::IoError::none());
+  }
+
+  NiceMock<Api::MockOsSysCalls> os_sys_calls_;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls_{&os_sys_calls_};
+  TestScopedRuntime scoped_runtime_;
+  NiceMock<LocalInfo::MockLocalInfo> local_info_;
+  NiceMock<Network::MockIoHandle> io_handle_;
+  NiceMock<Network::MockTransportSocketCallbacks> callbacks_;
+  ContextManagerImpl manager_{factory_context_.serverFactoryContext()};
+  Network::UpstreamTransportSocketFactoryPtr socket_factory_;
+  Network::TransportSocketPtr socket_;
+  bssl::UniquePtr<SSL_CTX> server_ctx_;
+  bssl::UniquePtr<SSL> server_;
+  BIO* client_bio_{};
+  bool connected_{};
+};
+
+TEST_F(SslSocketKernelTlsTest, EnableKernelTlsTx) {
+  EXPECT_CALL(os_sys_calls_, setsockopt_(Fd, IPPROTO_TCP, TCP_ULP, _, 3));
+  EXPECT_CALL(os_sys_calls_, setsockopt_(Fd, SOL_TLS, TLS_TX, _, _));
+  handshake();
+  EXPECT_EQ(1, counter("kernel_tls_tx"));
+  EXPECT_EQ(0, counter("kernel_tls_tx_failed"));
+
+  // Sent data is written to the socket in the clear, for the kernel to encrypt.
+  Buffer::OwnedImpl data("hello");
+  EXPECT_CALL(io_handle_, writev(_, _)).Times(0);
+  EXPECT_CALL(io_handle_, write(_)).WillOnce(Invoke([](Buffer::Instance& buffer) {
+    EXPECT_EQ("hello", buffer.toString());
+    return acceptWrite(buffer, buffer.length());
+  }));
+  Network::IoResult result = socket_->doWrite(data, false);
+  EXPECT_EQ(Network::PostIoAction::KeepOpen, result.action_);
+  EXPECT_EQ(5, result.bytes_processed_);
+  EXPECT_EQ(0, data.length());
+}
+
+TEST_F(SslSocketKernelTlsTest, KernelTlsUnavailable) {
+  EXPECT_CALL(os_sys_calls_, setsockopt_(Fd, IPPROTO_TCP, TCP_ULP, _, 3)).WillOnce(Return(-1));
+  handshake();
+  EXPECT_EQ(0, counter("kernel_tls_tx"));
+  EXPECT_EQ(1, counter("kernel_tls_tx_failed"));
+
+  // BoringSSL keeps encrypting sent data.
+  Buffer::OwnedImpl data("hello");
+  EXPECT_CALL(io_handle_, write(_)).Times(0);
+  Network::IoResult result = socket_->doWrite(data, false);
+  EXPECT_EQ(Network::PostIoAction::KeepOpen, result.action_);
+  EXPECT_EQ(5, result.bytes_processed_);
+  char received[5];
+  ASSERT_EQ(5, SSL_read(server_.get(), received, sizeof(received)));
+  EXPECT_EQ("hello", std::string(received, sizeof(received)));
+}
+
+TEST_F(SslSocketKernelTlsTest, KernelTlsWritePartialAndAgain) {
+  handshake();
+  ASSERT_EQ(1, counter("kernel_tls_tx"));
+
+  Buffer::OwnedImpl data("0123456789");
+  EXPECT_CALL(io_handle_, write(_))
+      .WillOnce(Invoke([](Buffer::Instance& buffer) { return acceptWrite(buffer, 4); }))
+      .WillOnce(Invoke([](Buffer::Instance&) {
+        return Api::IoCallUint64Result(0, Network::IoSocketError::getIoSocketEagainError());
+      }));
+  Network::IoResult result = socket_->doWrite(data, false);
+  EXPECT_EQ(Network::PostIoAction::KeepOpen, result.action_);
+  EXPECT_EQ(4, result.bytes_processed_);
+  EXPECT_EQ("456789", data.toString());
+
+  EXPECT_CALL(io_handle_, write(_)).WillOnce(Invoke([](Buffer::Instance& buffer) {
+    return acceptWrite(buffer, buffer.length());
+  }));
+  result = socket_->doWrite(data, false);
+  EXPECT_EQ(Network::PostIoAction::KeepOpen, result.action_);
+  EXPECT_EQ(6, result.bytes_processed_);
+  EXPECT_EQ(0, data.length());
+}
+
+TEST_F(SslSocketKernelTlsTest, KernelTlsWriteError) {
+  handshake();
+
+  Buffer::OwnedImpl data("hello");
+  EXPECT_CALL(io_handle_, write(_)).WillOnce(Invoke([](Buffer::Instance&) {
+    return Api::IoCallUint64Result(0, Network::IoSocketError::create(ECONNRESET));
+  }));
+  EXPECT_EQ(Network::PostIoAction::Close, socket_->doWrite(data, false).action_);
+}
+
+TEST_F(SslSocketKernelTlsTest, ShutdownKernelTlsRetriesWholeCloseNotify) {
+  handshake();
+
+  Buffer::OwnedImpl empty;
+  {
+    InSequence s;
+    EXPECT_CALL(os_sys_calls_, sendmsg(Fd, _, 0))
+        .WillOnce(Return(Api::SysCallSizeResult{-1, SOCKET_ERROR_AGAIN}));
+    EXPECT_CALL(os_sys_calls_, sendmsg(Fd, _, 0))
+        .WillOnce(Invoke([](os_fd_t, const msghdr* message, int) {
+          // The retry carries the whole alert again.
+          EXPECT_EQ(KernelTls::CloseNotifySize, message->msg_iov[0].iov_len);
+          return Api::SysCallSizeResult{2, 0};
+        }));
+  }
+  EXPECT_EQ(Network::PostIoAction::KeepOpen, socket_->doWrite(empty, true).action_);
+  EXPECT_EQ(Network::PostIoAction::KeepOpen, socket_->doWrite(empty, true).action_);
+  // The alert has been sent, so closing the socket does not send it again.
+  socket_->closeSocket(Network::ConnectionEvent::LocalClose);
+  EXPECT_EQ(0, counter("kernel_tls_close_notify_failed"));
+}
+
+TEST_F(SslSocketKernelTlsTest, ShutdownKernelTlsShortWrite) {
+  handshake();
+
+  Buffer::OwnedImpl empty;
+  EXPECT_CALL(os_sys_calls_, sendmsg(Fd, _, 0)).WillOnce(Return(Api::SysCallSizeResult{1, 0}));
+  EXPECT_EQ(Network::PostIoAction::KeepOpen, socket_->doWrite(empty, true).action_);
+  // The rest of the alert is not sent as a record of its own.
+  socket_->closeSocket(Network::ConnectionEvent::LocalClose);
+  EXPECT_EQ(1, counter("kernel_tls_close_notify_failed"));
+}
+
+TEST_F(SslSocketKernelTlsTest, ShutdownKernelTlsPendingAtClose) {
+  handshake();
+
+  Buffer::OwnedImpl empty;
+  EXPECT_CALL(os_sys_calls_, sendmsg(Fd, _, 0))
+      .Times(2)
+      .WillRepeatedly(Return(Api::SysCallSizeResult{-1, SOCKET_ERROR_AGAIN}));
+  EXPECT_EQ(Network::PostIoAction::KeepOpen, socket_->doWrite(empty, true).action_);
+  EXPECT_EQ(0, counter("kernel_tls_close_notify_failed"));
+  socket_->closeSocket(Network::ConnectionEvent::LocalClose);
+  EXPECT_EQ(1, counter("kernel_tls_close_notify_failed"));
+}
+
+#endif
+
 class SslReadBufferLimitTest : public SslSocketTest {
 protected:
   void initialize() {
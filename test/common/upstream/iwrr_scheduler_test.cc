@@ -0,0 +1,171 @@
+#include "source/common/upstream/iwrr_scheduler.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+TEST(IwrrSchedulerTest, Empty) {
+  IwrrScheduler<uint32_t> sched;
+  EXPECT_TRUE(sched.empty());
+  EXPECT_EQ(nullptr, sched.peekAgain([](const double&) { return 1; }));
+  EXPECT_EQ(nullptr, sched.pickAndAdd([](const double&) { return 1; }));
+}
+
+// Validate we get regular RR behavior when all weights are the same.
+TEST(IwrrSchedulerTest, Unweighted) {
+  IwrrScheduler<uint32_t> sched;
+  constexpr uint32_t num_entries = 128;
+  std::shared_ptr<uint32_t> entries[num_entries];
+
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    entries[i] = std::make_shared<uint32_t>(i);
+    sched.add(1, entries[i]);
+  }
+
+  for (uint32_t rounds = 0; rounds < 16; ++rounds) {
+    for (uint32_t i = 0; i < num_entries; ++i) {
+      auto peek = sched.peekAgain([](const double&) { return 1; });
+      auto p = sched.pickAndAdd([](const double&) { return 1; });
+      EXPECT_EQ(i, *p);
+      EXPECT_EQ(*peek, *p);
+    }
+  }
+}
+
+// Validate that each cycle picks entries in proportion to their weights.
+TEST(IwrrSchedulerTest, Weighted) {
+  IwrrScheduler<uint32_t> sched;
+  constexpr uint32_t num_entries = 4;
+  std::shared_ptr<uint32_t> entries[num_entries];
+  uint32_t pick_count[num_entries] = {};
+
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    entries[i] = std::make_shared<uint32_t>(i);
+    sched.add(i + 1, entries[i]);
+  }
+
+  // Levels are 64, 128, 192 and 256 for a cycle of 640 picks.
+  for (uint32_t i = 0; i < 640; ++i) {
+    auto p = sched.pickAndAdd([](const double& w) { return w + 1; });
+    ++pick_count[*p];
+  }
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    EXPECT_EQ(64 * (i + 1), pick_count[i]);
+  }
+}
+
+// Validate that picks of entries with different weights are interleaved instead of coming in
+// bursts.
+TEST(IwrrSchedulerTest, Interleaved) {
+  IwrrScheduler<uint32_t> sched;
+  auto light = std::make_shared<uint32_t>(0);
+  auto heavy = std::make_shared<uint32_t>(1);
+  sched.add(1, light);
+  sched.add(2, heavy);
+
+  uint32_t heavy_in_a_row = 0;
+  for (uint32_t i = 0; i < 384; ++i) {
+    auto p = sched.pickAndAdd([](const double& w) { return w + 1; });
+    heavy_in_a_row = *p == 1 ? heavy_in_a_row + 1 : 0;
+    EXPECT_LE(heavy_in_a_row, 2);
+  }
+}
+
+// Validate that weights returned on picks are applied.
+TEST(IwrrSchedulerTest, WeightChange) {
+  IwrrScheduler<uint32_t> sched;
+  constexpr uint32_t num_entries = 4;
+  std::shared_ptr<uint32_t> entries[num_entries];
+  uint32_t pick_count[num_entries] = {};
+
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    entries[i] = std::make_shared<uint32_t>(i);
+    sched.add(1, entries[i]);
+  }
+
+  // The first entry becomes twice as heavy as the others when it is picked. This changes a quarter
+  // of the weights, so the schedule is rebuilt right away. Skip the rest of the cycle.
+  const auto weight = [](const uint32_t& i) { return i == 0 ? 2 : 1; };
+  for (uint32_t i = 0; i < 640; ++i) {
+    sched.pickAndAdd(weight);
+  }
+  // Levels are now 256 and 128.
+  for (uint32_t i = 0; i < 640; ++i) {
+    auto p = sched.pickAndAdd(weight);
+    ++pick_count[*p];
+  }
+  EXPECT_EQ(256, pick_count[0]);
+  for (uint32_t i = 1; i < num_entries; ++i) {
+    EXPECT_EQ(128, pick_count[i]);
+  }
+}
+
+// Validate that weights far below the largest weight are still picked.
+TEST(IwrrSchedulerTest, SmallWeightRoundedUp) {
+  IwrrScheduler<uint32_t> sched;
+  auto light = std::make_shared<uint32_t>(0);
+  auto heavy = std::make_shared<uint32_t>(1);
+  sched.add(1, light);
+  sched.add(10000, heavy);
+
+  uint32_t light_picks = 0;
+  for (uint32_t i = 0; i < 257; ++i) {
+    auto p = sched.pickAndAdd([](const uint32_t& i) { return i == 0 ? 1 : 10000; });
+    light_picks += *p == 0;
+  }
+  EXPECT_EQ(1, light_picks);
+}
+
+// Validate that expired entries are skipped.
+TEST(IwrrSchedulerTest, Expired) {
+  IwrrScheduler<uint32_t> sched;
+  auto second_entry = std::make_shared<uint32_t>(42);
+  {
+    auto first_entry = std::make_shared<uint32_t>(37);
+    sched.add(2, first_entry);
+    sched.add(1, second_entry);
+  }
+
+  auto peek = sched.peekAgain([](const double&) { return 1; });
+  auto p = sched.pickAndAdd([](const double&) { return 1; });
+  EXPECT_EQ(*peek, *p);
+  EXPECT_EQ(*second_entry, *p);
+  EXPECT_EQ(*second_entry, *sched.pickAndAdd([](const double&) { return 1; }));
+
+  peek.reset();
+  p.reset();
+  second_entry.reset();
+  EXPECT_EQ(nullptr, sched.pickAndAdd([](const double&) { return 1; }));
+  EXPECT_TRUE(sched.empty());
+}
+
+// Validate that createWithPicks() resumes where the same number of picks would have left off.
+TEST(IwrrSchedulerTest, CreateWithPicks) {
+  constexpr uint32_t num_entries = 5;
+  std::vector<std::shared_ptr<uint32_t>> entries;
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    entries.push_back(std::make_shared<uint32_t>(i));
+  }
+  const auto weight = [](const uint32_t& i) -> double { return i + 1; };
+
+  for (uint32_t picks : {0, 1, 7, 100, 767, 768, 1000000}) {
+    SCOPED_TRACE(picks);
+    IwrrScheduler<uint32_t> expected;
+    for (const auto& entry : entries) {
+      expected.add(weight(*entry), entry);
+    }
+    for (uint32_t i = 0; i < picks % 768; ++i) {
+      expected.pickAndAdd(weight);
+    }
+    auto sched = IwrrScheduler<uint32_t>::createWithPicks(entries, weight, picks);
+    for (uint32_t i = 0; i < 1000; ++i) {
+      EXPECT_EQ(*expected.pickAndAdd(weight), *sched.pickAndAdd(weight));
+    }
+  }
+}
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
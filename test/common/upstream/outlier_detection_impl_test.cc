@@ -1878,6 +1878,40 @@ TEST_F(OutlierDetectorImplTest, CrossThreadFailRace) {
   EXPECT_EQ(1UL, outlier_detection_ejections_active_.value());
 }
 
+TEST_F(OutlierDetectorImplTest, CrossThreadBatchedErrors) {
+  ON_CALL(runtime_.snapshot_, getInteger(MaxEjectionPercentRuntime, _)).WillByDefault(Return(100));
+  EXPECT_CALL(cluster_.prioritySet(), addMemberUpdateCb(_));
+  addHosts({"tcp://127.0.0.1:80", "tcp://127.0.0.1:81"});
+  EXPECT_CALL(*interval_timer_, enableTimer(std::chrono::milliseconds(10000), _));
+  std::shared_ptr<DetectorImpl> detector(DetectorImpl::create(cluster_, empty_outlier_detection_,
+                                                              dispatcher_, runtime_, time_system_,
+                                                              event_logger_, random_)
+                                             .value());
+  detector->addChangedStateCb([&](HostSharedPtr host) -> void { checker_.check(host); });
+
+  // Errors detected before the main thread runs the first post are processed with it.
+  Event::PostCb post_cb;
+  EXPECT_CALL(dispatcher_, post(_)).WillOnce([&post_cb](Event::PostCb cb) {
+    post_cb = std::move(cb);
+  });
+  loadRq(hosts_[0], 5, 500);
+  loadRq(hosts_[1], 5, 500);
+
+  time_system_.setMonotonicTime(std::chrono::milliseconds(0));
+  EXPECT_CALL(checker_, check(hosts_[0]));
+  EXPECT_CALL(checker_, check(hosts_[1]));
+  EXPECT_CALL(*event_logger_, logEject(_, _, envoy::data::cluster::v3::CONSECUTIVE_5XX, true))
+      .Times(2);
+  post_cb();
+  EXPECT_TRUE(hosts_[0]->healthFlagGet(Host::HealthFlag::FAILED_OUTLIER_CHECK));
+  EXPECT_TRUE(hosts_[1]->healthFlagGet(Host::HealthFlag::FAILED_OUTLIER_CHECK));
+  EXPECT_EQ(2UL, outlier_detection_ejections_active_.value());
+
+  // Once the queue is processed, the next error posts again.
+  EXPECT_CALL(dispatcher_, post(_));
+  loadRq(hosts_[0], 5, 500);
+}
+
 TEST_F(OutlierDetectorImplTest, MaxEjectionPercentage) {
   // A 50% ejection limit should not eject more than 1 out of 3 pods.
   const std::string yaml = R"EOF(
@@ -5,6 +5,7 @@
 
 #include "source/common/common/random_generator.h"
 #include "source/common/upstream/edf_scheduler.h"
+#include "source/common/upstream/iwrr_scheduler.h"
 #include "source/common/upstream/wrsq_scheduler.h"
 
 #include "test/benchmark/main.h"
@@ -81,6 +82,35 @@ public:
       sched.pickAndAdd([](const auto& i) { return i.weight; });
     }
   }
+
+  // Picks with weights that change on every pick, as the least request LB does with the number of
+  // active requests of each host.
+  static void
+  dynamicWeightPickTest(Scheduler<ObjInfo>& sched, ::benchmark::State& state,
+                        std::function<std::vector<std::shared_ptr<ObjInfo>>(Scheduler<ObjInfo>&)>
+                            setup) {
+    std::vector<std::shared_ptr<ObjInfo>> obj_info;
+    uint32_t picks = 0;
+    for (auto _ : state) { // NOLINT: Silences warning about dead store
+      if (obj_info.empty()) {
+        obj_info = setup(sched);
+      }
+
+      ++picks;
+      sched.pickAndAdd([picks](const auto& i) { return i.weight / (1 + picks % 3); });
+    }
+  }
+
+  static std::vector<std::shared_ptr<ObjInfo>> makeUniqueWeights(size_t num_objs) {
+    std::vector<std::shared_ptr<ObjInfo>> info;
+    for (uint32_t i = 0; i < num_objs; ++i) {
+      auto oi = std::make_shared<ObjInfo>();
+      oi->weight = static_cast<double>(i + 1);
+      info.emplace_back(oi);
+    }
+    std::shuffle(info.begin(), info.end(), std::default_random_engine());
+    return info;
+  }
 };
 
 void splitWeightAddEdf(::benchmark::State& state) {
@@ -159,6 +189,81 @@ void uniqueWeightPickWRSQ(::benchmark::State& state) {
                             });
 }
 
+void splitWeightAddIwrr(::benchmark::State& state) {
+  IwrrScheduler<SchedulerTester::ObjInfo> iwrr;
+  const size_t num_objs = state.range(0);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    SchedulerTester::setupSplitWeights(iwrr, num_objs, state);
+  }
+}
+
+void uniqueWeightAddIwrr(::benchmark::State& state) {
+  IwrrScheduler<SchedulerTester::ObjInfo> iwrr;
+  const size_t num_objs = state.range(0);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    SchedulerTester::setupUniqueWeights(iwrr, num_objs, state);
+  }
+}
+
+void splitWeightPickIwrr(::benchmark::State& state) {
+  IwrrScheduler<SchedulerTester::ObjInfo> iwrr;
+  const size_t num_objs = state.range(0);
+
+  SchedulerTester::pickTest(iwrr, state,
+                            [num_objs, &state](Scheduler<SchedulerTester::ObjInfo>& sched) {
+                              return SchedulerTester::setupSplitWeights(sched, num_objs, state);
+                            });
+}
+
+void uniqueWeightPickIwrr(::benchmark::State& state) {
+  IwrrScheduler<SchedulerTester::ObjInfo> iwrr;
+  const size_t num_objs = state.range(0);
+
+  SchedulerTester::pickTest(iwrr, state,
+                            [num_objs, &state](Scheduler<SchedulerTester::ObjInfo>& sched) {
+                              return SchedulerTester::setupUniqueWeights(sched, num_objs, state);
+                            });
+}
+
+void dynamicWeightPickEdf(::benchmark::State& state) {
+  EdfScheduler<SchedulerTester::ObjInfo> edf;
+  const size_t num_objs = state.range(0);
+
+  SchedulerTester::dynamicWeightPickTest(
+      edf, state, [num_objs, &state](Scheduler<SchedulerTester::ObjInfo>& sched) {
+        return SchedulerTester::setupUniqueWeights(sched, num_objs, state);
+      });
+}
+
+void dynamicWeightPickIwrr(::benchmark::State& state) {
+  IwrrScheduler<SchedulerTester::ObjInfo> iwrr;
+  const size_t num_objs = state.range(0);
+
+  SchedulerTester::dynamicWeightPickTest(
+      iwrr, state, [num_objs, &state](Scheduler<SchedulerTester::ObjInfo>& sched) {
+        return SchedulerTester::setupUniqueWeights(sched, num_objs, state);
+      });
+}
+
+// Rebuilds a scheduler from a host list the way the LBs do on every host set update.
+void uniqueWeightRebuildEdf(::benchmark::State& state) {
+  const auto info = SchedulerTester::makeUniqueWeights(state.range(0));
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    auto edf = EdfScheduler<SchedulerTester::ObjInfo>::createWithPicks(
+        info, [](const auto& i) { return i.weight; }, 12345);
+    ::benchmark::DoNotOptimize(edf);
+  }
+}
+
+void uniqueWeightRebuildIwrr(::benchmark::State& state) {
+  const auto info = SchedulerTester::makeUniqueWeights(state.range(0));
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    auto iwrr = IwrrScheduler<SchedulerTester::ObjInfo>::createWithPicks(
+        info, [](const auto& i) { return i.weight; }, 12345);
+    ::benchmark::DoNotOptimize(iwrr);
+  }
+}
+
 BENCHMARK(splitWeightAddEdf)
     ->Unit(::benchmark::kMicrosecond)
     ->RangeMultiplier(8)
@@ -179,6 +284,26 @@ BENCHMARK(uniqueWeightAddWRSQ)
     ->Range(1 << 6, 1 << 14);
 BENCHMARK(uniqueWeightPickEdf)->RangeMultiplier(8)->Range(1 << 6, 1 << 14);
 BENCHMARK(uniqueWeightPickWRSQ)->RangeMultiplier(8)->Range(1 << 6, 1 << 14);
+BENCHMARK(splitWeightAddIwrr)
+    ->Unit(::benchmark::kMicrosecond)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 14);
+BENCHMARK(uniqueWeightAddIwrr)
+    ->Unit(::benchmark::kMicrosecond)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 14);
+BENCHMARK(splitWeightPickIwrr)->RangeMultiplier(8)->Range(1 << 6, 1 << 14);
+BENCHMARK(uniqueWeightPickIwrr)->RangeMultiplier(8)->Range(1 << 6, 1 << 14);
+BENCHMARK(dynamicWeightPickEdf)->RangeMultiplier(8)->Range(1 << 6, 1 << 14);
+BENCHMARK(dynamicWeightPickIwrr)->RangeMultiplier(8)->Range(1 << 6, 1 << 14);
+BENCHMARK(uniqueWeightRebuildEdf)
+    ->Unit(::benchmark::kMicrosecond)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 14);
+BENCHMARK(uniqueWeightRebuildIwrr)
+    ->Unit(::benchmark::kMicrosecond)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 14);
 
 } // namespace
 } // namespace Upstream
@@ -125,6 +125,7 @@ public:
   }
 
   Secret::SecretManager& secretManager() override { return secret_manager_; }
+  Ssl::ContextManager& sslContextManager() override { return ssl_context_manager_; }
   Singleton::Manager& singletonManager() override { return singleton_manager_; }
 
   MOCK_METHOD(ClusterManager*, clusterManagerFromProto_,
@@ -2895,6 +2895,67 @@ TEST_F(StaticClusterImplTest, HealthyStat) {
   EXPECT_EQ(0UL, cluster->info()->endpointStats().membership_degraded_.value());
 }
 
+// Validate that a health change shares the host vectors with the new update instead of copying
+// them, and keeps the vectors of the partitions whose hosts did not change.
+TEST_F(StaticClusterImplTest, HealthChangeSharesHostVectors) {
+  const std::string yaml = R"EOF(
+    name: addressportconfig
+    connect_timeout: 0.25s
+    type: static
+    lb_policy: random
+    load_assignment:
+        endpoints:
+          - lb_endpoints:
+            - endpoint:
+                address:
+                  socket_address:
+                    address: 10.0.0.1
+                    port_value: 11001
+            - endpoint:
+                address:
+                  socket_address:
+                    address: 10.0.0.1
+                    port_value: 11002
+  )EOF";
+
+  envoy::config::cluster::v3::Cluster cluster_config = parseClusterFromV3Yaml(yaml);
+
+  Envoy::Upstream::ClusterFactoryContextImpl factory_context(
+      server_context_, server_context_.cluster_manager_, nullptr, ssl_context_manager_, nullptr,
+      false);
+  std::shared_ptr<StaticClusterImpl> cluster = createCluster(cluster_config, factory_context);
+
+  std::shared_ptr<MockHealthChecker> health_checker(new NiceMock<MockHealthChecker>());
+  cluster->setHealthChecker(health_checker);
+  cluster->initialize([] { return absl::OkStatus(); });
+
+  const auto& host_set = cluster->prioritySet().hostSetsPerPriority()[0];
+  const HostVectorConstSharedPtr hosts = host_set->hostsPtr();
+  const HostsPerLocalityConstSharedPtr hosts_per_locality = host_set->hostsPerLocalityPtr();
+  const HealthyHostVectorConstSharedPtr healthy_hosts = host_set->healthyHostsPtr();
+  const DegradedHostVectorConstSharedPtr degraded_hosts = host_set->degradedHostsPtr();
+  const HostsPerLocalityConstSharedPtr degraded_hosts_per_locality =
+      host_set->degradedHostsPerLocalityPtr();
+
+  hosts->at(0)->healthFlagClear(Host::HealthFlag::FAILED_ACTIVE_HC);
+  health_checker->runCallbacks(hosts->at(0), HealthTransition::Changed, HealthState::Healthy);
+  EXPECT_EQ(1UL, host_set->healthyHosts().size());
+  EXPECT_EQ(hosts, host_set->hostsPtr());
+  EXPECT_EQ(hosts_per_locality, host_set->hostsPerLocalityPtr());
+  EXPECT_NE(healthy_hosts, host_set->healthyHostsPtr());
+  EXPECT_EQ(degraded_hosts, host_set->degradedHostsPtr());
+  EXPECT_EQ(degraded_hosts_per_locality, host_set->degradedHostsPerLocalityPtr());
+
+  // An update that does not change any partition keeps all of them.
+  const HealthyHostVectorConstSharedPtr new_healthy_hosts = host_set->healthyHostsPtr();
+  const HostsPerLocalityConstSharedPtr healthy_hosts_per_locality =
+      host_set->healthyHostsPerLocalityPtr();
+  health_checker->runCallbacks(hosts->at(0), HealthTransition::Changed, HealthState::Healthy);
+  EXPECT_EQ(new_healthy_hosts, host_set->healthyHostsPtr());
+  EXPECT_EQ(healthy_hosts_per_locality, host_set->healthyHostsPerLocalityPtr());
+  EXPECT_EQ(degraded_hosts, host_set->degradedHostsPtr());
+}
+
 TEST_F(StaticClusterImplTest, InitialHostsDisableHC) {
   const std::string yaml = R"EOF(
     name: staticcluster
@@ -178,6 +178,35 @@ TEST_F(RedisClientImplTest, BatchWithZeroBufferAndTimeout) {
   client_->close();
 }
 
+TEST_F(RedisClientImplTest, LbPolicyDataCountsActiveRequests) {
+  // Load balancers that count active requests themselves see the requests of the client.
+  struct TestLbPolicyData : public Upstream::HostLbPolicyData {
+    void onRequestActive() override { active_++; }
+    void onRequestInactive() override { active_--; }
+    int64_t active_{};
+  };
+  auto lb_policy_data = std::make_unique<TestLbPolicyData>();
+  TestLbPolicyData& active_requests = *lb_policy_data;
+  host_->lb_policy_data_ = std::move(lb_policy_data);
+
+  InSequence s;
+
+  setup();
+
+  Common::Redis::RespValue request1;
+  MockClientCallbacks callbacks1;
+  EXPECT_CALL(*encoder_, encode(Ref(request1), _));
+  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  PoolRequest* handle1 = client_->makeRequest(request1, callbacks1);
+  EXPECT_NE(nullptr, handle1);
+  EXPECT_EQ(1, active_requests.active_);
+
+  EXPECT_CALL(callbacks1, onFailure());
+  EXPECT_CALL(*connect_or_op_timer_, disableTimer());
+  client_->close();
+  EXPECT_EQ(0, active_requests.active_);
+}
+
 class ConfigBufferSizeGTSingleRequest : public Config {
   bool disableOutlierEvents() const override { return false; }
   std::chrono::milliseconds opTimeout() const override { return std::chrono::milliseconds(25); }
@@ -1,7 +1,10 @@
+#include <thread>
+
 #include "envoy/config/core/v3/extension.pb.h"
 
 #include "source/extensions/load_balancing_policies/least_request/config.h"
 
+#include "test/common/upstream/utility.h"
 #include "test/mocks/server/factory_context.h"
 #include "test/mocks/upstream/cluster_info.h"
 #include "test/mocks/upstream/priority_set.h"
@@ -43,6 +46,43 @@ TEST(LeastRequestConfigTest, ValidateFail) {
   EXPECT_NE(nullptr, thread_local_lb);
 }
 
+TEST(LeastRequestConfigTest, PerWorkerActiveRequests) {
+  NiceMock<Server::Configuration::MockServerFactoryContext> context;
+  context.options_.concurrency_ = 3;
+  NiceMock<Upstream::MockClusterInfo> cluster_info;
+  NiceMock<Upstream::MockPrioritySet> main_thread_priority_set;
+  auto cluster_info_ptr = std::make_shared<NiceMock<Upstream::MockClusterInfo>>();
+  Upstream::HostSharedPtr host =
+      Upstream::makeTestHost(cluster_info_ptr, "tcp://127.0.0.1:80", context.time_system_);
+  main_thread_priority_set.getMockHostSet(0)->hosts_ = {host};
+
+  envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest config_msg;
+  config_msg.mutable_per_worker_active_requests()->mutable_aggregation_interval()->set_seconds(1);
+  auto& factory = Config::Utility::getAndCheckFactoryByName<Upstream::TypedLoadBalancerFactory>(
+      "envoy.load_balancing_policies.least_request");
+  auto lb_config = factory.loadConfig(context, config_msg).value();
+
+  auto thread_aware_lb =
+      factory.create(*lb_config, cluster_info, main_thread_priority_set, context.runtime_loader_,
+                     context.api_.random_, context.time_system_);
+  ASSERT_TRUE(thread_aware_lb->initialize().ok());
+
+  // Hosts get their counts when the load balancer is initialized or when they are added. There is
+  // a count for every worker and one for the main thread.
+  auto active_requests = host->typedLbPolicyData<Upstream::PerWorkerActiveRequests>();
+  ASSERT_TRUE(active_requests.has_value());
+  EXPECT_EQ(4, active_requests->numShards());
+  Upstream::HostSharedPtr added_host =
+      Upstream::makeTestHost(cluster_info_ptr, "tcp://127.0.0.1:81", context.time_system_);
+  main_thread_priority_set.getMockHostSet(0)->hosts_ = {host, added_host};
+  main_thread_priority_set.runUpdateCallbacks(0, {added_host}, {});
+  EXPECT_TRUE(added_host->typedLbPolicyData<Upstream::PerWorkerActiveRequests>().has_value());
+
+  // Requests counted by another thread are seen when the counts are first read.
+  std::thread([&host] { host->lbPolicyData()->onRequestActive(); }).join();
+  EXPECT_EQ(1, active_requests->activeRequests(context.time_system_.monotonicTime()));
+}
+
 } // namespace
 } // namespace LeastRequest
 } // namespace LoadBalancingPolices
@@ -1,3 +1,5 @@
+#include "envoy/stats/primitive_stats.h"
+
 #include "source/extensions/load_balancing_policies/least_request/least_request_lb.h"
 
 #include "test/benchmark/main.h"
@@ -62,6 +64,38 @@ BENCHMARK(benchmarkLeastRequestLoadBalancerChooseHost)
     ->Args({100, 100, 1000000})
     ->Unit(::benchmark::kMillisecond);
 
+// The two benchmarks below compare counting active requests in a gauge updated by all the workers
+// with counting them per worker. Each iteration starts a request to a host, compares the active
+// requests of two hosts as P2C does, and finishes the request. Run with --benchmark_filter on a
+// machine with many cores to see the cost of sharing the gauges.
+void benchmarkActiveRequestsSharedGauge(::benchmark::State& state) {
+  static Stats::PrimitiveGauge active_requests[2];
+  uint64_t less = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    active_requests[0].inc();
+    less += active_requests[0].value() < active_requests[1].value();
+    active_requests[0].dec();
+  }
+  ::benchmark::DoNotOptimize(less);
+}
+BENCHMARK(benchmarkActiveRequestsSharedGauge)->ThreadRange(1, 32)->UseRealTime();
+
+void benchmarkActiveRequestsPerWorker(::benchmark::State& state) {
+  static PerWorkerActiveRequests active_requests[2]{
+      PerWorkerActiveRequests(33, std::chrono::milliseconds(100)),
+      PerWorkerActiveRequests(33, std::chrono::milliseconds(100))};
+  // The time does not advance, so each thread sums the counts once, on its first read.
+  const MonotonicTime now;
+  uint64_t less = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    active_requests[0].onRequestActive();
+    less += active_requests[0].activeRequests(now) < active_requests[1].activeRequests(now);
+    active_requests[0].onRequestInactive();
+  }
+  ::benchmark::DoNotOptimize(less);
+}
+BENCHMARK(benchmarkActiveRequestsPerWorker)->ThreadRange(1, 32)->UseRealTime();
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
@@ -1,3 +1,5 @@
+#include <thread>
+
 #include "source/extensions/load_balancing_policies/least_request/least_request_lb.h"
 
 #include "test/extensions/load_balancing_policies/common/load_balancer_impl_base_test.h"
@@ -84,6 +86,37 @@ TEST_P(LeastRequestLoadBalancerTest, Normal) {
   EXPECT_EQ(hostSet().healthy_hosts_[1], lb_.chooseHost(nullptr).host);
 }
 
+// Validate that per worker counts are used instead of the rq_active gauge when configured.
+TEST_P(LeastRequestLoadBalancerTest, PerWorkerActiveRequests) {
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", simTime()),
+                              makeTestHost(info_, "tcp://127.0.0.1:81", simTime())};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({}, {}); // Trigger callbacks. The added/removed lists are not relevant.
+  for (const HostSharedPtr& host : hostSet().healthy_hosts_) {
+    host->setLbPolicyData(
+        std::make_unique<PerWorkerActiveRequests>(4, std::chrono::milliseconds(100)));
+  }
+
+  envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest lr_lb_config;
+  lr_lb_config.mutable_per_worker_active_requests();
+  LeastRequestLoadBalancer lb{priority_set_, nullptr, stats_,       runtime_,
+                              random_,       50,      lr_lb_config, simTime()};
+
+  // The gauges say the opposite of the per worker counts.
+  hostSet().healthy_hosts_[0]->stats().rq_active_.set(2);
+  hostSet().healthy_hosts_[1]->stats().rq_active_.set(1);
+  hostSet().healthy_hosts_[0]->lbPolicyData()->onRequestActive();
+  hostSet().healthy_hosts_[1]->lbPolicyData()->onRequestActive();
+  hostSet().healthy_hosts_[1]->lbPolicyData()->onRequestActive();
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(2)).WillOnce(Return(3));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb.chooseHost(nullptr).host);
+
+  hostSet().healthy_hosts_[0]->lbPolicyData()->onRequestActive();
+  hostSet().healthy_hosts_[0]->lbPolicyData()->onRequestActive();
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(2)).WillOnce(Return(3));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb.chooseHost(nullptr).host);
+}
+
 TEST_P(LeastRequestLoadBalancerTest, PNC) {
   hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", simTime()),
                               makeTestHost(info_, "tcp://127.0.0.1:81", simTime()),
@@ -263,6 +296,39 @@ TEST_P(LeastRequestLoadBalancerTest, WeightImbalance) {
   EXPECT_EQ(hostSet().healthy_hosts_[0], lb_.chooseHost(nullptr).host);
 }
 
+// Validate that active requests adjust weights with the interleaved weighted round robin scheduler.
+TEST_P(LeastRequestLoadBalancerTest, WeightImbalanceIwrrScheduler) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.lb_iwrr_scheduler", "true"}});
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", simTime(), 1),
+                              makeTestHost(info_, "tcp://127.0.0.1:81", simTime(), 2)};
+
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({}, {}); // Trigger callbacks. The added/removed lists are not relevant.
+
+  EXPECT_CALL(random_, random()).WillRepeatedly(Return(0));
+
+  // We should see 2:1 ratio for hosts[1] to hosts[0] over a cycle of 384 picks.
+  absl::flat_hash_map<HostConstSharedPtr, uint32_t> host_picked_count_map;
+  for (uint32_t i = 0; i < 384; ++i) {
+    host_picked_count_map[lb_.chooseHost(nullptr).host]++;
+  }
+  EXPECT_EQ(128, host_picked_count_map[hostSet().healthy_hosts_[0]]);
+  EXPECT_EQ(256, host_picked_count_map[hostSet().healthy_hosts_[1]]);
+
+  // Settings hosts[0] to an active request should yield a 4:1 ratio once the new weight is seen.
+  hostSet().healthy_hosts_[0]->stats().rq_active_.set(1);
+  for (uint32_t i = 0; i < 384; ++i) {
+    lb_.chooseHost(nullptr);
+  }
+  host_picked_count_map.clear();
+  for (uint32_t i = 0; i < 320; ++i) {
+    host_picked_count_map[lb_.chooseHost(nullptr).host]++;
+  }
+  EXPECT_EQ(64, host_picked_count_map[hostSet().healthy_hosts_[0]]);
+  EXPECT_EQ(256, host_picked_count_map[hostSet().healthy_hosts_[1]]);
+}
+
 // Validate that the load balancer defaults to an active request bias value of 1.0 if the runtime
 // value is invalid (less than 0.0).
 TEST_P(LeastRequestLoadBalancerTest, WeightImbalanceWithInvalidActiveRequestBias) {
@@ -558,6 +624,31 @@ TEST_P(LeastRequestLoadBalancerTest, SlowStartWithActiveHC) {
   EXPECT_EQ(hostSet().healthy_hosts_[0], lb_2.chooseHost(nullptr).host);
 }
 
+// Validate that a thread sees its own requests right away, and those of other threads when it
+// sums the counts, which it does at most once per aggregation interval.
+TEST(PerWorkerActiveRequestsTest, Aggregate) {
+  PerWorkerActiveRequests active_requests(16, std::chrono::milliseconds(100));
+  const MonotonicTime now;
+  active_requests.onRequestActive();
+  active_requests.onRequestActive();
+  std::thread([&active_requests] {
+    active_requests.onRequestActive();
+    active_requests.onRequestActive();
+    active_requests.onRequestActive();
+    active_requests.onRequestInactive();
+  }).join();
+  EXPECT_EQ(4, active_requests.activeRequests(now));
+
+  std::thread([&active_requests] { active_requests.onRequestActive(); }).join();
+  EXPECT_EQ(4, active_requests.activeRequests(now + std::chrono::milliseconds(99)));
+  active_requests.onRequestInactive();
+  EXPECT_EQ(3, active_requests.activeRequests(now + std::chrono::milliseconds(99)));
+
+  EXPECT_EQ(4, active_requests.activeRequests(now + std::chrono::milliseconds(100)));
+  active_requests.onRequestInactive();
+  EXPECT_EQ(3, active_requests.activeRequests(now + std::chrono::milliseconds(150)));
+}
+
 INSTANTIATE_TEST_SUITE_P(PrimaryOrFailoverAndLegacyOrNew, LeastRequestLoadBalancerTest,
                          ::testing::Values(LoadBalancerTestParam{true},
                                            LoadBalancerTestParam{false}));
@@ -9,8 +9,16 @@ namespace {
 
 class MaglevTester : public BaseTester {
 public:
-  MaglevTester(uint64_t num_hosts, uint32_t weighted_subset_percent = 0, uint32_t weight = 0)
+  MaglevTester(uint64_t num_hosts, uint32_t weighted_subset_percent = 0, uint32_t weight = 0,
+               bool incremental_table_update = false)
       : BaseTester(num_hosts, weighted_subset_percent, weight) {
+    if (incremental_table_update) {
+      envoy::extensions::load_balancing_policies::maglev::v3::Maglev config;
+      config.set_incremental_table_update(true);
+      maglev_lb_ = std::make_unique<MaglevLoadBalancer>(priority_set_, stats_, stats_scope_,
+                                                        runtime_, random_, 50, config);
+      return;
+    }
     maglev_lb_ = std::make_unique<MaglevLoadBalancer>(
         priority_set_, stats_, stats_scope_, runtime_, random_,
         config_.has_value()
@@ -80,6 +88,34 @@ BENCHMARK(benchmarkMaglevLoadBalancerBuildTable)
     ->Arg(500)
     ->Unit(::benchmark::kMillisecond);
 
+// Times the table update that follows the loss of a host, with a full rebuild (second argument 0)
+// or an incremental update (1).
+void benchmarkMaglevLoadBalancerUpdateTable(::benchmark::State& state) {
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    state.PauseTiming();
+    const uint64_t num_hosts = state.range(0);
+    MaglevTester tester(num_hosts, 0, 0, state.range(1) != 0);
+    ASSERT_TRUE(tester.maglev_lb_->initialize().ok());
+    HostVector hosts = tester.priority_set_.hostSetsPerPriority()[0]->hosts();
+    const HostVector removed{hosts.back()};
+    hosts.pop_back();
+    auto update = HostSetImpl::partitionHosts(std::make_shared<HostVector>(hosts),
+                                              makeHostsPerLocality({hosts}));
+    state.ResumeTiming();
+
+    tester.priority_set_.updateHosts(0, std::move(update), {}, {}, removed,
+                                     tester.random_.random(), absl::nullopt);
+  }
+}
+BENCHMARK(benchmarkMaglevLoadBalancerUpdateTable)
+    ->Args({100, 0})
+    ->Args({100, 1})
+    ->Args({500, 0})
+    ->Args({500, 1})
+    ->Args({5000, 0})
+    ->Args({5000, 1})
+    ->Unit(::benchmark::kMillisecond);
+
 void benchmarkMaglevLoadBalancerHostLoss(::benchmark::State& state) {
   for (auto _ : state) { // NOLINT: Silences warning about dead store
     const uint64_t num_hosts = state.range(0);
@@ -14,6 +14,7 @@
 #include "test/test_common/simulated_time_system.h"
 #include "test/test_common/test_runtime.h"
 
+#include "absl/strings/str_cat.h"
 #include "absl/types/optional.h"
 
 namespace Envoy {
@@ -323,6 +324,65 @@ TEST_F(MaglevLoadBalancerTest, BasicStability) {
   }
 }
 
+// Incremental table updates only reassign the entries of removed hosts, and the entries taken by
+// added hosts.
+TEST_F(MaglevLoadBalancerTest, IncrementalTableUpdate) {
+  for (uint32_t i = 0; i < 10; ++i) {
+    host_set_.hosts_.push_back(
+        makeTestHost(info_, absl::StrCat("tcp://127.0.0.1:", 90 + i), simTime()));
+  }
+  host_set_.healthy_hosts_ = host_set_.hosts_;
+  host_set_.runCallbacks({}, {});
+  envoy::extensions::load_balancing_policies::maglev::v3::Maglev config;
+  config.set_incremental_table_update(true);
+  lb_ = std::make_unique<MaglevLoadBalancer>(priority_set_, stats_, *stats_store_.rootScope(),
+                                             runtime_, random_, 50, config);
+  EXPECT_TRUE(lb_->initialize().ok());
+
+  const auto assignments = [this]() {
+    LoadBalancerPtr lb = lb_->factory()->create(lb_params_);
+    std::vector<HostConstSharedPtr> hosts;
+    for (uint64_t i = 0; i < MaglevTable::DefaultTableSize; ++i) {
+      TestLoadBalancerContext context(i);
+      hosts.push_back(lb->chooseHost(&context).host);
+    }
+    return hosts;
+  };
+  const std::vector<HostConstSharedPtr> before = assignments();
+
+  // The remaining hosts are below their new share, so they keep all their entries.
+  const HostSharedPtr removed = host_set_.hosts_[3];
+  host_set_.hosts_.erase(host_set_.hosts_.begin() + 3);
+  host_set_.healthy_hosts_ = host_set_.hosts_;
+  host_set_.runCallbacks({}, {removed});
+  const std::vector<HostConstSharedPtr> after_removal = assignments();
+  for (uint64_t i = 0; i < before.size(); ++i) {
+    if (before[i] == removed) {
+      EXPECT_NE(removed, after_removal[i]);
+    } else {
+      EXPECT_EQ(before[i], after_removal[i]);
+    }
+  }
+  EXPECT_EQ(7281, lb_->stats().min_entries_per_host_.value());
+  EXPECT_EQ(7282, lb_->stats().max_entries_per_host_.value());
+
+  // The added host takes its share from the others, and nothing else moves.
+  host_set_.hosts_.push_back(makeTestHost(info_, "tcp://127.0.0.1:100", simTime()));
+  host_set_.healthy_hosts_ = host_set_.hosts_;
+  host_set_.runCallbacks({host_set_.hosts_.back()}, {});
+  const std::vector<HostConstSharedPtr> after_addition = assignments();
+  uint64_t moved = 0;
+  for (uint64_t i = 0; i < before.size(); ++i) {
+    if (after_addition[i] != after_removal[i]) {
+      EXPECT_EQ(host_set_.hosts_.back(), after_addition[i]);
+      ++moved;
+    }
+  }
+  EXPECT_EQ(6554, moved);
+  EXPECT_EQ(6553, lb_->stats().min_entries_per_host_.value());
+  EXPECT_EQ(6554, lb_->stats().max_entries_per_host_.value());
+}
+
 // Weighted sanity test.
 TEST_F(MaglevLoadBalancerTest, Weighted) {
   host_set_.hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:90", simTime(), 1),
@@ -2,6 +2,7 @@
 
 #include "test/benchmark/main.h"
 #include "test/extensions/load_balancing_policies/common/benchmark_base_tester.h"
+#include "test/test_common/thread_factory_for_test.h"
 
 namespace Envoy {
 namespace Upstream {
@@ -18,10 +19,12 @@ public:
             ? makeOptRef<const envoy::config::cluster::v3::Cluster::RingHashLbConfig>(
                   config_.value())
             : absl::nullopt,
-        common_config_);
+        common_config_, build_pool_);
   }
 
   absl::optional<envoy::config::cluster::v3::Cluster::RingHashLbConfig> config_;
+  RingBuildThreadPoolSharedPtr build_pool_{
+      std::make_shared<RingBuildThreadPool>(Thread::threadFactoryForTest(), 3)};
   std::unique_ptr<RingHashLoadBalancer> ring_hash_lb_;
 };
 
@@ -51,6 +54,7 @@ BENCHMARK(benchmarkRingHashLoadBalancerBuildRing)
     ->Args({100, 256000})
     ->Args({200, 256000})
     ->Args({500, 256000})
+    ->Args({1000, 8388608})
     ->Unit(::benchmark::kMillisecond);
 
 void benchmarkRingHashLoadBalancerChooseHost(::benchmark::State& state) {
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 #include <memory>
@@ -6,6 +7,7 @@
 #include "envoy/config/cluster/v3/cluster.pb.h"
 #include "envoy/router/router.h"
 
+#include "source/common/common/hash.h"
 #include "source/common/network/utility.h"
 #include "source/common/upstream/upstream_impl.h"
 #include "source/extensions/load_balancing_policies/ring_hash/ring_hash_lb.h"
@@ -13,18 +15,22 @@
 #include "test/common/upstream/utility.h"
 #include "test/mocks/common.h"
 #include "test/mocks/runtime/mocks.h"
+#include "test/mocks/thread/mocks.h"
 #include "test/mocks/upstream/cluster_info.h"
 #include "test/mocks/upstream/host.h"
 #include "test/mocks/upstream/host_set.h"
 #include "test/mocks/upstream/load_balancer_context.h"
 #include "test/mocks/upstream/priority_set.h"
 #include "test/test_common/simulated_time_system.h"
+#include "test/test_common/thread_factory_for_test.h"
 
 #include "absl/container/node_hash_map.h"
 #include "absl/types/optional.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+using testing::_;
+using testing::Invoke;
 using testing::NiceMock;
 using testing::Return;
 
@@ -72,7 +78,7 @@ public:
             ? makeOptRef<const envoy::config::cluster::v3::Cluster::RingHashLbConfig>(
                   config_.value())
             : absl::nullopt,
-        common_config_);
+        common_config_, build_pool_);
     EXPECT_TRUE(lb_->initialize().ok());
   }
 
@@ -96,6 +102,8 @@ public:
   envoy::config::cluster::v3::Cluster::CommonLbConfig common_config_;
   NiceMock<Runtime::MockLoader> runtime_;
   NiceMock<Random::MockRandomGenerator> random_;
+  RingBuildThreadPoolSharedPtr build_pool_{
+      std::make_shared<RingBuildThreadPool>(Thread::threadFactoryForTest(), 3)};
   std::unique_ptr<RingHashLoadBalancer> lb_;
 };
 
@@ -112,7 +120,7 @@ TEST_P(RingHashLoadBalancerTest, ChooseHostBeforeInit) {
       config_.has_value()
           ? makeOptRef<const envoy::config::cluster::v3::Cluster::RingHashLbConfig>(config_.value())
           : absl::nullopt,
-      common_config_);
+      common_config_, build_pool_);
   EXPECT_EQ(nullptr, lb_->factory()->create(lb_params_)->chooseHost(nullptr).host);
 }
 
@@ -540,6 +548,101 @@ TEST_P(RingHashLoadBalancerTest, BasicWithRetryHostPredicate) {
   }
 }
 
+// Given a ring large enough to be built by several threads, expect the same host as a search of
+// the sorted hashes, including for retries.
+TEST_P(RingHashLoadBalancerTest, LargeRingMatchesSortedHashes) {
+  hostSet().hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:90", simTime()),
+                      makeTestHost(info_, "tcp://127.0.0.1:91", simTime()),
+                      makeTestHost(info_, "tcp://127.0.0.1:92", simTime()),
+                      makeTestHost(info_, "tcp://127.0.0.1:93", simTime()),
+                      makeTestHost(info_, "tcp://127.0.0.1:94", simTime())};
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks({}, {});
+
+  config_ = envoy::config::cluster::v3::Cluster::RingHashLbConfig();
+  config_.value().mutable_minimum_ring_size()->set_value(5 * 65536);
+  init();
+  EXPECT_EQ(5 * 65536, lb_->stats().size_.value());
+  EXPECT_EQ(65536, lb_->stats().min_hashes_per_host_.value());
+  EXPECT_EQ(65536, lb_->stats().max_hashes_per_host_.value());
+  LoadBalancerPtr lb = lb_->factory()->create(lb_params_);
+
+  std::vector<std::pair<uint64_t, uint32_t>> ring;
+  for (uint32_t host = 0; host < 5; ++host) {
+    for (uint32_t i = 0; i < 65536; ++i) {
+      ring.emplace_back(HashUtil::xxHash64(fmt::format("127.0.0.1:{}_{}", 90 + host, i)), host);
+    }
+  }
+  std::sort(ring.begin(), ring.end());
+
+  for (uint64_t i = 0; i < 1000; ++i) {
+    const uint64_t hash = i * (std::numeric_limits<uint64_t>::max() / 999);
+    const uint32_t attempt = i % 3;
+    const size_t lower_bound =
+        std::lower_bound(ring.begin(), ring.end(), std::make_pair(hash, uint32_t(0))) -
+        ring.begin();
+    const uint32_t expected = ring[(lower_bound + attempt) % ring.size()].second;
+    TestLoadBalancerContext context(
+        hash, attempt, [&, tries = attempt](const Host&) mutable { return tries-- > 0; });
+    EXPECT_EQ(hostSet().hosts_[expected], lb->chooseHost(&context).host);
+  }
+}
+
+// Given threads that cannot be created, expect a large ring to be built on the calling thread
+// alone, and to match the ring built by several threads.
+TEST_P(RingHashLoadBalancerTest, LargeRingBuiltInlineWithoutThreads) {
+  hostSet().hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:90", simTime()),
+                      makeTestHost(info_, "tcp://127.0.0.1:91", simTime()),
+                      makeTestHost(info_, "tcp://127.0.0.1:92", simTime())};
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks({}, {});
+
+  config_ = envoy::config::cluster::v3::Cluster::RingHashLbConfig();
+  config_.value().mutable_minimum_ring_size()->set_value(3 * 65536);
+  init();
+  LoadBalancerPtr threaded_lb = lb_->factory()->create(lb_params_);
+
+  NiceMock<Thread::MockThreadFactory> thread_factory;
+  EXPECT_CALL(thread_factory, createThread(_, _)).Times(3).WillRepeatedly(Return(nullptr));
+  build_pool_ = std::make_shared<RingBuildThreadPool>(thread_factory, 3);
+  init();
+  EXPECT_EQ(3 * 65536, lb_->stats().size_.value());
+  LoadBalancerPtr inline_lb = lb_->factory()->create(lb_params_);
+
+  for (uint64_t i = 0; i < 1000; ++i) {
+    TestLoadBalancerContext context(i * (std::numeric_limits<uint64_t>::max() / 999));
+    EXPECT_EQ(threaded_lb->chooseHost(&context).host, inline_lb->chooseHost(&context).host);
+  }
+}
+
+// Expect the helper threads of the build pool to be created once, on the first large ring build,
+// and to be reused by later rebuilds.
+TEST_P(RingHashLoadBalancerTest, LargeRingRebuildsReuseThreads) {
+  NiceMock<Thread::MockThreadFactory> thread_factory;
+  EXPECT_CALL(thread_factory, createThread(_, _))
+      .Times(3)
+      .WillRepeatedly(Invoke([](std::function<void()> thread_routine,
+                                Thread::OptionsOptConstRef options) {
+        return Thread::threadFactoryForTest().createThread(thread_routine, options);
+      }));
+  build_pool_ = std::make_shared<RingBuildThreadPool>(thread_factory, 3);
+
+  hostSet().hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:90", simTime()),
+                      makeTestHost(info_, "tcp://127.0.0.1:91", simTime())};
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks({}, {});
+
+  config_ = envoy::config::cluster::v3::Cluster::RingHashLbConfig();
+  config_.value().mutable_minimum_ring_size()->set_value(2 * 65536);
+  init();
+  EXPECT_EQ(2 * 65536, lb_->stats().size_.value());
+
+  hostSet().hosts_.push_back(makeTestHost(info_, "tcp://127.0.0.1:92", simTime()));
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks({hostSet().hosts_.back()}, {});
+  EXPECT_EQ(3 * 43691, lb_->stats().size_.value());
+}
+
 // Given 2 hosts and a minimum ring size of 3, expect 2 hashes per host and a ring size of 4.
 TEST_P(RingHashLoadBalancerTest, UnevenHosts) {
   hostSet().hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", simTime()),
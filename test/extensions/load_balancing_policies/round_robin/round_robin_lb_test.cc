@@ -495,6 +495,39 @@ TEST_P(RoundRobinLoadBalancerTest, WeightedInitializationPicksAllHosts) {
   }
 }
 
+// Validate weighted selection with the interleaved weighted round robin scheduler.
+TEST_P(RoundRobinLoadBalancerTest, WeightedIwrrScheduler) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.lb_iwrr_scheduler", "true"}});
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", simTime(), 1),
+                              makeTestHost(info_, "tcp://127.0.0.1:81", simTime(), 2),
+                              makeTestHost(info_, "tcp://127.0.0.1:82", simTime(), 4)};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  init(false);
+
+  // Any 448 consecutive picks make up a whole cycle of the schedule.
+  absl::flat_hash_map<HostConstSharedPtr, uint32_t> host_picked_count_map;
+  for (uint32_t i = 0; i < 448; ++i) {
+    host_picked_count_map[lb_->chooseHost(nullptr).host]++;
+  }
+  EXPECT_EQ(64, host_picked_count_map[hostSet().healthy_hosts_[0]]);
+  EXPECT_EQ(128, host_picked_count_map[hostSet().healthy_hosts_[1]]);
+  EXPECT_EQ(256, host_picked_count_map[hostSet().healthy_hosts_[2]]);
+
+  // Weight changes are applied after they are seen on picks.
+  hostSet().healthy_hosts_[0]->weight(4);
+  for (uint32_t i = 0; i < 448; ++i) {
+    lb_->chooseHost(nullptr);
+  }
+  host_picked_count_map.clear();
+  for (uint32_t i = 0; i < 640; ++i) {
+    host_picked_count_map[lb_->chooseHost(nullptr).host]++;
+  }
+  EXPECT_EQ(256, host_picked_count_map[hostSet().healthy_hosts_[0]]);
+  EXPECT_EQ(128, host_picked_count_map[hostSet().healthy_hosts_[1]]);
+  EXPECT_EQ(256, host_picked_count_map[hostSet().healthy_hosts_[2]]);
+}
+
 TEST_P(RoundRobinLoadBalancerTest, MaxUnhealthyPanic) {
   hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", simTime()),
                               makeTestHost(info_, "tcp://127.0.0.1:81", simTime())};
@@ -523,6 +556,71 @@ TEST_P(RoundRobinLoadBalancerTest, MaxUnhealthyPanic) {
   EXPECT_EQ(3UL, stats_.lb_healthy_panic_.value());
 }
 
+// Validate that an update keeping the host vector, e.g. a health change, keeps the scheduler of all
+// hosts, and that a new host vector rebuilds it.
+TEST_P(RoundRobinLoadBalancerTest, AllHostsSchedulerKeptAcrossHealthUpdates) {
+  auto hosts = std::make_shared<HostVector>(
+      HostVector{makeTestHost(info_, "tcp://127.0.0.1:80", simTime(), 1),
+                 makeTestHost(info_, "tcp://127.0.0.1:81", simTime(), 2)});
+  hostSet().hosts_ = *hosts;
+  hostSet().healthy_hosts_ = {hostSet().hosts_[0]};
+  ON_CALL(hostSet(), hostsPtr()).WillByDefault(Return(hosts));
+  // Any unhealthy host causes panic, so hosts are picked from all hosts.
+  common_config_.mutable_healthy_panic_threshold()->set_value(100);
+  init(false);
+  EXPECT_EQ(hostSet().hosts_[1], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().hosts_[0], lb_->chooseHost(nullptr).host);
+
+  hostSet().healthy_hosts_ = {hostSet().hosts_[1]};
+  hostSet().runCallbacks({}, {});
+  // The picks go on where they were. A new scheduler would pick hosts 1, 0, 1, 1.
+  EXPECT_EQ(hostSet().hosts_[1], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().hosts_[1], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().hosts_[0], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().hosts_[1], lb_->chooseHost(nullptr).host);
+
+  // The same hosts in a new vector start the picks over.
+  hosts = std::make_shared<HostVector>(*hosts);
+  ON_CALL(hostSet(), hostsPtr()).WillByDefault(Return(hosts));
+  hostSet().runCallbacks({}, {});
+  EXPECT_EQ(hostSet().hosts_[1], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().hosts_[0], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().hosts_[1], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().hosts_[1], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(10UL, stats_.lb_healthy_panic_.value());
+}
+
+// Validate that an update keeping the healthy host vector keeps the scheduler of healthy hosts,
+// while the scheduler of all hosts is rebuilt from its new vector, and that a new healthy host
+// vector rebuilds it.
+TEST_P(RoundRobinLoadBalancerTest, HealthyHostsSchedulerKeptAcrossUpdates) {
+  hostSet().hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", simTime(), 1),
+                      makeTestHost(info_, "tcp://127.0.0.1:81", simTime(), 2)};
+  auto healthy_hosts = std::make_shared<HealthyHostVector>(hostSet().hosts_);
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  ON_CALL(hostSet(), healthyHostsPtr()).WillByDefault(Return(healthy_hosts));
+  init(false);
+  EXPECT_EQ(hostSet().hosts_[1], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().hosts_[0], lb_->chooseHost(nullptr).host);
+
+  hostSet().runCallbacks({}, {});
+  // The picks go on where they were. A new scheduler would pick hosts 1, 0, 1, 1.
+  EXPECT_EQ(hostSet().hosts_[1], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().hosts_[1], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().hosts_[0], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().hosts_[1], lb_->chooseHost(nullptr).host);
+
+  // The same hosts in a new vector start the picks over.
+  healthy_hosts = std::make_shared<HealthyHostVector>(*healthy_hosts);
+  ON_CALL(hostSet(), healthyHostsPtr()).WillByDefault(Return(healthy_hosts));
+  hostSet().runCallbacks({}, {});
+  EXPECT_EQ(hostSet().hosts_[1], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().hosts_[0], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().hosts_[1], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().hosts_[1], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(0UL, stats_.lb_healthy_panic_.value());
+}
+
 // Test that no hosts are selected when fail_traffic_on_panic is enabled.
 TEST_P(RoundRobinLoadBalancerTest, MaxUnhealthyPanicDisableOnPanic) {
   hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", simTime()),
@@ -136,6 +136,43 @@ public:
     snapshot_.histograms_.push_back(*histogram_storage_.back());
   }
 
+  // Adds a histogram holding `values`, reporting its log-linear bins as the detailed buckets.
+  void addDetailedHistogramToSnapshot(const std::string& name, const std::vector<double>& values,
+                                      bool is_delta = false) {
+    auto histogram = std::make_unique<NiceMock<Stats::MockParentHistogram>>();
+
+    histogram_t* hist = hist_alloc();
+    for (auto value : values) {
+      hist_insert(hist, value, 1);
+    }
+    histogram_ptrs_.push_back(hist);
+    hist_stats_.push_back(std::make_unique<Stats::HistogramStatisticsImpl>(hist));
+
+    std::vector<Stats::ParentHistogram::Bucket> buckets(hist_num_buckets(hist));
+    for (uint32_t i = 0; i < buckets.size(); ++i) {
+      hist_bucket_t hist_bucket;
+      hist_bucket_idx_bucket(hist, i, &hist_bucket, &buckets[i].count_);
+      buckets[i].lower_bound_ = hist_bucket_to_double(hist_bucket);
+      buckets[i].width_ = hist_bucket_to_double_bin_width(hist_bucket);
+    }
+
+    if (is_delta) {
+      ON_CALL(*histogram, intervalStatistics()).WillByDefault(ReturnRef(*hist_stats_.back()));
+      ON_CALL(*histogram, detailedIntervalBuckets()).WillByDefault(Return(buckets));
+    } else {
+      ON_CALL(*histogram, cumulativeStatistics()).WillByDefault(ReturnRef(*hist_stats_.back()));
+      ON_CALL(*histogram, detailedTotalBuckets()).WillByDefault(Return(buckets));
+    }
+
+    histogram_storage_.emplace_back(std::move(histogram));
+    histogram_storage_.back()->name_ = name;
+    histogram_storage_.back()->setTagExtractedName(getTagExtractedName(name));
+    histogram_storage_.back()->used_ = true;
+    histogram_storage_.back()->setTags({{"hist_key", "hist_val"}});
+
+    snapshot_.histograms_.push_back(*histogram_storage_.back());
+  }
+
   long long int expected_time_ns_;
   std::vector<histogram_t*> histogram_ptrs_;
   std::vector<std::unique_ptr<Stats::HistogramStatisticsImpl>> hist_stats_;
@@ -433,6 +470,81 @@ TEST_F(OtlpMetricsFlusherTests, DeltaHistogramMetric) {
   expectHistogram(metricAt(1, metrics), getTagExtractedName("test_histogram2"), true);
 }
 
+TEST_F(OtlpMetricsFlusherTests, ExponentialHistogramOptions) {
+  SinkConfig sink_config;
+  EXPECT_FALSE(OtlpOptions(sink_config).exportExponentialHistograms());
+
+  sink_config.mutable_exponential_histogram();
+  OtlpOptions defaults(sink_config);
+  EXPECT_TRUE(defaults.exportExponentialHistograms());
+  EXPECT_EQ(20, defaults.exponentialHistogramMaxScale());
+  EXPECT_EQ(160, defaults.exponentialHistogramMaxBuckets());
+
+  sink_config.mutable_exponential_histogram()->mutable_max_scale()->set_value(-3);
+  sink_config.mutable_exponential_histogram()->mutable_max_buckets()->set_value(8);
+  OtlpOptions options(sink_config);
+  EXPECT_EQ(-3, options.exponentialHistogramMaxScale());
+  EXPECT_EQ(8, options.exponentialHistogramMaxBuckets());
+}
+
+TEST_F(OtlpMetricsFlusherTests, CumulativeExponentialHistogramMetric) {
+  SinkConfig sink_config;
+  sink_config.mutable_exponential_histogram()->mutable_max_scale()->set_value(0);
+  OtlpMetricsFlusherImpl flusher(std::make_shared<OtlpOptions>(sink_config));
+
+  addDetailedHistogramToSnapshot("test_histogram", {0, 1, 1, 1, 3, 10, 10, 10, 10, -3});
+
+  MetricsExportRequestSharedPtr metrics = flusher.flush(snapshot_);
+  expectMetricsCount(metrics, 1);
+  const auto& metric = metricAt(0, metrics);
+  EXPECT_EQ(getTagExtractedName("test_histogram"), metric.name());
+  EXPECT_FALSE(metric.has_histogram());
+  ASSERT_TRUE(metric.has_exponential_histogram());
+  EXPECT_EQ(AggregationTemporality::AGGREGATION_TEMPORALITY_CUMULATIVE,
+            metric.exponential_histogram().aggregation_temporality());
+  ASSERT_EQ(1, metric.exponential_histogram().data_points().size());
+
+  const auto& data_point = metric.exponential_histogram().data_points()[0];
+  EXPECT_EQ(expected_time_ns_, data_point.time_unix_nano());
+  expectAttributes(data_point.attributes(), "hist_key", "hist_val");
+  EXPECT_EQ(10, data_point.count());
+  EXPECT_EQ(0, data_point.scale());
+  EXPECT_EQ(1, data_point.zero_count());
+  // At scale 0 bucket i holds (2^i, 2^(i+1)]. The bins of 1, 3 and 10 have midpoints 1.05, 3.05
+  // and 10.5, so they land in buckets 0, 1 and 3.
+  EXPECT_EQ(0, data_point.positive().offset());
+  EXPECT_THAT(data_point.positive().bucket_counts(), testing::ElementsAre(3, 1, 0, 4));
+  EXPECT_EQ(1, data_point.negative().offset());
+  EXPECT_THAT(data_point.negative().bucket_counts(), testing::ElementsAre(1));
+}
+
+TEST_F(OtlpMetricsFlusherTests, DeltaExponentialHistogramMetricLowersScale) {
+  SinkConfig sink_config;
+  sink_config.set_report_histograms_as_deltas(true);
+  sink_config.mutable_exponential_histogram()->mutable_max_buckets()->set_value(4);
+  OtlpMetricsFlusherImpl flusher(std::make_shared<OtlpOptions>(sink_config));
+
+  addDetailedHistogramToSnapshot("test_histogram", {1, 1000}, true);
+
+  MetricsExportRequestSharedPtr metrics = flusher.flush(snapshot_);
+  expectMetricsCount(metrics, 1);
+  const auto& metric = metricAt(0, metrics);
+  ASSERT_TRUE(metric.has_exponential_histogram());
+  EXPECT_EQ(AggregationTemporality::AGGREGATION_TEMPORALITY_DELTA,
+            metric.exponential_histogram().aggregation_temporality());
+
+  const auto& data_point = metric.exponential_histogram().data_points()[0];
+  EXPECT_EQ(2, data_point.count());
+  EXPECT_GE(data_point.sum(), 1001);
+  // The midpoints 1.05 and 1050 are 10 doublings apart, which only fits in 4 buckets once each
+  // bucket spans 4 doublings, at scale -2.
+  EXPECT_EQ(-2, data_point.scale());
+  EXPECT_EQ(0, data_point.zero_count());
+  EXPECT_EQ(0, data_point.positive().offset());
+  EXPECT_THAT(data_point.positive().bucket_counts(), testing::ElementsAre(1, 0, 1));
+  EXPECT_EQ(0, data_point.negative().bucket_counts().size());
+}
+
 class MockOpenTelemetryGrpcMetricsExporter : public OpenTelemetryGrpcMetricsExporter {
 public:
   MOCK_METHOD(void, send, (MetricsExportRequestPtr &&));
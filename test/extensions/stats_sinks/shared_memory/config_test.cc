@@ -0,0 +1,77 @@
+#include "envoy/extensions/stat_sinks/shared_memory/v3/shared_memory.pb.h"
+
+#include "source/extensions/stat_sinks/shared_memory/config.h"
+#include "source/extensions/stat_sinks/shared_memory/shared_memory_impl.h"
+
+#include "test/mocks/server/instance.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace StatSinks {
+namespace SharedMemory {
+namespace {
+
+TEST(SharedMemoryConfigTest, SharedMemorySinkType) {
+  NiceMock<Server::Configuration::MockServerFactoryContext> server;
+  Server::Configuration::StatsSinkFactory* factory =
+      Registry::FactoryRegistry<Server::Configuration::StatsSinkFactory>::getFactory(
+          SharedMemoryName);
+  ASSERT_NE(factory, nullptr);
+
+  {
+    envoy::extensions::stat_sinks::shared_memory::v3::SharedMemorySink sink_config;
+    ProtobufTypes::MessagePtr message = factory->createEmptyConfigProto();
+    TestUtility::jsonConvert(sink_config, *message);
+
+    EXPECT_THROW(factory->createStatsSink(*message, server).value(), ProtoValidationException);
+  }
+
+  {
+    envoy::extensions::stat_sinks::shared_memory::v3::SharedMemorySink sink_config;
+    sink_config.set_path(TestEnvironment::temporaryPath("shared_memory_config_test"));
+    sink_config.mutable_max_size_bytes()->set_value(1 << 20);
+    ProtobufTypes::MessagePtr message = factory->createEmptyConfigProto();
+    TestUtility::jsonConvert(sink_config, *message);
+
+    Stats::SinkPtr sink = factory->createStatsSink(*message, server).value();
+    auto* shared_memory_sink = dynamic_cast<SharedMemoryStatsSink*>(sink.get());
+    ASSERT_NE(shared_memory_sink, nullptr);
+    EXPECT_EQ(1 << 20, shared_memory_sink->header().region_size_);
+  }
+
+  {
+    envoy::extensions::stat_sinks::shared_memory::v3::SharedMemorySink sink_config;
+    sink_config.set_path(TestEnvironment::temporaryPath("shared_memory_config_test"));
+    sink_config.mutable_removed_stats_reconcile_flushes()->set_value(0);
+    ProtobufTypes::MessagePtr message = factory->createEmptyConfigProto();
+    TestUtility::jsonConvert(sink_config, *message);
+
+    EXPECT_THROW(factory->createStatsSink(*message, server).value(), ProtoValidationException);
+  }
+}
+
+TEST(SharedMemoryConfigTest, UnwritablePath) {
+  NiceMock<Server::Configuration::MockServerFactoryContext> server;
+  Server::Configuration::StatsSinkFactory* factory =
+      Registry::FactoryRegistry<Server::Configuration::StatsSinkFactory>::getFactory(
+          SharedMemoryName);
+  envoy::extensions::stat_sinks::shared_memory::v3::SharedMemorySink sink_config;
+  sink_config.set_path(TestEnvironment::temporaryPath("missing_directory/stats"));
+  ProtobufTypes::MessagePtr message = factory->createEmptyConfigProto();
+  TestUtility::jsonConvert(sink_config, *message);
+
+  EXPECT_FALSE(factory->createStatsSink(*message, server).ok());
+}
+
+} // namespace
+} // namespace SharedMemory
+} // namespace StatSinks
+} // namespace Extensions
+} // namespace Envoy
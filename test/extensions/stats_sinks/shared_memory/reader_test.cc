@@ -0,0 +1,149 @@
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "source/extensions/stat_sinks/shared_memory/reader.h"
+
+#include "test/test_common/environment.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace StatSinks {
+namespace SharedMemory {
+namespace {
+
+// Lays out a region by hand with a single counter "rq.c.foo" carrying the tag c=foo.
+class RegionReaderTest : public testing::Test {
+protected:
+  RegionReaderTest() : words_(64) {
+    const std::string strings = "rq.c.foorqcfoo";
+    header().magic_ = RegionMagic;
+    header().version_ = RegionVersion;
+    header().header_size_ = sizeof(RegionHeader);
+    header().region_size_ = words_.size() * sizeof(uint64_t);
+    header().sequence_ = 6;
+    header().num_entries_ = 1;
+    header().num_tags_ = 1;
+    header().entries_offset_ = sizeof(RegionHeader);
+    header().tags_offset_ = header().entries_offset_ + sizeof(EntryRecord);
+    header().strings_offset_ = header().tags_offset_ + sizeof(TagRecord);
+    header().used_size_ = header().strings_offset_ + strings.size();
+    header().snapshot_time_ms_ = 1000;
+
+    entry().value_ = 42;
+    entry().name_offset_ = 0;
+    entry().name_size_ = 8;
+    entry().tag_extracted_name_offset_ = 8;
+    entry().tag_extracted_name_size_ = 2;
+    entry().first_tag_ = 0;
+    entry().num_tags_ = 1;
+    entry().type_ = StatType::Counter;
+    tag() = {10, 1, 11, 3};
+    memcpy(bytes() + header().strings_offset_, strings.data(), strings.size());
+  }
+
+  uint8_t* bytes() { return reinterpret_cast<uint8_t*>(words_.data()); }
+  RegionHeader& header() { return *reinterpret_cast<RegionHeader*>(bytes()); }
+  EntryRecord& entry() {
+    return *reinterpret_cast<EntryRecord*>(bytes() + header().entries_offset_);
+  }
+  TagRecord& tag() { return *reinterpret_cast<TagRecord*>(bytes() + header().tags_offset_); }
+  absl::string_view region() {
+    return {reinterpret_cast<const char*>(bytes()), header().used_size_};
+  }
+
+  void expectInvalid(const std::string& message) {
+    const auto snapshot = decodeRegion(region());
+    ASSERT_FALSE(snapshot.ok());
+    EXPECT_TRUE(absl::IsInvalidArgument(snapshot.status()));
+    EXPECT_THAT(snapshot.status().message(), testing::HasSubstr(message));
+  }
+
+  std::vector<uint64_t> words_;
+};
+
+TEST_F(RegionReaderTest, DecodesRegion) {
+  RegionReader reader(bytes(), words_.size() * sizeof(uint64_t));
+  const auto snapshot = reader.snapshot();
+  ASSERT_TRUE(snapshot.ok()) << snapshot.status();
+  EXPECT_EQ(6, snapshot->sequence_);
+  EXPECT_EQ(1000, snapshot->snapshot_time_ms_);
+  EXPECT_FALSE(snapshot->truncated_);
+  ASSERT_EQ(1, snapshot->stats_.size());
+  const StatSnapshot& stat = snapshot->stats_[0];
+  EXPECT_EQ("rq.c.foo", stat.name_);
+  EXPECT_EQ("rq", stat.tag_extracted_name_);
+  EXPECT_THAT(stat.tags_, testing::ElementsAre(testing::Pair("c", "foo")));
+  EXPECT_EQ(StatType::Counter, stat.type_);
+  EXPECT_EQ(42, stat.value_);
+}
+
+TEST_F(RegionReaderTest, WriterActive) {
+  header().sequence_ = 7;
+  RegionReader reader(bytes(), words_.size() * sizeof(uint64_t));
+  EXPECT_TRUE(absl::IsUnavailable(reader.snapshot(10).status()));
+}
+
+TEST_F(RegionReaderTest, UsedSizeBeyondMapping) {
+  RegionReader reader(bytes(), header().used_size_ - 1);
+  EXPECT_TRUE(absl::IsInvalidArgument(reader.snapshot().status()));
+}
+
+TEST_F(RegionReaderTest, BadMagic) {
+  header().magic_ = 0;
+  expectInvalid("magic");
+}
+
+TEST_F(RegionReaderTest, BadVersion) {
+  header().version_ = RegionVersion + 1;
+  expectInvalid("unsupported region version");
+}
+
+TEST_F(RegionReaderTest, OverlappingSections) {
+  header().num_entries_ = 2;
+  expectInvalid("sections overlap");
+}
+
+TEST_F(RegionReaderTest, UnknownType) {
+  entry().type_ = static_cast<StatType>(3);
+  expectInvalid("unknown type");
+}
+
+TEST_F(RegionReaderTest, NameOutOfBounds) {
+  entry().name_size_ = 100;
+  expectInvalid("name out of bounds");
+}
+
+TEST_F(RegionReaderTest, TagsOutOfBounds) {
+  entry().num_tags_ = 2;
+  expectInvalid("tags out of bounds");
+}
+
+TEST_F(RegionReaderTest, TagStringOutOfBounds) {
+  tag().value_offset_ = UINT32_MAX;
+  expectInvalid("tag 0 is out of bounds");
+}
+
+TEST_F(RegionReaderTest, Truncated) {
+  header().flags_ = RegionFlagTruncated;
+  EXPECT_TRUE(decodeRegion(region())->truncated_);
+}
+
+TEST(RegionReaderOpenTest, MissingFile) {
+  EXPECT_TRUE(
+      absl::IsNotFound(RegionReader::open(TestEnvironment::temporaryPath("missing")).status()));
+}
+
+TEST(RegionReaderOpenTest, NotARegion) {
+  const std::string path = TestEnvironment::writeStringToFileForTest("not_a_region", "short");
+  EXPECT_TRUE(absl::IsInvalidArgument(RegionReader::open(path).status()));
+}
+
+} // namespace
+} // namespace SharedMemory
+} // namespace StatSinks
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,283 @@
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/stat_sinks/shared_memory/reader.h"
+#include "source/extensions/stat_sinks/shared_memory/shared_memory_impl.h"
+
+#include "test/mocks/stats/mocks.h"
+#include "test/test_common/environment.h"
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/str_cat.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::ElementsAre;
+using testing::NiceMock;
+using testing::Pair;
+using testing::Return;
+
+namespace Envoy {
+namespace Extensions {
+namespace StatSinks {
+namespace SharedMemory {
+namespace {
+
+// A store that leaves out the gauges named in removed_gauges_, as if they had been removed.
+class StoreWithRemovedGauges : public Stats::IsolatedStoreImpl {
+public:
+  void forEachSinkedGauge(Stats::SizeFn f_size, Stats::StatFn<Stats::Gauge> f_stat) const override {
+    Stats::IsolatedStoreImpl::forEachSinkedGauge(f_size, [&](Stats::Gauge& gauge) {
+      if (!removed_gauges_.contains(gauge.name())) {
+        f_stat(gauge);
+      }
+    });
+  }
+
+  absl::flat_hash_set<std::string> removed_gauges_;
+};
+
+class SharedMemoryStatsSinkTest : public testing::Test {
+protected:
+  SharedMemoryStatsSinkTest()
+      : path_(TestEnvironment::temporaryPath("shared_memory_stats_sink_test")),
+        pool_(store_.symbolTable()) {}
+
+  void createSink(uint32_t size = 1 << 20, bool flush_changed_only = false,
+                  uint32_t reconcile_flushes = 12) {
+    auto sink_or_error =
+        SharedMemoryStatsSink::create(store_, path_, size, flush_changed_only, reconcile_flushes);
+    ASSERT_TRUE(sink_or_error.ok());
+    sink_ = std::move(sink_or_error.value());
+    auto reader_or_error = RegionReader::open(path_);
+    ASSERT_TRUE(reader_or_error.ok());
+    reader_ = std::move(reader_or_error.value());
+  }
+
+  Stats::Counter& counter(const std::string& name, const Stats::StatNameTagVector& tags = {}) {
+    Stats::Counter& counter =
+        store_.rootScope()->counterFromStatNameWithTags(pool_.add(name), tags);
+    snapshot_.counters_.push_back({0, counter});
+    return counter;
+  }
+
+  Stats::Gauge& gauge(const std::string& name) {
+    Stats::Gauge& gauge =
+        store_.rootScope()->gaugeFromString(name, Stats::Gauge::ImportMode::Accumulate);
+    snapshot_.gauges_.push_back(gauge);
+    return gauge;
+  }
+
+  RegionSnapshot readRegion() {
+    auto snapshot = reader_->snapshot();
+    EXPECT_TRUE(snapshot.ok()) << snapshot.status();
+    return std::move(snapshot.value());
+  }
+
+  const std::string path_;
+  StoreWithRemovedGauges store_;
+  Stats::StatNamePool pool_;
+  NiceMock<Stats::MockMetricSnapshot> snapshot_;
+  std::unique_ptr<SharedMemoryStatsSink> sink_;
+  std::unique_ptr<RegionReader> reader_;
+};
+
+TEST_F(SharedMemoryStatsSinkTest, EmptyRegion) {
+  createSink();
+  const RegionSnapshot region = readRegion();
+  EXPECT_EQ(2, region.sequence_);
+  EXPECT_FALSE(region.truncated_);
+  EXPECT_TRUE(region.stats_.empty());
+}
+
+TEST_F(SharedMemoryStatsSinkTest, PublishesCountersAndGauges) {
+  createSink();
+  counter("cluster.upstream_rq", {{pool_.add("envoy.cluster_name"), pool_.add("foo")}}).add(3);
+  gauge("server.live").set(1);
+  EXPECT_CALL(snapshot_, snapshotTime())
+      .WillRepeatedly(Return(SystemTime(std::chrono::milliseconds(1234))));
+  sink_->flush(snapshot_);
+
+  const RegionSnapshot region = readRegion();
+  EXPECT_EQ(4, region.sequence_);
+  EXPECT_EQ(1234, region.snapshot_time_ms_);
+  ASSERT_EQ(2, region.stats_.size());
+
+  const StatSnapshot& rq = region.stats_[0];
+  EXPECT_EQ("cluster.upstream_rq.envoy.cluster_name.foo", rq.name_);
+  EXPECT_EQ("cluster.upstream_rq", rq.tag_extracted_name_);
+  EXPECT_THAT(rq.tags_, ElementsAre(Pair("envoy.cluster_name", "foo")));
+  EXPECT_EQ(StatType::Counter, rq.type_);
+  EXPECT_EQ(3, rq.value_);
+
+  const StatSnapshot& live = region.stats_[1];
+  EXPECT_EQ("server.live", live.name_);
+  EXPECT_EQ(StatType::Gauge, live.type_);
+  EXPECT_EQ(1, live.value_);
+}
+
+TEST_F(SharedMemoryStatsSinkTest, UpdatesValuesInPlace) {
+  createSink();
+  Stats::Counter& rq = counter("upstream_rq");
+  Stats::Gauge& active = gauge("active");
+  rq.add(1);
+  active.set(5);
+  sink_->flush(snapshot_);
+  const uint64_t layouts = sink_->layoutsWritten();
+  const uint64_t used_size = sink_->header().used_size_;
+
+  rq.add(2);
+  active.set(4);
+  sink_->flush(snapshot_);
+  EXPECT_EQ(layouts, sink_->layoutsWritten());
+  EXPECT_EQ(used_size, sink_->header().used_size_);
+
+  const RegionSnapshot region = readRegion();
+  ASSERT_EQ(2, region.stats_.size());
+  EXPECT_EQ(3, region.stats_[0].value_);
+  EXPECT_EQ(4, region.stats_[1].value_);
+}
+
+TEST_F(SharedMemoryStatsSinkTest, SharesStrings) {
+  createSink();
+  const Stats::StatName cluster_name = pool_.add("envoy.cluster_name");
+  counter("upstream_rq", {{cluster_name, pool_.add("foo")}});
+  sink_->flush(snapshot_);
+  const uint64_t used_size = sink_->header().used_size_;
+
+  // Only the new name and tag value are added to the string table.
+  counter("upstream_rq", {{cluster_name, pool_.add("bar")}});
+  sink_->flush(snapshot_);
+  const std::string new_strings = "upstream_rq.envoy.cluster_name.bar"
+                                  "bar";
+  EXPECT_EQ(used_size + sizeof(EntryRecord) + sizeof(TagRecord) + new_strings.size(),
+            sink_->header().used_size_);
+  EXPECT_EQ(2, readRegion().stats_.size());
+}
+
+TEST_F(SharedMemoryStatsSinkTest, RemovesStatsMissingFromSnapshot) {
+  createSink();
+  counter("a").add(1);
+  counter("b").add(2);
+  sink_->flush(snapshot_);
+  EXPECT_EQ(2, readRegion().stats_.size());
+
+  snapshot_.counters_.pop_back();
+  sink_->flush(snapshot_);
+  const RegionSnapshot region = readRegion();
+  ASSERT_EQ(1, region.stats_.size());
+  EXPECT_EQ("a", region.stats_[0].name_);
+  EXPECT_EQ(1, region.stats_[0].value_);
+}
+
+TEST_F(SharedMemoryStatsSinkTest, KeepsUnchangedStatsWhenFlushingChangedOnly) {
+  createSink(1 << 20, true);
+  Stats::Counter& a = counter("a");
+  counter("b").add(2);
+  sink_->flush(snapshot_);
+  const uint64_t layouts = sink_->layoutsWritten();
+
+  a.add(1);
+  snapshot_.counters_.pop_back();
+  sink_->flush(snapshot_);
+  EXPECT_EQ(layouts, sink_->layoutsWritten());
+  const RegionSnapshot region = readRegion();
+  ASSERT_EQ(2, region.stats_.size());
+  EXPECT_EQ(1, region.stats_[0].value_);
+  EXPECT_EQ(2, region.stats_[1].value_);
+}
+
+TEST_F(SharedMemoryStatsSinkTest, ReconcilesRemovedStatsWhenFlushingChangedOnly) {
+  createSink(1 << 20, true, 5);
+  counter("a").add(1);
+  gauge("b").set(2);
+  sink_->flush(snapshot_);
+  EXPECT_EQ(2, readRegion().stats_.size());
+
+  // Removed stats are only dropped once the stats are read from the store.
+  snapshot_.gauges_.clear();
+  store_.removed_gauges_.insert("b");
+  for (uint64_t flushes = 2; flushes < 5; ++flushes) {
+    sink_->flush(snapshot_);
+    EXPECT_EQ(2, readRegion().stats_.size());
+  }
+  sink_->flush(snapshot_);
+  const RegionSnapshot region = readRegion();
+  ASSERT_EQ(1, region.stats_.size());
+  EXPECT_EQ("a", region.stats_[0].name_);
+  EXPECT_EQ(1, region.stats_[0].value_);
+}
+
+TEST_F(SharedMemoryStatsSinkTest, TruncatesStatsThatDoNotFit) {
+  createSink(4096);
+  Stats::Counter* last = nullptr;
+  for (int i = 0; i < 100; ++i) {
+    last = &counter(absl::StrCat("a.long.enough.stat.name.", i));
+    last->add(i);
+  }
+  sink_->flush(snapshot_);
+
+  const RegionSnapshot region = readRegion();
+  EXPECT_TRUE(region.truncated_);
+  EXPECT_LE(sink_->header().used_size_, 4096);
+  ASSERT_FALSE(region.stats_.empty());
+  ASSERT_LT(region.stats_.size(), 100);
+  for (size_t i = 0; i < region.stats_.size(); ++i) {
+    EXPECT_EQ(absl::StrCat("a.long.enough.stat.name.", i), region.stats_[i].name_);
+    EXPECT_EQ(i, region.stats_[i].value_);
+  }
+
+  // Stats left out of the region do not touch it when their values change.
+  last->add(1);
+  sink_->flush(snapshot_);
+  EXPECT_EQ(region.stats_.size(), readRegion().stats_.size());
+}
+
+TEST_F(SharedMemoryStatsSinkTest, ReplacesExistingFile) {
+  createSink();
+  counter("a");
+  sink_->flush(snapshot_);
+  std::unique_ptr<RegionReader> old_reader = std::move(reader_);
+
+  createSink();
+  EXPECT_TRUE(readRegion().stats_.empty());
+  // The previous region stays readable through its existing mapping.
+  EXPECT_EQ(1, old_reader->snapshot()->stats_.size());
+}
+
+// Readers racing with flushes must only ever see complete flushes.
+TEST_F(SharedMemoryStatsSinkTest, ConcurrentReader) {
+  createSink();
+  Stats::Gauge& first = gauge("first");
+  Stats::Gauge& second = gauge("second");
+
+  std::atomic<bool> done{false};
+  uint64_t snapshots = 0;
+  std::thread reader([&]() {
+    // The final flush leaves both stats in the region, so this loop ends.
+    while (!done || snapshots == 0) {
+      auto region = reader_->snapshot(UINT32_MAX);
+      ASSERT_TRUE(region.ok());
+      if (region->stats_.size() == 2) {
+        ASSERT_EQ(region->stats_[0].value_, region->stats_[1].value_);
+        ++snapshots;
+      }
+    }
+  });
+  for (uint64_t i = 0; i < 10000; ++i) {
+    first.set(i);
+    second.set(i);
+    sink_->flush(snapshot_);
+  }
+  done = true;
+  reader.join();
+  EXPECT_GT(snapshots, 0);
+}
+
+} // namespace
+} // namespace SharedMemory
+} // namespace StatSinks
+} // namespace Extensions
+} // namespace Envoy
@@ -189,6 +189,7 @@ public:
     health_check->mutable_http_health_check()->set_path("/healthcheck");
     health_check->mutable_http_health_check()->set_codec_client_type(codec_client_type);
     health_check->mutable_unhealthy_threshold()->set_value(unhealthy_threshold);
+    health_check->set_session_threads(session_threads_);
     if (retriable_range != nullptr) {
       auto* range = health_check->mutable_http_health_check()->add_retriable_statuses();
       range->set_start(retriable_range->start());
@@ -211,6 +212,9 @@ public:
     EXPECT_EQ(cluster_data.host_stream_->headers().getMethodValue(), "GET");
     EXPECT_EQ(cluster_data.host_stream_->headers().getHostValue(), cluster_data.name_);
   }
+
+  // The number of threads the health check sessions run on, 0 for the main thread.
+  uint32_t session_threads_{};
 };
 
 class HttpHealthCheckIntegrationTest : public Event::TestUsingSimulatedTime,
@@ -245,6 +249,25 @@ TEST_P(HttpHealthCheckIntegrationTest, SingleEndpointHealthyHttp) {
   EXPECT_EQ(0, test_server_->counter("cluster.cluster_1.health_check.failure")->value());
 }
 
+// Tests that health checks run on session threads reach the endpoint, and that their results are
+// applied to the cluster.
+TEST_P(HttpHealthCheckIntegrationTest, SingleEndpointHealthyHttpOnSessionThreads) {
+  const uint32_t cluster_idx = 0;
+  session_threads_ = 2;
+  initialize();
+  initHttpHealthCheck(cluster_idx);
+
+  // Endpoint responds with healthy status to the health check.
+  clusters_[cluster_idx].host_stream_->encodeHeaders(
+      Http::TestResponseHeaderMapImpl{{":status", "200"}}, false);
+  clusters_[cluster_idx].host_stream_->encodeData(1024, true);
+
+  // Verify that Envoy detected the health check response, and marked the host healthy.
+  test_server_->waitForCounterGe("cluster.cluster_1.health_check.success", 1);
+  test_server_->waitForGaugeEq("cluster.cluster_1.membership_healthy", 1);
+  EXPECT_EQ(0, test_server_->counter("cluster.cluster_1.health_check.failure")->value());
+}
+
 // Tests that an unhealthy endpoint returns a valid HTTP health check response.
 TEST_P(HttpHealthCheckIntegrationTest, SingleEndpointUnhealthyHttp) {
   const uint32_t cluster_idx = 0;
@@ -163,6 +163,37 @@ TEST_P(TcpProxyIntegrationTest, TcpProxyDownstreamDisconnectBytesMeter) {
                                                    "\r?.*")));
 }
 
+// Test that data spliced between the connections, in both directions and in amounts larger than a
+// pipe holds, arrives intact and is accounted for.
+TEST_P(TcpProxyIntegrationTest, TcpProxySpliceBytesMeter) {
+  config_helper_.addRuntimeOverride("envoy.reloadable_features.tcp_proxy_splice", "true");
+  setupByteMeterAccessLog();
+  initialize();
+  IntegrationTcpClientPtr tcp_client = makeTcpConnection(lookupPort("tcp_proxy"));
+  ASSERT_TRUE(tcp_client->write("hello"));
+  FakeRawConnectionPtr fake_upstream_connection;
+  ASSERT_TRUE(fake_upstreams_[0]->waitForRawConnection(fake_upstream_connection));
+  ASSERT_TRUE(fake_upstream_connection->waitForData(5));
+
+  const std::string upstream_data(256 * 1024, 'u');
+  ASSERT_TRUE(fake_upstream_connection->write(upstream_data));
+  tcp_client->waitForData(upstream_data);
+  const std::string downstream_data(128 * 1024, 'd');
+  ASSERT_TRUE(tcp_client->write(downstream_data, true));
+  ASSERT_TRUE(fake_upstream_connection->waitForData(5 + downstream_data.size()));
+  ASSERT_TRUE(fake_upstream_connection->waitForHalfClose());
+  ASSERT_TRUE(fake_upstream_connection->write("", true));
+  ASSERT_TRUE(fake_upstream_connection->waitForDisconnect());
+  tcp_client->waitForDisconnect();
+  test_server_.reset();
+  auto log_result = waitForAccessLog(listener_access_log_name_);
+  EXPECT_THAT(log_result, MatchesRegex(fmt::format("DOWNSTREAM_WIRE_BYTES_SENT=262144 "
+                                                   "DOWNSTREAM_WIRE_BYTES_RECEIVED=131077 "
+                                                   "UPSTREAM_WIRE_BYTES_SENT=131077 "
+                                                   "UPSTREAM_WIRE_BYTES_RECEIVED=262144"
+                                                   "\r?.*")));
+}
+
 TEST_P(TcpProxyIntegrationTest, TcpProxyRandomBehavior) {
   autonomous_upstream_ = true;
   initialize();
@@ -142,6 +142,9 @@ class MockLinuxOsSysCalls : public LinuxOsSysCallsImpl {
 public:
   // Api::LinuxOsSysCalls
   MOCK_METHOD(SysCallIntResult, sched_getaffinity, (pid_t pid, size_t cpusetsize, cpu_set_t* mask));
+  MOCK_METHOD(SysCallIntResult, pipe2, (int pipefd[2], int flags));
+  MOCK_METHOD(SysCallSizeResult, splice,
+              (os_fd_t fd_in, os_fd_t fd_out, size_t len, unsigned int flags));
 };
 #endif
 
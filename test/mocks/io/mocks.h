@@ -16,12 +16,14 @@ public:
   MOCK_METHOD(IoUringResult, prepareAccept,
               (os_fd_t fd, struct sockaddr* remote_addr, socklen_t* remote_addr_len,
                Request* user_data));
+  MOCK_METHOD(IoUringResult, prepareMultishotAccept, (os_fd_t fd, Request* user_data));
   MOCK_METHOD(IoUringResult, prepareConnect,
               (os_fd_t fd, const Network::Address::InstanceConstSharedPtr& address,
                Request* user_data));
   MOCK_METHOD(IoUringResult, prepareReadv,
               (os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs, off_t offset,
                Request* user_data));
+  MOCK_METHOD(IoUringResult, prepareRecvMultishot, (os_fd_t fd, Request* user_data));
   MOCK_METHOD(IoUringResult, prepareWritev,
               (os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs, off_t offset,
                Request* user_data));
@@ -31,6 +33,10 @@ public:
   MOCK_METHOD(IoUringResult, submit, ());
   MOCK_METHOD(void, injectCompletion, (os_fd_t fd, Request* user_data, int32_t result));
   MOCK_METHOD(void, removeInjectedCompletion, (os_fd_t fd));
+  MOCK_METHOD(bool, setupProvidedBuffers, (uint32_t num_buffers, uint32_t buffer_size));
+  MOCK_METHOD(uint32_t, numAvailableProvidedBuffers, (), (const));
+  MOCK_METHOD(uint8_t*, takeProvidedBuffer, (uint16_t buffer_id));
+  MOCK_METHOD(void, returnProvidedBuffer, (uint16_t buffer_id));
 };
 
 class MockIoUringSocket : public IoUringSocket {
@@ -57,6 +63,7 @@ public:
   MOCK_METHOD(const OptRef<ReadParam>&, getReadParam, (), (const));
   MOCK_METHOD(const OptRef<WriteParam>&, getWriteParam, (), (const));
   MOCK_METHOD(void, setFileReadyCb, (Event::FileReadyCb cb));
+  MOCK_METHOD(os_fd_t, popAcceptedFd, ());
 };
 
 class MockIoUringWorker : public IoUringWorker {
@@ -68,7 +75,9 @@ public:
                bool enable_close_event));
   MOCK_METHOD(IoUringSocket&, addClientSocket,
               (os_fd_t fd, Event::FileReadyCb cb, bool enable_close_event));
+  MOCK_METHOD(IoUringSocket&, addAcceptSocket, (os_fd_t fd, Event::FileReadyCb cb));
   MOCK_METHOD(Event::Dispatcher&, dispatcher, ());
+  MOCK_METHOD(Request*, submitAcceptRequest, (IoUringSocket & socket));
   MOCK_METHOD(Request*, submitConnectRequest,
               (IoUringSocket & socket, const Network::Address::InstanceConstSharedPtr& address));
   MOCK_METHOD(Request*, submitReadRequest, (IoUringSocket & socket));
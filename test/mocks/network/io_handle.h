@@ -40,6 +40,7 @@ public:
               (RawSliceArrays & slices, uint32_t self_port,
                const UdpSaveCmsgConfig& save_cmsg_config, RecvMsgOutput& output));
   MOCK_METHOD(Api::IoCallUint64Result, recv, (void* buffer, size_t length, int flags));
+  MOCK_METHOD(Api::IoCallUint64Result, recvZeroCopyCompletions, (const ZeroCopyCompletionCb& cb));
   MOCK_METHOD(bool, supportsMmsg, (), (const));
   MOCK_METHOD(bool, supportsUdpGro, (), (const));
   MOCK_METHOD(Api::SysCallIntResult, bind, (Address::InstanceConstSharedPtr address));
@@ -26,6 +26,9 @@ public:
 
   MOCK_METHOD(absl::StatusOr<ClientContextSharedPtr>, createSslClientContext,
               (Stats::Scope & scope, const ClientContextConfig& config));
+  MOCK_METHOD(PreparedClientContextsPtr, prepareClientContexts,
+              (const std::vector<const envoy::config::core::v3::TransportSocket*>&
+                   transport_sockets));
   MOCK_METHOD(absl::StatusOr<ServerContextSharedPtr>, createSslServerContext,
               (Stats::Scope & stats, const ServerContextConfig& config,
                const std::vector<std::string>& server_names,
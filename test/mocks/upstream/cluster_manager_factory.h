@@ -6,6 +6,7 @@
 #include "source/common/singleton/manager_impl.h"
 
 #include "test/mocks/secret/mocks.h"
+#include "test/mocks/ssl/mocks.h"
 #include "test/test_common/thread_factory_for_test.h"
 
 #include "gmock/gmock.h"
@@ -20,6 +21,7 @@ public:
   ~MockClusterManagerFactory() override;
 
   Secret::MockSecretManager& secretManager() override { return secret_manager_; };
+  Ssl::MockContextManager& sslContextManager() override { return ssl_context_manager_; }
   Singleton::Manager& singletonManager() override { return singleton_manager_; }
 
   MOCK_METHOD(absl::StatusOr<ClusterManagerPtr>, clusterManagerFromProto,
@@ -53,6 +55,7 @@ public:
 
 private:
   NiceMock<Secret::MockSecretManager> secret_manager_;
+  NiceMock<Ssl::MockContextManager> ssl_context_manager_;
   Singleton::ManagerImpl singleton_manager_;
 };
 } // namespace Upstream
@@ -30,19 +30,27 @@ MockHostSet::MockHostSet(uint32_t priority, uint32_t overprovisioning_factor)
   ON_CALL(*this, hostsPerLocality()).WillByDefault(Invoke([this]() -> const HostsPerLocality& {
     return *hosts_per_locality_;
   }));
-  ON_CALL(*this, hostsPerLocalityPtr()).WillByDefault(Return(hosts_per_locality_));
+  ON_CALL(*this, hostsPerLocalityPtr()).WillByDefault(Invoke([this]() {
+    return HostsPerLocalityConstSharedPtr(hosts_per_locality_);
+  }));
   ON_CALL(*this, healthyHostsPerLocality())
       .WillByDefault(
           Invoke([this]() -> const HostsPerLocality& { return *healthy_hosts_per_locality_; }));
-  ON_CALL(*this, healthyHostsPerLocalityPtr()).WillByDefault(Return(healthy_hosts_per_locality_));
+  ON_CALL(*this, healthyHostsPerLocalityPtr()).WillByDefault(Invoke([this]() {
+    return HostsPerLocalityConstSharedPtr(healthy_hosts_per_locality_);
+  }));
   ON_CALL(*this, degradedHostsPerLocality())
       .WillByDefault(
           Invoke([this]() -> const HostsPerLocality& { return *degraded_hosts_per_locality_; }));
-  ON_CALL(*this, degradedHostsPerLocalityPtr()).WillByDefault(Return(degraded_hosts_per_locality_));
+  ON_CALL(*this, degradedHostsPerLocalityPtr()).WillByDefault(Invoke([this]() {
+    return HostsPerLocalityConstSharedPtr(degraded_hosts_per_locality_);
+  }));
   ON_CALL(*this, excludedHostsPerLocality())
       .WillByDefault(
           Invoke([this]() -> const HostsPerLocality& { return *excluded_hosts_per_locality_; }));
-  ON_CALL(*this, excludedHostsPerLocalityPtr()).WillByDefault(Return(excluded_hosts_per_locality_));
+  ON_CALL(*this, excludedHostsPerLocalityPtr()).WillByDefault(Invoke([this]() {
+    return HostsPerLocalityConstSharedPtr(excluded_hosts_per_locality_);
+  }));
   ON_CALL(*this, localityWeights()).WillByDefault(Invoke([this]() -> LocalityWeightsConstSharedPtr {
     return locality_weights_;
   }));
@@ -101,6 +101,27 @@ protected:
 
   Stats::StatName makeStat(absl::string_view name) { return pool_.add(name); }
 
+  // Renders the stats of a store with a PrometheusStatsRequest, chunk_size bytes at a time.
+  std::string streamPrometheus(Stats::Store& store, const StatsParams& params,
+                               PrometheusNameCacheSharedPtr name_cache,
+                               const Stats::CustomStatNamespaces& custom_namespaces,
+                               uint64_t chunk_size = PrometheusStatsRequest::DefaultChunkSize) {
+    PrometheusStatsRequest request(store, params, endpoints_helper_->cm_, custom_namespaces,
+                                   std::move(name_cache));
+    request.setChunkSize(chunk_size);
+    Http::TestResponseHeaderMapImpl response_headers;
+    EXPECT_EQ(Http::Code::OK, request.start(response_headers));
+    std::string output;
+    Buffer::OwnedImpl chunk;
+    bool more;
+    do {
+      more = request.nextChunk(chunk);
+      output += chunk.toString();
+      chunk.drain(chunk.length());
+    } while (more);
+    return output;
+  }
+
   // Format tags into the name to create a unique stat_name for each name:tag combination.
   // If the same stat_name is passed to makeGauge() or makeCounter(), even with different
   // tags, a copy of the previous metric will be returned.
@@ -346,24 +367,16 @@ envoy_cluster_default_total_match_count{envoy_cluster_name="a"} 0
 envoy_cluster_default_total_match_count{envoy_cluster_name="x"} 0
 )EOF";
 
-  // Note: in the version of prometheus_stats_test.cc that works with the
-  // streaming GroupedStatsRequest, the test code is slightly different;
-  // it's based on the local 'store' object rather than being based on
-  // the counters_ member variable.
-  //    StatsParams params;
-  //    params.type_ = StatsType::Counters;
-  //    params.format_ = StatsFormat::Prometheus;
-  //    auto request = std::make_unique<GroupedStatsRequest>(store, params, custom_namespaces_);
-  //    EXPECT_EQ(expected_output, response(*request));
-  // This code is left here so that we can verify the bug is fixed if we decide to
-  // re-try the streaming Prometheus implementation.
-
   Buffer::OwnedImpl response;
   const uint64_t size = PrometheusStatsFormatter::statsAsPrometheus(
       counters_, gauges_, histograms_, textReadouts_, endpoints_helper_->cm_, response,
       StatsParams(), custom_namespaces);
   EXPECT_EQ(1, size);
   EXPECT_EQ(expected_output, response.toString());
+
+  // The streaming request reads the same stats from the store.
+  auto name_cache = std::make_shared<PrometheusNameCache>(&*symbol_table_);
+  EXPECT_EQ(expected_output, streamPrometheus(store, StatsParams(), name_cache, custom_namespaces));
 }
 
 TEST_F(PrometheusStatsFormatterTest, HistogramWithNonDefaultBuckets) {
@@ -1025,5 +1038,149 @@ envoy_cluster_endpoint_c1{a_tag_name="a.tag-value",envoy_cluster_name="test_1",e
   }
 }
 
+class PrometheusStatsRequestTest : public PrometheusStatsFormatterTest {
+protected:
+  PrometheusStatsRequestTest()
+      : store_(alloc_), name_cache_(std::make_shared<PrometheusNameCache>(&*symbol_table_)) {}
+
+  ~PrometheusStatsRequestTest() override { name_cache_.reset(); }
+
+  void addStoreStats(absl::string_view cluster) {
+    const Stats::StatNameTagVector tags{{makeStat("cluster"), makeStat(cluster)}};
+    Stats::Scope& root = *store_.rootScope();
+    root.counterFromStatNameWithTags(makeStat("cluster.upstream_cx_total"), tags).add(10);
+    root.gaugeFromStatNameWithTags(makeStat("cluster.upstream_cx_active"), tags,
+                                   Stats::Gauge::ImportMode::Accumulate)
+        .set(3);
+    root.textReadoutFromStatNameWithTags(makeStat("control_plane.identifier"), tags).set("cp\"1");
+  }
+
+  Stats::ThreadLocalStoreImpl store_;
+  Stats::CustomStatNamespacesImpl custom_namespaces_;
+  PrometheusNameCacheSharedPtr name_cache_;
+};
+
+TEST_F(PrometheusStatsRequestTest, MatchesFormatter) {
+  addStoreStats("c2");
+  addStoreStats("c1");
+  StatsParams params;
+  params.prometheus_text_readouts_ = true;
+
+  Buffer::OwnedImpl expected;
+  const uint64_t families = PrometheusStatsFormatter::statsAsPrometheus(
+      store_.counters(), store_.gauges(), store_.histograms(), store_.textReadouts(),
+      endpoints_helper_->cm_, expected, params, custom_namespaces_);
+  EXPECT_EQ(3, families);
+  EXPECT_EQ(R"EOF(# TYPE envoy_cluster_upstream_cx_total counter
+envoy_cluster_upstream_cx_total{cluster="c1"} 10
+envoy_cluster_upstream_cx_total{cluster="c2"} 10
+# TYPE envoy_cluster_upstream_cx_active gauge
+envoy_cluster_upstream_cx_active{cluster="c1"} 3
+envoy_cluster_upstream_cx_active{cluster="c2"} 3
+# TYPE envoy_control_plane_identifier gauge
+envoy_control_plane_identifier{cluster="c1",text_value="cp\"1"} 0
+envoy_control_plane_identifier{cluster="c2",text_value="cp\"1"} 0
+)EOF",
+            expected.toString());
+
+  EXPECT_EQ(expected.toString(),
+            streamPrometheus(store_, params, name_cache_, custom_namespaces_));
+  // A chunk ends after the line that reaches the chunk size.
+  EXPECT_EQ(expected.toString(),
+            streamPrometheus(store_, params, name_cache_, custom_namespaces_, 1));
+}
+
+TEST_F(PrometheusStatsRequestTest, CountsMetricFamilies) {
+  addStoreStats("c1");
+  addStoreStats("c2");
+  PrometheusStatsRequest request(store_, StatsParams(), endpoints_helper_->cm_,
+                                 custom_namespaces_, name_cache_);
+  Http::TestResponseHeaderMapImpl response_headers;
+  request.start(response_headers);
+  Buffer::OwnedImpl response;
+  while (request.nextChunk(response)) {
+  }
+  // Text readouts are only rendered on request.
+  EXPECT_EQ(2, request.metricFamilies());
+}
+
+TEST_F(PrometheusStatsRequestTest, ChunkSize) {
+  for (int i = 0; i < 10; ++i) {
+    addStoreStats(absl::StrCat("c", i));
+  }
+  PrometheusStatsRequest request(store_, StatsParams(), endpoints_helper_->cm_,
+                                 custom_namespaces_, name_cache_);
+  request.setChunkSize(100);
+  Http::TestResponseHeaderMapImpl response_headers;
+  request.start(response_headers);
+  Buffer::OwnedImpl response;
+  uint32_t chunks = 1;
+  while (request.nextChunk(response)) {
+    // Lines are rendered whole, so a chunk may go over the chunk size by one line.
+    EXPECT_LT(response.length(), 200);
+    response.drain(response.length());
+    ++chunks;
+  }
+  EXPECT_GT(chunks, 5);
+}
+
+TEST_F(PrometheusStatsRequestTest, NamesCachedAcrossScrapes) {
+  addStoreStats("c1");
+  Stats::ScopeSharedPtr scope = store_.rootScope()->createScope("scoped");
+  scope->counterFromString("removed");
+
+  const std::string first =
+      streamPrometheus(store_, StatsParams(), name_cache_, custom_namespaces_);
+  EXPECT_THAT(first, testing::HasSubstr("envoy_scoped_removed{} 0\n"));
+  EXPECT_EQ(3, name_cache_->size());
+  EXPECT_EQ(first, streamPrometheus(store_, StatsParams(), name_cache_, custom_namespaces_));
+  EXPECT_EQ(3, name_cache_->size());
+
+  // Names of stats that are gone are dropped after the next scrape.
+  scope.reset();
+  const std::string second =
+      streamPrometheus(store_, StatsParams(), name_cache_, custom_namespaces_);
+  EXPECT_THAT(second, testing::Not(testing::HasSubstr("removed")));
+  EXPECT_EQ(2, name_cache_->size());
+}
+
+TEST_F(PrometheusStatsRequestTest, EvictionWaitsForActiveScrapes) {
+  Stats::Counter& counter = store_.rootScope()->counterFromString("c");
+  Stats::Counter& other = store_.rootScope()->counterFromString("other");
+
+  name_cache_->beginScrape();
+  const PrometheusNameCache::Entry& entry = name_cache_->get(counter, custom_namespaces_);
+  EXPECT_EQ("envoy_c", entry.metric_name_);
+
+  // A later scrape that does not see the counter must not drop the entry the first scrape holds.
+  name_cache_->beginScrape();
+  name_cache_->get(other, custom_namespaces_);
+  name_cache_->endScrape();
+  EXPECT_EQ(2, name_cache_->size());
+  EXPECT_EQ("envoy_c", entry.metric_name_);
+  name_cache_->endScrape();
+  EXPECT_EQ(2, name_cache_->size());
+
+  name_cache_->beginScrape();
+  name_cache_->get(other, custom_namespaces_);
+  name_cache_->endScrape();
+  EXPECT_EQ(1, name_cache_->size());
+}
+
+TEST_F(PrometheusStatsRequestTest, OtherSymbolTablesNotCached) {
+  Stats::CustomStatNamespacesImpl custom_namespaces;
+  custom_namespaces.registerStatNamespace("promtest");
+  auto histogram = makeHistogram("cluster.upstream_rq_time", {});
+  Stats::Counter& invalid = store_.rootScope()->counterFromString("promtest.1234abcd");
+
+  name_cache_->beginScrape();
+  EXPECT_EQ("envoy_cluster_upstream_rq_time",
+            name_cache_->get(*histogram, custom_namespaces).metric_name_);
+  // Invalid names are cached too, so that they are only checked once.
+  EXPECT_EQ("", name_cache_->get(invalid, custom_namespaces).metric_name_);
+  name_cache_->endScrape();
+  EXPECT_EQ(1, name_cache_->size());
+}
+
 } // namespace Server
 } // namespace Envoy
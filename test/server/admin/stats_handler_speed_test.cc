@@ -194,11 +194,17 @@ public:
    */
   uint64_t handlerStats(const StatsParams& params) {
     Buffer::OwnedImpl data;
+    Admin::RequestPtr request;
     if (params.format_ == StatsFormat::Prometheus) {
-      StatsHandler::prometheusRender(*store_, custom_namespaces_, cm_, params, data);
-      return data.length();
+      // Shared across iterations, as the admin handler shares it across scrapes.
+      if (prometheus_name_cache_ == nullptr) {
+        prometheus_name_cache_ = std::make_shared<PrometheusNameCache>(&store_->symbolTable());
+      }
+      request = StatsHandler::makePrometheusRequest(*store_, params, cm_, custom_namespaces_,
+                                                    prometheus_name_cache_);
+    } else {
+      request = StatsHandler::makeRequest(*store_, params, cm_);
     }
-    Admin::RequestPtr request = StatsHandler::makeRequest(*store_, params, cm_);
     auto response_headers = Http::ResponseHeaderMapImpl::create();
     request->start(*response_headers);
     uint64_t count = 0;
@@ -215,6 +221,7 @@ public:
   Envoy::Stats::CustomStatNamespacesImpl custom_namespaces_;
   FastMockClusterManager cm_;
   bool endpoint_stats_initialized_{false};
+  PrometheusNameCacheSharedPtr prometheus_name_cache_;
 };
 
 } // namespace Server
@@ -8,6 +8,7 @@
 #include "envoy/server/bootstrap_extension_config.h"
 #include "envoy/server/fatal_action_config.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/assert.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/network/listen_socket_impl.h"
@@ -160,6 +161,48 @@ TEST(ServerInstanceUtil, flushImportModeUninitializedGauges) {
   InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
 }
 
+TEST(ServerInstanceUtil, flushChangedOnly) {
+  InSequence s;
+
+  NiceMock<Upstream::MockClusterManager> cm;
+  Stats::TestUtil::TestStore store;
+  Event::SimulatedTimeSystem time_system;
+  Stats::Counter& c = store.counter("hello");
+  Stats::Gauge& g = store.gauge("world", Stats::Gauge::ImportMode::Accumulate);
+  store.counter("unchanged").inc();
+  c.inc();
+  g.set(5);
+
+  std::list<Stats::SinkPtr> sinks;
+  Stats::MockSink* sink = new StrictMock<Stats::MockSink>();
+  sinks.emplace_back(sink);
+
+  // The first flush reports everything.
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_EQ(snapshot.counters().size(), 2);
+    EXPECT_EQ(snapshot.gauges().size(), 1);
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system, true);
+
+  // Later flushes only report what changed.
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    ASSERT_EQ(snapshot.counters().size(), 1);
+    EXPECT_EQ(snapshot.counters()[0].counter_.get().name(), "hello");
+    EXPECT_EQ(snapshot.counters()[0].delta_, 2);
+    EXPECT_TRUE(snapshot.gauges().empty());
+  }));
+  c.add(2);
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system, true);
+
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_TRUE(snapshot.counters().empty());
+    ASSERT_EQ(snapshot.gauges().size(), 1);
+    EXPECT_EQ(snapshot.gauges()[0].get().value(), 7);
+  }));
+  g.set(7);
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system, true);
+}
+
 class RunHelperTest : public testing::Test {
 public:
   RunHelperTest() {
@@ -881,6 +924,26 @@ TEST_P(ServerStatsTest, FlushStats) {
   EXPECT_EQ(recent_lookups.value(), strobed_recent_lookups);
 }
 
+TEST_P(ServerStatsTest, BufferSliceCacheStats) {
+  initialize("test/server/test_data/server/buffer_slice_cache_bootstrap.yaml");
+  EXPECT_EQ(65536, Buffer::SliceStorageCache::maxBytesPerThread());
+
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.buffer_slice_storage_cache", "true"}});
+  Buffer::SliceStorageCache::clearThreadCacheForTest();
+  { Buffer::OwnedImpl buffer(std::string(10, 'a')); }
+  const Buffer::SliceStorageCache::Counters counters = Buffer::SliceStorageCache::counters();
+  flushStats();
+  // Flushing may allocate slices too.
+  EXPECT_LE(counters.misses_,
+            TestUtility::findCounter(stats_store_, "server.buffer_slice_cache_misses")->value());
+  EXPECT_NE(nullptr, TestUtility::findGauge(stats_store_, "server.buffer_slice_cache_bytes"));
+
+  Buffer::SliceStorageCache::clearThreadCacheForTest();
+  Buffer::SliceStorageCache::setMaxBytesPerThread(
+      Buffer::SliceStorageCache::DefaultMaxBytesPerThread);
+}
+
 TEST_P(ServerInstanceImplTest, FlushStatsOnAdmin) {
   CustomStatsSinkFactory factory;
   Registry::InjectFactory<Server::Configuration::StatsSinkFactory> registered(factory);
@@ -0,0 +1,49 @@
+// NOLINT(namespace-envoy)
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "source/extensions/stat_sinks/shared_memory/reader.h"
+
+using Envoy::Extensions::StatSinks::SharedMemory::RegionReader;
+using Envoy::Extensions::StatSinks::SharedMemory::StatSnapshot;
+using Envoy::Extensions::StatSinks::SharedMemory::StatType;
+
+int main(int argc, char* argv[]) {
+  const bool dump = argc == 3 && std::string(argv[2]) == "--dump";
+  if (argc != 2 && !dump) {
+    std::cerr << "Usage: stats_region_check PATH [--dump]\n"
+                 "\nValidate the stats region published by the shared memory stat sink\n"
+                 "\n\tPATH - the path the sink was configured with."
+                 "\n\t--dump - print every stat in the region."
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  auto reader = RegionReader::open(argv[1]);
+  if (!reader.ok()) {
+    std::cerr << reader.status() << std::endl;
+    return EXIT_FAILURE;
+  }
+  const auto snapshot = (*reader)->snapshot();
+  if (!snapshot.ok()) {
+    std::cerr << "Invalid stats region: " << snapshot.status() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (dump) {
+    for (const StatSnapshot& stat : snapshot->stats_) {
+      std::cout << (stat.type_ == StatType::Counter ? "counter " : "gauge ") << stat.name_ << ": "
+                << stat.value_ << " (" << stat.tag_extracted_name_;
+      for (const auto& [name, value] : stat.tags_) {
+        std::cout << " " << name << "=" << value;
+      }
+      std::cout << ")\n";
+    }
+  }
+  std::cout << "Stats: " << snapshot->stats_.size() << ". Sequence: " << snapshot->sequence_
+            << ". Snapshot time (ms): " << snapshot->snapshot_time_ms_ << "."
+            << (snapshot->truncated_ ? " Some stats did not fit in the region." : "")
+            << std::endl;
+  return EXIT_SUCCESS;
+}